@@ -165,6 +165,12 @@
 #ifndef HAVE_SYS_IOCTL_H
 #cmakedefine HAVE_SYS_IOCTL_H
 #endif
+#ifndef HAVE_SYS_SELECT_H
+#cmakedefine HAVE_SYS_SELECT_H
+#endif
+#ifndef HAVE_SYS_INOTIFY_H
+#cmakedefine HAVE_SYS_INOTIFY_H
+#endif
 #ifndef HAVE_MYSQL_MYSQL_H
 #cmakedefine HAVE_MYSQL_MYSQL_H
 #endif
@@ -181,10 +187,19 @@
 #ifndef HAVE_SYS_UTSNAME_H
 #cmakedefine HAVE_SYS_UTSNAME_H
 #endif
+#ifndef HAVE_SYS_UN_H
+#cmakedefine HAVE_SYS_UN_H
+#endif
 
 #ifndef HAVE_ALARM
 #cmakedefine HAVE_ALARM
 #endif
+#ifndef HAVE_CLOCK_GETTIME
+#cmakedefine HAVE_CLOCK_GETTIME
+#endif
+#ifndef HAVE_MMAP
+#cmakedefine HAVE_MMAP
+#endif
 #ifndef HAVE_GETPASS
 #cmakedefine HAVE_GETPASS
 #endif
@@ -21,3 +21,15 @@ alter table outbox_multipart add constraint "outbox_multipart_Coding_check"
 alter table sentitems drop constraint "sentitems_Coding_check";
 alter table sentitems add constraint "sentitems_Coding_check"
   check ("Coding" IN ('Default_No_Compression', 'Unicode_No_Compression', '8bit', 'Default_Compression', 'Unicode_Compression', 'ASCII'));
+
+--
+-- notify SMSD about new messages in outbox
+--
+CREATE OR REPLACE FUNCTION notify_outbox() RETURNS trigger AS $notify_outbox$
+  BEGIN
+    NOTIFY gammu_outbox;
+    RETURN NULL;
+  END;
+$notify_outbox$ LANGUAGE plpgsql;
+DROP TRIGGER IF EXISTS notify_outbox ON outbox;
+CREATE TRIGGER notify_outbox AFTER INSERT ON outbox FOR EACH STATEMENT EXECUTE PROCEDURE notify_outbox();
@@ -19,6 +19,16 @@ CREATE OR REPLACE FUNCTION update_timestamp() RETURNS trigger AS $update_timesta
   END;
 $update_timestamp$ LANGUAGE plpgsql;
 
+--
+-- Function declaration for notifying SMSD about new messages in outbox
+--
+CREATE OR REPLACE FUNCTION notify_outbox() RETURNS trigger AS $notify_outbox$
+  BEGIN
+    NOTIFY gammu_outbox;
+    RETURN NULL;
+  END;
+$notify_outbox$ LANGUAGE plpgsql;
+
 -- --------------------------------------------------------
 
 --
@@ -150,6 +160,7 @@ CREATE INDEX outbox_sender ON outbox("SenderID");
 --
 
 CREATE TRIGGER update_timestamp BEFORE UPDATE ON outbox FOR EACH ROW EXECUTE PROCEDURE update_timestamp();
+CREATE TRIGGER notify_outbox AFTER INSERT ON outbox FOR EACH STATEMENT EXECUTE PROCEDURE notify_outbox();
 
 -- --------------------------------------------------------
 
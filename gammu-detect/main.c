@@ -38,6 +38,7 @@
 #ifdef WIN32
 #include "win32-serial.h"
 #endif
+#include "probe.h"
 
 gint debug = 0;
 #ifdef GUDEV_FOUND
@@ -50,10 +51,16 @@ gint no_bluez = 0;
 gint no_win32_serial = 0;
 #endif
 gint show_version = 0;
+gint probe = 0;
+gint probe_timeout = 10;
+gint probe_threads = 64;
 
 static GOptionEntry entries[] = {
 	{"debug", 'd', 0, G_OPTION_ARG_NONE, &debug, N_("Show debugging output for detecting devices."), NULL},
 	{"version", 'v', 0, G_OPTION_ARG_NONE, &show_version, N_("Show version information and compiled in features."), NULL},
+	{"probe", 'p', 0, G_OPTION_ARG_NONE, &probe, N_("Connects to detected devices and lists only those with responding phone."), NULL},
+	{"timeout", 't', 0, G_OPTION_ARG_INT, &probe_timeout, N_("Maximal time in seconds for probing one device."), N_("SECONDS")},
+	{"threads", 'j', 0, G_OPTION_ARG_INT, &probe_threads, N_("Number of devices probed at once."), N_("COUNT")},
 #ifdef GUDEV_FOUND
 	{"no-udev", 'u', 0, G_OPTION_ARG_NONE, &no_udev, N_("Disables scanning of udev."), NULL},
 #endif
@@ -92,7 +99,7 @@ void print_version(void)
 	printf("\n");
 }
 
-void print_config(const gchar *device, const gchar *name, const gchar *connection)
+void write_config(const gchar *device, const gchar *name, const gchar *connection, const gchar *imei)
 {
 	static gint section = 0;
 
@@ -114,9 +121,21 @@ void print_config(const gchar *device, const gchar *name, const gchar *connectio
 	if (connection != NULL) {
 		g_print("connection = %s\n", connection);
 	}
+	if (imei != NULL && imei[0] != 0) {
+		g_print("; IMEI: %s\n", imei);
+	}
 	g_print("\n");
 }
 
+void print_config(const gchar *device, const gchar *name, const gchar *connection)
+{
+	if (probe) {
+		probe_add(device, name, connection);
+	} else {
+		write_config(device, name, connection, NULL);
+	}
+}
+
 int main(int argc, char *argv[])
 {
 	GError *error = NULL;
@@ -164,6 +183,11 @@ int main(int argc, char *argv[])
 		return 0;
 	}
 
+	if (probe_timeout <= 0 || probe_threads <= 0) {
+		g_printerr("%s\n", _("Timeout and number of threads have to be positive."));
+		exit(1);
+	}
+
 #ifdef GUDEV_FOUND
 	if (!no_udev) {
 		udev_detect();
@@ -180,6 +204,10 @@ int main(int argc, char *argv[])
 	}
 #endif
 
+	if (probe) {
+		probe_run(probe_timeout, probe_threads);
+	}
+
 	return 0;
 }
 
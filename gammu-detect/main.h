@@ -1,3 +1,4 @@
 extern gint debug;
 
+extern void write_config(const gchar *device, const gchar *name, const gchar *connection, const gchar *imei);
 extern void print_config(const gchar *device, const gchar *name, const gchar *connection);
@@ -0,0 +1,227 @@
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <glib.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <gammu.h>		/* For PRINTF_STYLE and locales */
+#include "../helper/locales.h"	/* For gettext */
+
+#include "config.h"
+
+#include "probe.h"
+#include "main.h"
+
+/**
+ * Candidate device found by detection, which is probed for phone.
+ */
+typedef struct {
+	gchar *device;
+	gchar *name;
+	gchar *connection;
+	/* State machine of running probe, protected by probe lock */
+	GSM_StateMachine *sm;
+	/* Monotonic time in milliseconds when probe started */
+	long long started;
+	gboolean finished;
+	GSM_Error error;
+	char manufacturer[GSM_MAX_MANUFACTURER_LENGTH + 1];
+	char model[GSM_MAX_MODEL_LENGTH + 1];
+	char imei[GSM_MAX_IMEI_LENGTH + 1];
+} probe_device;
+
+static GPtrArray *candidates = NULL;
+
+G_LOCK_DEFINE_STATIC(probe);
+
+void probe_add(const gchar *device, const gchar *name, const gchar *connection)
+{
+	probe_device *dev;
+
+	if (candidates == NULL) {
+		candidates = g_ptr_array_new();
+	}
+
+	dev = g_new0(probe_device, 1);
+	dev->device = g_strdup(device);
+	dev->name = g_strdup(name);
+	dev->connection = g_strdup(connection);
+	dev->error = ERR_UNKNOWN;
+	g_ptr_array_add(candidates, dev);
+}
+
+static void probe_free(probe_device *dev)
+{
+	g_free(dev->device);
+	g_free(dev->name);
+	g_free(dev->connection);
+	g_free(dev);
+}
+
+/**
+ * Connects to single device and reads phone identification, executed
+ * in thread pool.
+ */
+static void probe_device_thread(gpointer data, gpointer user_data UNUSED)
+{
+	probe_device *dev = data;
+	GSM_StateMachine *sm;
+	GSM_Config *cfg;
+	GSM_Error error;
+
+	sm = GSM_AllocStateMachine();
+	if (sm == NULL) {
+		G_LOCK(probe);
+		dev->error = ERR_MOREMEMORY;
+		dev->finished = TRUE;
+		G_UNLOCK(probe);
+		return;
+	}
+
+	cfg = GSM_GetConfig(sm, 0);
+	cfg->Device = strdup(dev->device);
+	cfg->Connection = strdup(dev->connection);
+	cfg->UseGlobalDebugFile = TRUE;
+	cfg->SyncTime = FALSE;
+	cfg->LockDevice = FALSE;
+	cfg->StartInfo = FALSE;
+	cfg->CNMIParams[0] = cfg->CNMIParams[1] = cfg->CNMIParams[2] = -1;
+	cfg->CNMIParams[3] = cfg->CNMIParams[4] = -1;
+	GSM_SetConfigNum(sm, 1);
+
+	/* Publish state machine, so that it can be aborted on timeout */
+	G_LOCK(probe);
+	dev->sm = sm;
+	dev->started = GSM_GetMonotonicTime();
+	G_UNLOCK(probe);
+
+	/* Every command is tried only once */
+	error = GSM_InitConnection(sm, 1);
+	if (error == ERR_NONE) {
+		error = GSM_GetManufacturer(sm, dev->manufacturer);
+	}
+	if (error == ERR_NONE) {
+		error = GSM_GetModel(sm, dev->model);
+	}
+	if (error == ERR_NONE && GSM_GetIMEI(sm, dev->imei) != ERR_NONE) {
+		dev->imei[0] = 0;
+	}
+
+	G_LOCK(probe);
+	dev->sm = NULL;
+	G_UNLOCK(probe);
+
+	if (error != ERR_DEVICEOPENERROR) {
+		GSM_TerminateConnection(sm);
+	}
+	GSM_FreeStateMachine(sm);
+
+	G_LOCK(probe);
+	dev->error = error;
+	dev->finished = TRUE;
+	G_UNLOCK(probe);
+}
+
+/**
+ * Waits for all probes, aborting the ones running longer than timeout.
+ */
+static void probe_wait(gint timeout)
+{
+	probe_device *dev;
+	gboolean running;
+	long long now;
+	guint i;
+
+	do {
+		running = FALSE;
+		now = GSM_GetMonotonicTime();
+
+		G_LOCK(probe);
+		for (i = 0; i < candidates->len; i++) {
+			dev = g_ptr_array_index(candidates, i);
+			if (dev->finished) {
+				continue;
+			}
+			running = TRUE;
+			if (dev->sm != NULL && now - dev->started >= (long long)timeout * 1000) {
+				GSM_AbortOperation(dev->sm);
+			}
+		}
+		G_UNLOCK(probe);
+
+		if (running) {
+			g_usleep(G_USEC_PER_SEC / 10);
+		}
+	} while (running);
+}
+
+void probe_run(gint timeout, gint threads)
+{
+	GThreadPool *pool;
+	GError *error = NULL;
+	probe_device *dev;
+	gchar *name;
+	guint i;
+
+	if (candidates == NULL) {
+		return;
+	}
+
+#if !GLIB_CHECK_VERSION(2, 32, 0)
+	if (!g_thread_supported()) {
+		g_thread_init(NULL);
+	}
+#endif
+
+	pool = g_thread_pool_new(probe_device_thread, NULL, threads, TRUE, &error);
+	if (pool == NULL) {
+		g_printerr(_("Failed to create threads: %s\n"), error->message);
+		g_error_free(error);
+		return;
+	}
+
+	/* All devices are probed at once, limited by number of threads */
+	for (i = 0; i < candidates->len; i++) {
+		g_thread_pool_push(pool, g_ptr_array_index(candidates, i), NULL);
+	}
+
+	probe_wait(timeout);
+	g_thread_pool_free(pool, FALSE, TRUE);
+
+	/* Output is in order of detection, not of probe completion */
+	for (i = 0; i < candidates->len; i++) {
+		dev = g_ptr_array_index(candidates, i);
+		if (debug) {
+			printf("; %s (%s): %s\n", dev->device, dev->connection,
+				GSM_ErrorString(dev->error));
+		}
+		if (dev->error == ERR_NONE) {
+			name = g_strdup_printf("%s %s", dev->manufacturer, dev->model);
+			write_config(dev->device, name, dev->connection, dev->imei);
+			g_free(name);
+		}
+		probe_free(dev);
+	}
+
+	g_ptr_array_free(candidates, TRUE);
+	candidates = NULL;
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -0,0 +1,3 @@
+
+extern void probe_add(const gchar *device, const gchar *name, const gchar *connection);
+extern void probe_run(gint timeout, gint threads);
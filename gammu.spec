@@ -3,7 +3,7 @@
 #
 
 
-%define so_ver 8
+%define so_ver 9
 
 # Change if using tar.gz or tar.bz2 sources
 %define extension   xz
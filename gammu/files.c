@@ -18,6 +18,8 @@
 #else
 #  include <utime.h>
 #endif
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include "files.h"
 #include "memory.h"
@@ -341,14 +343,64 @@ void GetFolderListing(int argc UNUSED, char *argv[])
 	GSM_Terminate();
 }
 
+/**
+ * Local file where downloaded file is being streamed.
+ */
+typedef struct {
+	FILE *file;
+	char name[5000];
+	int index;
+} FileOutput;
+
+/**
+ * Opens local file named after downloaded one on first received data
+ * and writes them there.
+ */
+static GSM_Error SaveFileData(GSM_StateMachine *sm UNUSED, GSM_File * File,
+			      const unsigned char *Buffer, size_t Length,
+			      void *user_data)
+{
+	FileOutput *Output = (FileOutput *) user_data;
+	char *buffer = Output->name;
+	int j;
+
+	if (Output->file == NULL) {
+		sprintf(buffer, "%s", DecodeUnicodeConsole(File->Name));
+		for (j = strlen(buffer) - 1; j > 0; j--) {
+			if (buffer[j] == '\\' || buffer[j] == '/')
+				break;
+		}
+		if (buffer[j] == '\\' || buffer[j] == '/') {
+			sprintf(buffer, "%s",
+				DecodeUnicodeConsole(File->Name + j * 2 + 2));
+		}
+		Output->file = fopen(buffer, "wb");
+		if (Output->file == NULL) {
+			sprintf(buffer, "file%s",
+				DecodeUnicodeString(File->ID_FullName));
+			Output->file = fopen(buffer, "wb");
+		}
+		if (Output->file == NULL) {
+			sprintf(buffer, "file%i", Output->index);
+			Output->file = fopen(buffer, "wb");
+		}
+		if (Output->file == NULL)
+			return ERR_CANTOPENFILE;
+	}
+	if (fwrite(Buffer, 1, Length, Output->file) != Length) {
+		printf_err("%s", _("Error while writing file!\n"));
+		return ERR_WRITING_FILE;
+	}
+	return ERR_NONE;
+}
+
 static void GetOneFile(GSM_File * File, gboolean newtime, int i)
 {
 	GSM_Error error;
-	FILE *file;
+	FileOutput Output;
 	gboolean start;
-	unsigned char buffer[5000];
 	struct utimbuf filedate;
-	int Handle, p, q, j, old1;
+	int Handle, p, q, old1;
 	size_t Size;
 	time_t t_time1, t_time2;
 	long diff;
@@ -360,6 +412,11 @@ static void GetOneFile(GSM_File * File, gboolean newtime, int i)
 	File->Used = 0;
 	start = TRUE;
 
+	/* Data are written to disk as they arrive */
+	Output.file = NULL;
+	Output.index = i;
+	GSM_SetFileStream(gsm, SaveFileData, NULL, &Output);
+
 	t_time1 = time(NULL);
 	old1 = 65536;
 
@@ -412,8 +469,18 @@ static void GetOneFile(GSM_File * File, gboolean newtime, int i)
 				break;
 			}
 		}
+		if (error != ERR_NONE && Output.file != NULL) {
+			/* Do not leave partially downloaded file behind */
+			fclose(Output.file);
+			Output.file = NULL;
+			remove(Output.name);
+		}
 		Print_Error(error);
 	}
+	GSM_SetFileStream(gsm, NULL, NULL, NULL);
+	free(File->Buffer);
+	File->Buffer = NULL;
+
 	t_time2 = time(NULL);
 	diff = t_time2 - t_time1;
 	if ((diff > 0) && (File->Used > 0)) {
@@ -426,45 +493,16 @@ static void GetOneFile(GSM_File * File, gboolean newtime, int i)
 	}
 	fprintf(stderr, "\n");
 	fflush(stderr);
-	if (error == ERR_NONE || error == ERR_EMPTY || error == ERR_WRONGCRC) {
-		if (File->Used != 0) {
-			sprintf(buffer, "%s", DecodeUnicodeConsole(File->Name));
-			for (j = strlen(buffer) - 1; j > 0; j--) {
-				if (buffer[j] == '\\' || buffer[j] == '/')
-					break;
-			}
-			if (buffer[j] == '\\' || buffer[j] == '/') {
-				sprintf(buffer, "%s",
-					DecodeUnicodeConsole(File->Name +
-							     j * 2 + 2));
-			}
-			file = fopen(buffer, "wb");
-			if (file == NULL) {
-				sprintf(buffer, "file%s",
-					DecodeUnicodeString(File->ID_FullName));
-				file = fopen(buffer, "wb");
-			}
-			if (file == NULL) {
-				sprintf(buffer, "file%i", i);
-				file = fopen(buffer, "wb");
-			}
-			if (file == NULL)
-				Print_Error(ERR_CANTOPENFILE);
-			printf(_("  Saving to %s\n"), buffer);
-			if (fwrite(File->Buffer, 1, File->Used, file) != File->Used) {
-				printf_err("%s", _("Error while writing file!\n"));
-			}
-			free(File->Buffer);
-			File->Buffer = NULL;
-			fclose(file);
-			if (!newtime && !File->ModifiedEmpty) {
-				/* access time */
-				filedate.actime = Fill_Time_T(File->Modified);
-				/* modification time */
-				filedate.modtime = Fill_Time_T(File->Modified);
-				smprintf(gsm, "Setting date of %s\n", buffer);
-				utime(buffer, &filedate);
-			}
+	if (Output.file != NULL) {
+		printf(_("  Saving to %s\n"), Output.name);
+		fclose(Output.file);
+		if (!newtime && !File->ModifiedEmpty) {
+			/* access time */
+			filedate.actime = Fill_Time_T(File->Modified);
+			/* modification time */
+			filedate.modtime = Fill_Time_T(File->Modified);
+			smprintf(gsm, "Setting date of %s\n", Output.name);
+			utime(Output.name, &filedate);
 		}
 	}
 }
@@ -623,6 +661,14 @@ void AddOneFile(GSM_File * File, const char *text, const gboolean send)
 			}
 		}
 	}
+	GSM_GetCurrentDateTime(&dt);
+	t_time2 = Fill_Time_T(dt);
+	diff = t_time2 - t_time1;
+	if ((diff > 0) && (Pos > 0)) {
+		fprintf(stderr, "\r%s ", text);
+		fprintf(stderr, _("%lu Bytes in %li seconds, %lu Bytes/sec"),
+			(long unsigned int) Pos, (long unsigned int) diff, (long unsigned int) Pos / diff);
+	}
 	fprintf(stderr, "\n");
 	if (error == ERR_WRONGCRC) {
 		printf_warn("%s\n",
@@ -630,10 +676,63 @@ void AddOneFile(GSM_File * File, const char *text, const gboolean send)
 	}
 }
 
+/**
+ * Provides data of uploaded file from local file.
+ */
+static GSM_Error LoadFileData(GSM_StateMachine *sm UNUSED, GSM_File * File UNUSED,
+			      size_t Offset, unsigned char *Buffer,
+			      size_t Length, void *user_data)
+{
+	FILE *file = (FILE *) user_data;
+
+	if (fseek(file, Offset, SEEK_SET) != 0 ||
+	    fread(Buffer, 1, Length, file) != Length) {
+		printf_err("%s", _("Error while reading file!\n"));
+		return ERR_CANTOPENFILE;
+	}
+	return ERR_NONE;
+}
+
+/**
+ * Prepares local file for upload. Regular files are streamed from
+ * disk, only their beginning is read here to detect file type. Other
+ * files are read whole into File->Buffer and input is set to NULL.
+ */
+static GSM_Error OpenFileInput(const char *FileName, GSM_File * File,
+			       FILE ** input)
+{
+	struct stat fileinfo;
+	unsigned char header[32];
+
+	*input = NULL;
+	if (stat(FileName, &fileinfo) != 0 ||
+	    (fileinfo.st_mode & S_IFMT) != S_IFREG) {
+		return GSM_ReadFile(FileName, File);
+	}
+
+	*input = fopen(FileName, "rb");
+	if (*input == NULL) {
+		return ERR_CANTOPENFILE;
+	}
+
+	File->Buffer = header;
+	File->Used = fread(header, 1, sizeof(header), *input);
+	GSM_IdentifyFileFormat(File);
+	File->Buffer = NULL;
+	File->Used = fileinfo.st_size;
+
+	File->Level = 0;
+	File->Folder = FALSE;
+	File->ModifiedEmpty = FALSE;
+	Fill_GSM_DateTime(&File->Modified, fileinfo.st_mtime);
+	return ERR_NONE;
+}
+
 void AddSendFile(int argc, char *argv[])
 {
 	GSM_Error error;
 	GSM_File File;
+	FILE *input;
 	int i, nextlong;
 	char IDUTF[200];
 	gboolean sendfile = FALSE;
@@ -649,7 +748,7 @@ void AddSendFile(int argc, char *argv[])
 					  strlen(argv[optint]));
 		optint++;
 	}
-	error = GSM_ReadFile(argv[optint], &File);
+	error = OpenFileInput(argv[optint], &File, &input);
 	Print_Error(error);
 	EncodeUnicode(File.Name, argv[optint], strlen(argv[optint]));
 	for (i = strlen(argv[optint]) - 1; i > 0; i--) {
@@ -662,8 +761,6 @@ void AddSendFile(int argc, char *argv[])
 	}
 	optint++;
 
-	GSM_IdentifyFileFormat(&File);
-
 	File.Protected = FALSE;
 	File.ReadOnly = FALSE;
 	File.Hidden = FALSE;
@@ -752,10 +849,18 @@ void AddSendFile(int argc, char *argv[])
 
 	GSM_Init(TRUE);
 
+	if (input != NULL) {
+		GSM_SetFileStream(gsm, NULL, LoadFileData, input);
+	}
+
 	AddOneFile(&File, _("Writing:"), sendfile);
 	EncodeUTF8QuotedPrintable(IDUTF, File.ID_FullName);
 	printf(_("ID of new file is \"%s\"\n"), IDUTF);
 
+	GSM_SetFileStream(gsm, NULL, NULL, NULL);
+	if (input != NULL) {
+		fclose(input);
+	}
 	free(File.Buffer);
 	GSM_Terminate();
 }
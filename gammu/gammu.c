@@ -325,6 +325,22 @@ static void CheckVersion(int argc, char *argv[])
 	free(RSS.Buffer);
 }
 
+static void ClearCapabilityCache(int argc UNUSED, char *argv[]UNUSED)
+{
+	GSM_Config *smcfg;
+	int i;
+
+	for (i = 0; i < GSM_GetConfigNum(gsm); i++) {
+		smcfg = GSM_GetConfig(gsm, i);
+		if (smcfg == NULL || smcfg->CapabilityCache == NULL) {
+			continue;
+		}
+		if (remove(smcfg->CapabilityCache) == 0) {
+			printf(_("Removed capability cache %s\n"), smcfg->CapabilityCache);
+		}
+	}
+}
+
 static void Version(int argc UNUSED, char *argv[]UNUSED)
 {
 	PrintVersion();
@@ -507,6 +523,7 @@ static GSM_Parameters Parameters[] = {
 	{"version",			0, 0, Version,			{H_Gammu,0},			""},
 	{"features",			0, 0, Features,			{H_Gammu,0},			""},
 	{"checkversion",		0, 1, CheckVersion,		{H_Gammu,0},			"[STABLE]"},
+	{"clearcapabilitycache",	0, 0, ClearCapabilityCache,	{H_Gammu,0},			""},
 	{"getdisplaystatus",		0, 0, GetDisplayStatus,		{H_Info,0},			""},
 	{"monitor",			0, 1, Monitor,			{H_Info,H_Network,H_Call,0},	"[times]"},
 	{"battery",			0, 0, Battery,			{H_Info,0},			""},
@@ -679,7 +696,7 @@ static GSM_Parameters Parameters[] = {
 	{"presskeysequence",		1, 1, PressKeySequence,		{H_Other,0},			"mMnNpPuUdD+-123456789*0#gGrR<>[]hHcCjJfFoOmMdD@"},
 	{"setpower",			1, 1, SetPower,		{H_Other,0},		"ON|OFF"},
 #if defined(WIN32) || defined(HAVE_PTHREAD)
-	{"searchphone",		0, 1, SearchPhone,		{H_Other,0},			"[-debug]"},
+	{"searchphone",		0, 4, SearchPhone,		{H_Other,0},			"[-debug] [-config] [-timeout seconds]"},
 #endif
 	{"install",			0, 1, Install,			{H_Other,0},			"[-minimal]"},
 #ifdef GSM_ENABLE_BACKUP
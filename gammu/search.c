@@ -2,10 +2,13 @@
 
 #include <gammu.h>
 #include <string.h>
+#include <stdlib.h>
 #include <stdarg.h>
+#include <time.h>
 
 #ifdef HAVE_PTHREAD
 #  include <pthread.h>
+#  include <unistd.h>
 #  include <sys/types.h>
 #  include <sys/stat.h>
 #  include <fcntl.h>
@@ -23,9 +26,17 @@
 #include "common.h"
 
 #include "../helper/formats.h"
+#include "../helper/printing.h"
+#include "../helper/cmdline.h"
 #include "../libgammu/misc/string.h"
 
 #if defined(HAVE_WIN32_THREADS) || defined(HAVE_PTHREAD)
+
+/**
+ * Default number of seconds one connection attempt can take.
+ */
+#define SEARCH_TIMEOUT 15
+
 /**
  * Structure to hold information about connection for searching.
  */
@@ -48,10 +59,81 @@ typedef struct {
 	 * List of connections to try
 	 */
 	OneConnectionInfo Connections[5];
+	/**
+	 * State machine used for current connection attempt, protected
+	 * by SearchLock.
+	 */
+	GSM_StateMachine *StateMachine;
+	/**
+	 * Time when current connection attempt was started.
+	 */
+	time_t Started;
+	/**
+	 * Whether searching thread was created.
+	 */
+	gboolean HasThread;
+	/**
+	 * Whether searching on this device has finished.
+	 */
+	gboolean Finished;
+	/**
+	 * Connection which works, empty if none was found.
+	 */
+	unsigned char Found[50];
+	/**
+	 * Manufacturer of found phone.
+	 */
+	char Manufacturer[GSM_MAX_MANUFACTURER_LENGTH + 1];
+	/**
+	 * Model of found phone.
+	 */
+	char Model[GSM_MAX_MODEL_LENGTH + 1];
+#ifdef HAVE_PTHREAD
+	pthread_t Thread;
+#else
+	HANDLE Thread;
+#endif
 } OneDeviceInfo;
 
 gboolean SearchOutput;
 
+/**
+ * Whether only configuration for found phones should be printed.
+ */
+gboolean SearchConfig;
+
+/**
+ * Number of seconds after which connection attempt is aborted.
+ */
+int SearchTimeout;
+
+OneDeviceInfo *SearchDevices;
+int SearchDevicesCount;
+
+#ifdef HAVE_PTHREAD
+pthread_mutex_t SearchLock = PTHREAD_MUTEX_INITIALIZER;
+#else
+CRITICAL_SECTION SearchLock;
+#endif
+
+static void SearchLockAcquire(void)
+{
+#ifdef HAVE_PTHREAD
+	pthread_mutex_lock(&SearchLock);
+#else
+	EnterCriticalSection(&SearchLock);
+#endif
+}
+
+static void SearchLockRelease(void)
+{
+#ifdef HAVE_PTHREAD
+	pthread_mutex_unlock(&SearchLock);
+#else
+	LeaveCriticalSection(&SearchLock);
+#endif
+}
+
 /**
  * Like printf, but only when output from searching is enabled.
  */
@@ -71,35 +153,31 @@ int SearchPrintf(const char *format, ...)
 	return ret;
 }
 
-void SearchPrintPhoneInfo(GSM_StateMachine * sm)
+/**
+ * Reads phone identification into device information.
+ */
+GSM_Error SearchGetPhoneInfo(GSM_StateMachine * sm, OneDeviceInfo *Info)
 {
 	GSM_Error error;
-	char buffer[GSM_MAX_INFO_LENGTH];
 
 	/* Try to get phone manufacturer */
-	error = GSM_GetManufacturer(sm, buffer);
-
-	/* Bail out if we failed */
+	error = GSM_GetManufacturer(sm, Info->Manufacturer);
 	if (error != ERR_NONE) {
-		SearchPrintf("\t%s\n", GSM_ErrorString(error));
-		return;
+		return error;
 	}
 
-	/* Print basic information */
-	printf("\t" LISTFORMAT "%s\n", _("Manufacturer"), buffer);
-
 	/* Try to get phone model */
-	error = GSM_GetModel(sm, buffer);
+	return GSM_GetModel(sm, Info->Model);
+}
 
-	/* Bail out if we failed */
-	if (error != ERR_NONE) {
-		SearchPrintf("\t%s\n", GSM_ErrorString(error));
-		return;
-	}
+void SearchPrintPhoneInfo(GSM_StateMachine * sm, OneDeviceInfo *Info)
+{
+	/* Print basic information */
+	printf("\t" LISTFORMAT "%s\n", _("Manufacturer"), Info->Manufacturer);
 
 	/* Print model information */
 	printf("\t" LISTFORMAT "%s (%s)\n", _("Model"),
-	       GSM_GetModelInfo(sm)->model, buffer);
+	       GSM_GetModelInfo(sm)->model, Info->Model);
 }
 
 THREAD_RETURN SearchPhoneThread(void * arg)
@@ -117,7 +195,7 @@ THREAD_RETURN SearchPhoneThread(void * arg)
 		/* Allocate state machine */
 		search_gsm = GSM_AllocStateMachine();
 		if (search_gsm == NULL)
-			return THREAD_RETURN_VAL;
+			break;
 
 		/* Get configuration pointers */
 		smcfg = GSM_GetConfig(search_gsm, 0);
@@ -139,152 +217,291 @@ THREAD_RETURN SearchPhoneThread(void * arg)
 		/* We have only one configured connection */
 		GSM_SetConfigNum(search_gsm, 1);
 
-		/* Let's connect */
-		error = GSM_InitConnection(search_gsm, 1);
+		/* Publish state machine, so that it can be aborted on timeout */
+		SearchLockAcquire();
+		Info->StateMachine = search_gsm;
+		Info->Started = time(NULL);
+		SearchLockRelease();
 
-		printf(_("Connection \"%s\" on device \"%s\"\n"),
-		       Info->Connections[j].Connection, Info->Device);
-
-		/* Did we succeed? Show info */
+		/* Let's connect, trying every command only once */
+		error = GSM_InitConnection(search_gsm, 1);
 		if (error == ERR_NONE) {
-			SearchPrintPhoneInfo(search_gsm);
-		} else {
-			SearchPrintf("\t%s\n", GSM_ErrorString(error));
+			error = SearchGetPhoneInfo(search_gsm, Info);
+		}
+
+		/* Whole block is printed at once not to mix output of threads */
+		SearchLockAcquire();
+		if (!SearchConfig) {
+			printf(_("Connection \"%s\" on device \"%s\"\n"),
+			       Info->Connections[j].Connection, Info->Device);
+
+			/* Did we succeed? Show info */
+			if (error == ERR_NONE) {
+				SearchPrintPhoneInfo(search_gsm, Info);
+			} else {
+				SearchPrintf("\t%s\n", GSM_ErrorString(error));
+			}
+			fflush(stdout);
+		}
+		if (error == ERR_NONE && Info->Found[0] == 0) {
+			strcpy(Info->Found, Info->Connections[j].Connection);
 		}
+		Info->StateMachine = NULL;
+		SearchLockRelease();
 
 		if (error != ERR_DEVICEOPENERROR) {
 			GSM_TerminateConnection(search_gsm);
 		}
 
+		/* Free allocated buffer */
+		GSM_FreeStateMachine(search_gsm);
+
 		if (error == ERR_DEVICEOPENERROR)
 			break;
 
-		/* Free allocated buffer */
-		GSM_FreeStateMachine(search_gsm);
+		/* For configuration first working connection is enough */
+		if (SearchConfig && Info->Found[0] != 0)
+			break;
 	}
-	return THREAD_RETURN_VAL;
-}
 
-#ifdef HAVE_PTHREAD
-pthread_t Threads[100];
-#else
-HANDLE Threads[100];
-#endif
+	SearchLockAcquire();
+	Info->Finished = TRUE;
+	SearchLockRelease();
 
-OneDeviceInfo SearchDevices[60];
+	return THREAD_RETURN_VAL;
+}
 
-void MakeSearchThread(int i)
+void MakeSearchThread(OneDeviceInfo *Info)
 {
 #ifdef HAVE_PTHREAD
 	if (pthread_create
-	    (&Threads[i], NULL, SearchPhoneThread,
-	     &SearchDevices[i]) != 0) {
+	    (&Info->Thread, NULL, SearchPhoneThread,
+	     Info) != 0) {
 		fprintf(stderr, "%s", _("Error creating thread\n"));
+		Info->Finished = TRUE;
+		return;
 	}
 #else
-	Threads[i] = CreateThread((LPSECURITY_ATTRIBUTES) NULL, 0,
+	Info->Thread = CreateThread((LPSECURITY_ATTRIBUTES) NULL, 0,
 			 (LPTHREAD_START_ROUTINE) SearchPhoneThread,
-			 &SearchDevices[i], 0, NULL);
-	if (Threads[i] 	== NULL) {
+			 Info, 0, NULL);
+	if (Info->Thread == NULL) {
 		fprintf(stderr, "%s", _("Error creating thread\n"));
+		Info->Finished = TRUE;
+		return;
 	}
 #endif
+	Info->HasThread = TRUE;
 }
 
-void SearchPhone(int argc, char *argv[])
+/**
+ * Adds device to search list, the connections are NULL terminated.
+ */
+void SearchAddDevice(const char *device, ...)
 {
-	int i, dev = 0;
+	OneDeviceInfo *info;
+	const char *connection;
+	va_list ap;
+	int i = 0;
+
+	info = (OneDeviceInfo *)realloc(SearchDevices,
+			(SearchDevicesCount + 1) * sizeof(OneDeviceInfo));
+	if (info == NULL) {
+		return;
+	}
+	SearchDevices = info;
+	info = &SearchDevices[SearchDevicesCount++];
+	memset(info, 0, sizeof(OneDeviceInfo));
+	strcpy(info->Device, device);
+
+	va_start(ap, device);
+	while ((connection = va_arg(ap, const char *)) != NULL &&
+			i < (int)(sizeof(info->Connections) / sizeof(info->Connections[0])) - 1) {
+		strcpy(info->Connections[i++].Connection, connection);
+	}
+	va_end(ap);
+}
+
 #ifdef HAVE_PTHREAD
+/**
+ * Checks whether device exists and can be opened without waiting for
+ * carrier or blocking on other application.
+ */
+gboolean SearchDeviceExists(const char *device)
+{
 	int fd;
-	void *ret;
+
+	fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (fd < 0)
+		return FALSE;
+	close(fd);
+	return TRUE;
+}
+
+/**
+ * Adds existing devices from numbered range to search list.
+ */
+void SearchAddDevices(const char *format, int count, const char *connections[])
+{
+	char device[50];
+	int i;
+
+	for (i = 0; i < count; i++) {
+		snprintf(device, sizeof(device), format, i);
+		if (!SearchDeviceExists(device))
+			continue;
+		SearchAddDevice(device, connections[0], connections[1],
+				connections[2], connections[3], NULL);
+	}
+}
 #endif
 
+/**
+ * Aborts connection attempts taking longer than timeout and waits for
+ * all searching threads to finish.
+ */
+void SearchWait(void)
+{
+	gboolean running;
+	time_t now;
+	int i;
+
+	do {
+		running = FALSE;
+		now = time(NULL);
+
+		SearchLockAcquire();
+		for (i = 0; i < SearchDevicesCount; i++) {
+			if (SearchDevices[i].Finished)
+				continue;
+			running = TRUE;
+			if (SearchDevices[i].StateMachine != NULL &&
+					difftime(now, SearchDevices[i].Started) >= SearchTimeout) {
+				GSM_AbortOperation(SearchDevices[i].StateMachine);
+			}
+		}
+		SearchLockRelease();
 
-	SearchOutput = FALSE;
-	if (argc == 3 && strcasecmp(argv[2], "-debug") == 0)
-		SearchOutput = TRUE;
+		if (running) {
+#ifdef HAVE_PTHREAD
+			usleep(100000);
+#else
+			Sleep(100);
+#endif
+		}
+	} while (running);
 
-#ifdef HAVE_WIN32_THREADS
-	SearchDevices[dev].Device[0] = 0;
-	sprintf(SearchDevices[dev].Connections[0].Connection, "irdaphonet");
-	sprintf(SearchDevices[dev].Connections[1].Connection, "irdaat");
-	SearchDevices[dev].Connections[2].Connection[0] = 0;
-	dev++;
-	for (i = 0; i < 20; i++) {
-		sprintf(SearchDevices[dev].Device, "com%i:", i + 1);
-		sprintf(SearchDevices[dev].Connections[0].Connection,
-			"fbusdlr3");
-		sprintf(SearchDevices[dev].Connections[1].Connection, "fbus");
-		sprintf(SearchDevices[dev].Connections[2].Connection,
-			"at19200");
-		sprintf(SearchDevices[dev].Connections[3].Connection, "mbus");
-		SearchDevices[dev].Connections[4].Connection[0] = 0;
-		dev++;
-	}
+	for (i = 0; i < SearchDevicesCount; i++) {
+		if (!SearchDevices[i].HasThread)
+			continue;
+#ifdef HAVE_PTHREAD
+		pthread_join(SearchDevices[i].Thread, NULL);
 #else
-	for (i = 0; i < 6; i++) {
-		sprintf(SearchDevices[dev].Device, "/dev/ircomm%i", i);
-		fd = open(SearchDevices[dev].Device, O_RDWR);
-		if (fd < 0) continue;
-		close(fd);
-		sprintf(SearchDevices[dev].Connections[0].Connection,
-			"irdaphonet");
-		sprintf(SearchDevices[dev].Connections[1].Connection,
-			"at19200");
-		SearchDevices[dev].Connections[2].Connection[0] = 0;
-		dev++;
-	}
-	for (i = 0; i < 10; i++) {
-		sprintf(SearchDevices[dev].Device, "/dev/ttyS%i", i);
-		fd = open(SearchDevices[dev].Device, O_RDWR);
-		if (fd < 0) continue;
-		close(fd);
-		sprintf(SearchDevices[dev].Connections[0].Connection,
-			"fbusdlr3");
-		sprintf(SearchDevices[dev].Connections[1].Connection, "fbus");
-		sprintf(SearchDevices[dev].Connections[2].Connection,
-			"at19200");
-		sprintf(SearchDevices[dev].Connections[3].Connection, "mbus");
-		SearchDevices[dev].Connections[4].Connection[0] = 0;
-		dev++;
+		WaitForSingleObject(SearchDevices[i].Thread, INFINITE);
+		CloseHandle(SearchDevices[i].Thread);
+#endif
 	}
-	for (i = 0; i < 8; i++) {
-		sprintf(SearchDevices[dev].Device, "/dev/ttyD00%i", i);
-		fd = open(SearchDevices[dev].Device, O_RDWR);
-		if (fd < 0) continue;
-		close(fd);
-		sprintf(SearchDevices[dev].Connections[0].Connection,
-			"fbusdlr3");
-		sprintf(SearchDevices[dev].Connections[1].Connection, "fbus");
-		sprintf(SearchDevices[dev].Connections[2].Connection,
-			"at19200");
-		sprintf(SearchDevices[dev].Connections[3].Connection, "mbus");
-		SearchDevices[dev].Connections[4].Connection[0] = 0;
-		dev++;
+}
+
+/**
+ * Prints configuration file sections for all found phones.
+ */
+void SearchPrintConfig(void)
+{
+	int i, section = 0;
+
+	for (i = 0; i < SearchDevicesCount; i++) {
+		if (SearchDevices[i].Found[0] == 0)
+			continue;
+		if (section == 0) {
+			printf("; %s\n", _("Configuration file generated by gammu searchphone."));
+			printf("; %s\n", _("Please check The Gammu Manual for more information."));
+			printf("\n");
+			printf("[gammu]\n");
+		} else {
+			printf("[gammu%d]\n", section);
+		}
+		section++;
+		printf("device = %s\n", SearchDevices[i].Device);
+		printf("name = %s %s\n", SearchDevices[i].Manufacturer,
+				SearchDevices[i].Model);
+		printf("connection = %s\n", SearchDevices[i].Found);
+		printf("\n");
 	}
-	for (i = 0; i < 4; i++) {
-		sprintf(SearchDevices[dev].Device, "/dev/usb/tts/%i", i);
-		fd = open(SearchDevices[dev].Device, O_RDWR);
-		if (fd < 0) continue;
-		close(fd);
-		sprintf(SearchDevices[dev].Connections[0].Connection,
-			"fbusdlr3");
-		sprintf(SearchDevices[dev].Connections[1].Connection, "fbus");
-		sprintf(SearchDevices[dev].Connections[2].Connection,
-			"at19200");
-		sprintf(SearchDevices[dev].Connections[3].Connection, "mbus");
-		SearchDevices[dev].Connections[4].Connection[0] = 0;
-		dev++;
+
+	if (section == 0) {
+		printf_err("%s\n", _("No phone found!"));
 	}
+}
+
+void SearchPhone(int argc, char *argv[])
+{
+	int i;
+#ifdef HAVE_PTHREAD
+	const char *serial[] = {"fbusdlr3", "fbus", "at19200", "mbus"};
+	const char *usb[] = {"at", "fbusdlr3", "fbus", NULL};
+	const char *acm[] = {"at", NULL, NULL, NULL};
+	const char *ircomm[] = {"irdaphonet", "at19200", NULL, NULL};
 #endif
-	for (i = 0; i < dev; i++)
-		MakeSearchThread(i);
+
+	SearchOutput = FALSE;
+	SearchConfig = FALSE;
+	SearchTimeout = SEARCH_TIMEOUT;
+	for (i = 2; i < argc; i++) {
+		if (strcasecmp(argv[i], "-debug") == 0) {
+			SearchOutput = TRUE;
+		} else if (strcasecmp(argv[i], "-config") == 0) {
+			SearchConfig = TRUE;
+		} else if (strcasecmp(argv[i], "-timeout") == 0 && i + 1 < argc) {
+			SearchTimeout = GetInt(argv[++i]);
+			if (SearchTimeout <= 0) {
+				printf_err(_("Invalid timeout: %s\n"), argv[i]);
+				Terminate(3);
+			}
+		} else {
+			printf_err(_("Unknown parameter (\"%s\")\n"), argv[i]);
+			Terminate(3);
+		}
+	}
+
+	SearchDevices = NULL;
+	SearchDevicesCount = 0;
+
 #ifdef HAVE_WIN32_THREADS
-	WaitForMultipleObjects(dev, Threads, TRUE, INFINITE);
+	InitializeCriticalSection(&SearchLock);
+	SearchAddDevice("", "irdaphonet", "irdaat", NULL);
+	for (i = 0; i < 20; i++) {
+		char device[50];
+
+		sprintf(device, "com%i:", i + 1);
+		SearchAddDevice(device, "fbusdlr3", "fbus", "at19200", "mbus", NULL);
+	}
 #else
-	for (i = 0; i < dev; i++)
-		pthread_join(Threads[i], &ret);
+	SearchAddDevices("/dev/ircomm%i", 6, ircomm);
+	SearchAddDevices("/dev/ttyS%i", 10, serial);
+	SearchAddDevices("/dev/ttyD00%i", 8, serial);
+	SearchAddDevices("/dev/usb/tts/%i", 4, serial);
+	SearchAddDevices("/dev/ttyUSB%i", 256, usb);
+	SearchAddDevices("/dev/ttyACM%i", 256, acm);
+	SearchAddDevices("/dev/rfcomm%i", 32, acm);
+#endif
+
+	/* All devices are probed at once */
+	for (i = 0; i < SearchDevicesCount; i++)
+		MakeSearchThread(&SearchDevices[i]);
+
+	SearchWait();
+
+	if (SearchConfig) {
+		SearchPrintConfig();
+	}
+
+#ifdef HAVE_WIN32_THREADS
+	DeleteCriticalSection(&SearchLock);
 #endif
+	free(SearchDevices);
+	SearchDevices = NULL;
+	SearchDevicesCount = 0;
 }
 #endif				/*Support for threads */
 
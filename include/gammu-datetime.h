@@ -139,6 +139,16 @@ time_t Fill_Time_T(GSM_DateTime DT);
  */
 int GSM_GetLocalTimezoneOffset(void);
 
+/**
+ * Returns monotonic time in milliseconds. Only differences between
+ * returned values are meaningful.
+ *
+ * \return Current monotonic time.
+ *
+ * \ingroup DateTime
+ */
+long long GSM_GetMonotonicTime(void);
+
 /**
  * Converts time_t to gammu \ref GSM_DateTime structure.
  *
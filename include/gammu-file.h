@@ -210,6 +210,69 @@ GSM_Error GSM_GetNextRootFolder(GSM_StateMachine * s, GSM_File * File);
  */
 GSM_Error GSM_SetFileAttributes(GSM_StateMachine * s, GSM_File * File);
 
+/**
+ * Callback receiving downloaded file data, see \ref GSM_SetFileStream.
+ *
+ * \param s State machine pointer.
+ * \param File File being transferred.
+ * \param Buffer Received data.
+ * \param Length Length of received data.
+ * \param user_data Pointer passed to \ref GSM_SetFileStream.
+ *
+ * \return Error code, anything else than \ref ERR_NONE aborts transfer.
+ *
+ * \ingroup File
+ */
+typedef GSM_Error(*GSM_FileWriteCallback) (GSM_StateMachine * s,
+					   GSM_File * File,
+					   const unsigned char *Buffer,
+					   size_t Length, void *user_data);
+
+/**
+ * Callback providing uploaded file data, see \ref GSM_SetFileStream.
+ *
+ * \param s State machine pointer.
+ * \param File File being transferred.
+ * \param Offset Position of requested data in the file.
+ * \param Buffer Storage for data.
+ * \param Length Number of bytes to read, callback has to fill all of
+ * them.
+ * \param user_data Pointer passed to \ref GSM_SetFileStream.
+ *
+ * \return Error code, anything else than \ref ERR_NONE aborts transfer.
+ *
+ * \ingroup File
+ */
+typedef GSM_Error(*GSM_FileReadCallback) (GSM_StateMachine * s,
+					  GSM_File * File, size_t Offset,
+					  unsigned char *Buffer, size_t Length,
+					  void *user_data);
+
+/**
+ * Sets callbacks for streaming file transfers, so that file data do not
+ * have to be kept in memory.
+ *
+ * When write callback is set, \ref GSM_GetFilePart passes received data
+ * to it instead of storing them in File->Buffer, which has to be NULL
+ * on transfer start. File->Used still counts received bytes.
+ *
+ * When read callback is set, \ref GSM_AddFilePart and
+ * \ref GSM_SendFilePart read data of file with NULL File->Buffer
+ * through it, File->Used has to contain size of the file.
+ *
+ * Drivers which can not stream data fall back to transferring them
+ * through memory.
+ *
+ * \param s State machine pointer.
+ * \param Write Callback for downloaded data, NULL to disable.
+ * \param Read Callback for uploaded data, NULL to disable.
+ * \param user_data Pointer passed to callbacks.
+ *
+ * \ingroup File
+ */
+void GSM_SetFileStream(GSM_StateMachine * s, GSM_FileWriteCallback Write,
+		       GSM_FileReadCallback Read, void *user_data);
+
 /**
  * Retrieves file part.
  *
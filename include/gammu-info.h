@@ -278,6 +278,38 @@ typedef struct {
 	GSM_BatteryType BatteryType;
 } GSM_BatteryCharge;
 
+/**
+ * Phone status read by \ref GSM_GetPhoneStatus.
+ *
+ * \ingroup Info
+ */
+typedef struct {
+	/**
+	 * Battery charge.
+	 */
+	GSM_BatteryCharge BatteryCharge;
+	/**
+	 * Result of reading battery charge.
+	 */
+	GSM_Error BatteryChargeError;
+	/**
+	 * Signal quality.
+	 */
+	GSM_SignalQuality SignalQuality;
+	/**
+	 * Result of reading signal quality.
+	 */
+	GSM_Error SignalQualityError;
+	/**
+	 * Network information.
+	 */
+	GSM_NetworkInfo NetworkInfo;
+	/**
+	 * Result of reading network information.
+	 */
+	GSM_Error NetworkInfoError;
+} GSM_PhoneStatus;
+
 /**
  * Display feature
  *
@@ -737,6 +769,14 @@ typedef enum {
 	 * Phone does not have a SR memory even if it reports so.
 	 */
 	F_SMS_NO_SR,
+	/**
+	 * Phone does not handle OBEX Single Response Mode header.
+	 */
+	F_OBEX_NO_SRM,
+	/**
+	 * Phone does not accept several AT commands on one line.
+	 */
+	F_NO_ATCOMPOUND,
 	/**
 	 * Just marker of highest feature code, should not be used.
 	 */
@@ -788,6 +828,12 @@ typedef struct {
 	 * List of supported features
 	 */
 	GSM_Feature features[GSM_MAX_PHONE_FEATURES + 1];
+	/**
+	 * Bitmap of supported features, filled in for model information
+	 * attached to state machine (see \ref GSM_GetModelInfo). Bit 0
+	 * (no feature has value zero) marks the bitmap as valid.
+	 */
+	unsigned char featuremask[GSM_MAX_PHONE_FEATURE_BITS / 8];
 } GSM_PhoneModel;
 
 /**
@@ -942,6 +988,26 @@ GSM_Error GSM_GetSignalQuality(GSM_StateMachine * s, GSM_SignalQuality * sig);
  */
 GSM_Error GSM_GetNetworkInfo(GSM_StateMachine * s, GSM_NetworkInfo * netinfo);
 
+/**
+ * Reads battery charge, signal quality and network information at
+ * once. Phones which allow it get all values using single request,
+ * otherwise they are read one by one.
+ *
+ * \param s State machine pointer.
+ * \param status Storage for status, error for each value is stored
+ * there as well. Values which were not requested have error set to
+ * ERR_NOTSUPPORTED.
+ * \param battery Whether to read battery charge.
+ * \param signal Whether to read signal quality.
+ * \param network Whether to read network information.
+ *
+ * \return Error code, ERR_NONE even if some value could not be read.
+ *
+ * \ingroup Info
+ */
+GSM_Error GSM_GetPhoneStatus(GSM_StateMachine * s, GSM_PhoneStatus * status,
+			     gboolean battery, gboolean signal, gboolean network);
+
 /**
  * Acquired display status.
  *
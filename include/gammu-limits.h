@@ -309,6 +309,15 @@ extern "C" {
  */
 #define GSM_MAX_PHONE_FEATURES 20
 
+/**
+ * Number of features which fit into feature bitmap of model information.
+ * It is bigger than number of currently known features, so that new ones
+ * can be added without changing size of \ref GSM_PhoneModel.
+ *
+ * \ingroup Limits
+ */
+#define GSM_MAX_PHONE_FEATURE_BITS 512
+
 /**
  * Maximal length of USSD text.
  *
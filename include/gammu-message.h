@@ -825,6 +825,27 @@ typedef struct {
 	gboolean Processed;
 } GSM_MultiSMSMessage;
 
+/**
+ * Location of SMS message, used when operating on several messages at
+ * once.
+ *
+ * \ingroup SMS
+ */
+typedef struct {
+	/**
+	 * Folder where message is stored, 0 for flat memory.
+	 */
+	int Folder;
+	/**
+	 * Location of message.
+	 */
+	int Location;
+	/**
+	 * Memory where message is stored, can be 0 if not known.
+	 */
+	GSM_MemoryType Memory;
+} GSM_SMSLocation;
+
 /**
  * Information about MMS folder.
  *
@@ -1321,6 +1342,23 @@ GSM_Error GSM_AddSMS(GSM_StateMachine * s, GSM_SMSMessage * sms);
  */
 GSM_Error GSM_DeleteSMS(GSM_StateMachine * s, GSM_SMSMessage * sms);
 
+/**
+ * Deletes several SMS messages at once. Drivers which can not do this
+ * in fewer requests fall back to deleting messages one by one.
+ *
+ * Messages which are already deleted are silently skipped.
+ *
+ * \param s State machine pointer.
+ * \param[in] locations Array of message locations.
+ * \param[in] count Number of entries in locations.
+ *
+ * \return Error code.
+ *
+ * \ingroup SMS
+ */
+GSM_Error GSM_DeleteSMSBatch(GSM_StateMachine * s,
+			     GSM_SMSLocation * locations, int count);
+
 /**
  * Sends SMS.
  *
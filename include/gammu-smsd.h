@@ -33,6 +33,85 @@ typedef struct _GSM_SMSDConfig GSM_SMSDConfig;
  */
 #define SMSD_TEXT_LENGTH 255
 
+/**
+ * Number of latency histogram buckets in \ref GSM_SMSDMetric.
+ */
+#define SMSD_METRIC_BUCKETS 14
+
+/**
+ * Processing stages of SMSD for which latency is measured.
+ *
+ * \ingroup SMSD
+ */
+typedef enum {
+	/**
+	 * Reading message to send from service backend.
+	 */
+	SMSD_METRIC_OUTBOX = 0,
+	/**
+	 * Submitting message to the phone (encoding, waiting for prompt
+	 * and transferring PDU).
+	 */
+	SMSD_METRIC_SUBMIT,
+	/**
+	 * Waiting for the phone to confirm message was sent.
+	 */
+	SMSD_METRIC_CONFIRM,
+	/**
+	 * Storing information about sent message in service backend.
+	 */
+	SMSD_METRIC_SENT,
+	/**
+	 * Reading received message from the phone.
+	 */
+	SMSD_METRIC_READ,
+	/**
+	 * Saving received message in service backend.
+	 */
+	SMSD_METRIC_INBOX,
+	/**
+	 * Executing RunOn* hooks.
+	 */
+	SMSD_METRIC_HOOK,
+	/**
+	 * Refreshing phone status (battery, signal, network).
+	 */
+	SMSD_METRIC_STATUS,
+	/**
+	 * Number of stages, not a stage.
+	 */
+	SMSD_METRIC_LAST
+} SMSD_MetricStage;
+
+/**
+ * Counters and latency histogram of single processing stage.
+ *
+ * \ingroup SMSD
+ */
+typedef struct {
+	/**
+	 * Number of measured operations.
+	 */
+	unsigned int Count;
+	/**
+	 * Number of operations which failed.
+	 */
+	unsigned int Errors;
+	/**
+	 * Sum of latencies in milliseconds.
+	 */
+	unsigned long long Sum;
+	/**
+	 * Highest latency in milliseconds.
+	 */
+	unsigned int Max;
+	/**
+	 * Number of operations per latency bucket, see
+	 * GSM_SMSDStatus::BucketLimits.
+	 */
+	unsigned int Buckets[SMSD_METRIC_BUCKETS];
+} GSM_SMSDMetric;
+
 /**
  * Status structure, which can be found in shared memory (if supported
  * on platform).
@@ -41,9 +120,14 @@ typedef struct _GSM_SMSDConfig GSM_SMSDConfig;
  */
 typedef struct {
 	/**
-	 * Version of this structure (2 for now).
+	 * Version of this structure (4 for now).
 	 */
 	int Version;
+	/**
+	 * Sequence counter of updates, it is odd while SMSD is updating
+	 * the structure. Use \ref SMSD_GetStatus to get consistent copy.
+	 */
+	unsigned int Sequence;
 	/**
 	 * PhoneID from configuration.
 	 */
@@ -84,6 +168,27 @@ typedef struct {
 	 * Network information.
 	 */
 	GSM_NetworkInfo NetInfo;
+	/**
+	 * Upper limits of latency buckets in milliseconds, last bucket
+	 * has limit -1 and holds all slower operations.
+	 */
+	int BucketLimits[SMSD_METRIC_BUCKETS];
+	/**
+	 * Metrics for each processing stage.
+	 */
+	GSM_SMSDMetric Metrics[SMSD_METRIC_LAST];
+	/**
+	 * Time when last message was sent, 0 if none.
+	 */
+	time_t LastSent;
+	/**
+	 * Time when last message was received, 0 if none.
+	 */
+	time_t LastReceived;
+	/**
+	 * Time when phone status was last refreshed, 0 if never.
+	 */
+	time_t LastStatus;
 } GSM_SMSDStatus;
 
 /**
@@ -101,7 +206,9 @@ typedef struct {
 GSM_Error SMSD_InjectSMS(GSM_SMSDConfig * Config, GSM_MultiSMSMessage * sms, char *NewID);
 
 /**
- * Gets SMSD status via shared memory.
+ * Gets SMSD status via shared memory. The copy is always consistent,
+ * the call retries while SMSD is updating the status. The shared
+ * memory stays mapped between calls, so it can be polled often.
  *
  * \param Config SMSD configuration pointer.
  * \param status pointer where status will be copied
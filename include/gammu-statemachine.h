@@ -127,8 +127,78 @@ typedef struct {
    * Phone number associated with the device.
    */
    char PhoneNumber[GSM_MAX_NUMBER_LENGTH];
+	/**
+	 * File where detected phone capabilities are cached.
+	 */
+	char *CapabilityCache;
+	/**
+	 * Whether to derive timeouts from measured response times.
+	 */
+	gboolean AdaptiveTimeout;
+	/**
+	 * Lower bound for timeouts derived from response times, in
+	 * milliseconds.
+	 */
+	int MinTimeout;
+	/**
+	 * Upper bound for all timeouts in milliseconds, 0 to use timeouts
+	 * defined by phone drivers.
+	 */
+	int MaxTimeout;
 } GSM_Config;
 
+/**
+ * Statistics of response times for one type of request sent to the
+ * phone. Response time is the longest period without any data from
+ * the phone while waiting for reply, which is what timeouts limit.
+ *
+ * \ingroup StateMachine
+ */
+typedef struct {
+	/**
+	 * Name of request type.
+	 */
+	const char *Request;
+	/**
+	 * Number of received replies.
+	 */
+	int Count;
+	/**
+	 * Number of attempts which timed out.
+	 */
+	int Timeouts;
+	/**
+	 * Exponentially weighted moving average of response time in
+	 * milliseconds.
+	 */
+	int Average;
+	/**
+	 * Exponentially weighted moving average of deviation from average
+	 * response time in milliseconds.
+	 */
+	int Deviation;
+	/**
+	 * Estimate of 95th percentile of recent response times in
+	 * milliseconds.
+	 */
+	int Percentile95;
+	/**
+	 * Estimate of 99th percentile of recent response times in
+	 * milliseconds.
+	 */
+	int Percentile99;
+	/**
+	 * Longest response time in milliseconds.
+	 */
+	int Maximum;
+	/**
+	 * Timeout for first attempt derived from statistics in
+	 * milliseconds, 0 if adaptive timeouts are disabled or there is
+	 * not enough data.
+	 */
+	int Timeout;
+} GSM_ResponseStats;
+
 /**
  * Connection types definitions.
  */
@@ -302,6 +372,19 @@ int GSM_GetConfigNum(const GSM_StateMachine * s);
  */
 void GSM_SetConfigNum(GSM_StateMachine * s, int sections);
 
+/**
+ * Gets statistics of response times measured on current connection.
+ *
+ * \param s State machine data
+ * \param index Index of request type to return, starting from 0.
+ * \param stats Storage for statistics.
+ * \return ERR_NONE on success, ERR_EMPTY if there are no more request
+ * types with statistics.
+ *
+ * \ingroup StateMachine
+ */
+GSM_Error GSM_GetResponseStats(GSM_StateMachine * s, int index, GSM_ResponseStats * stats);
+
 /**
  * Allocates new clean state machine structure. You should free it then
  * by \ref GSM_FreeStateMachine.
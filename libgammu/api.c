@@ -1,4 +1,5 @@
 #include <string.h>
+#include <stdlib.h>
 
 #include <gammu.h>
 #include "gsmstate.h"
@@ -457,6 +458,40 @@ GSM_Error GSM_GetNetworkInfo(GSM_StateMachine *s, GSM_NetworkInfo *netinfo)
 	PRINT_LOG_ERROR(err);
 	return err;
 }
+/**
+ * Reads battery charge, signal quality and network information at once.
+ */
+GSM_Error GSM_GetPhoneStatus(GSM_StateMachine *s, GSM_PhoneStatus *status,
+			     gboolean battery, gboolean signal, gboolean network)
+{
+	GSM_Error err;
+
+	CHECK_PHONE_CONNECTION();
+
+	memset(status, 0, sizeof(GSM_PhoneStatus));
+	status->NetworkInfo.State = GSM_NetworkStatusUnknown;
+	status->NetworkInfo.PacketState = GSM_NetworkStatusUnknown;
+
+	err = s->Phone.Functions->GetPhoneStatus(s, status, battery, signal, network);
+	if (err == ERR_NOTSUPPORTED || err == ERR_NOTIMPLEMENTED) {
+		/* Read values one by one */
+		status->BatteryChargeError = ERR_NOTSUPPORTED;
+		status->SignalQualityError = ERR_NOTSUPPORTED;
+		status->NetworkInfoError = ERR_NOTSUPPORTED;
+		if (battery) {
+			status->BatteryChargeError = GSM_GetBatteryCharge(s, &status->BatteryCharge);
+		}
+		if (signal) {
+			status->SignalQualityError = GSM_GetSignalQuality(s, &status->SignalQuality);
+		}
+		if (network) {
+			status->NetworkInfoError = GSM_GetNetworkInfo(s, &status->NetworkInfo);
+		}
+		err = ERR_NONE;
+	}
+	PRINT_LOG_ERROR(err);
+	return err;
+}
 /**
  * Reads category from phone.
  */
@@ -734,6 +769,36 @@ GSM_Error GSM_DeleteSMS(GSM_StateMachine *s, GSM_SMSMessage *sms)
 	PRINT_LOG_ERROR(err);
 	return err;
 }
+/**
+ * Deletes several SMS messages at once.
+ */
+GSM_Error GSM_DeleteSMSBatch(GSM_StateMachine *s, GSM_SMSLocation *locations, int count)
+{
+	GSM_Error err;
+	GSM_SMSMessage sms;
+	int i;
+
+	CHECK_PHONE_CONNECTION();
+	smprintf(s, "Messages = %d\n", count);
+
+	err = s->Phone.Functions->DeleteSMSBatch(s, locations, count);
+	if (err == ERR_NOTIMPLEMENTED || err == ERR_NOTSUPPORTED) {
+		/* Fallback to deleting messages one by one */
+		err = ERR_NONE;
+		for (i = 0; i < count && err == ERR_NONE; i++) {
+			GSM_SetDefaultSMSData(&sms);
+			sms.Folder = locations[i].Folder;
+			sms.Location = locations[i].Location;
+			sms.Memory = locations[i].Memory;
+			err = s->Phone.Functions->DeleteSMS(s, &sms);
+			if (err == ERR_EMPTY) {
+				err = ERR_NONE;
+			}
+		}
+	}
+	PRINT_LOG_ERROR(err);
+	return err;
+}
 /**
  * Sends SMS.
  */
@@ -1751,14 +1816,105 @@ GSM_Error GSM_SetFileAttributes(GSM_StateMachine *s, GSM_File *File)
  */
 GSM_Error GSM_GetFilePart(GSM_StateMachine *s, GSM_File *File, int *Handle, size_t *Size)
 {
-	GSM_Error err;
+	GSM_Error err, error;
 
 	CHECK_PHONE_CONNECTION();
 
+	/* Decide on transfer start whether data go to stream callback */
+	if (File->Used == 0) {
+		s->Phone.Data.FileStream = NULL;
+		if (s->User.FileWrite != NULL && File->Buffer == NULL) {
+			s->Phone.Data.FileStream = File;
+			s->Phone.Data.FileStreamed = 0;
+		}
+	}
+
 	err = s->Phone.Functions->GetFilePart(s, File, Handle, Size);
+
+	if (s->Phone.Data.FileStream == File) {
+		/* Pass on data from drivers which can not stream them */
+		if ((err == ERR_NONE || err == ERR_EMPTY || err == ERR_WRONGCRC) &&
+				File->Buffer != NULL && File->Used > s->Phone.Data.FileStreamed) {
+			error = s->User.FileWrite(s, File,
+				File->Buffer + s->Phone.Data.FileStreamed,
+				File->Used - s->Phone.Data.FileStreamed,
+				s->User.FileStreamUserData);
+			s->Phone.Data.FileStreamed = File->Used;
+			if (error != ERR_NONE) {
+				err = error;
+			}
+		}
+		if (err != ERR_NONE) {
+			s->Phone.Data.FileStream = NULL;
+		}
+	}
 	PRINT_LOG_ERROR(err);
 	return err;
 }
+/**
+ * Prepares streaming of uploaded file. Drivers which can not stream get
+ * whole file read into memory on transfer start, the buffer is lent to
+ * them only for duration of the call.
+ */
+static GSM_Error GSM_StartFileUpload(GSM_StateMachine *s, GSM_File *File, size_t *Pos)
+{
+	GSM_Error error;
+	unsigned char *buffer;
+
+	if (*Pos == 0) {
+		free(s->Phone.Data.FileStreamBuffer);
+		s->Phone.Data.FileStreamBuffer = NULL;
+		s->Phone.Data.FileStream = NULL;
+
+		if (s->User.FileRead == NULL || File->Buffer != NULL) {
+			return ERR_NONE;
+		}
+		s->Phone.Data.FileStream = File;
+		if (s->Phone.Data.FileStreamSupported) {
+			return ERR_NONE;
+		}
+
+		buffer = (unsigned char *)malloc(File->Used + 1);
+		if (buffer == NULL) {
+			s->Phone.Data.FileStream = NULL;
+			return ERR_MOREMEMORY;
+		}
+		if (File->Used > 0) {
+			error = s->User.FileRead(s, File, 0, buffer, File->Used, s->User.FileStreamUserData);
+			if (error != ERR_NONE) {
+				free(buffer);
+				s->Phone.Data.FileStream = NULL;
+				return error;
+			}
+		}
+		s->Phone.Data.FileStreamBuffer = buffer;
+	}
+
+	if (s->Phone.Data.FileStream == File && s->Phone.Data.FileStreamBuffer != NULL) {
+		File->Buffer = s->Phone.Data.FileStreamBuffer;
+	}
+	return ERR_NONE;
+}
+
+/**
+ * Takes back buffer lent to driver and releases streaming state once
+ * transfer is over.
+ */
+static void GSM_EndFileUpload(GSM_StateMachine *s, GSM_File *File, GSM_Error err)
+{
+	if (s->Phone.Data.FileStream != File) {
+		return;
+	}
+	if (s->Phone.Data.FileStreamBuffer != NULL) {
+		File->Buffer = NULL;
+	}
+	if (err == ERR_NONE) {
+		return;
+	}
+	free(s->Phone.Data.FileStreamBuffer);
+	s->Phone.Data.FileStreamBuffer = NULL;
+	s->Phone.Data.FileStream = NULL;
+}
 /**
  * Adds file part to filesystem.
  */
@@ -1768,7 +1924,11 @@ GSM_Error GSM_AddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos, int
 
 	CHECK_PHONE_CONNECTION();
 
-	err = s->Phone.Functions->AddFilePart(s, File, Pos, Handle);
+	err = GSM_StartFileUpload(s, File, Pos);
+	if (err == ERR_NONE) {
+		err = s->Phone.Functions->AddFilePart(s, File, Pos, Handle);
+	}
+	GSM_EndFileUpload(s, File, err);
 	PRINT_LOG_ERROR(err);
 	return err;
 }
@@ -1781,7 +1941,11 @@ GSM_Error GSM_SendFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos, int
 
 	CHECK_PHONE_CONNECTION();
 
-	err = s->Phone.Functions->SendFilePart(s, File, Pos, Handle);
+	err = GSM_StartFileUpload(s, File, Pos);
+	if (err == ERR_NONE) {
+		err = s->Phone.Functions->SendFilePart(s, File, Pos, Handle);
+	}
+	GSM_EndFileUpload(s, File, err);
 	PRINT_LOG_ERROR(err);
 	return err;
 }
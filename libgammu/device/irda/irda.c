@@ -99,11 +99,11 @@ static gboolean irda_discover_device(GSM_StateMachine *state, SOCKET *fd)
 							list->Device[i].irdaDeviceName,
 							deviceid
 							);
-					if (strcmp(GetModelData(state, NULL,NULL,list->Device[i].irdaDeviceName)->number,"") != 0) {
+					if (strcmp(GetModelData(NULL, NULL,NULL,list->Device[i].irdaDeviceName)->number,"") != 0) {
 						founddevice = TRUE;
 						/* Model AUTO */
 						if (state->CurrentConfig->Model[0]==0)
-							strcpy(state->Phone.Data.Model,GetModelData(state, NULL,NULL,list->Device[i].irdaDeviceName)->number);
+							strcpy(state->Phone.Data.Model,GetModelData(NULL, NULL,NULL,list->Device[i].irdaDeviceName)->number);
 						state->Phone.Data.ModelInfo = GetModelData(state, NULL,state->Phone.Data.Model,NULL);
 					}
 					if (founddevice) {
@@ -65,6 +65,19 @@ struct cdc_extra_desc {
 /* Interface descriptor (bDescriptorType) */
 #define USB_DT_CS_INTERFACE     0x24
 
+/**
+ * Size of buffer of one read transfer.
+ */
+#define USB_READ_SIZE		4096
+/**
+ * Timeout for single write in ms.
+ */
+#define USB_WRITE_TIMEOUT	5000
+/**
+ * How long does read wait for data in us.
+ */
+#define USB_EVENT_WAIT		50000
+
 
 GSM_Error GSM_USB_Error(GSM_StateMachine *s, enum libusb_error code)
 {
@@ -416,12 +429,264 @@ done:
 	return error;
 }
 
-GSM_Error GSM_USB_Init(GSM_StateMachine *s)
+static int GSM_USB_Submit(struct libusb_transfer *transfer)
+{
+	return libusb_submit_transfer(transfer);
+}
+
+static int GSM_USB_Cancel(struct libusb_transfer *transfer)
+{
+	return libusb_cancel_transfer(transfer);
+}
+
+static int GSM_USB_LibusbHandleEvents(libusb_context *context, struct timeval *tv, int *completed)
+{
+	return libusb_handle_events_timeout_completed(context, tv, completed);
+}
+
+/**
+ * Transfers go directly to libusb.
+ */
+static const GSM_USB_Transport GSM_USB_LibusbTransport = {
+	GSM_USB_Submit,
+	GSM_USB_Cancel,
+	GSM_USB_LibusbHandleEvents
+};
+
+/**
+ * Converts status of finished transfer to libusb error code.
+ */
+static int GSM_USB_TransferError(enum libusb_transfer_status status)
+{
+	switch (status) {
+		case LIBUSB_TRANSFER_COMPLETED:
+			return LIBUSB_SUCCESS;
+		case LIBUSB_TRANSFER_TIMED_OUT:
+			return LIBUSB_ERROR_TIMEOUT;
+		case LIBUSB_TRANSFER_STALL:
+			return LIBUSB_ERROR_PIPE;
+		case LIBUSB_TRANSFER_NO_DEVICE:
+			return LIBUSB_ERROR_NO_DEVICE;
+		case LIBUSB_TRANSFER_OVERFLOW:
+			return LIBUSB_ERROR_OVERFLOW;
+		default:
+			return LIBUSB_ERROR_IO;
+	}
+}
+
+/**
+ * Stores received data until they are read by state machine.
+ */
+static GSM_Error GSM_USB_QueueData(GSM_Device_USBData *d, const unsigned char *data, size_t length)
+{
+	unsigned char *buffer;
+	size_t size;
+
+	if (d->read_start + d->read_length + length > d->read_buffer_size) {
+		/* Reuse space of already consumed data */
+		memmove(d->read_buffer, d->read_buffer + d->read_start, d->read_length);
+		d->read_start = 0;
+	}
+	if (d->read_length + length > d->read_buffer_size) {
+		size = MAX(2 * d->read_buffer_size, d->read_length + length);
+		buffer = (unsigned char *)realloc(d->read_buffer, size);
+		if (buffer == NULL) {
+			return ERR_MOREMEMORY;
+		}
+		d->read_buffer = buffer;
+		d->read_buffer_size = size;
+	}
+	memcpy(d->read_buffer + d->read_start + d->read_length, data, length);
+	d->read_length += length;
+	return ERR_NONE;
+}
+
+/**
+ * Read transfers are submitted without timeout, they wait for data
+ * until they are cancelled, so any failure means the device is broken.
+ */
+static void LIBUSB_CALL GSM_USB_ReadCallback(struct libusb_transfer *transfer)
+{
+	GSM_StateMachine *s = transfer->user_data;
+	GSM_Device_USBData *d = &s->Device.Data.USB;
+	int rc;
+
+	switch (transfer->status) {
+		case LIBUSB_TRANSFER_COMPLETED:
+			if (GSM_USB_QueueData(d, transfer->buffer, transfer->actual_length) != ERR_NONE) {
+				smprintf(s, "Failed to store data read from usb!\n");
+				d->transfer_error = LIBUSB_ERROR_NO_MEM;
+				d->read_active--;
+				return;
+			}
+			break;
+		case LIBUSB_TRANSFER_CANCELLED:
+			d->read_active--;
+			return;
+		default:
+			/* Device failed or is gone, resubmitting would only spin */
+			smprintf(s, "Failed to read from usb (%d)!\n", transfer->status);
+			d->transfer_error = GSM_USB_TransferError(transfer->status);
+			d->read_active--;
+			return;
+	}
+
+	if (d->closing) {
+		d->read_active--;
+		return;
+	}
+
+	/* Keep transfer in flight */
+	rc = d->transport->Submit(transfer);
+	if (rc != 0) {
+		smprintf(s, "Failed to resubmit usb read (%d)!\n", rc);
+		d->transfer_error = rc;
+		d->read_active--;
+	}
+}
+
+static void LIBUSB_CALL GSM_USB_WriteCallback(struct libusb_transfer *transfer)
 {
+	GSM_StateMachine *s = transfer->user_data;
 	GSM_Device_USBData *d = &s->Device.Data.USB;
+	int error = 0;
+
+	if (transfer->status != LIBUSB_TRANSFER_COMPLETED) {
+		smprintf(s, "Failed to write to usb (%d)!\n", transfer->status);
+		error = GSM_USB_TransferError(transfer->status);
+	} else if (transfer->actual_length != transfer->length) {
+		smprintf(s, "Written only %d of %d bytes to usb!\n", transfer->actual_length, transfer->length);
+		error = LIBUSB_ERROR_IO;
+	}
+	/* Result of abandoned write does not belong to current one */
+	if (transfer == d->write_transfer) {
+		d->write_error = error;
+		d->write_completed = 1;
+		d->write_transfer = NULL;
+	}
+	/* Transfer and its buffer are freed by libusb */
+	d->write_active--;
+}
+
+/**
+ * Processes libusb events for at most given time or until completed
+ * flag is set.
+ */
+static int GSM_USB_HandleEvents(GSM_StateMachine *s, int usec, int *completed)
+{
+	GSM_Device_USBData *d = &s->Device.Data.USB;
+	struct timeval tv;
 	int rc;
 
+	tv.tv_sec = usec / 1000000;
+	tv.tv_usec = usec % 1000000;
+	rc = d->transport->HandleEvents(d->context, &tv, completed);
+	if (rc == LIBUSB_ERROR_INTERRUPTED) {
+		return 0;
+	}
+	if (rc != 0) {
+		smprintf(s, "Failed to handle usb events (%d)!\n", rc);
+	}
+	return rc;
+}
+
+/**
+ * Waits for abandoned writes and cancels read transfers.
+ */
+void GSM_USB_StopTransfers(GSM_StateMachine *s)
+{
+	GSM_Device_USBData *d = &s->Device.Data.USB;
+	int i;
+
+	for (i = 0; i < 100 && d->write_active > 0; i++) {
+		if (GSM_USB_HandleEvents(s, USB_EVENT_WAIT, NULL) != 0) break;
+	}
+
+	d->closing = TRUE;
+	for (i = 0; i < GSM_USB_READ_TRANSFERS; i++) {
+		if (d->read_transfers[i] != NULL) {
+			d->transport->Cancel(d->read_transfers[i]);
+		}
+	}
+	for (i = 0; i < 100 && d->read_active > 0; i++) {
+		if (GSM_USB_HandleEvents(s, USB_EVENT_WAIT, NULL) != 0) break;
+	}
+
+	if (d->read_active > 0 || d->write_active > 0) {
+		/* Freeing transfers still owned by libusb is not safe */
+		smprintf(s, "Some usb transfers did not finish, leaking them!\n");
+	} else {
+		for (i = 0; i < GSM_USB_READ_TRANSFERS; i++) {
+			libusb_free_transfer(d->read_transfers[i]);
+		}
+	}
+	for (i = 0; i < GSM_USB_READ_TRANSFERS; i++) {
+		d->read_transfers[i] = NULL;
+	}
+
+	free(d->read_buffer);
+	d->read_buffer = NULL;
+	d->read_buffer_size = 0;
+	d->read_start = 0;
+	d->read_length = 0;
+}
+
+/**
+ * Submits ring of read transfers, so that data are received even when
+ * state machine does not read.
+ */
+GSM_Error GSM_USB_StartTransfers(GSM_StateMachine *s)
+{
+	GSM_Device_USBData *d = &s->Device.Data.USB;
+	unsigned char *buffer;
+	int i, rc;
+
+	d->closing = FALSE;
+	d->transfer_error = 0;
+
+	for (i = 0; i < GSM_USB_READ_TRANSFERS; i++) {
+		d->read_transfers[i] = libusb_alloc_transfer(0);
+		buffer = (unsigned char *)malloc(USB_READ_SIZE);
+		if (d->read_transfers[i] == NULL || buffer == NULL) {
+			free(buffer);
+			GSM_USB_StopTransfers(s);
+			return ERR_MOREMEMORY;
+		}
+		libusb_fill_bulk_transfer(d->read_transfers[i], d->handle, d->ep_read,
+			buffer, USB_READ_SIZE, GSM_USB_ReadCallback, s, 0);
+		d->read_transfers[i]->flags = LIBUSB_TRANSFER_FREE_BUFFER;
+
+		rc = d->transport->Submit(d->read_transfers[i]);
+		if (rc != 0) {
+			smprintf(s, "Failed to submit usb read (%d)!\n", rc);
+			GSM_USB_StopTransfers(s);
+			return GSM_USB_Error(s, rc);
+		}
+		d->read_active++;
+	}
+
+	return ERR_NONE;
+}
+
+GSM_Error GSM_USB_Init(GSM_StateMachine *s)
+{
+	GSM_Device_USBData *d = &s->Device.Data.USB;
+	int rc, i;
+
+	d->transport = &GSM_USB_LibusbTransport;
 	d->handle = NULL;
+	for (i = 0; i < GSM_USB_READ_TRANSFERS; i++) {
+		d->read_transfers[i] = NULL;
+	}
+	d->read_active = 0;
+	d->write_transfer = NULL;
+	d->write_active = 0;
+	d->transfer_error = 0;
+	d->closing = FALSE;
+	d->read_buffer = NULL;
+	d->read_buffer_size = 0;
+	d->read_start = 0;
+	d->read_length = 0;
 
 	rc = libusb_init(&d->context);
 	if (rc != 0) {
@@ -439,6 +704,8 @@ GSM_Error GSM_USB_Terminate(GSM_StateMachine *s)
 	int rc;
 
 	if (d->handle != NULL) {
+		GSM_USB_StopTransfers(s);
+
 		rc = libusb_set_interface_alt_setting(d->handle, d->data_iface, d->data_idlesetting);
 		if (rc != 0) {
 			smprintf(s, "Failed to set idle settings\n");
@@ -468,63 +735,85 @@ GSM_Error GSM_USB_Terminate(GSM_StateMachine *s)
 ssize_t GSM_USB_Read(GSM_StateMachine *s, void *buf, size_t nbytes)
 {
 	GSM_Device_USBData *d = &s->Device.Data.USB;
-	int rc = LIBUSB_ERROR_TIMEOUT, ret = 0, repeat = 0;
-
-	while (repeat < 10 && (rc == LIBUSB_ERROR_TIMEOUT || rc == LIBUSB_ERROR_INTERRUPTED || rc == LIBUSB_ERROR_OTHER || rc == LIBUSB_ERROR_NO_MEM)) {
-		rc = libusb_bulk_transfer(d->handle, d->ep_read, buf, nbytes, &ret, 1000);
-		/* This seems to be some strange failure on partial data transfer */
-		if (rc == LIBUSB_ERROR_OTHER && ret != 0) {
-			smprintf(s, "Other error while reading, but got some data\n");
-			rc = 0;
-			break;
-		}
-		if (rc == LIBUSB_ERROR_TIMEOUT && ret != 0) {
-			smprintf(s, "Timeout while reading, but got some data\n");
-			rc = 0;
-			break;
+	size_t len;
+
+	if (d->read_length == 0) {
+		if (GSM_USB_HandleEvents(s, USB_EVENT_WAIT, NULL) != 0) {
+			return -1;
 		}
-		if (rc != 0) {
-			smprintf(s, "Failed to read from usb (%d)!\n", rc);
-			GSM_USB_Error(s, rc);
+	}
+
+	if (d->read_length == 0) {
+		if (d->read_active == 0) {
+			smprintf(s, "No usb read transfer active!\n");
+			GSM_USB_Error(s, d->transfer_error);
+			return -1;
 		}
-		repeat++;
-		usleep(1000);
+		return 0;
 	}
-	if (rc != 0) {
-		return -1;
+
+	len = MIN(nbytes, d->read_length);
+	memcpy(buf, d->read_buffer + d->read_start, len);
+	d->read_start += len;
+	d->read_length -= len;
+	if (d->read_length == 0) {
+		d->read_start = 0;
 	}
-	return ret;
+	return len;
 }
 
 ssize_t GSM_USB_Write(GSM_StateMachine *s, const void *buf, size_t nbytes)
 {
 	GSM_Device_USBData *d = &s->Device.Data.USB;
-	int rc = LIBUSB_ERROR_TIMEOUT, ret = 0, repeat = 0;
-
-	while (repeat < 10 && (rc == LIBUSB_ERROR_TIMEOUT || rc == LIBUSB_ERROR_INTERRUPTED || rc == LIBUSB_ERROR_OTHER || rc == LIBUSB_ERROR_NO_MEM)) {
-		rc = libusb_bulk_transfer(d->handle, d->ep_write, (void *)buf, nbytes, &ret, 1000);
-		/* This seems to be some strange failure on partial data transfer */
-		if (rc == LIBUSB_ERROR_OTHER && ret != 0) {
-			smprintf(s, "Other error while writing, but got some data\n");
-			rc = 0;
-			break;
-		}
-		if (rc == LIBUSB_ERROR_TIMEOUT && ret != 0) {
-			smprintf(s, "Timeout while write, but some data were written\n");
-			rc = 0;
-			break;
-		}
+	struct libusb_transfer *transfer;
+	unsigned char *buffer;
+	int rc;
+
+	transfer = libusb_alloc_transfer(0);
+	buffer = (unsigned char *)malloc(nbytes);
+	if (transfer == NULL || buffer == NULL) {
+		libusb_free_transfer(transfer);
+		free(buffer);
+		return -1;
+	}
+	memcpy(buffer, buf, nbytes);
+
+	libusb_fill_bulk_transfer(transfer, d->handle, d->ep_write,
+		buffer, nbytes, GSM_USB_WriteCallback, s, USB_WRITE_TIMEOUT);
+	transfer->flags = LIBUSB_TRANSFER_FREE_BUFFER | LIBUSB_TRANSFER_FREE_TRANSFER;
+
+	rc = d->transport->Submit(transfer);
+	if (rc != 0) {
+		smprintf(s, "Failed to write to usb (%d)!\n", rc);
+		GSM_USB_Error(s, rc);
+		libusb_free_transfer(transfer);
+		return -1;
+	}
+	d->write_transfer = transfer;
+	d->write_completed = 0;
+	d->write_error = 0;
+	d->write_active++;
+
+	/*
+	 * Wait for the write to finish, so that failure is reported to
+	 * caller. Reads are processed meanwhile.
+	 */
+	while (!d->write_completed) {
+		rc = GSM_USB_HandleEvents(s, USB_EVENT_WAIT, &d->write_completed);
 		if (rc != 0) {
-			smprintf(s, "Failed to write to usb (%d)!\n", rc);
+			/* Callback will ignore result of abandoned write */
+			d->write_transfer = NULL;
+			d->transport->Cancel(transfer);
 			GSM_USB_Error(s, rc);
+			return -1;
 		}
-		repeat++;
-		usleep(1000);
 	}
-	if (rc != 0) {
+
+	if (d->write_error != 0) {
+		GSM_USB_Error(s, d->write_error);
 		return -1;
 	}
-	return ret;
+	return nbytes;
 }
 
 /**
@@ -670,6 +959,9 @@ GSM_Error FBUSUSB_Open(GSM_StateMachine *s)
 	error = GSM_USB_Probe(s, FBUSUSB_Match);
 	if (error != ERR_NONE) return error;
 
+	error = GSM_USB_StartTransfers(s);
+	if (error != ERR_NONE) return error;
+
 	return ERR_NONE;
 }
 
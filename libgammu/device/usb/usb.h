@@ -23,7 +23,26 @@
 #define struct_libusb_device_descriptor struct libusb_device_descriptor
 #endif
 
+/**
+ * Number of read transfers kept submitted at once.
+ */
+#define GSM_USB_READ_TRANSFERS 4
+
+struct libusb_transfer;
+struct timeval;
+
+/**
+ * Operations on transfers, replaceable to test transfer handling
+ * without device.
+ */
+typedef struct {
+    int (*Submit)(struct libusb_transfer *transfer);
+    int (*Cancel)(struct libusb_transfer *transfer);
+    int (*HandleEvents)(libusb_context *context, struct timeval *tv, int *completed);
+} GSM_USB_Transport;
+
 typedef struct {
+    const GSM_USB_Transport *transport;
     libusb_context *context;
     libusb_device_handle *handle;
     int configuration;
@@ -34,6 +53,21 @@ typedef struct {
     int data_idlesetting;
     unsigned char ep_read;
     unsigned char ep_write;
+    /* Asynchronous transfers */
+    struct libusb_transfer *read_transfers[GSM_USB_READ_TRANSFERS];
+    int read_active;
+    int transfer_error;
+    /* Write currently being waited for */
+    struct libusb_transfer *write_transfer;
+    int write_active;
+    int write_completed;
+    int write_error;
+    gboolean closing;
+    /* Data received, but not yet consumed */
+    unsigned char *read_buffer;
+    size_t read_buffer_size;
+    size_t read_start;
+    size_t read_length;
 } GSM_Device_USBData;
 
 typedef gboolean (*GSM_USB_Match_Function)(GSM_StateMachine *s, libusb_device *dev, struct_libusb_device_descriptor *desc);
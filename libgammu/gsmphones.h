@@ -12,15 +12,18 @@
 
 /**
  * Converts model string to model record record describing it's
- * features. If state machine structure is provided, phone features
- * can be overrided from current state machine configuration.
+ * features. If state machine structure is provided, the record is
+ * copied to state machine, phone features can be overrided from
+ * current state machine configuration and feature bitmap is resolved.
+ * Static model database is never modified.
  *
  * \param s Pointer to state machine structure, can be NULL.
  * \param model Model name string, NULL if not to be searched.
  * \param number Model number string, NULL if not to be searched.
  * \param irdamodel IrDA model name string, NULL if not to be searched.
  *
- * \return Pointer to static structure containing phone information.
+ * \return Pointer to structure containing phone information, either
+ * static one or the one stored in state machine.
  */
 GSM_PhoneModel *GetModelData(GSM_StateMachine *s, const char *model, const char *number, const char *irdamodel);
 
@@ -196,9 +196,11 @@ typedef enum {
 	ID_AlcatelUpdateField,
 
 	ID_SetPower,
+	ID_CompoundCommand,
 
 	ID_IncomingFrame,
   ID_CheckCHUP,
+	ID_CheckCMGD,
 
 	ID_User1,
 	ID_User2,
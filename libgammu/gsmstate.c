@@ -66,6 +66,9 @@
 #define DEFAULT_DEBUG_LEVEL ""
 #define DEFAULT_LOCK_DEVICE FALSE
 #define DEFAULT_START_INFO FALSE
+#define DEFAULT_ADAPTIVE_TIMEOUT TRUE
+#define DEFAULT_MIN_TIMEOUT 1000
+#define DEFAULT_MAX_TIMEOUT 0
 
 /**
  * Returns current debuging descriptor. It honors use_global
@@ -195,7 +198,8 @@ GSM_Protocol_Functions NoProtocol = {
 	NONEFUNCTION,
 	NONEFUNCTION,
 	NONEFUNCTION,
-	NONEFUNCTION
+	NONEFUNCTION,
+	NULL
 };
 
 static GSM_Error GSM_RegisterAllConnections(GSM_StateMachine *s, const char *connection)
@@ -365,7 +369,7 @@ static void GSM_RegisterModule(GSM_StateMachine *s,GSM_Phone_Functions *phone)
 {
 	/* Auto model */
 	if (s->CurrentConfig->Model[0] == 0) {
-		if (strstr(phone->models,GetModelData(s, NULL, s->Phone.Data.Model, NULL)->model) != NULL) {
+		if (strstr(phone->models,GetModelData(NULL, NULL, s->Phone.Data.Model, NULL)->model) != NULL) {
 			smprintf(s,"[Module           - \"%s\"]\n",phone->models);
 			s->Phone.Functions = phone;
 		}
@@ -390,7 +394,11 @@ GSM_Error GSM_RegisterAllPhoneModules(GSM_StateMachine *s)
 
 	/* Auto model */
 	if (s->CurrentConfig->Model[0] == 0) {
-		model = GetModelData(s, NULL, s->Phone.Data.Model, NULL);
+		/* Use model information resolved while reading model from phone */
+		model = s->Phone.Data.ModelInfo;
+		if (model == NULL) {
+			model = GetModelData(s, NULL, s->Phone.Data.Model, NULL);
+		}
 #ifdef GSM_ENABLE_ATGEN
 		/* With ATgen and auto model we can work with unknown models too */
 		if (s->ConnectionType==GCT_AT || s->ConnectionType==GCT_PROXYAT || s->ConnectionType==GCT_IRDAAT || s->ConnectionType==GCT_DKU2AT) {
@@ -716,7 +724,7 @@ GSM_Error GSM_InitConnection_Log(GSM_StateMachine *s, int ReplyNum, GSM_Log_Func
 {
 	GSM_Error	error;
 	GSM_DateTime	current_time;
-	int		i;
+	int		i, j;
 
 	for (i=0;i<s->ConfigNum;i++) {
 		s->CurrentConfig		  = &s->Config[i];
@@ -744,12 +752,21 @@ GSM_Error GSM_InitConnection_Log(GSM_StateMachine *s, int ReplyNum, GSM_Log_Func
 		s->Phone.Data.EnableIncomingSMS	  = FALSE;
 		s->Phone.Data.EnableIncomingCB	  = FALSE;
 		s->Phone.Data.EnableIncomingUSSD  = FALSE;
+		s->Phone.Data.FileStream	  = NULL;
+		s->Phone.Data.FileStreamBuffer	  = NULL;
+		s->Phone.Data.FileStreamSupported = FALSE;
 		s->User.UserReplyFunctions	  = NULL;
 		s->User.IncomingCall		  = NULL;
 		s->User.IncomingSMS		  = NULL;
 		s->User.IncomingCB		  = NULL;
 		s->User.IncomingUSSD		  = NULL;
 		s->User.SendSMSStatus		  = NULL;
+		s->SilentTimeouts		  = 0;
+		for (j = 0; j <= ID_EachFrame; j++) {
+			GSM_Timing_Reset(&s->Timing[j]);
+		}
+		s->User.FileWrite		  = NULL;
+		s->User.FileRead		  = NULL;
 		s->LockFile			  = NULL;
 		s->opened			  = FALSE;
 		s->Phone.Functions		  = NULL;
@@ -950,12 +967,59 @@ int GSM_ReadDevice (GSM_StateMachine *s, gboolean waitforreply)
 		usleep(5000);
 		GSM_GetCurrentDateTime(&Date);
 	}
+	if (res > 0 && s->Protocol.Functions->StateMachineBlock != NULL) {
+		s->Protocol.Functions->StateMachineBlock(s, buff, res);
+		return res;
+	}
 	for (count = 0; count < res; count++) {
 		s->Protocol.Functions->StateMachine(s, buff[count]);
 	}
 	return res;
 }
 
+int GSM_GetDeviceDescriptor(GSM_StateMachine *s)
+{
+	if (!GSM_IsConnected(s) || s->Device.Functions == NULL) {
+		return -1;
+	}
+#ifndef WIN32
+#if defined(GSM_ENABLE_SERIALDEVICE) && !defined(DJGPP)
+	if (s->Device.Functions == &SerialDevice) {
+		return s->Device.Data.Serial.hPhone;
+	}
+#endif
+#ifdef GSM_ENABLE_IRDADEVICE
+	if (s->Device.Functions == &IrdaDevice) {
+		return s->Device.Data.Irda.hPhone;
+	}
+#endif
+#ifdef GSM_ENABLE_BLUETOOTHDEVICE
+	if (s->Device.Functions == &BlueToothDevice) {
+		return s->Device.Data.BlueTooth.hPhone;
+	}
+#endif
+	if (s->Device.Functions == &ProxyDevice) {
+		return s->Device.Data.Proxy.hRead;
+	}
+#endif
+	return -1;
+}
+
+/**
+ * Logs response time statistics, useful for tuning timeouts.
+ */
+static void GSM_LogResponseStats(GSM_StateMachine *s)
+{
+	GSM_ResponseStats stats;
+	int i;
+
+	for (i = 0; GSM_GetResponseStats(s, i, &stats) == ERR_NONE; i++) {
+		smprintf(s, "[Response times for %s: %d replies, %d timeouts, average %d ms, 95%% below %d ms, maximum %d ms]\n",
+			stats.Request, stats.Count, stats.Timeouts,
+			stats.Average, stats.Percentile95, stats.Maximum);
+	}
+}
+
 GSM_Error GSM_TerminateConnection(GSM_StateMachine *s)
 {
 	GSM_Error error;
@@ -964,6 +1028,8 @@ GSM_Error GSM_TerminateConnection(GSM_StateMachine *s)
 
 	smprintf(s,"[Terminating]\n");
 
+	GSM_LogResponseStats(s);
+
 	if (s->CurrentConfig->StartInfo) {
 		if (s->Phone.Data.StartInfoCounter > 0) s->Phone.Functions->ShowStartInfo(s,FALSE);
 	}
@@ -973,6 +1039,10 @@ GSM_Error GSM_TerminateConnection(GSM_StateMachine *s)
 		if (error!=ERR_NONE) return error;
 	}
 
+	free(s->Phone.Data.FileStreamBuffer);
+	s->Phone.Data.FileStreamBuffer = NULL;
+	s->Phone.Data.FileStream = NULL;
+
 	error = GSM_CloseConnection(s);
 	if (error != ERR_NONE) return error;
 
@@ -993,47 +1063,72 @@ GSM_Error GSM_AbortOperation(GSM_StateMachine * s)
 	return ERR_NONE;
 }
 
-GSM_Error GSM_WaitForOnce(GSM_StateMachine *s, unsigned const char *buffer,
-			  size_t length, int type, int timeout)
+/**
+ * Reads from device until request is completed or there is no data from
+ * the phone for given number of milliseconds. Longest period without
+ * data is stored in silence, it is -1 if no data were received at all.
+ */
+static GSM_Error GSM_WaitForReply(GSM_StateMachine *s, unsigned const char *buffer,
+			  size_t length, int type, int timeout, int *silence)
 {
 	GSM_Phone_Data *Phone = &s->Phone.Data;
-	GSM_Protocol_Message sentmsg;
-	int i = 0;
+	GSM_Protocol_Message sentmsg, *oldmsg = Phone->SentMsg;
+	GSM_Error error = ERR_TIMEOUT;
+	long long last, now;
 
-	do {
-		if (length != 0) {
-			sentmsg.Length 	= length;
-			sentmsg.Type	= type;
-			sentmsg.Buffer 	= (unsigned char *)malloc(length);
-			memcpy(sentmsg.Buffer, buffer, length);
-			Phone->SentMsg  = &sentmsg;
-		}
+	/*
+	 * Sent message is used only for dumping unknown replies, so it
+	 * just references caller's buffer, which lives until we return.
+	 */
+	if (length != 0) {
+		memset(&sentmsg, 0, sizeof(sentmsg));
+		sentmsg.Length 	= length;
+		sentmsg.Type	= type;
+		sentmsg.Buffer 	= (unsigned char *)buffer;
+		Phone->SentMsg  = &sentmsg;
+	}
+
+	*silence = -1;
+	last = GSM_GetMonotonicTime();
 
+	do {
 		/* Some data received. Reset timer */
-		if (GSM_ReadDevice(s, TRUE) > 0) {
-			i = 0;
+		if (GSM_ReadDevice(s, FALSE) > 0) {
+			now = GSM_GetMonotonicTime();
+			if (now - last > *silence) {
+				*silence = (int)(now - last);
+			}
+			last = now;
 		} else {
-			usleep(10000);
-		}
-
-		if (length != 0) {
-			free(sentmsg.Buffer);
-			sentmsg.Buffer = NULL;
-			Phone->SentMsg = NULL;
+			usleep(5000);
+			now = GSM_GetMonotonicTime();
 		}
 
 		if (s->Abort) {
-			return ERR_ABORTED;
+			error = ERR_ABORTED;
+			break;
 		}
 
 		/* Request completed */
 		if (Phone->RequestID == ID_None) {
-			return Phone->DispatchError;
+			error = Phone->DispatchError;
+			break;
 		}
-		i++;
-	} while (i < timeout);
+	} while (now - last < timeout);
 
-	return ERR_TIMEOUT;
+	if (length != 0) {
+		Phone->SentMsg = oldmsg;
+	}
+
+	return error;
+}
+
+GSM_Error GSM_WaitForOnce(GSM_StateMachine *s, unsigned const char *buffer,
+			  size_t length, int type, int timeout)
+{
+	int silence;
+
+	return GSM_WaitForReply(s, buffer, length, type, timeout * GSM_TIMEOUT_UNIT, &silence);
 }
 
 GSM_Error GSM_WaitFor (GSM_StateMachine *s, unsigned const char *buffer,
@@ -1041,8 +1136,10 @@ GSM_Error GSM_WaitFor (GSM_StateMachine *s, unsigned const char *buffer,
 		       GSM_Phone_RequestID request)
 {
 	GSM_Phone_Data		*Phone = &s->Phone.Data;
+	GSM_ResponseTiming	*timing = &s->Timing[request];
 	GSM_Error		error;
-	int			reply;
+	gboolean		received = FALSE;
+	int			reply, attempts, limit, wait, silence;
 
 	if (s->CurrentConfig->StartInfo) {
 		if (Phone->StartInfoCounter > 0) {
@@ -1056,7 +1153,24 @@ GSM_Error GSM_WaitFor (GSM_StateMachine *s, unsigned const char *buffer,
 	Phone->RequestID	= request;
 	Phone->DispatchError	= ERR_TIMEOUT;
 
-	for (reply = 0; reply < s->ReplyNum; reply++) {
+	limit = timeout * GSM_TIMEOUT_UNIT;
+	if (s->CurrentConfig->MaxTimeout > 0 && s->CurrentConfig->MaxTimeout < limit) {
+		limit = s->CurrentConfig->MaxTimeout;
+	}
+	wait = GSM_Timing_Timeout(timing, s->CurrentConfig, limit);
+	attempts = s->ReplyNum;
+
+	/*
+	 * Phone did not send anything for previous request, do not spend
+	 * all retries on it again. The only attempt still waits as long
+	 * as phone driver asks, as phone might be just busy.
+	 */
+	if (s->SilentTimeouts > 0 && attempts > 1) {
+		smprintf_level(s, D_ERROR, "[No data for previous request, trying only once]\n");
+		attempts = 1;
+	}
+
+	for (reply = 0; reply < attempts; reply++) {
 		if (reply != 0) {
 			smprintf_level(s, D_ERROR, "[Retrying %i type 0x%02X]\n", reply, type);
 		}
@@ -1070,11 +1184,31 @@ GSM_Error GSM_WaitFor (GSM_StateMachine *s, unsigned const char *buffer,
 			return ERR_NONE;
 		}
 
-		error = GSM_WaitForOnce(s, buffer, length, type, timeout);
+		/* Last attempt waits as long as phone driver asks */
+		if (reply == attempts - 1) {
+			wait = limit;
+		}
+
+		error = GSM_WaitForReply(s, buffer, length, type, wait, &silence);
+		if (silence >= 0) {
+			received = TRUE;
+			s->SilentTimeouts = 0;
+		}
 		if (error != ERR_TIMEOUT) {
+			if (error != ERR_ABORTED) {
+				GSM_Timing_Record(timing, silence);
+			}
 			return error;
 		}
-  }
+		GSM_Timing_RecordTimeout(timing);
+
+		/* Be more patient with next attempt */
+		wait = MIN(2 * wait, limit);
+	}
+
+	if (!received) {
+		s->SilentTimeouts++;
+	}
 
 	if (request != ID_Reset && GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_RESET_AFTER_TIMEOUT)) {
 		smprintf_level(s, D_ERROR, "Performing device reset after timeout!\n");
@@ -1434,6 +1568,38 @@ void GSM_SetConfigNum(GSM_StateMachine *s, int sections)
 	s->ConfigNum = sections;
 }
 
+GSM_Error GSM_GetResponseStats(GSM_StateMachine *s, int index, GSM_ResponseStats *stats)
+{
+	GSM_ResponseTiming *timing;
+	int i, found = 0;
+
+	for (i = 0; i <= ID_EachFrame; i++) {
+		timing = &s->Timing[i];
+		if (timing->Count == 0 && timing->Timeouts == 0) {
+			continue;
+		}
+		if (found++ != index) {
+			continue;
+		}
+
+		stats->Request = GSM_RequestIDToString(i);
+		stats->Count = timing->Count;
+		stats->Timeouts = timing->Timeouts;
+		stats->Average = (int)(timing->Average + 0.5);
+		stats->Deviation = (int)(timing->Deviation + 0.5);
+		stats->Percentile95 = GSM_Timing_Percentile(timing, 95);
+		stats->Percentile99 = GSM_Timing_Percentile(timing, 99);
+		stats->Maximum = timing->Maximum;
+		stats->Timeout = 0;
+		if (s->CurrentConfig != NULL && s->CurrentConfig->AdaptiveTimeout &&
+				timing->Count >= GSM_TIMING_MIN_SAMPLES) {
+			stats->Timeout = GSM_Timing_Timeout(timing, s->CurrentConfig, INT_MAX);
+		}
+		return ERR_NONE;
+	}
+	return ERR_EMPTY;
+}
+
 /**
  * Expand path to user home.
  */
@@ -1596,6 +1762,19 @@ GSM_Error GSM_ReadConfig(INI_Section *cfg_info, GSM_Config *cfg, int num)
 		GSM_ExpandUserPath(&cfg->DebugFile);
 	}
 
+	/* Set capability cache file */
+	free(cfg->CapabilityCache);
+	cfg->CapabilityCache = INI_GetValue(cfg_info, section, "capabilitycache", FALSE);
+	if (cfg->CapabilityCache != NULL) {
+		cfg->CapabilityCache		 = strdup(cfg->CapabilityCache);
+		GSM_ExpandUserPath(&cfg->CapabilityCache);
+	}
+
+	/* Set timeouts */
+	cfg->AdaptiveTimeout = INI_GetBool(cfg_info, section, "adaptivetimeout", DEFAULT_ADAPTIVE_TIMEOUT);
+	cfg->MinTimeout = INI_GetInt(cfg_info, section, "mintimeout", DEFAULT_MIN_TIMEOUT);
+	cfg->MaxTimeout = INI_GetInt(cfg_info, section, "maxtimeout", DEFAULT_MAX_TIMEOUT);
+
 	/* Set file locking */
 	cfg->LockDevice  = INI_GetBool(cfg_info, section, "use_locking", DEFAULT_LOCK_DEVICE);
 
@@ -1723,6 +1902,9 @@ fail:
 		strcpy(cfg->Model,DEFAULT_MODEL);
 		strcpy(cfg->DebugLevel,DEFAULT_DEBUG_LEVEL);
 		cfg->StartInfo	 		 = DEFAULT_START_INFO;
+		cfg->AdaptiveTimeout		 = DEFAULT_ADAPTIVE_TIMEOUT;
+		cfg->MinTimeout			 = DEFAULT_MIN_TIMEOUT;
+		cfg->MaxTimeout			 = DEFAULT_MAX_TIMEOUT;
 		strcpy(cfg->TextReminder,"Reminder");
 		strcpy(cfg->TextMeeting,"Meeting");
 		strcpy(cfg->TextCall,"Call");
@@ -1874,6 +2056,13 @@ void GSM_SetSendSMSStatusCallback(GSM_StateMachine *s, SendSMSStatusCallback cal
 	s->User.SendSMSStatusUserData = user_data;
 }
 
+void GSM_SetFileStream(GSM_StateMachine *s, GSM_FileWriteCallback Write, GSM_FileReadCallback Read, void *user_data)
+{
+	s->User.FileWrite = Write;
+	s->User.FileRead = Read;
+	s->User.FileStreamUserData = user_data;
+}
+
 GSM_StateMachine *GSM_AllocStateMachine(void)
 {
 	GSM_StateMachine *ret;
@@ -1900,6 +2089,8 @@ void GSM_FreeStateMachine(GSM_StateMachine *s)
 		s->Config[i].Connection = NULL;
 		free(s->Config[i].DebugFile);
 		s->Config[i].DebugFile = NULL;
+		free(s->Config[i].CapabilityCache);
+		s->Config[i].CapabilityCache = NULL;
 	}
 	free(s);
 	s = NULL;
@@ -218,6 +218,7 @@ typedef struct _GSM_User	 	GSM_User;
 
 #include "debug.h"
 #include "gsmreply.h"
+#include "gsmtiming.h"
 
 typedef struct EventBinding_ EventBinding;
 
@@ -422,6 +423,13 @@ typedef struct {
 	 * Protocol termination.
 	 */
 	GSM_Error (*Terminate)    (GSM_StateMachine *s);
+	/**
+	 * This one is called with block of characters received from
+	 * device, protocols which do not set it get them one by one in
+	 * StateMachine.
+	 */
+	GSM_Error (*StateMachineBlock) (GSM_StateMachine *s, const unsigned char *buffer,
+				   size_t length);
 } GSM_Protocol_Functions;
 
 #ifdef GSM_ENABLE_MBUS2
@@ -508,9 +516,14 @@ typedef struct {
 	 */
 	char			Model[GSM_MAX_MODEL_LENGTH + 1];
 	/**
-	 * Model information, pointer to static @ref allmodels array.
+	 * Model information, usually pointer to @ref ModelData.
 	 */
 	GSM_PhoneModel		*ModelInfo;
+	/**
+	 * Per connection copy of model information with user configured
+	 * features applied, filled in by @ref GetModelData.
+	 */
+	GSM_PhoneModel		ModelData;
 	/**
 	 * Phone version as reported by phone. It doesn't have to be numerical
 	 * at all.
@@ -704,6 +717,24 @@ typedef struct {
 	 * Pointer to structure used internally by phone drivers.
 	 */
 	GSM_File		*File;
+	/**
+	 * File which is being transferred through user stream callbacks,
+	 * NULL when no streaming transfer is in progress.
+	 */
+	GSM_File		*FileStream;
+	/**
+	 * Number of bytes of file already passed to user stream callback.
+	 */
+	size_t			FileStreamed;
+	/**
+	 * Buffer holding whole file for drivers which can not stream data.
+	 */
+	unsigned char		*FileStreamBuffer;
+	/**
+	 * Whether phone driver reads and writes file data using
+	 * PHONE_ReadFileData and PHONE_AppendFileData.
+	 */
+	gboolean		FileStreamSupported;
 	/**
 	 * Pointer to structure used internally by phone drivers.
 	 */
@@ -1025,6 +1056,10 @@ typedef struct {
 	 * Deletes SMS.
 	 */
 	GSM_Error (*DeleteSMS)	  	(GSM_StateMachine *s, GSM_SMSMessage *sms);
+	/**
+	 * Deletes several SMSes at once.
+	 */
+	GSM_Error (*DeleteSMSBatch)	(GSM_StateMachine *s, GSM_SMSLocation *locations, int count);
 	/**
 	 * Sends SMS.
 	 */
@@ -1383,6 +1418,10 @@ typedef struct {
 	 * API action hook, executed before API call
 	 */
 	GSM_Error (*PreAPICall)(GSM_StateMachine *s);
+	/**
+	 * Reads battery, signal and network status at once.
+	 */
+	GSM_Error (*GetPhoneStatus)(GSM_StateMachine *s, GSM_PhoneStatus *status, gboolean battery, gboolean signal, gboolean network);
 } GSM_Phone_Functions;
 
 	extern GSM_Phone_Functions NAUTOPhone;
@@ -1456,6 +1495,10 @@ struct _GSM_User {
 	void * IncomingCBUserData;
 	void * IncomingUSSDUserData;
 	void * SendSMSStatusUserData;
+
+	GSM_FileWriteCallback FileWrite;
+	GSM_FileReadCallback FileRead;
+	void * FileStreamUserData;
 };
 
 /* --------------------------- Statemachine layer -------------------------- */
@@ -1494,6 +1537,16 @@ struct _GSM_StateMachine {
 	 */
 	volatile size_t MessagesCount;
 
+	/**
+	 * Response time statistics for each request type.
+	 */
+	GSM_ResponseTiming	Timing[ID_EachFrame + 1];
+	/**
+	 * Number of requests in row which timed out without any data
+	 * from the phone.
+	 */
+	int			SilentTimeouts;
+
 	GSM_Device		Device; /**< Device driver data and functions */
 	GSM_Protocol		Protocol; /**< Protocol driver data and functions */
 	GSM_Phone		Phone; /**< Phone driver data and functions */
@@ -1502,6 +1555,12 @@ struct _GSM_StateMachine {
 
 /* ------------------------ Other general definitions ---------------------- */
 
+/**
+ * Returns file descriptor of opened device which can be waited on for
+ * incoming data, -1 if device does not provide any.
+ */
+int GSM_GetDeviceDescriptor(GSM_StateMachine *s);
+
 /**
  * Tries to register all modules to find one matching current configuration.
  *
@@ -1521,7 +1580,9 @@ GSM_Error GSM_WaitForOnce		(GSM_StateMachine *s, unsigned const char *buffer,
  * \param buffer Data to write to phone.
  * \param length Length of data in buffer.
  * \param type Type of request (for protocols where it makes sense).
- * \param timeout How long to wait for reply.
+ * \param timeout How long to wait for reply, in seconds without any
+ * data from the phone. Shorter timeout derived from response times is
+ * used for all but last attempt, see \ref GSM_Timing_Timeout.
  * \param request ID of request
  *
  * \return Error code, ERR_NONE on sucecss.
@@ -0,0 +1,349 @@
+/**
+ * \file gsmtiming.c
+ *
+ * Response time statistics and adaptive timeouts.
+ *
+ * For every request type we measure the longest period without data
+ * from the phone while waiting for reply, as that is what timeouts
+ * limit. Timeouts are derived from moving average and deviation
+ * (similar to TCP retransmission timeout) and from percentile estimated
+ * from histogram with logarithmic buckets.
+ */
+#include <gammu-config.h>
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "gsmtiming.h"
+
+typedef struct {
+	GSM_Phone_RequestID Request;
+	const char *Name;
+} GSM_RequestName;
+
+static const GSM_RequestName AllRequestNames[] = {
+	{ID_None, "None"},
+	{ID_GetModel, "GetModel"},
+	{ID_GetFirmware, "GetFirmware"},
+	{ID_EnableSecurity, "EnableSecurity"},
+	{ID_OpenFile, "OpenFile"},
+	{ID_CloseFile, "CloseFile"},
+	{ID_GetIMEI, "GetIMEI"},
+	{ID_GetDateTime, "GetDateTime"},
+	{ID_GetAlarm, "GetAlarm"},
+	{ID_GetMemory, "GetMemory"},
+	{ID_GetMemoryStatus, "GetMemoryStatus"},
+	{ID_GetSMSC, "GetSMSC"},
+	{ID_GetSMSMessage, "GetSMSMessage"},
+	{ID_EnableEcho, "EnableEcho"},
+	{ID_EnableErrorInfo, "EnableErrorInfo"},
+	{ID_SetOBEX, "SetOBEX"},
+	{ID_SetUSSD, "SetUSSD"},
+	{ID_GetUSSD, "GetUSSD"},
+	{ID_GetNote, "GetNote"},
+	{ID_SetNote, "SetNote"},
+	{ID_GetSignalQuality, "GetSignalQuality"},
+	{ID_GetBatteryCharge, "GetBatteryCharge"},
+	{ID_GetSMSFolders, "GetSMSFolders"},
+	{ID_GetSMSFolderStatus, "GetSMSFolderStatus"},
+	{ID_GetSMSStatus, "GetSMSStatus"},
+	{ID_AddSMSFolder, "AddSMSFolder"},
+	{ID_ConfigureNetworkInfo, "ConfigureNetworkInfo"},
+	{ID_GetNetworkInfo, "GetNetworkInfo"},
+	{ID_GetNetworkCode, "GetNetworkCode"},
+	{ID_GetNetworkName, "GetNetworkName"},
+	{ID_GetRingtone, "GetRingtone"},
+	{ID_DialVoice, "DialVoice"},
+	{ID_GetCalendarNotesInfo, "GetCalendarNotesInfo"},
+	{ID_GetCalendarNote, "GetCalendarNote"},
+	{ID_GetSecurityCode, "GetSecurityCode"},
+	{ID_GetWAPBookmark, "GetWAPBookmark"},
+	{ID_GetBitmap, "GetBitmap"},
+	{ID_GetCRC, "GetCRC"},
+	{ID_SetAttrib, "SetAttrib"},
+	{ID_SaveSMSMessage, "SaveSMSMessage"},
+	{ID_CancelCall, "CancelCall"},
+	{ID_SetDateTime, "SetDateTime"},
+	{ID_SetAlarm, "SetAlarm"},
+	{ID_DisableConnectFunc, "DisableConnectFunc"},
+	{ID_EnableConnectFunc, "EnableConnectFunc"},
+	{ID_AnswerCall, "AnswerCall"},
+	{ID_SetBitmap, "SetBitmap"},
+	{ID_SetRingtone, "SetRingtone"},
+	{ID_DeleteSMSMessage, "DeleteSMSMessage"},
+	{ID_DeleteCalendarNote, "DeleteCalendarNote"},
+	{ID_SetPath, "SetPath"},
+	{ID_SetSMSC, "SetSMSC"},
+	{ID_SetProfile, "SetProfile"},
+	{ID_SetMemory, "SetMemory"},
+	{ID_DeleteMemory, "DeleteMemory"},
+	{ID_SetCalendarNote, "SetCalendarNote"},
+	{ID_AddCalendarNote, "AddCalendarNote"},
+	{ID_SetIncomingSMS, "SetIncomingSMS"},
+	{ID_SetIncomingCB, "SetIncomingCB"},
+	{ID_SetIncomingCall, "SetIncomingCall"},
+	{ID_GetCNMIMode, "GetCNMIMode"},
+	{ID_GetCalendarNotePos, "GetCalendarNotePos"},
+	{ID_Initialise, "Initialise"},
+	{ID_Terminate, "Terminate"},
+	{ID_GetConnectSet, "GetConnectSet"},
+	{ID_SetWAPBookmark, "SetWAPBookmark"},
+	{ID_GetLocale, "GetLocale"},
+	{ID_SetLocale, "SetLocale"},
+	{ID_GetCalendarSettings, "GetCalendarSettings"},
+	{ID_SetCalendarSettings, "SetCalendarSettings"},
+	{ID_GetGPRSPoint, "GetGPRSPoint"},
+	{ID_GetGPRSState, "GetGPRSState"},
+	{ID_SetGPRSPoint, "SetGPRSPoint"},
+	{ID_EnableGPRSPoint, "EnableGPRSPoint"},
+	{ID_DeleteWAPBookmark, "DeleteWAPBookmark"},
+	{ID_Netmonitor, "Netmonitor"},
+	{ID_HoldCall, "HoldCall"},
+	{ID_UnholdCall, "UnholdCall"},
+	{ID_ConferenceCall, "ConferenceCall"},
+	{ID_SplitCall, "SplitCall"},
+	{ID_TransferCall, "TransferCall"},
+	{ID_SwitchCall, "SwitchCall"},
+	{ID_GetManufactureMonth, "GetManufactureMonth"},
+	{ID_GetProductCode, "GetProductCode"},
+	{ID_GetOriginalIMEI, "GetOriginalIMEI"},
+	{ID_GetHardware, "GetHardware"},
+	{ID_GetPPM, "GetPPM"},
+	{ID_GetSMSMode, "GetSMSMode"},
+	{ID_GetSMSMemories, "GetSMSMemories"},
+	{ID_GetManufacturer, "GetManufacturer"},
+	{ID_SetMemoryType, "SetMemoryType"},
+	{ID_GetMemoryCharset, "GetMemoryCharset"},
+	{ID_SetMemoryCharset, "SetMemoryCharset"},
+	{ID_SetSMSParameters, "SetSMSParameters"},
+	{ID_GetFMStation, "GetFMStation"},
+	{ID_SetFMStation, "SetFMStation"},
+	{ID_GetLanguage, "GetLanguage"},
+	{ID_SetFastSMSSending, "SetFastSMSSending"},
+	{ID_Reset, "Reset"},
+	{ID_GetToDoInfo, "GetToDoInfo"},
+	{ID_GetToDo, "GetToDo"},
+	{ID_PressKey, "PressKey"},
+	{ID_DeleteAllToDo, "DeleteAllToDo"},
+	{ID_SetLight, "SetLight"},
+	{ID_Divert, "Divert"},
+	{ID_SetDivert, "SetDivert"},
+	{ID_SetToDo, "SetToDo"},
+	{ID_AddToDo, "AddToDo"},
+	{ID_PlayTone, "PlayTone"},
+	{ID_GetChatSettings, "GetChatSettings"},
+	{ID_GetSyncMLSettings, "GetSyncMLSettings"},
+	{ID_GetSyncMLName, "GetSyncMLName"},
+	{ID_GetSecurityStatus, "GetSecurityStatus"},
+	{ID_EnterSecurityCode, "EnterSecurityCode"},
+	{ID_GetProfile, "GetProfile"},
+	{ID_GetRingtonesInfo, "GetRingtonesInfo"},
+	{ID_MakeAuthentication, "MakeAuthentication"},
+	{ID_GetSpeedDial, "GetSpeedDial"},
+	{ID_ResetPhoneSettings, "ResetPhoneSettings"},
+	{ID_SendDTMF, "SendDTMF"},
+	{ID_GetDisplayStatus, "GetDisplayStatus"},
+	{ID_SetAutoNetworkLogin, "SetAutoNetworkLogin"},
+	{ID_SetConnectSet, "SetConnectSet"},
+	{ID_GetSIMIMSI, "GetSIMIMSI"},
+	{ID_GetFileInfo, "GetFileInfo"},
+	{ID_FileSystemStatus, "FileSystemStatus"},
+	{ID_GetFile, "GetFile"},
+	{ID_AddFile, "AddFile"},
+	{ID_AddFolder, "AddFolder"},
+	{ID_DeleteFolder, "DeleteFolder"},
+	{ID_DeleteFile, "DeleteFile"},
+	{ID_ModeSwitch, "ModeSwitch"},
+	{ID_GetProtocol, "GetProtocol"},
+	{ID_Screenshot, "Screenshot"},
+	{ID_GetScreenSize, "GetScreenSize"},
+	{ID_SetFlowControl, "SetFlowControl"},
+	{ID_AlcatelConnect, "AlcatelConnect"},
+	{ID_AlcatelProtocol, "AlcatelProtocol"},
+	{ID_AlcatelAttach, "AlcatelAttach"},
+	{ID_AlcatelDetach, "AlcatelDetach"},
+	{ID_AlcatelCommit, "AlcatelCommit"},
+	{ID_AlcatelCommit2, "AlcatelCommit2"},
+	{ID_AlcatelEnd, "AlcatelEnd"},
+	{ID_AlcatelClose, "AlcatelClose"},
+	{ID_AlcatelStart, "AlcatelStart"},
+	{ID_AlcatelSelect1, "AlcatelSelect1"},
+	{ID_AlcatelSelect2, "AlcatelSelect2"},
+	{ID_AlcatelSelect3, "AlcatelSelect3"},
+	{ID_AlcatelBegin1, "AlcatelBegin1"},
+	{ID_AlcatelBegin2, "AlcatelBegin2"},
+	{ID_AlcatelGetIds1, "AlcatelGetIds1"},
+	{ID_AlcatelGetIds2, "AlcatelGetIds2"},
+	{ID_AlcatelGetCategories1, "AlcatelGetCategories1"},
+	{ID_AlcatelGetCategories2, "AlcatelGetCategories2"},
+	{ID_AlcatelGetCategoryText1, "AlcatelGetCategoryText1"},
+	{ID_AlcatelGetCategoryText2, "AlcatelGetCategoryText2"},
+	{ID_AlcatelAddCategoryText1, "AlcatelAddCategoryText1"},
+	{ID_AlcatelAddCategoryText2, "AlcatelAddCategoryText2"},
+	{ID_AlcatelGetFields1, "AlcatelGetFields1"},
+	{ID_AlcatelGetFields2, "AlcatelGetFields2"},
+	{ID_AlcatelGetFieldValue1, "AlcatelGetFieldValue1"},
+	{ID_AlcatelGetFieldValue2, "AlcatelGetFieldValue2"},
+	{ID_AlcatelDeleteItem1, "AlcatelDeleteItem1"},
+	{ID_AlcatelDeleteItem2, "AlcatelDeleteItem2"},
+	{ID_AlcatelDeleteField, "AlcatelDeleteField"},
+	{ID_AlcatelCreateField, "AlcatelCreateField"},
+	{ID_AlcatelUpdateField, "AlcatelUpdateField"},
+	{ID_SetPower, "SetPower"},
+	{ID_CompoundCommand, "CompoundCommand"},
+	{ID_IncomingFrame, "IncomingFrame"},
+	{ID_CheckCHUP, "CheckCHUP"},
+	{ID_CheckCMGD, "CheckCMGD"},
+	{ID_User1, "User1"},
+	{ID_User2, "User2"},
+	{ID_User3, "User3"},
+	{ID_User4, "User4"},
+	{ID_User5, "User5"},
+	{ID_User6, "User6"},
+	{ID_User7, "User7"},
+	{ID_User8, "User8"},
+	{ID_User9, "User9"},
+	{ID_User10, "User10"},
+	{ID_All, "All"},
+	{ID_EachFrame, "EachFrame"},
+	{0, NULL}
+};
+
+const char *GSM_RequestIDToString(GSM_Phone_RequestID Request)
+{
+	const GSM_RequestName *current;
+
+	for (current = AllRequestNames; current->Name != NULL; current++) {
+		if (current->Request == Request) {
+			return current->Name;
+		}
+	}
+	return NULL;
+}
+
+long long GSM_GetMonotonicTime(void)
+{
+#ifdef WIN32
+	return (long long)GetTickCount64();
+#elif defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+	}
+	return (long long)time(NULL) * 1000;
+#else
+	return (long long)time(NULL) * 1000;
+#endif
+}
+
+void GSM_Timing_Reset(GSM_ResponseTiming *Timing)
+{
+	memset(Timing, 0, sizeof(GSM_ResponseTiming));
+}
+
+static int GSM_Timing_Bucket(int Duration)
+{
+	int bucket = 0;
+
+	while (Duration > 0 && bucket < GSM_TIMING_BUCKETS - 1) {
+		Duration >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+void GSM_Timing_Record(GSM_ResponseTiming *Timing, int Duration)
+{
+	int i;
+
+	if (Duration < 0) {
+		Duration = 0;
+	}
+
+	/* Same weights as TCP uses for round trip time */
+	if (Timing->Count == 0) {
+		Timing->Average = Duration;
+		Timing->Deviation = Duration / 2.0;
+	} else {
+		Timing->Deviation = 0.75 * Timing->Deviation + 0.25 * fabs(Duration - Timing->Average);
+		Timing->Average = 0.875 * Timing->Average + 0.125 * Duration;
+	}
+	Timing->Count++;
+	if (Duration > Timing->Maximum) {
+		Timing->Maximum = Duration;
+	}
+
+	/* Age histogram to follow changes in phone behaviour */
+	if (Timing->HistogramCount >= GSM_TIMING_WINDOW) {
+		Timing->HistogramCount = 0;
+		for (i = 0; i < GSM_TIMING_BUCKETS; i++) {
+			Timing->Histogram[i] /= 2;
+			Timing->HistogramCount += Timing->Histogram[i];
+		}
+	}
+	Timing->Histogram[GSM_Timing_Bucket(Duration)]++;
+	Timing->HistogramCount++;
+}
+
+void GSM_Timing_RecordTimeout(GSM_ResponseTiming *Timing)
+{
+	Timing->Timeouts++;
+}
+
+int GSM_Timing_Percentile(const GSM_ResponseTiming *Timing, int Percent)
+{
+	int i, needed, seen = 0;
+
+	if (Timing->HistogramCount == 0) {
+		return 0;
+	}
+
+	/* Number of samples which have to be below returned value */
+	needed = (Timing->HistogramCount * Percent + 99) / 100;
+
+	for (i = 0; i < GSM_TIMING_BUCKETS - 1; i++) {
+		seen += Timing->Histogram[i];
+		if (seen >= needed) {
+			return (1 << i) - 1;
+		}
+	}
+	return Timing->Maximum;
+}
+
+int GSM_Timing_Timeout(const GSM_ResponseTiming *Timing, const GSM_Config *Config, int Limit)
+{
+	double expected;
+	int timeout;
+
+	if (Config->MaxTimeout > 0 && Config->MaxTimeout < Limit) {
+		Limit = Config->MaxTimeout;
+	}
+	if (!Config->AdaptiveTimeout || Timing->Count < GSM_TIMING_MIN_SAMPLES) {
+		return Limit;
+	}
+
+	/* Twice the worse of smoothed estimate and recent percentile */
+	expected = Timing->Average + 4 * Timing->Deviation;
+	if (expected < GSM_Timing_Percentile(Timing, 99)) {
+		expected = GSM_Timing_Percentile(Timing, 99);
+	}
+	timeout = (int)(2 * expected);
+
+	if (timeout < Config->MinTimeout) {
+		timeout = Config->MinTimeout;
+	}
+	if (timeout > Limit) {
+		timeout = Limit;
+	}
+	return timeout;
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
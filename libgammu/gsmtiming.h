@@ -0,0 +1,116 @@
+/**
+ * \file gsmtiming.h
+ *
+ * Response time statistics and adaptive timeouts.
+ */
+#ifndef __gsmtiming_h
+#define __gsmtiming_h
+
+#include <gammu-statemachine.h>
+#include <gammu-datetime.h>
+
+#include "gsmreply.h"
+
+/**
+ * Number of histogram buckets, bucket i > 0 holds response times from
+ * 2^(i-1) to 2^i - 1 milliseconds, last one holds all longer.
+ */
+#define GSM_TIMING_BUCKETS 17
+
+/**
+ * Number of samples in histogram after which it is aged, so that
+ * percentiles describe recent behaviour of the phone.
+ */
+#define GSM_TIMING_WINDOW 256
+
+/**
+ * Minimal number of replies before timeouts are derived from
+ * statistics.
+ */
+#define GSM_TIMING_MIN_SAMPLES 10
+
+/**
+ * Milliseconds corresponding to one unit of timeout used by phone
+ * drivers. Historically timeout counted reads from the device, each
+ * waiting for data until the next second.
+ */
+#define GSM_TIMEOUT_UNIT 1000
+
+/**
+ * Response time statistics for one request type.
+ */
+typedef struct {
+	/**
+	 * Number of received replies.
+	 */
+	int Count;
+	/**
+	 * Number of attempts which timed out.
+	 */
+	int Timeouts;
+	/**
+	 * Moving average of response time in milliseconds.
+	 */
+	double Average;
+	/**
+	 * Moving average of deviation in milliseconds.
+	 */
+	double Deviation;
+	/**
+	 * Longest response time in milliseconds.
+	 */
+	int Maximum;
+	/**
+	 * Histogram of recent response times.
+	 */
+	int Histogram[GSM_TIMING_BUCKETS];
+	/**
+	 * Number of samples in histogram.
+	 */
+	int HistogramCount;
+} GSM_ResponseTiming;
+
+/**
+ * Clears statistics.
+ */
+void GSM_Timing_Reset(GSM_ResponseTiming *Timing);
+
+/**
+ * Records reply received after given response time.
+ */
+void GSM_Timing_Record(GSM_ResponseTiming *Timing, int Duration);
+
+/**
+ * Records attempt which timed out.
+ */
+void GSM_Timing_RecordTimeout(GSM_ResponseTiming *Timing);
+
+/**
+ * Estimates percentile of recent response times in milliseconds. The
+ * estimate is upper bound of histogram bucket, so it does not
+ * underestimate.
+ */
+int GSM_Timing_Percentile(const GSM_ResponseTiming *Timing, int Percent);
+
+/**
+ * Derives timeout for first attempt of request from statistics.
+ *
+ * \param Timing Statistics for request type.
+ * \param Config Configuration with bounds for timeouts.
+ * \param Limit Timeout defined by phone driver in milliseconds, never
+ * exceeded.
+ *
+ * \return Timeout in milliseconds.
+ */
+int GSM_Timing_Timeout(const GSM_ResponseTiming *Timing, const GSM_Config *Config, int Limit);
+
+/**
+ * Returns name of request type, NULL if not known.
+ */
+const char *GSM_RequestIDToString(GSM_Phone_RequestID Request);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
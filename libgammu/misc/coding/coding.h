@@ -150,6 +150,13 @@ GSM_Error GSM_GetVCSLine(char **OutBuffer, char *Buffer, size_t *Pos, size_t Max
  */
 GSM_Error MyGetLine(char *Buffer, size_t *Pos, char *OutBuffer, size_t MaxLen, size_t MaxOutLen, gboolean MergeLines);
 
+/**
+ * Maximal length to pass to MyGetLine or GSM_GetVCSLine for NUL
+ * terminated buffers. Both stop on NUL, so there is no need to scan
+ * whole buffer for its length on every call.
+ */
+#define GSM_NUL_TERMINATED ((size_t)-1)
+
 char *EncodeSpecialChars(char *dest, const char *buffer);
 char *DecodeSpecialChars(char *dest, const char *buffer);
 
@@ -60,6 +60,16 @@ void SplitLines(const char *message, const size_t messagesize, GSM_CutLines *lin
  */
 const char *GetLineString(const char *message, GSM_CutLines *lines, int start);
 
+/**
+ * Returns pointer to start of line inside message, the line is not
+ * terminated.
+ *
+ * @param message Parsed message.
+ * @param lines Parsed lines information.
+ * @param start Which line we want.
+ */
+const char *GetLineStringPos(const char *message, const GSM_CutLines *lines, int start);
+
 /**
  * Returns line length.
  * @param message Parsed message.
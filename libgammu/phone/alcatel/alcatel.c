@@ -288,6 +288,63 @@ GSM_Error ALCATEL_ProtocolVersionReply	(GSM_Protocol_Message *msg, GSM_StateMach
 	}
 }
 
+/**
+ * Finds item in cache of given type.
+ */
+static GSM_Alcatel_CachedItem *ALCATEL_FindCachedItem(GSM_Phone_ALCATELData *Priv, GSM_Alcatel_BinaryType type, int id)
+{
+	int			i;
+
+	for (i = 0; i < Priv->ItemCacheCount[type]; i++) {
+		if (Priv->ItemCache[type][i].Id == id) return &(Priv->ItemCache[type][i]);
+	}
+	return NULL;
+}
+
+static void ALCATEL_FreeCachedItem(GSM_Alcatel_CachedItem *item)
+{
+	int			i;
+
+	for (i = 0; i < item->FieldsCount; i++) {
+		free(item->Fields[i].String);
+	}
+	free(item->Fields);
+	item->Fields = NULL;
+	item->FieldsCount = 0;
+}
+
+/**
+ * Removes item from cache, used when it is being changed or deleted.
+ */
+static void ALCATEL_DropCachedItem(GSM_Phone_ALCATELData *Priv, GSM_Alcatel_BinaryType type, int id)
+{
+	GSM_Alcatel_CachedItem	*item;
+
+	item = ALCATEL_FindCachedItem(Priv, type, id);
+	if (item == NULL) return;
+
+	ALCATEL_FreeCachedItem(item);
+	Priv->ItemCacheCount[type]--;
+	*item = Priv->ItemCache[type][Priv->ItemCacheCount[type]];
+	Priv->CurrentItem = NULL;
+}
+
+/**
+ * Removes all items of given type from cache.
+ */
+static void ALCATEL_FreeItemCache(GSM_Phone_ALCATELData *Priv, GSM_Alcatel_BinaryType type)
+{
+	int			i;
+
+	for (i = 0; i < Priv->ItemCacheCount[type]; i++) {
+		ALCATEL_FreeCachedItem(&(Priv->ItemCache[type][i]));
+	}
+	free(Priv->ItemCache[type]);
+	Priv->ItemCache[type] = NULL;
+	Priv->ItemCacheCount[type] = 0;
+	Priv->CurrentItem = NULL;
+}
+
 /**
  * Switches phone to Alcatel binary protocol
  */
@@ -303,8 +360,12 @@ static GSM_Error ALCATEL_SetBinaryMode(GSM_StateMachine *s)
 	error=GSM_WaitFor (s, "AT+IFC=2,2\r", 11, 0x02, 4, ID_SetFlowControl);
 	if (error != ERR_NONE) return error;
 
-	error=GSM_WaitFor (s, "AT+CPROT=?\r", 11, 0x02, 4, ID_AlcatelProtocol);
-	if (error != ERR_NONE) return error;
+	/* Protocol version does not change, ask only on first switch */
+	if (!Priv->ProtocolKnown) {
+		error=GSM_WaitFor (s, "AT+CPROT=?\r", 11, 0x02, 4, ID_AlcatelProtocol);
+		if (error != ERR_NONE) return error;
+		Priv->ProtocolKnown = TRUE;
+	}
 
 	if (Priv->ProtocolVersion == V_1_0) {
 		error=GSM_WaitFor (s, "AT+CPROT=16,\"V1.0\",16\r", 22, 0x00, 4, ID_AlcatelConnect);
@@ -374,6 +435,9 @@ static GSM_Error ALCATEL_GoToBinaryState(GSM_StateMachine *s, GSM_Alcatel_Binary
 	error = ALCATEL_SetBinaryMode(s);
 	if (error != ERR_NONE) return error;
 
+	/* Cached copy of edited item will be outdated */
+	if (state == StateEdit && item != 0) ALCATEL_DropCachedItem(Priv, type, item);
+
 	/* Do we need to do anything? */
 	if ((state == Priv->BinaryState) && (type == Priv->BinaryType) && (item == Priv->BinaryItem)) return ERR_NONE;
 
@@ -561,6 +625,7 @@ static GSM_Error ALCATEL_Initialise(GSM_StateMachine *s)
 {
 	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
 	GSM_Error		error;
+	int			i;
 
 	Priv->Mode				= ModeAT;
 
@@ -575,7 +640,13 @@ static GSM_Error ALCATEL_Initialise(GSM_StateMachine *s)
 	Priv->CurrentFieldsItem			= 0;
 	Priv->CurrentFieldsType			= 0;
 	Priv->ProtocolVersion			= V_1_0;
+	Priv->ProtocolKnown			= FALSE;
 	Priv->CurrentFieldsItem			= -1;
+	Priv->CurrentItem			= NULL;
+	for (i = 0; i <= TypeToDo; i++) {
+		Priv->ItemCache[i]		= NULL;
+		Priv->ItemCacheCount[i]		= 0;
+	}
 
 	Priv->CurrentCategoriesCount		= 0;
 	Priv->CurrentCategoriesType		= 0;
@@ -600,7 +671,11 @@ static GSM_Error ALCATEL_Terminate(GSM_StateMachine *s)
 {
 	GSM_Error 		error;
 	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
+	int			i;
 
+	for (i = 0; i <= TypeToDo; i++) {
+		ALCATEL_FreeItemCache(Priv, i);
+	}
 	free(Priv->CalendarItems);
 	Priv->CalendarItems=NULL;
 	free(Priv->ContactsItems);
@@ -616,15 +691,11 @@ static GSM_Error ALCATEL_Terminate(GSM_StateMachine *s)
 }
 
 /**
- * Finds whether id is set in the phone
+ * Selects list of items of given type as current one.
  */
-static GSM_Error ALCATEL_IsIdAvailable(GSM_StateMachine *s, int id) {
-	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
-	int			i;
-
-	if (id > ALCATEL_MAX_LOCATION) return ERR_INVALIDLOCATION;
-
-	switch (Priv->BinaryType) {
+static void ALCATEL_SelectList(GSM_Phone_ALCATELData *Priv, GSM_Alcatel_BinaryType type)
+{
+	switch (type) {
 		case TypeCalendar:
 			Priv->CurrentList 	= &(Priv->CalendarItems);
 			Priv->CurrentCount 	= &(Priv->CalendarItemsCount);
@@ -638,6 +709,18 @@ static GSM_Error ALCATEL_IsIdAvailable(GSM_StateMachine *s, int id) {
 			Priv->CurrentCount 	= &(Priv->ToDoItemsCount);
 			break;
 	}
+}
+
+/**
+ * Finds whether id is set in the phone
+ */
+static GSM_Error ALCATEL_IsIdAvailable(GSM_StateMachine *s, GSM_Alcatel_BinaryType type, int id) {
+	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
+	int			i;
+
+	if (id > ALCATEL_MAX_LOCATION) return ERR_INVALIDLOCATION;
+
+	ALCATEL_SelectList(Priv, type);
 
 	for (i=0; i<*Priv->CurrentCount; i++) {
 		if ((*Priv->CurrentList)[i] == id) return ERR_NONE;
@@ -649,25 +732,12 @@ static GSM_Error ALCATEL_IsIdAvailable(GSM_StateMachine *s, int id) {
 /**
  * Finds next id that is available in the phone
  */
-static GSM_Error ALCATEL_GetNextId(GSM_StateMachine *s, int *id) {
+static GSM_Error ALCATEL_GetNextId(GSM_StateMachine *s, GSM_Alcatel_BinaryType type, int *id) {
 	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
 	int 			i = 0;
 	int			next = ALCATEL_MAX_LOCATION;
 
-	switch (Priv->BinaryType) {
-		case TypeCalendar:
-			Priv->CurrentList 	= &(Priv->CalendarItems);
-			Priv->CurrentCount 	= &(Priv->CalendarItemsCount);
-			break;
-		case TypeContacts:
-			Priv->CurrentList 	= &(Priv->ContactsItems);
-			Priv->CurrentCount 	= &(Priv->ContactsItemsCount);
-			break;
-		case TypeToDo:
-			Priv->CurrentList 	= &(Priv->ToDoItems);
-			Priv->CurrentCount 	= &(Priv->ToDoItemsCount);
-			break;
-	}
+	ALCATEL_SelectList(Priv, type);
 
 	for (i=0; i<*Priv->CurrentCount; i++) {
 		if (((*Priv->CurrentList)[i] > *id) && ((*Priv->CurrentList)[i] < next )) {
@@ -744,6 +814,8 @@ static GSM_Error ALCATEL_GetAvailableIds(GSM_StateMachine *s, gboolean refresh)
 		if (!refresh) {
 			return ERR_NONE;
 		}
+		/* Items might have been changed as well */
+		ALCATEL_FreeItemCache(Priv, Priv->BinaryType);
 		free(*Priv->CurrentList);
 		*Priv->CurrentList = NULL;
 	}
@@ -1021,6 +1093,146 @@ static GSM_Error ALCATEL_GetFieldValue(GSM_StateMachine *s, int id, int field)
 	return ERR_NONE;
 }
 
+/**
+ * Reads all fields of item in current session and stores them in cache.
+ */
+static GSM_Error ALCATEL_CacheItem(GSM_StateMachine *s, int id)
+{
+	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
+	GSM_Alcatel_CachedItem	item, *items;
+	GSM_Alcatel_CachedField	*field;
+	GSM_Error		error;
+	size_t			len;
+	int			i;
+
+	if ((error = ALCATEL_GetFields(s, id))!= ERR_NONE) return error;
+
+	item.Id = id;
+	item.FieldsCount = 0;
+	item.Fields = (GSM_Alcatel_CachedField *)calloc(Priv->CurrentFieldsCount + 1, sizeof(GSM_Alcatel_CachedField));
+	if (item.Fields == NULL) return ERR_MOREMEMORY;
+
+	for (i = 0; i < Priv->CurrentFieldsCount; i++) {
+		error = ALCATEL_GetFieldValue(s, id, Priv->CurrentFields[i]);
+		if (error != ERR_NONE) {
+			ALCATEL_FreeCachedItem(&item);
+			return error;
+		}
+		field = &(item.Fields[item.FieldsCount++]);
+		field->Field	= Priv->CurrentFields[i];
+		field->Type	= Priv->ReturnType;
+		field->DateTime	= Priv->ReturnDateTime;
+		field->Int	= Priv->ReturnInt;
+		if (Priv->ReturnType == Alcatel_string || Priv->ReturnType == Alcatel_phone) {
+			len = (UnicodeLength(Priv->ReturnString) + 1) * 2;
+			field->String = (unsigned char *)malloc(len);
+			if (field->String == NULL) {
+				ALCATEL_FreeCachedItem(&item);
+				return ERR_MOREMEMORY;
+			}
+			memcpy(field->String, Priv->ReturnString, len);
+		}
+	}
+
+	items = (GSM_Alcatel_CachedItem *)realloc(Priv->ItemCache[Priv->BinaryType],
+			(Priv->ItemCacheCount[Priv->BinaryType] + 1) * sizeof(GSM_Alcatel_CachedItem));
+	if (items == NULL) {
+		ALCATEL_FreeCachedItem(&item);
+		return ERR_MOREMEMORY;
+	}
+	items[Priv->ItemCacheCount[Priv->BinaryType]++] = item;
+	Priv->ItemCache[Priv->BinaryType] = items;
+	/* Array might have been moved */
+	Priv->CurrentItem = NULL;
+
+	return ERR_NONE;
+}
+
+/**
+ * Reads all items of given type in one binary session, so that
+ * following reads do not need to switch modes.
+ */
+static GSM_Error ALCATEL_CacheItems(GSM_StateMachine *s, GSM_Alcatel_BinaryType type)
+{
+	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
+	GSM_Error		error;
+	int			i;
+
+	ALCATEL_SelectList(Priv, type);
+	if (*Priv->CurrentList != NULL && Priv->ItemCacheCount[type] == *Priv->CurrentCount) return ERR_NONE;
+
+	if ((error = ALCATEL_GoToBinaryState(s, StateSession, type, 0))!= ERR_NONE) return error;
+	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
+
+	smprintf(s,"Reading all %d items\n", *Priv->CurrentCount);
+	for (i = 0; i < *Priv->CurrentCount; i++) {
+		if (ALCATEL_FindCachedItem(Priv, type, (*Priv->CurrentList)[i]) != NULL) continue;
+		if ((error = ALCATEL_CacheItem(s, (*Priv->CurrentList)[i]))!= ERR_NONE) return error;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * Makes item fields available in @ref CurrentFields and their values
+ * through @ref ALCATEL_GetCachedValue. Items which are already cached
+ * or known to be missing are handled without talking to phone.
+ */
+static GSM_Error ALCATEL_ReadItem(GSM_StateMachine *s, GSM_Alcatel_BinaryType type, int id)
+{
+	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
+	GSM_Alcatel_CachedItem	*item;
+	GSM_Error		error;
+	int			i;
+
+	item = ALCATEL_FindCachedItem(Priv, type, id);
+	if (item == NULL) {
+		ALCATEL_SelectList(Priv, type);
+		if (*Priv->CurrentList != NULL) {
+			if ((error = ALCATEL_IsIdAvailable(s, type, id))!= ERR_NONE) return error;
+		}
+		if ((error = ALCATEL_GoToBinaryState(s, StateSession, type, 0))!= ERR_NONE) return error;
+		if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
+		if ((error = ALCATEL_IsIdAvailable(s, type, id))!= ERR_NONE) return error;
+		if ((error = ALCATEL_CacheItem(s, id))!= ERR_NONE) return error;
+		item = ALCATEL_FindCachedItem(Priv, type, id);
+		if (item == NULL) return ERR_UNKNOWN;
+	}
+
+	for (i = 0; i < item->FieldsCount; i++) {
+		Priv->CurrentFields[i] = item->Fields[i].Field;
+	}
+	Priv->CurrentFields[item->FieldsCount] = 0;
+	Priv->CurrentFieldsCount = item->FieldsCount;
+	Priv->CurrentFieldsItem = id;
+	Priv->CurrentFieldsType = type;
+	Priv->CurrentItem = item;
+
+	return ERR_NONE;
+}
+
+/**
+ * Loads value of field of item read by @ref ALCATEL_ReadItem, index
+ * matches @ref CurrentFields.
+ */
+static GSM_Error ALCATEL_GetCachedValue(GSM_StateMachine *s, int i)
+{
+	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
+	GSM_Alcatel_CachedField	*field;
+
+	if (Priv->CurrentItem == NULL || i >= Priv->CurrentItem->FieldsCount) return ERR_UNKNOWN;
+
+	field = &(Priv->CurrentItem->Fields[i]);
+	Priv->ReturnType	= field->Type;
+	Priv->ReturnDateTime	= field->DateTime;
+	Priv->ReturnInt		= field->Int;
+	if (field->String != NULL) {
+		CopyUnicodeString(Priv->ReturnString, field->String);
+	}
+
+	return ERR_NONE;
+}
+
 static GSM_Error ALCATEL_ReplyGetCategories(GSM_Protocol_Message *msg, GSM_StateMachine *s)
 {
 	GSM_Phone_ALCATELData 	*Priv = &s->Phone.Data.Priv.ALCATEL;
@@ -1241,6 +1453,8 @@ static GSM_Error ALCATEL_DeleteItem(GSM_StateMachine *s, int id) {
 
 	smprintf(s,"Deleting item (%08x)\n", id);
 
+	ALCATEL_DropCachedItem(Priv, Priv->BinaryType, id);
+
 	switch (Priv->BinaryType) {
 		case TypeCalendar:
 			buffer[2] = ALCATEL_SYNC_TYPE_CALENDAR;
@@ -1480,18 +1694,15 @@ static GSM_Error ALCATEL_GetMemory(GSM_StateMachine *s, GSM_MemoryEntry *entry)
 	int			j = 0;
 
 	if (entry->MemoryType == MEM_ME) {
-		if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeContacts, 0))!= ERR_NONE) return error;
-		if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-		if ((error = ALCATEL_IsIdAvailable(s, entry->Location))!= ERR_NONE) {
+		if ((error = ALCATEL_ReadItem(s, TypeContacts, entry->Location))!= ERR_NONE) {
 			entry->EntriesNum = 0;
 			return error;
 		}
-		if ((error = ALCATEL_GetFields(s, entry->Location))!= ERR_NONE) return error;
 
 		entry->EntriesNum = Priv->CurrentFieldsCount;
 
 		for (i=0; i<Priv->CurrentFieldsCount; i++) {
-			if ((error = ALCATEL_GetFieldValue(s, entry->Location, Priv->CurrentFields[i]))!= ERR_NONE) return error;
+			if ((error = ALCATEL_GetCachedValue(s, i))!= ERR_NONE) return error;
 			entry->Entries[i].VoiceTag   = 0;
 			entry->Entries[i].SMSList[0] = 0;
 			switch (Priv->CurrentFields[i]) {
@@ -1823,12 +2034,11 @@ static GSM_Error ALCATEL_GetNextMemory(GSM_StateMachine *s, GSM_MemoryEntry *ent
 	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
 
 	if (entry->MemoryType == MEM_ME) {
-		if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeContacts, 0))!= ERR_NONE) return error;
-		if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
+		if ((error = ALCATEL_CacheItems(s, TypeContacts))!= ERR_NONE) return error;
 		if (Priv->ContactsItemsCount == 0) return ERR_EMPTY;
 
 		if (start) entry->Location = 0;
-		if ((error = ALCATEL_GetNextId(s, &(entry->Location))) != ERR_NONE) return error;
+		if ((error = ALCATEL_GetNextId(s, TypeContacts, &(entry->Location))) != ERR_NONE) return error;
 
 		return ALCATEL_GetMemory(s, entry);
 	} else {
@@ -2007,7 +2217,7 @@ static GSM_Error ALCATEL_SetMemory(GSM_StateMachine *s, GSM_MemoryEntry *entry)
 		if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeContacts, 0))!= ERR_NONE) return error;
 		/* Save modified entry */
 		if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-		if ((error = ALCATEL_IsIdAvailable(s, entry->Location))!= ERR_NONE) {
+		if ((error = ALCATEL_IsIdAvailable(s, TypeContacts, entry->Location))!= ERR_NONE) {
 			/* Entry doesn't exist, we will create new one */
 			return ALCATEL_AddMemory(s, entry);
 		}
@@ -2196,7 +2406,7 @@ static GSM_Error ALCATEL_DeleteMemory(GSM_StateMachine *s, GSM_MemoryEntry *entr
 	if (entry->MemoryType == MEM_ME) {
 		if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeContacts, 0))!= ERR_NONE) return error;
 		if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-		if ((error = ALCATEL_IsIdAvailable(s, entry->Location))!= ERR_NONE) {
+		if ((error = ALCATEL_IsIdAvailable(s, TypeContacts, entry->Location))!= ERR_NONE) {
 			/* Entry was empty => no error */
 			return ERR_NONE;
 		}
@@ -2504,18 +2714,15 @@ static GSM_Error ALCATEL_GetCalendar(GSM_StateMachine *s, GSM_CalendarEntry *Not
 	int			i;
 	int			j=0;
 
-	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeCalendar, 0))!= ERR_NONE) return error;
-	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-	if ((error = ALCATEL_IsIdAvailable(s, Note->Location))!= ERR_NONE) {
+	if ((error = ALCATEL_ReadItem(s, TypeCalendar, Note->Location))!= ERR_NONE) {
 		Note->EntriesNum = 0;
 		return error;
 	}
-	if ((error = ALCATEL_GetFields(s, Note->Location))!= ERR_NONE) return error;
 
 	Note->EntriesNum = Priv->CurrentFieldsCount;
 
 	for (i=0; i < Priv->CurrentFieldsCount; i++) {
-		if ((error = ALCATEL_GetFieldValue(s, Note->Location, Priv->CurrentFields[i]))!= ERR_NONE) return error;
+		if ((error = ALCATEL_GetCachedValue(s, i))!= ERR_NONE) return error;
 		switch (Priv->CurrentFields[i]) {
 			case 0:
 				if (Priv->ReturnType != Alcatel_date) {
@@ -2891,12 +3098,11 @@ static GSM_Error ALCATEL_GetNextCalendar(GSM_StateMachine *s, GSM_CalendarEntry
 	GSM_Error 		error;
 	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
 
-	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeCalendar, 0))!= ERR_NONE) return error;
-	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
+	if ((error = ALCATEL_CacheItems(s, TypeCalendar))!= ERR_NONE) return error;
 	if (Priv->CalendarItemsCount == 0) return ERR_EMPTY;
 
 	if (start) Note->Location = 0;
-	if ((error = ALCATEL_GetNextId(s, &(Note->Location))) != ERR_NONE) return error;
+	if ((error = ALCATEL_GetNextId(s, TypeCalendar, &(Note->Location))) != ERR_NONE) return error;
 
 	return ALCATEL_GetCalendar(s, Note);
 }
@@ -2909,7 +3115,7 @@ static GSM_Error ALCATEL_DeleteCalendar(GSM_StateMachine *s, GSM_CalendarEntry *
 	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeCalendar, 0))!= ERR_NONE) return error;
 	/* Delete Calendar */
 	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-	if ((error = ALCATEL_IsIdAvailable(s, Note->Location))!= ERR_NONE) {
+	if ((error = ALCATEL_IsIdAvailable(s, TypeCalendar, Note->Location))!= ERR_NONE) {
 		/* Entry was empty => no error */
 		return ERR_NONE;
 	}
@@ -3065,7 +3271,7 @@ static GSM_Error ALCATEL_SetCalendar(GSM_StateMachine *s, GSM_CalendarEntry *Not
 
 	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeCalendar, 0))!= ERR_NONE) return error;
 	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-	if ((error = ALCATEL_IsIdAvailable(s, Note->Location))!= ERR_NONE) {
+	if ((error = ALCATEL_IsIdAvailable(s, TypeCalendar, Note->Location))!= ERR_NONE) {
 		/* Entry doesn't exist, we will create new one */
 		return ALCATEL_AddCalendar(s, Note);
 	}
@@ -3379,20 +3585,17 @@ static GSM_Error ALCATEL_GetToDo (GSM_StateMachine *s, GSM_ToDoEntry *ToDo)
 	int			i;
 	int			j=0;
 
-	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeToDo, 0))!= ERR_NONE) return error;
-	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-	if ((error = ALCATEL_IsIdAvailable(s, ToDo->Location))!= ERR_NONE) {
+	if ((error = ALCATEL_ReadItem(s, TypeToDo, ToDo->Location))!= ERR_NONE) {
 		ToDo->EntriesNum = 0;
 		return error;
 	}
-	if ((error = ALCATEL_GetFields(s, ToDo->Location))!= ERR_NONE) return error;
 
 	ToDo->EntriesNum = Priv->CurrentFieldsCount;
 	ToDo->Priority = GSM_Priority_None;
 	ToDo->Type = GSM_CAL_MEMO;
 
 	for (i=0; i < Priv->CurrentFieldsCount; i++) {
-		if ((error = ALCATEL_GetFieldValue(s, ToDo->Location, Priv->CurrentFields[i]))!= ERR_NONE) return error;
+		if ((error = ALCATEL_GetCachedValue(s, i))!= ERR_NONE) return error;
 		switch (Priv->CurrentFields[i]) {
 			case 0:
 				if (Priv->ReturnType != Alcatel_date) {
@@ -3628,12 +3831,11 @@ static GSM_Error ALCATEL_GetNextToDo(GSM_StateMachine *s, GSM_ToDoEntry *ToDo, g
 	GSM_Error 		error;
 	GSM_Phone_ALCATELData	*Priv = &s->Phone.Data.Priv.ALCATEL;
 
-	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeToDo, 0))!= ERR_NONE) return error;
-	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
+	if ((error = ALCATEL_CacheItems(s, TypeToDo))!= ERR_NONE) return error;
 	if (Priv->ToDoItemsCount == 0) return ERR_EMPTY;
 
 	if (start) ToDo->Location = 0;
-	if ((error = ALCATEL_GetNextId(s, &(ToDo->Location))) != ERR_NONE) return error;
+	if ((error = ALCATEL_GetNextId(s, TypeToDo, &(ToDo->Location))) != ERR_NONE) return error;
 
 	return ALCATEL_GetToDo(s, ToDo);
 }
@@ -3760,7 +3962,7 @@ static GSM_Error ALCATEL_SetToDo (GSM_StateMachine *s, GSM_ToDoEntry *ToDo)
 	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeToDo, 0))!= ERR_NONE) return error;
 	/* Save modified ToDo */
 	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-	if ((error = ALCATEL_IsIdAvailable(s, ToDo->Location))!= ERR_NONE) {
+	if ((error = ALCATEL_IsIdAvailable(s, TypeToDo, ToDo->Location))!= ERR_NONE) {
 		/* Entry doesn't exist, we will create new one */
 		return ALCATEL_AddToDo(s, ToDo);
 	}
@@ -3870,7 +4072,7 @@ static GSM_Error ALCATEL_DeleteToDo (GSM_StateMachine *s, GSM_ToDoEntry *ToDo)
 	if ((error = ALCATEL_GoToBinaryState(s, StateSession, TypeToDo, 0))!= ERR_NONE) return error;
 	/* Delete ToDo */
 	if ((error = ALCATEL_GetAvailableIds(s, FALSE))!= ERR_NONE) return error;
-	if ((error = ALCATEL_IsIdAvailable(s, ToDo->Location))!= ERR_NONE) {
+	if ((error = ALCATEL_IsIdAvailable(s, TypeToDo, ToDo->Location))!= ERR_NONE) {
 		/* Entry was empty => no error */
 		return ERR_NONE;
 	}
@@ -4117,6 +4319,7 @@ GSM_Phone_Functions ALCATELPhone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	ALCATEL_AddSMS,
 	ALCATEL_DeleteSMS,
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	ALCATEL_SendSMS,
 	ALCATEL_SendSavedSMS,
 	ALCATEL_SetFastSMSSending,
@@ -4205,7 +4408,8 @@ GSM_Phone_Functions ALCATELPhone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
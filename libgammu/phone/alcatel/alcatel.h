@@ -144,6 +144,50 @@ typedef enum {
 	Alcatel_byte
 } GSM_Alcatel_FieldType;
 
+/**
+ * Cached value of one item field.
+ */
+typedef struct {
+	/**
+	 * Field number.
+	 */
+	int			Field;
+	/**
+	 * Type of field value.
+	 */
+	GSM_Alcatel_FieldType	Type;
+	/**
+	 * Value, if it can be saved in DateTime.
+	 */
+	GSM_DateTime		DateTime;
+	/**
+	 * Value, if it can be saved in int.
+	 */
+	unsigned int		Int;
+	/**
+	 * Value, if it can be saved in string, NULL otherwise.
+	 */
+	unsigned char		*String;
+} GSM_Alcatel_CachedField;
+
+/**
+ * Cached item with all its fields.
+ */
+typedef struct {
+	/**
+	 * Location of item.
+	 */
+	int			Id;
+	/**
+	 * Count of fields in @ref Fields.
+	 */
+	int			FieldsCount;
+	/**
+	 * Field values.
+	 */
+	GSM_Alcatel_CachedField	*Fields;
+} GSM_Alcatel_CachedItem;
+
 /**
  * Return value for GetMemoryStatus. There is no way ho to determine free
  * memory so we have to return some fixed value.
@@ -188,6 +232,11 @@ typedef struct {
 	 * Protocol version being used.
 	 */
 	GSM_Alcatel_ProtocolVersion	ProtocolVersion;
+	/**
+	 * Whether @ref ProtocolVersion was already detected, so that it
+	 * does not have to be asked on each switch to binary mode.
+	 */
+	gboolean			ProtocolKnown;
 
 	/*****************/
 	/* Return values */
@@ -272,6 +321,21 @@ typedef struct {
 	 * and @ref CurrentFields) item.
 	 */
 	GSM_Alcatel_BinaryType	CurrentFieldsType;
+	/**
+	 * Items read from phone for each type, indexed by @ref
+	 * GSM_Alcatel_BinaryType. Cached items can be returned without
+	 * switching to binary mode.
+	 */
+	GSM_Alcatel_CachedItem	*ItemCache[TypeToDo + 1];
+	/**
+	 * Count of items in @ref ItemCache.
+	 */
+	int			ItemCacheCount[TypeToDo + 1];
+	/**
+	 * Item whose fields are listed in @ref CurrentFields when it was
+	 * read through @ref ItemCache.
+	 */
+	GSM_Alcatel_CachedItem	*CurrentItem;
 
 	/**
 	 * Listing of categories of current type.
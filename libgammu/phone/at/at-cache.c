@@ -0,0 +1,265 @@
+/**
+ * Cache of capabilities detected on AT phones.
+ *
+ * Results of probing done while initialising connection are stored in
+ * INI file, so that later connections to the same phone can skip most
+ * of the probing.
+ */
+/**
+ * @ingroup Phone
+ * @{
+ */
+/**
+ * @addtogroup ATPhone
+ * @{
+ */
+
+#include <gammu-config.h>
+
+#ifdef GSM_ENABLE_ATGEN
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../gsmcomon.h"
+#include "../../gsmphones.h"
+
+#include "atgen.h"
+#include "atfunc.h"
+
+/**
+ * Section used in capability cache file.
+ */
+#define CACHE_SECTION "capabilities"
+
+/**
+ * Describes configuration which affects detected capabilities, cache
+ * created with different configuration is not used.
+ */
+static void ATGEN_CacheConfigKey(GSM_StateMachine *s, char *buffer, size_t size)
+{
+	GSM_Config *cfg = s->CurrentConfig;
+	size_t pos;
+	int i;
+
+	pos = snprintf(buffer, size, "%d,%d,%d,%d,%d",
+			cfg->CNMIParams[0], cfg->CNMIParams[1], cfg->CNMIParams[2],
+			cfg->CNMIParams[3], cfg->CNMIParams[4]);
+
+	for (i = 0; i < GSM_MAX_PHONE_FEATURES && cfg->PhoneFeatures[i] != 0 && pos < size; i++) {
+		pos += snprintf(buffer + pos, size - pos, ",%s",
+				GSM_FeatureToString(cfg->PhoneFeatures[i]));
+	}
+}
+
+static const char *ATGEN_CacheString(INI_Section *cache, const char *key)
+{
+	const char *value;
+
+	value = INI_GetValue(cache, CACHE_SECTION, key, FALSE);
+	if (value == NULL) {
+		return "";
+	}
+	return value;
+}
+
+GSM_Error ATGEN_LoadCapabilities(GSM_StateMachine *s)
+{
+	GSM_Phone_Data		*Data = &s->Phone.Data;
+	GSM_Phone_ATGENData	*Priv = &s->Phone.Data.Priv.ATGEN;
+	GSM_Feature		features[GSM_MAX_PHONE_FEATURES + 1];
+	INI_Section		*cache = NULL;
+	const char		*value;
+	char			config[500];
+	GSM_Error		error;
+	int			i;
+
+	if (s->CurrentConfig->CapabilityCache == NULL) {
+		return ERR_NOTSUPPORTED;
+	}
+
+	error = INI_ReadFile(s->CurrentConfig->CapabilityCache, FALSE, &cache);
+	if (error != ERR_NONE) {
+		smprintf(s, "Can not read capability cache, probing phone\n");
+		return error;
+	}
+
+	ATGEN_CacheConfigKey(s, config, sizeof(config));
+	if (strcmp(ATGEN_CacheString(cache, "gammu"), GAMMU_VERSION) != 0 ||
+			strcmp(ATGEN_CacheString(cache, "config"), config) != 0) {
+		smprintf(s, "Capability cache was created with different configuration\n");
+		error = ERR_INVALIDDATA;
+		goto done;
+	}
+
+	value = ATGEN_CacheString(cache, "model");
+	if (value[0] == 0 || strlen(value) > GSM_MAX_MODEL_LENGTH) {
+		error = ERR_INVALIDDATA;
+		goto done;
+	}
+
+	/* Verify that we talk to same phone with same firmware */
+	Data->IMEI[0] = 0;
+	error = ATGEN_GetIMEI(s);
+	if (error != ERR_NONE) {
+		goto done;
+	}
+	error = ATGEN_GetFirmware(s);
+	if (error != ERR_NONE) {
+		goto done;
+	}
+	if (strcmp(ATGEN_CacheString(cache, "imei"), Data->IMEI) != 0 ||
+			strcmp(ATGEN_CacheString(cache, "firmware"), Data->Version) != 0) {
+		smprintf(s, "Capability cache is for different phone or firmware\n");
+		error = ERR_INVALIDDATA;
+		goto done;
+	}
+
+	/* Model and features */
+	if (Data->Model[0] == 0) {
+		strcpy(Data->Model, value);
+	}
+	ATGEN_FindModelData(s);
+	value = INI_GetValue(cache, CACHE_SECTION, "features", FALSE);
+	if (value != NULL) {
+		error = GSM_SetFeatureString(features, value);
+		if (error != ERR_NONE) {
+			goto done;
+		}
+		for (i = 0; features[i] != 0; i++) {
+			GSM_AddPhoneFeature(Data->ModelInfo, features[i]);
+		}
+	}
+
+	value = ATGEN_CacheString(cache, "manufacturer");
+	if (strlen(value) <= GSM_MAX_MANUFACTURER_LENGTH) {
+		strcpy(Data->Manufacturer, value);
+	}
+	Priv->Manufacturer = INI_GetInt(cache, CACHE_SECTION, "manufacturerid", 0);
+
+	Priv->Mode = INI_GetBool(cache, CACHE_SECTION, "mode", FALSE);
+	Priv->CMEEMode = INI_GetInt(cache, CACHE_SECTION, "cmee", 0);
+	Priv->HasCHUP = INI_GetBool(cache, CACHE_SECTION, "chup", FALSE);
+
+	Priv->NormalCharset = INI_GetInt(cache, CACHE_SECTION, "normalcharset", 0);
+	Priv->IRACharset = INI_GetInt(cache, CACHE_SECTION, "iracharset", 0);
+	Priv->GSMCharset = INI_GetInt(cache, CACHE_SECTION, "gsmcharset", 0);
+	Priv->UnicodeCharset = INI_GetInt(cache, CACHE_SECTION, "unicodecharset", 0);
+
+	Priv->PhoneSMSMemory = INI_GetInt(cache, CACHE_SECTION, "phonesmsmemory", 0);
+	Priv->SIMSMSMemory = INI_GetInt(cache, CACHE_SECTION, "simsmsmemory", 0);
+	Priv->SRSMSMemory = INI_GetInt(cache, CACHE_SECTION, "srsmsmemory", 0);
+	Priv->PhoneSaveSMS = INI_GetInt(cache, CACHE_SECTION, "phonesavesms", 0);
+	Priv->SIMSaveSMS = INI_GetInt(cache, CACHE_SECTION, "simsavesms", 0);
+	Priv->SRSaveSMS = INI_GetInt(cache, CACHE_SECTION, "srsavesms", 0);
+	Priv->MotorolaSMS = INI_GetBool(cache, CACHE_SECTION, "motorolasms", FALSE);
+
+	Priv->CNMIMode = INI_GetInt(cache, CACHE_SECTION, "cnmimode", -1);
+	Priv->CNMIProcedure = INI_GetInt(cache, CACHE_SECTION, "cnmiprocedure", -1);
+	Priv->CNMIDeliverProcedure = INI_GetInt(cache, CACHE_SECTION, "cnmideliverprocedure", -1);
+#ifdef GSM_ENABLE_CELLBROADCAST
+	Priv->CNMIBroadcastProcedure = INI_GetInt(cache, CACHE_SECTION, "cnmibroadcastprocedure", -1);
+#endif
+	Priv->CNMIClearUnsolicitedResultCodes = INI_GetInt(cache, CACHE_SECTION, "cnmiclear", -1);
+
+	smprintf(s, "Using cached capabilities from %s\n", s->CurrentConfig->CapabilityCache);
+	error = ERR_NONE;
+done:
+	INI_Free(cache);
+	return error;
+}
+
+GSM_Error ATGEN_SaveCapabilities(GSM_StateMachine *s)
+{
+	GSM_Phone_Data		*Data = &s->Phone.Data;
+	GSM_Phone_ATGENData	*Priv = &s->Phone.Data.Priv.ATGEN;
+	const char		*path = s->CurrentConfig->CapabilityCache;
+	char			*tmppath;
+	char			config[500];
+	FILE			*f;
+	gboolean		ok;
+	int			i;
+
+	if (path == NULL) {
+		return ERR_NONE;
+	}
+	if (Data->IMEI[0] == 0 || Data->Model[0] == 0 || Data->ModelInfo == NULL) {
+		return ERR_NOTSUPPORTED;
+	}
+
+	tmppath = (char *)malloc(strlen(path) + 5);
+	if (tmppath == NULL) {
+		return ERR_MOREMEMORY;
+	}
+	sprintf(tmppath, "%s.tmp", path);
+
+	f = fopen(tmppath, "w");
+	if (f == NULL) {
+		smprintf(s, "Can not create capability cache %s\n", tmppath);
+		free(tmppath);
+		return ERR_CANTOPENFILE;
+	}
+
+	ATGEN_CacheConfigKey(s, config, sizeof(config));
+
+	fprintf(f, "[%s]\n", CACHE_SECTION);
+	fprintf(f, "gammu = %s\n", GAMMU_VERSION);
+	fprintf(f, "config = %s\n", config);
+	fprintf(f, "imei = %s\n", Data->IMEI);
+	fprintf(f, "firmware = %s\n", Data->Version);
+	fprintf(f, "model = %s\n", Data->Model);
+	fprintf(f, "manufacturer = %s\n", Data->Manufacturer);
+	fprintf(f, "manufacturerid = %d\n", Priv->Manufacturer);
+	fprintf(f, "features = ");
+	for (i = 0; Data->ModelInfo->features[i] != 0; i++) {
+		fprintf(f, "%s%s", i == 0 ? "" : ",",
+				GSM_FeatureToString(Data->ModelInfo->features[i]));
+	}
+	fprintf(f, "\n");
+	fprintf(f, "mode = %s\n", Priv->Mode ? "yes" : "no");
+	fprintf(f, "cmee = %d\n", Priv->CMEEMode);
+	fprintf(f, "chup = %s\n", Priv->HasCHUP ? "yes" : "no");
+	fprintf(f, "normalcharset = %d\n", Priv->NormalCharset);
+	fprintf(f, "iracharset = %d\n", Priv->IRACharset);
+	fprintf(f, "gsmcharset = %d\n", Priv->GSMCharset);
+	fprintf(f, "unicodecharset = %d\n", Priv->UnicodeCharset);
+	fprintf(f, "phonesmsmemory = %d\n", Priv->PhoneSMSMemory);
+	fprintf(f, "simsmsmemory = %d\n", Priv->SIMSMSMemory);
+	fprintf(f, "srsmsmemory = %d\n", Priv->SRSMSMemory);
+	fprintf(f, "phonesavesms = %d\n", Priv->PhoneSaveSMS);
+	fprintf(f, "simsavesms = %d\n", Priv->SIMSaveSMS);
+	fprintf(f, "srsavesms = %d\n", Priv->SRSaveSMS);
+	fprintf(f, "motorolasms = %s\n", Priv->MotorolaSMS ? "yes" : "no");
+	fprintf(f, "cnmimode = %d\n", Priv->CNMIMode);
+	fprintf(f, "cnmiprocedure = %d\n", Priv->CNMIProcedure);
+	fprintf(f, "cnmideliverprocedure = %d\n", Priv->CNMIDeliverProcedure);
+#ifdef GSM_ENABLE_CELLBROADCAST
+	fprintf(f, "cnmibroadcastprocedure = %d\n", Priv->CNMIBroadcastProcedure);
+#endif
+	fprintf(f, "cnmiclear = %d\n", Priv->CNMIClearUnsolicitedResultCodes);
+
+	ok = !ferror(f);
+	ok = (fclose(f) == 0) && ok;
+
+	if (ok) {
+#ifdef WIN32
+		remove(path);
+#endif
+		ok = rename(tmppath, path) == 0;
+	}
+	if (!ok) {
+		smprintf(s, "Can not write capability cache %s\n", path);
+		remove(tmppath);
+	}
+	free(tmppath);
+	return ok ? ERR_NONE : ERR_WRITING_FILE;
+}
+
+#endif
+/*@}*/
+/*@}*/
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -1047,6 +1047,54 @@ GSM_Error ATGEN_ReplyGetSMSMessage(GSM_Protocol_Message *msg, GSM_StateMachine *
 	return ERR_UNKNOWNRESPONSE;
 }
 
+/**
+ * Finds location in messages listed since reading was started.
+ *
+ * \return Index in SMSListed or -1 if not found.
+ */
+static int ATGEN_FindListedSMS(GSM_StateMachine *s, int location)
+{
+	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
+	int i;
+
+	for (i = 0; i < Priv->SMSListedCount; i++) {
+		if (Priv->SMSListed[i].Location == location) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * Remembers locations from current listing, these are later used to
+ * delete messages from all folders at once.
+ */
+static void ATGEN_RememberSMSList(GSM_StateMachine *s)
+{
+	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
+	GSM_AT_SMS_Listed *listed;
+	int i;
+
+	if (Priv->SMSCount == 0) {
+		return;
+	}
+	listed = (GSM_AT_SMS_Listed *)realloc(Priv->SMSListed,
+			(Priv->SMSListedCount + Priv->SMSCount) * sizeof(GSM_AT_SMS_Listed));
+
+	if (listed == NULL) {
+		/* Listing is only an optimization, forget it */
+		Priv->SMSListedCount = 0;
+		return;
+	}
+	Priv->SMSListed = listed;
+
+	for (i = 0; i < Priv->SMSCount; i++) {
+		listed[Priv->SMSListedCount].Location = Priv->SMSCache[i].Location;
+		listed[Priv->SMSListedCount].State = Priv->SMSCache[i].State;
+		Priv->SMSListedCount++;
+	}
+}
+
 GSM_Error ATGEN_GetSMS(GSM_StateMachine *s, GSM_MultiSMSMessage *sms)
 {
 	GSM_Error error;
@@ -1099,6 +1147,10 @@ GSM_Error ATGEN_GetSMS(GSM_StateMachine *s, GSM_MultiSMSMessage *sms)
 			sms->SMS[0].Memory = MEM_SM;
 			if (getfolder > 2) sms->SMS[0].Memory = MEM_ME;
 		}
+		/* Message is now read, listing does not describe memory anymore */
+		if (ATGEN_FindListedSMS(s, sms->SMS[0].Location) == -1) {
+			Priv->SMSListedCount = 0;
+		}
 	}
  fail:
 	if (oldmode != Priv->SMSMode) {
@@ -1252,6 +1304,7 @@ GSM_Error ATGEN_GetSMSList(GSM_StateMachine *s, gboolean first)
 	}
 	if (first) {
 		Priv->SMSReadFolder = 1;
+		Priv->SMSListedCount = 0;
 
 		if (Priv->SIMSMSMemory == AT_AVAILABLE) {
 			error = ATGEN_SetSMSMemory(s, TRUE, FALSE, FALSE);
@@ -1308,6 +1361,9 @@ GSM_Error ATGEN_GetSMSList(GSM_StateMachine *s, gboolean first)
 	if (error == ERR_NONE && Priv->SMSCache == NULL) {
 		Priv->SMSCache = (GSM_AT_SMS_Cache *)realloc(Priv->SMSCache, sizeof(GSM_AT_SMS_Cache));
 	}
+	if (error == ERR_NONE && !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_BROKEN_CMGL)) {
+		ATGEN_RememberSMSList(s);
+	}
 	if (used != Priv->SMSCount && (error == ERR_NONE || error == ERR_EMPTY)) {
 		smprintf(s, "WARNING: Used messages according to CPMS %d, but CMGL returned %d. Expect problems!\n", used, Priv->SMSCount);
 		if (! GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_USE_SMSTEXTMODE)) {
@@ -2288,14 +2344,40 @@ GSM_Error ATGEN_ReplyDeleteSMSMessage(GSM_Protocol_Message *msg UNUSED, GSM_Stat
 	return ERR_UNKNOWNRESPONSE;
 }
 
-GSM_Error ATGEN_DeleteSMS(GSM_StateMachine *s, GSM_SMSMessage *sms)
+/**
+ * Deletes message on location without checking it first.
+ *
+ * \param read_all Whether to delete all read messages in same memory.
+ */
+static GSM_Error ATGEN_DeleteSMSLocation(GSM_StateMachine *s, GSM_SMSMessage *sms, gboolean read_all)
 {
 	GSM_Error error;
-	GSM_MultiSMSMessage msms;
 	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
-	unsigned char req[20] = {'\0'}, folderid = 0;
+	unsigned char req[30] = {'\0'}, folderid = 0;
 	int location = 0, length = 0;
 
+	error = ATGEN_GetSMSLocation(s, sms, &folderid, &location,
+			ATGEN_IsMemoryWriteable(Priv, sms->Memory));
+
+	if (error != ERR_NONE) {
+		return error;
+	}
+	if (read_all) {
+		smprintf(s, "Deleting all read SMS\n");
+		length = sprintf(req, "AT+CMGD=%i,1\r", location);
+	} else {
+		smprintf(s, "Deleting SMS\n");
+		length = sprintf(req, "AT+CMGD=%i\r", location);
+	}
+	error = ATGEN_WaitFor(s, req, length, 0x00, 5, ID_DeleteSMSMessage);
+	return error;
+}
+
+GSM_Error ATGEN_DeleteSMS(GSM_StateMachine *s, GSM_SMSMessage *sms)
+{
+	GSM_Error error;
+	GSM_MultiSMSMessage msms;
+
 	msms.Number = 0;
 	msms.SMS[0] = *sms;
 
@@ -2306,15 +2388,207 @@ GSM_Error ATGEN_DeleteSMS(GSM_StateMachine *s, GSM_SMSMessage *sms)
 		return error;
 	}
 
-	error = ATGEN_GetSMSLocation(s, sms, &folderid, &location,
-			ATGEN_IsMemoryWriteable(Priv, sms->Memory));
+	return ATGEN_DeleteSMSLocation(s, sms, FALSE);
+}
 
-	if (error != ERR_NONE) {
-		return error;
+GSM_Error ATGEN_ReplyCheckCMGD(GSM_Protocol_Message *msg, GSM_StateMachine *s)
+{
+	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
+	const char *str;
+	char *end;
+	long low, high;
+
+	Priv->CMGDFlag = AT_NOTAVAILABLE;
+
+	switch (Priv->ReplyState) {
+	case AT_Reply_OK:
+		break;
+	case AT_Reply_Error:
+		return ERR_NOTSUPPORTED;
+	case AT_Reply_CMSError:
+		return ATGEN_HandleCMSError(s);
+	case AT_Reply_CMEError:
+		return ATGEN_HandleCMEError(s);
+	default:
+		return ERR_UNKNOWNRESPONSE;
 	}
-	smprintf(s, "Deleting SMS\n");
-	length = sprintf(req, "AT+CMGD=%i\r",location);
-	error = ATGEN_WaitFor(s, req, length, 0x00, 5, ID_DeleteSMSMessage);
+
+	/* Reply looks like +CMGD: (1-20),(0-4), flags are in second group */
+	str = strstr(GetLineString(msg->Buffer, &Priv->Lines, 2), "+CMGD:");
+	if (str != NULL) {
+		str = strchr(str, ')');
+	}
+	if (str != NULL) {
+		str = strchr(str, '(');
+	}
+	if (str == NULL) {
+		smprintf(s, "No delete flags supported\n");
+		return ERR_NONE;
+	}
+	str++;
+
+	while (*str != ')' && *str != 0) {
+		low = strtol(str, &end, 10);
+		if (end == str) {
+			break;
+		}
+		high = low;
+		if (*end == '-') {
+			str = end + 1;
+			high = strtol(str, &end, 10);
+			if (end == str) {
+				break;
+			}
+		}
+		if (low <= 1 && high >= 1) {
+			Priv->CMGDFlag = AT_AVAILABLE;
+			break;
+		}
+		str = end;
+		if (*str == ',') {
+			str++;
+		}
+	}
+	smprintf(s, "Deleting read messages at once %s\n",
+			Priv->CMGDFlag == AT_AVAILABLE ? "supported" : "not supported");
+	return ERR_NONE;
+}
+
+/**
+ * Checks whether all received messages listed in folder are going to
+ * be deleted, so that AT+CMGD=index,1 can be used instead of deleting
+ * them one by one.
+ */
+static gboolean ATGEN_CanDeleteReadSMS(GSM_StateMachine *s, const int *flat, const gboolean *known, int count, int folderid)
+{
+	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
+	gboolean found;
+	int i, j;
+
+	for (i = 0; i < Priv->SMSListedCount; i++) {
+		if (Priv->SMSListed[i].Location / GSM_PHONE_MAXSMSINFOLDER + 1 != folderid) {
+			continue;
+		}
+		/* Stored messages are not touched by AT+CMGD=index,1 */
+		if (Priv->SMSListed[i].State == 2 || Priv->SMSListed[i].State == 3) {
+			continue;
+		}
+		found = FALSE;
+		for (j = 0; j < count; j++) {
+			if (known[j] && flat[j] == Priv->SMSListed[i].Location) {
+				found = TRUE;
+				break;
+			}
+		}
+		/* Would delete message which was not requested */
+		if (!found) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+GSM_Error ATGEN_DeleteSMSBatch(GSM_StateMachine *s, GSM_SMSLocation *locations, int count)
+{
+	GSM_Error error = ERR_NONE;
+	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
+	GSM_SMSMessage *sms = NULL;
+	int *flat = NULL;
+	gboolean *known = NULL, *received = NULL;
+	gboolean read_all[2];
+	int i, index, folderid, first;
+
+	if (count == 0) {
+		return ERR_NONE;
+	}
+
+	/* Without listing we can not do better than one by one */
+	if (Priv->SMSListedCount == 0 ||
+			GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_BROKEN_CMGL)) {
+		return ERR_NOTIMPLEMENTED;
+	}
+
+	sms = (GSM_SMSMessage *)malloc(sizeof(GSM_SMSMessage));
+	flat = (int *)malloc(count * sizeof(int));
+	known = (gboolean *)malloc(count * sizeof(gboolean));
+	received = (gboolean *)malloc(count * sizeof(gboolean));
+
+	if (sms == NULL || flat == NULL || known == NULL || received == NULL) {
+		error = ERR_MOREMEMORY;
+		goto done;
+	}
+
+	/* Translate locations to flat memory used by listing */
+	for (i = 0; i < count; i++) {
+		if (locations[i].Folder == 0) {
+			flat[i] = locations[i].Location;
+		} else {
+			folderid = locations[i].Folder <= 2 ? 1 : 2;
+			flat[i] = (folderid - 1) * GSM_PHONE_MAXSMSINFOLDER + locations[i].Location;
+		}
+		index = ATGEN_FindListedSMS(s, flat[i]);
+		known[i] = (index != -1 && locations[i].Memory != MEM_SR);
+		received[i] = known[i] &&
+			(Priv->SMSListed[index].State == 0 || Priv->SMSListed[index].State == 1);
+	}
+
+	if (Priv->CMGDFlag == 0) {
+		error = ATGEN_WaitForAutoLen(s, "AT+CMGD=?\r", 0x00, 5, ID_CheckCMGD);
+		if (error != ERR_NONE) {
+			Priv->CMGDFlag = AT_NOTAVAILABLE;
+		}
+		error = ERR_NONE;
+	}
+	for (folderid = 1; folderid <= 2; folderid++) {
+		read_all[folderid - 1] = (Priv->CMGDFlag == AT_AVAILABLE &&
+			ATGEN_CanDeleteReadSMS(s, flat, known, count, folderid));
+	}
+
+	for (folderid = 1; folderid <= 2 && error == ERR_NONE; folderid++) {
+		first = -1;
+
+		for (i = 0; i < count && error == ERR_NONE; i++) {
+			if (flat[i] / GSM_PHONE_MAXSMSINFOLDER + 1 != folderid) {
+				continue;
+			}
+			/* Received messages are deleted together at the end */
+			if (received[i] && read_all[folderid - 1]) {
+				if (first == -1) {
+					first = i;
+				}
+				continue;
+			}
+			GSM_SetDefaultSMSData(sms);
+			sms->Folder = locations[i].Folder;
+			sms->Location = locations[i].Location;
+			sms->Memory = locations[i].Memory;
+
+			/* Listed messages exist, no need to read them first */
+			if (known[i]) {
+				error = ATGEN_DeleteSMSLocation(s, sms, FALSE);
+			} else {
+				error = ATGEN_DeleteSMS(s, sms);
+			}
+			if (error == ERR_EMPTY) {
+				error = ERR_NONE;
+			}
+		}
+		if (error == ERR_NONE && first != -1) {
+			GSM_SetDefaultSMSData(sms);
+			sms->Folder = locations[first].Folder;
+			sms->Location = locations[first].Location;
+			sms->Memory = locations[first].Memory;
+			error = ATGEN_DeleteSMSLocation(s, sms, TRUE);
+		}
+	}
+
+	/* Listing does not match memory content anymore */
+	Priv->SMSListedCount = 0;
+done:
+	free(sms);
+	free(flat);
+	free(known);
+	free(received);
 	return error;
 }
 
@@ -2421,6 +2695,11 @@ GSM_Error ATGEN_IncomingSMSInfo(GSM_Protocol_Message *msg, GSM_StateMachine *s)
     return error;
 
   sms.Memory = GSM_StringToMemoryType(mem_tag);
+
+  /* Some phones start locations from 0, API locations start from 1 */
+  if (GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_SMS_LOCATION_0)) {
+    sms.Location++;
+  }
   if (!ATGEN_IsMemoryAvailable(Priv, sms.Memory)) {
 		smprintf(s, "Incoming SMS information ignored as %s memory is disabled\n", mem_tag);
 		return ERR_NONE;
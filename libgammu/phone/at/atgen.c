@@ -459,6 +459,155 @@ GSM_Error ATGEN_WaitFor(GSM_StateMachine *s, const char * cmd, size_t len,
 	return error;
 }
 
+/**
+ * Maximal length of compound command, longer lines are not accepted
+ * by some phones.
+ */
+#define AT_COMPOUND_MAX_LENGTH 80
+
+GSM_Error ATGEN_WaitForCompound(GSM_StateMachine *s, GSM_AT_CompoundQuery *queries,
+			size_t count, int timeout)
+{
+	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
+	char command[AT_COMPOUND_MAX_LENGTH + 2];
+	gboolean compound = FALSE;
+	size_t i, pos;
+	GSM_Error error;
+
+	/* Motorola mode switching depends on the command */
+	if (count > 1 && !Priv->NoCompound && !Priv->Mode &&
+			!GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_NO_ATCOMPOUND)) {
+		pos = snprintf(command, sizeof(command), "AT");
+		for (i = 0; i < count && pos < sizeof(command); i++) {
+			pos += snprintf(command + pos, sizeof(command) - pos, "%s%s",
+					i == 0 ? "" : ";", queries[i].Command);
+		}
+		if (pos <= AT_COMPOUND_MAX_LENGTH) {
+			command[pos++] = '\r';
+			command[pos] = 0;
+
+			Priv->Compound = queries;
+			Priv->CompoundCount = count;
+			error = ATGEN_WaitFor(s, command, pos, 0x00, timeout, ID_CompoundCommand);
+			Priv->Compound = NULL;
+			Priv->CompoundCount = 0;
+
+			if (error == ERR_NONE || error == ERR_ABORTED) {
+				return error;
+			}
+			smprintf(s, "Compound command failed, sending queries separately\n");
+			compound = TRUE;
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		snprintf(command, sizeof(command), "AT%s\r", queries[i].Command);
+		queries[i].Error = ATGEN_WaitForAutoLen(s, command, 0x00, timeout, queries[i].Request);
+		if (queries[i].Error == ERR_ABORTED) {
+			return ERR_ABORTED;
+		}
+	}
+
+	/* Rejected compound command is explained by failure of first query */
+	if (compound && Priv->NoCompound && queries[0].Error != ERR_NONE) {
+		smprintf(s, "First query fails on its own, keeping compound commands enabled\n");
+		Priv->NoCompound = FALSE;
+	}
+	return ERR_NONE;
+}
+
+/**
+ * Splits reply to compound command and dispatches each part as if it
+ * was reply to separate command.
+ */
+static GSM_Error ATGEN_ReplyCompound(GSM_Protocol_Message *msg, GSM_StateMachine *s)
+{
+	GSM_Phone_ATGENData	*Priv = &s->Phone.Data.Priv.ATGEN;
+	GSM_AT_CompoundQuery	*queries = Priv->Compound;
+	size_t			count = Priv->CompoundCount;
+	GSM_Protocol_Message	*parts;
+	GSM_Error		error = ERR_NONE;
+	const char		*line;
+	size_t			i, current = 0, len, prefix;
+	int			lines, j;
+
+	/* First line is echo, last one final result */
+	for (lines = 0; Priv->Lines.numbers[lines * 2 + 1] != 0; lines++);
+
+	switch (Priv->ReplyState) {
+	case AT_Reply_OK:
+		break;
+	case AT_Reply_Error:
+		/*
+		 * Phone understanding compound command answers queries
+		 * preceding the failed one, plain error without any
+		 * answer means the command line itself was rejected.
+		 */
+		if (lines <= 2) {
+			smprintf(s, "Compound command rejected by phone\n");
+			Priv->NoCompound = TRUE;
+		}
+		return ERR_UNKNOWN;
+	case AT_Reply_CMSError:
+		return ATGEN_HandleCMSError(s);
+	case AT_Reply_CMEError:
+		return ATGEN_HandleCMEError(s);
+	default:
+		return ERR_UNKNOWN;
+	}
+	if (queries == NULL) {
+		return ERR_UNKNOWNRESPONSE;
+	}
+
+	parts = (GSM_Protocol_Message *)calloc(count, sizeof(GSM_Protocol_Message));
+	if (parts == NULL) {
+		return ERR_MOREMEMORY;
+	}
+	for (i = 0; i < count; i++) {
+		parts[i].Buffer = (unsigned char *)malloc(msg->Length + 2 * lines +
+				strlen(queries[i].Command) + 10);
+		if (parts[i].Buffer == NULL) {
+			error = ERR_MOREMEMORY;
+			goto done;
+		}
+		parts[i].Length = sprintf((char *)parts[i].Buffer, "AT%s\r\n", queries[i].Command);
+	}
+
+	/* Line belongs to nearest following query with matching prefix */
+	for (j = 2; j < lines; j++) {
+		line = GetLineStringPos(msg->Buffer, &Priv->Lines, j);
+		len = GetLineLength(msg->Buffer, &Priv->Lines, j);
+		for (i = current; i < count; i++) {
+			prefix = strcspn(queries[i].Command, "?=");
+			if (len > prefix && line[prefix] == ':' &&
+					strncmp(line, queries[i].Command, prefix) == 0) {
+				current = i;
+				break;
+			}
+		}
+		memcpy(parts[current].Buffer + parts[current].Length, line, len);
+		parts[current].Length += len;
+		memcpy(parts[current].Buffer + parts[current].Length, "\r\n", 2);
+		parts[current].Length += 2;
+	}
+
+	for (i = 0; i < count; i++) {
+		parts[i].Length += sprintf((char *)parts[i].Buffer + parts[i].Length, "OK\r\n");
+		s->Phone.Data.RequestMsg = &parts[i];
+		s->Phone.Data.RequestID = queries[i].Request;
+		queries[i].Error = ATGEN_DispatchMessage(s);
+	}
+	s->Phone.Data.RequestMsg = msg;
+	s->Phone.Data.RequestID = ID_CompoundCommand;
+
+done:
+	for (i = 0; i < count; i++) {
+		free(parts[i].Buffer);
+	}
+	free(parts);
+	return error;
+}
+
 /**
  * Checks whether string contains some non hex chars.
  *
@@ -1828,6 +1977,29 @@ GSM_Error ATGEN_SetIncomingUSSD(GSM_StateMachine *s, gboolean enable)
 	return error;
 }
 
+void ATGEN_FindModelData(GSM_StateMachine *s)
+{
+	GSM_Phone_Data *Data = &s->Phone.Data;
+
+	Data->ModelInfo = GetModelData(s, NULL, Data->Model, NULL);
+
+	if (Data->ModelInfo->number[0] == 0)
+		Data->ModelInfo = GetModelData(s, NULL, NULL, Data->Model);
+
+	if (Data->ModelInfo->number[0] == 0)
+		Data->ModelInfo = GetModelData(s, Data->Model, NULL, NULL);
+
+	if (Data->ModelInfo->number[0] == 0) {
+		smprintf(s, "Unknown model, but it should still work\n");
+	}
+	smprintf(s, "[Model name: `%s']\n", Data->Model);
+	smprintf(s, "[Model data: `%s']\n", Data->ModelInfo->number);
+	smprintf(s, "[Model data: `%s']\n", Data->ModelInfo->model);
+
+	s->Protocol.Data.AT.FastWrite = !GSM_IsPhoneFeatureAvailable(Data->ModelInfo, F_SLOWWRITE);
+	s->Protocol.Data.AT.CPINNoOK = GSM_IsPhoneFeatureAvailable(Data->ModelInfo, F_CPIN_NO_OK);
+}
+
 GSM_Error ATGEN_ReplyGetModel(GSM_Protocol_Message *msg, GSM_StateMachine *s)
 {
 	GSM_Phone_ATGENData 	*Priv = &s->Phone.Data.Priv.ATGEN;
@@ -1897,23 +2069,7 @@ GSM_Error ATGEN_ReplyGetModel(GSM_Protocol_Message *msg, GSM_StateMachine *s)
 	strncpy(Data->Model, pos, MIN(1 + pos2 - pos, GSM_MAX_MODEL_LENGTH));
 	Data->Model[1 + pos2 - pos] = 0;
 
-	Data->ModelInfo = GetModelData(s, NULL, Data->Model, NULL);
-
-	if (Data->ModelInfo->number[0] == 0)
-		Data->ModelInfo = GetModelData(s, NULL, NULL, Data->Model);
-
-	if (Data->ModelInfo->number[0] == 0)
-		Data->ModelInfo = GetModelData(s, Data->Model, NULL, NULL);
-
-	if (Data->ModelInfo->number[0] == 0) {
-		smprintf(s, "Unknown model, but it should still work\n");
-	}
-	smprintf(s, "[Model name: `%s']\n", Data->Model);
-	smprintf(s, "[Model data: `%s']\n", Data->ModelInfo->number);
-	smprintf(s, "[Model data: `%s']\n", Data->ModelInfo->model);
-
-	s->Protocol.Data.AT.FastWrite = !GSM_IsPhoneFeatureAvailable(Data->ModelInfo, F_SLOWWRITE);
-	s->Protocol.Data.AT.CPINNoOK = GSM_IsPhoneFeatureAvailable(Data->ModelInfo, F_CPIN_NO_OK);
+	ATGEN_FindModelData(s);
 
 	return ERR_NONE;
 }
@@ -2171,6 +2327,7 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 	GSM_Phone_ATGENData     *Priv = &s->Phone.Data.Priv.ATGEN;
 	GSM_Error               error;
     	char                    buff[2]={0};
+	gboolean		cached;
 
 	InitLines(&Priv->Lines);
 
@@ -2223,7 +2380,16 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 
 	Priv->SMSCount			= 0;
 	Priv->SMSCache			= NULL;
+	Priv->SMSListedCount		= 0;
+	Priv->SMSListed			= NULL;
+	Priv->CMGDFlag			= 0;
 	Priv->ReplyState		= 0;
+	Priv->HasCHUP			= FALSE;
+	Priv->CMEEMode			= 0;
+	Priv->CapabilitiesKnown		= FALSE;
+	Priv->NoCompound		= FALSE;
+	Priv->Compound			= NULL;
+	Priv->CompoundCount		= 0;
 
 	if (s->ConnectionType != GCT_IRDAAT && s->ConnectionType != GCT_BLUEAT) {
 		/* We try to escape AT+CMGS mode, at least Siemens M20
@@ -2271,29 +2437,46 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 		return error;
 	}
 
+	/* Skip probing if we already know this phone */
+	cached = (ATGEN_LoadCapabilities(s) == ERR_NONE);
+	Priv->CapabilitiesKnown = cached;
+
 	/* Try whether phone supports mode switching as Motorola phones. */
-	smprintf(s, "Trying Motorola mode switch\n");
-	error = GSM_WaitForAutoLen(s, "AT+MODE=2\r", 0x00, 10, ID_ModeSwitch);
+	if (!cached || Priv->Mode) {
+		smprintf(s, "Trying Motorola mode switch\n");
+		error = GSM_WaitForAutoLen(s, "AT+MODE=2\r", 0x00, 10, ID_ModeSwitch);
 
-	if (error != ERR_NONE) {
-		smprintf(s, "Seems not to be supported\n");
-		Priv->Mode = FALSE;
-	} else {
-		smprintf(s, "Works, will use it\n");
-		Priv->Mode = TRUE;
-		Priv->CurrentMode = 2;
+		if (error != ERR_NONE) {
+			smprintf(s, "Seems not to be supported\n");
+			Priv->Mode = FALSE;
+		} else {
+			smprintf(s, "Works, will use it\n");
+			Priv->Mode = TRUE;
+			Priv->CurrentMode = 2;
+		}
 	}
 	smprintf(s, "Enabling CME errors\n");
 
-	/* Try numeric errors */
-	error = ATGEN_WaitForAutoLen(s, "AT+CMEE=1\r", 0x00, 10, ID_EnableErrorInfo);
-
-	if (error != ERR_NONE) {
-		/* Try textual errors */
-		error = ATGEN_WaitForAutoLen(s, "AT+CMEE=2\r", 0x00, 10, ID_EnableErrorInfo);
+	if (cached) {
+		if (Priv->CMEEMode == 1) {
+			error = ATGEN_WaitForAutoLen(s, "AT+CMEE=1\r", 0x00, 10, ID_EnableErrorInfo);
+		} else if (Priv->CMEEMode == 2) {
+			error = ATGEN_WaitForAutoLen(s, "AT+CMEE=2\r", 0x00, 10, ID_EnableErrorInfo);
+		}
+	} else {
+		/* Try numeric errors */
+		error = ATGEN_WaitForAutoLen(s, "AT+CMEE=1\r", 0x00, 10, ID_EnableErrorInfo);
+		Priv->CMEEMode = 1;
 
 		if (error != ERR_NONE) {
-			smprintf(s, "CME errors could not be enabled, some error types won't be detected.\n");
+			/* Try textual errors */
+			error = ATGEN_WaitForAutoLen(s, "AT+CMEE=2\r", 0x00, 10, ID_EnableErrorInfo);
+			Priv->CMEEMode = 2;
+
+			if (error != ERR_NONE) {
+				smprintf(s, "CME errors could not be enabled, some error types won't be detected.\n");
+				Priv->CMEEMode = 0;
+			}
 		}
 	}
 
@@ -2312,7 +2495,9 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 	error = ERR_NONE;
 
 	/* Mode switching cabaple phones can switch using AT+MODE */
-	if (!Priv->Mode) {
+	if (cached) {
+		smprintf(s, "Using cached OBEX support\n");
+	} else if (!Priv->Mode) {
 		smprintf(s, "Checking for OBEX support\n");
 		/* We don't care about error here */
 		error = ATGEN_WaitForAutoLen(s, "AT+CPROT=?\r", 0x00, 20, ID_SetOBEX);
@@ -2342,7 +2527,7 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 #endif
 	}
 
-	if (!GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_MOBEX) && !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_TSSPCSW) && !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_NO_ATSYNCML)) {
+	if (!cached && !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_MOBEX) && !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_TSSPCSW) && !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_NO_ATSYNCML)) {
 		smprintf(s, "Checking for SYNCML/OBEX support\n");
 		/* We don't care about error here */
 		error = ATGEN_WaitForAutoLen(s, "AT+SYNCML=?\r", 0x00, 20, ID_SetOBEX);
@@ -2387,7 +2572,9 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 #endif
 
   /* can we use CHUP to hangup calls (otherwise use ATH) */
-  ATGEN_WaitForAutoLen(s, "AT+CHUP=?\r", 0x00, 40, ID_CheckCHUP);
+  if (!cached) {
+    ATGEN_WaitForAutoLen(s, "AT+CHUP=?\r", 0x00, 40, ID_CheckCHUP);
+  }
 
   if(s->CurrentConfig->NetworkType == NETWORK_AUTO) {
     // TODO: [KS] when not determined by configuration then set according to reported network,
@@ -2399,6 +2586,15 @@ GSM_Error ATGEN_Initialise(GSM_StateMachine *s)
 	s->Protocol.Data.AT.FastWrite = !GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_SLOWWRITE);
 	s->Protocol.Data.AT.CPINNoOK = GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_CPIN_NO_OK);
 
+	/* Remember what we have found for next time */
+	if (!cached && s->CurrentConfig->CapabilityCache != NULL) {
+		s->Phone.Data.IMEI[0] = 0;
+		if (ATGEN_GetIMEI(s) == ERR_NONE && ATGEN_GetFirmware(s) == ERR_NONE) {
+			Priv->CapabilitiesKnown = TRUE;
+			ATGEN_SaveCapabilities(s);
+		}
+	}
+
 	return error;
 }
 
@@ -3289,17 +3485,13 @@ GSM_Error ATGEN_ReplyGetGPRSState(GSM_Protocol_Message *msg, GSM_StateMachine *s
 	return ERR_UNKNOWNRESPONSE;
 }
 
-GSM_Error ATGEN_GetNetworkInfo(GSM_StateMachine *s, GSM_NetworkInfo *netinfo)
+/**
+ * Enables reporting of LAC and CID in network registration replies.
+ */
+static GSM_Error ATGEN_ConfigureNetworkInfo(GSM_StateMachine *s)
 {
 	GSM_Error error;
 
-	s->Phone.Data.NetworkInfo = netinfo;
-
-	netinfo->NetworkName[0] = 0;
-	netinfo->NetworkName[1] = 0;
-	netinfo->NetworkCode[0] = 0;
-	netinfo->GPRS = 0;
-
 	smprintf(s, "Enable full network info\n");
 	error = ATGEN_WaitForAutoLen(s, "AT+CREG=2\r", 0x00, 40, ID_ConfigureNetworkInfo);
 
@@ -3318,28 +3510,28 @@ GSM_Error ATGEN_GetNetworkInfo(GSM_StateMachine *s, GSM_NetworkInfo *netinfo)
 		/* Try basic info at least */
 		error = ATGEN_WaitForAutoLen(s, "AT+CGREG=1\r", 0x00, 40, ID_ConfigureNetworkInfo);
 	}
-	if (error != ERR_NONE) {
-		return error;
-	}
-
-	smprintf(s, "Getting GPRS state\n");
-	error = ATGEN_WaitForAutoLen(s, "AT+CGATT?\r", 0x00, 40, ID_GetGPRSState);
-
-	if (error != ERR_NONE) {
-		return error;
-	}
-	smprintf(s, "Getting network LAC and CID and state\n");
-	error = ATGEN_WaitForAutoLen(s, "AT+CREG?\r", 0x00, 40, ID_GetNetworkInfo);
+	return error;
+}
 
-	if (error != ERR_NONE) {
-		return error;
-	}
-	smprintf(s, "Getting packet network LAC and CID and state\n");
-	error = ATGEN_WaitForAutoLen(s, "AT+CGREG?\r", 0x00, 40, ID_GetNetworkInfo);
+/**
+ * Fills queries for GPRS state and network LAC and CID and state.
+ */
+static size_t ATGEN_NetworkInfoQueries(GSM_AT_CompoundQuery *queries)
+{
+	queries[0].Command = "+CGATT?";
+	queries[0].Request = ID_GetGPRSState;
+	queries[1].Command = "+CREG?";
+	queries[1].Request = ID_GetNetworkInfo;
+	queries[2].Command = "+CGREG?";
+	queries[2].Request = ID_GetNetworkInfo;
+	return 3;
+}
 
-	if (error != ERR_NONE) {
-		return error;
-	}
+/**
+ * Reads network code and name if phone is registered.
+ */
+static GSM_Error ATGEN_GetNetworkOperator(GSM_StateMachine *s, GSM_NetworkInfo *netinfo)
+{
 	if (netinfo->State == GSM_HomeNetwork          ||
 	    netinfo->State == GSM_RoamingNetwork       ||
 	    netinfo->PacketState == GSM_HomeNetwork    ||
@@ -3347,24 +3539,110 @@ GSM_Error ATGEN_GetNetworkInfo(GSM_StateMachine *s, GSM_NetworkInfo *netinfo)
 	    ) {
 		/* Set numeric format for AT+COPS? */
 		smprintf(s, "Setting short network name format\n");
-		error = ATGEN_WaitForAutoLen(s, "AT+COPS=3,2\r", 0x00, 40, ID_ConfigureNetworkInfo);
+		ATGEN_WaitForAutoLen(s, "AT+COPS=3,2\r", 0x00, 40, ID_ConfigureNetworkInfo);
 
 		/* Get operator code */
 		smprintf(s, "Getting network code\n");
-		error = ATGEN_WaitForAutoLen(s, "AT+COPS?\r", 0x00, 40, ID_GetNetworkCode);
+		ATGEN_WaitForAutoLen(s, "AT+COPS?\r", 0x00, 40, ID_GetNetworkCode);
 
 		/* Set string format for AT+COPS? */
 		smprintf(s, "Setting long string network name format\n");
-		error = ATGEN_WaitForAutoLen(s, "AT+COPS=3,0\r", 0x00, 40, ID_ConfigureNetworkInfo);
+		ATGEN_WaitForAutoLen(s, "AT+COPS=3,0\r", 0x00, 40, ID_ConfigureNetworkInfo);
 
 		/* Get operator code */
 		smprintf(s, "Getting network code\n");
-		error = ATGEN_WaitForAutoLen(s, "AT+COPS?\r", 0x00, 40, ID_GetNetworkName);
+		ATGEN_WaitForAutoLen(s, "AT+COPS?\r", 0x00, 40, ID_GetNetworkName);
+	}
+	/* All information here is optional */
+	return ERR_NONE;
+}
 
-		/* All information here is optional */
-		error = ERR_NONE;
+GSM_Error ATGEN_GetNetworkInfo(GSM_StateMachine *s, GSM_NetworkInfo *netinfo)
+{
+	GSM_AT_CompoundQuery queries[3];
+	size_t count, i;
+	GSM_Error error;
+
+	s->Phone.Data.NetworkInfo = netinfo;
+
+	netinfo->NetworkName[0] = 0;
+	netinfo->NetworkName[1] = 0;
+	netinfo->NetworkCode[0] = 0;
+	netinfo->GPRS = 0;
+
+	error = ATGEN_ConfigureNetworkInfo(s);
+	if (error != ERR_NONE) {
+		return error;
 	}
-	return error;
+
+	smprintf(s, "Getting GPRS state and network LAC and CID and state\n");
+	count = ATGEN_NetworkInfoQueries(queries);
+	error = ATGEN_WaitForCompound(s, queries, count, 40);
+	for (i = 0; i < count && error == ERR_NONE; i++) {
+		error = queries[i].Error;
+	}
+	if (error != ERR_NONE) {
+		return error;
+	}
+
+	return ATGEN_GetNetworkOperator(s, netinfo);
+}
+
+GSM_Error ATGEN_GetPhoneStatus(GSM_StateMachine *s, GSM_PhoneStatus *status,
+		gboolean battery, gboolean signal, gboolean network)
+{
+	GSM_AT_CompoundQuery queries[5];
+	size_t count = 0, network_start = 0, i;
+	GSM_Error error;
+
+	status->BatteryChargeError = ERR_NOTSUPPORTED;
+	status->SignalQualityError = ERR_NOTSUPPORTED;
+	status->NetworkInfoError = ERR_NOTSUPPORTED;
+
+	if (battery) {
+		GSM_ClearBatteryCharge(&status->BatteryCharge);
+		s->Phone.Data.BatteryCharge = &status->BatteryCharge;
+		queries[count].Command = "+CBC";
+		queries[count].Request = ID_GetBatteryCharge;
+		count++;
+	}
+	if (signal) {
+		s->Phone.Data.SignalQuality = &status->SignalQuality;
+		queries[count].Command = "+CSQ";
+		queries[count].Request = ID_GetSignalQuality;
+		count++;
+	}
+	if (network) {
+		s->Phone.Data.NetworkInfo = &status->NetworkInfo;
+		status->NetworkInfoError = ATGEN_ConfigureNetworkInfo(s);
+		if (status->NetworkInfoError == ERR_NONE) {
+			network_start = count;
+			count += ATGEN_NetworkInfoQueries(queries + count);
+		}
+	}
+
+	smprintf(s, "Getting phone status\n");
+	error = ATGEN_WaitForCompound(s, queries, count, 40);
+	if (error != ERR_NONE) {
+		return error;
+	}
+
+	i = 0;
+	if (battery) {
+		status->BatteryChargeError = queries[i++].Error;
+	}
+	if (signal) {
+		status->SignalQualityError = queries[i++].Error;
+	}
+	if (network && status->NetworkInfoError == ERR_NONE) {
+		for (i = network_start; i < count && status->NetworkInfoError == ERR_NONE; i++) {
+			status->NetworkInfoError = queries[i].Error;
+		}
+		if (status->NetworkInfoError == ERR_NONE) {
+			status->NetworkInfoError = ATGEN_GetNetworkOperator(s, &status->NetworkInfo);
+		}
+	}
+	return ERR_NONE;
 }
 
 /**
@@ -5760,11 +6038,18 @@ GSM_Error ATGEN_Terminate(GSM_StateMachine *s)
 {
 	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
 
+	/* Store also capabilities detected later */
+	if (Priv->CapabilitiesKnown) {
+		ATGEN_SaveCapabilities(s);
+	}
+
 	FreeLines(&Priv->Lines);
 	free(Priv->file.Buffer);
 	Priv->file.Buffer = NULL;
 	free(Priv->SMSCache);
 	Priv->SMSCache = NULL;
+	free(Priv->SMSListed);
+	Priv->SMSListed = NULL;
 	return ERR_NONE;
 }
 
@@ -6204,6 +6489,7 @@ GSM_Reply_Function ATGENReplyFunctions[] = {
 {ATGEN_GenericReply,		"AT+CSCA"		,0x00,0x00,ID_SetSMSC		 },
 {ATGEN_ReplyGetSMSC,		"AT+CSCA?"		,0x00,0x00,ID_GetSMSC		 },
 {ATGEN_ReplyDeleteSMSMessage,	"AT+CMGD"		,0x00,0x00,ID_DeleteSMSMessage	 },
+{ATGEN_ReplyCheckCMGD,		"AT+CMGD=?"		,0x00,0x00,ID_CheckCMGD		 },
 {ATGEN_GenericReply,		"ATE1"			,0x00,0x00,ID_SetSMSParameters	 },
 {ATGEN_GenericReply,		"\x1b\x0D"		,0x00,0x00,ID_SetSMSParameters	 },
 {ATGEN_GenericReply,		"AT+CMMS"		,0x00,0x00,ID_SetFastSMSSending  },
@@ -6386,6 +6672,7 @@ GSM_Reply_Function ATGENReplyFunctions[] = {
 {ATGEN_GenericReply,		"AT+CPROT=16" 	 	,0x00,0x00,ID_AlcatelConnect	 },
 #endif
 {ATGEN_GenericReply,		"AT+CFUN="	,0x00,0x00,ID_SetPower	 },
+{ATGEN_ReplyCompound,		"AT"		,0x00,0x00,ID_CompoundCommand	 },
 {ATGEN_GenericReply,		"AT^CURC="	,0x00,0x00,ID_SetIncomingCall	 },
 {ATGEN_GenericReply,		"AT^PORTSEL="	,0x00,0x00,ID_SetIncomingCall	 },
 {ATGEN_GenericReply,		"AT+ZCDRUN="	,0x00,0x00,ID_Initialise	 },
@@ -6452,6 +6739,7 @@ GSM_Phone_Functions ATGENPhone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	ATGEN_AddSMS,
 	ATGEN_DeleteSMS,
+	ATGEN_DeleteSMSBatch,
 	ATGEN_SendSMS,
 	ATGEN_SendSavedSMS,
 	ATGEN_SetFastSMSSending,
@@ -6540,7 +6828,8 @@ GSM_Phone_Functions ATGENPhone = {
 	SONYERICSSON_GetScreenshot,
 	ATGEN_SetPower,
 	ATGEN_PostConnect,
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	ATGEN_GetPhoneStatus
 };
 
 #endif
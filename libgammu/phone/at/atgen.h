@@ -229,13 +229,36 @@ typedef struct {
 } GSM_AT_SMS_Cache;
 
 /**
- * Structure for SMS Info cache.
+ * Structure for locations listed by AT+CMGL in all folders.
  */
 typedef struct {
-	size_t cache_size;
-	unsigned int cache_used;
-	GSM_SMSMessage *smsInfo_records;
-} GSM_AT_SMSInfo_Cache;
+	/**
+	 * Location of SMS (translated).
+	 */
+	int Location;
+	/**
+	 * State of message as listed, -1 if not known.
+	 */
+	int State;
+} GSM_AT_SMS_Listed;
+
+/**
+ * Query sent as part of compound AT command.
+ */
+typedef struct {
+	/**
+	 * Command without AT prefix, eg. "+CSQ".
+	 */
+	const char *Command;
+	/**
+	 * Request ID used for dispatching reply.
+	 */
+	GSM_Phone_RequestID Request;
+	/**
+	 * Result of the query.
+	 */
+	GSM_Error Error;
+} GSM_AT_CompoundQuery;
 
 /**
  * Maximal length of phonebook memories list.
@@ -402,6 +425,18 @@ typedef struct {
 	 * Locations of non empty SMSes.
 	 */
 	GSM_AT_SMS_Cache	*SMSCache;
+	/**
+	 * Number of entries in SMSListed.
+	 */
+	int			SMSListedCount;
+	/**
+	 * Messages listed in all folders since reading was started.
+	 */
+	GSM_AT_SMS_Listed	*SMSListed;
+	/**
+	 * Whether phone can delete read messages using AT+CMGD=index,1.
+	 */
+	GSM_AT_Feature		CMGDFlag;
 	/**
 	 * Which folder do we read SMS from.
 	 */
@@ -423,10 +458,6 @@ typedef struct {
    * Can we write to phone SR memory?
    */
   GSM_AT_Feature		SRSaveSMS;
-	/**
-	 * Cache for incoming SMS info.
-	 */
-	GSM_AT_SMSInfo_Cache SMSInfoCache;
   /**
    * Whether device supports CHUP for hanging up calls.
    */
@@ -435,6 +466,27 @@ typedef struct {
    * TRUE if an incoming call is in the process of being dropped.
    */
   gboolean CancellingCall;
+	/**
+	 * Which AT+CMEE mode works (0 if none).
+	 */
+	int			CMEEMode;
+	/**
+	 * Whether capabilities were detected and can be stored in cache.
+	 */
+	gboolean		CapabilitiesKnown;
+	/**
+	 * Whether phone rejected compound command, queries are then
+	 * sent one by one.
+	 */
+	gboolean		NoCompound;
+	/**
+	 * Queries of compound command being processed.
+	 */
+	GSM_AT_CompoundQuery	*Compound;
+	/**
+	 * Number of entries in Compound.
+	 */
+	size_t			CompoundCount;
 } GSM_Phone_ATGENData;
 
 /**
@@ -502,6 +554,23 @@ GSM_Error ATGEN_WaitFor(GSM_StateMachine *s, const char * cmd, size_t len,
 #define ATGEN_WaitForAutoLen(s, cmd, type, time, request) \
 	ATGEN_WaitFor(s, cmd, strlen(cmd), type, time, request)
 
+/**
+ * Sends independent read only queries as single command line (eg.
+ * AT+CSQ;+CBC) and dispatches each part of the reply to reply function
+ * of its query. Falls back to sending queries one by one if phone
+ * does not handle this.
+ *
+ * \param s State machine structure.
+ * \param queries Queries to send, result of each is stored in them.
+ * \param count Number of queries.
+ * \param timeout Timeout for replies.
+ *
+ * \return ERR_NONE if all queries were processed (even when some
+ * of them failed), error code otherwise.
+ */
+GSM_Error ATGEN_WaitForCompound(GSM_StateMachine *s, GSM_AT_CompoundQuery *queries,
+			size_t count, int timeout);
+
 /**
  * Parses AT formatted reply. This is a bit like sprintf parser, but
  * specially focused on AT replies and can automatically convert text
@@ -609,6 +678,33 @@ int ATGEN_ExtractOneParameter(unsigned char *input, unsigned char *output);
  */
 GSM_Error ATGEN_DecodeDateTime(GSM_StateMachine *s, GSM_DateTime *dt, unsigned char *_input);
 
+/**
+ * Looks up model data for model name reported by phone.
+ *
+ * \param s State machine structure.
+ */
+void ATGEN_FindModelData(GSM_StateMachine *s);
+
+/**
+ * Restores phone capabilities from configured cache file. The cache is
+ * used only when phone reports same IMEI and firmware as is stored in
+ * it.
+ *
+ * \param s State machine structure.
+ *
+ * \return ERR_NONE if capabilities were restored, error code otherwise.
+ */
+GSM_Error ATGEN_LoadCapabilities(GSM_StateMachine *s);
+
+/**
+ * Stores detected phone capabilities to configured cache file.
+ *
+ * \param s State machine structure.
+ *
+ * \return Error code.
+ */
+GSM_Error ATGEN_SaveCapabilities(GSM_StateMachine *s);
+
 #endif
 /*@}*/
 /*@}*/
@@ -341,6 +341,14 @@ GSM_Error ATOBEX_DeleteSMS(GSM_StateMachine *s, GSM_SMSMessage *sms)
 	return ATGEN_DeleteSMS(s, sms);
 }
 
+GSM_Error ATOBEX_DeleteSMSBatch(GSM_StateMachine *s, GSM_SMSLocation *locations, int count)
+{
+	GSM_Error error;
+
+	if ((error = ATOBEX_SetATMode(s))!= ERR_NONE) return error;
+	return ATGEN_DeleteSMSBatch(s, locations, count);
+}
+
 GSM_Error ATOBEX_AddSMS(GSM_StateMachine *s, GSM_SMSMessage *sms)
 {
 	GSM_Error error;
@@ -1590,6 +1598,7 @@ GSM_Phone_Functions ATOBEXPhone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	ATOBEX_AddSMS,
 	ATOBEX_DeleteSMS,
+	ATOBEX_DeleteSMSBatch,
 	ATOBEX_SendSMS,
 	ATOBEX_SendSavedSMS,
 	ATOBEX_SetFastSMSSending,
@@ -1678,7 +1687,8 @@ GSM_Phone_Functions ATOBEXPhone = {
 	SONYERICSSON_GetScreenshot,			/* 	GetScreenshot		*/
 	ATOBEX_SetPower,
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
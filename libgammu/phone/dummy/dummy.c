@@ -290,6 +290,7 @@ GSM_Error DUMMY_Initialise(GSM_StateMachine *s)
 	size_t i;
 
 	Priv->devlen = strlen(s->CurrentConfig->Device);
+	s->Phone.Data.FileStreamSupported = TRUE;
 
 	log_file = DUMMY_GetFilePath(s, "operations.log");
 
@@ -1102,7 +1103,8 @@ GSM_Error DUMMY_AddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos, in
 {
 	char *path;
 	FILE *file;
-	size_t pos;
+	unsigned char buffer[DUMMY_FILE_PART];
+	size_t pos, offset, chunk;
 	GSM_Error error;
 
 	*Handle = 0;
@@ -1124,12 +1126,22 @@ GSM_Error DUMMY_AddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos, in
 		if (error == ERR_EMPTY) return ERR_PERMISSION;
 		return error;
 	}
-	if (fwrite(File->Buffer, 1, File->Used, file) != File->Used) {
-		error = DUMMY_Error(s, "fwrite failed", path);
-		free(path);
-		fclose(file);
-		if (error == ERR_EMPTY) return ERR_PERMISSION;
-		return error;
+	for (offset = 0; offset < File->Used; offset += chunk) {
+		chunk = File->Used - offset;
+		if (chunk > sizeof(buffer)) chunk = sizeof(buffer);
+		error = PHONE_ReadFileData(s, File, offset, buffer, chunk);
+		if (error != ERR_NONE) {
+			free(path);
+			fclose(file);
+			return error;
+		}
+		if (fwrite(buffer, 1, chunk, file) != chunk) {
+			error = DUMMY_Error(s, "fwrite failed", path);
+			free(path);
+			fclose(file);
+			if (error == ERR_EMPTY) return ERR_PERMISSION;
+			return error;
+		}
 	}
 	if (fclose(file) != 0) {
 		error = DUMMY_Error(s, "fclose failed", path);
@@ -1154,27 +1166,64 @@ GSM_Error DUMMY_SendFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos, i
 GSM_Error DUMMY_GetFilePart(GSM_StateMachine *s, GSM_File *File, int *Handle, size_t *Size)
 {
 	char *path, *name, *pos;
+	unsigned char buffer[DUMMY_FILE_PART];
+	GSM_File start;
+	struct stat sb;
+	FILE *file;
+	size_t got;
 	GSM_Error error;
 
 	*Handle = 0;
 
 	path = DUMMY_GetFSFilePath(s, File->ID_FullName);
 
-	error = GSM_ReadFile(path, File);
-	*Size = File->Used;
-
-	name = strrchr(path, '/');
-	if (name == NULL) name = path;
-	else name++;
-	EncodeUnicode(File->Name, name, strlen(name));
-	pos = path;
-	while (*pos != 0 && (pos = strchr(pos + 1, '/')) != NULL) File->Level++;
+	file = fopen(path, "rb");
+	if (file == NULL || stat(path, &sb) != 0) {
+		if (file != NULL) fclose(file);
+		free(path);
+		return ERR_CANTOPENFILE;
+	}
+	if (fseek(file, File->Used, SEEK_SET) != 0) {
+		error = DUMMY_Error(s, "fseek failed", path);
+		fclose(file);
+		free(path);
+		return error;
+	}
+	got = fread(buffer, 1, sizeof(buffer), file);
+	fclose(file);
+
+	*Size = sb.st_size;
+
+	if (File->Used == 0) {
+		start.Buffer = buffer;
+		start.Used = got;
+		GSM_IdentifyFileFormat(&start);
+		File->Type = start.Type;
+		File->Protected = FALSE;
+		File->Hidden = FALSE;
+		File->System = FALSE;
+		File->ReadOnly = FALSE;
+		File->Folder = FALSE;
+		File->ModifiedEmpty = FALSE;
+		Fill_GSM_DateTime(&File->Modified, sb.st_mtime);
+
+		name = strrchr(path, '/');
+		if (name == NULL) name = path;
+		else name++;
+		EncodeUnicode(File->Name, name, strlen(name));
+		File->Level = 0;
+		pos = path;
+		while (*pos != 0 && (pos = strchr(pos + 1, '/')) != NULL) File->Level++;
+	}
 
 	free(path);
 	path=NULL;
 
-	if (error == ERR_NONE) return ERR_EMPTY;
-	return error;
+	error = PHONE_AppendFileData(s, File, buffer, got);
+	if (error != ERR_NONE) return error;
+
+	if (got < sizeof(buffer)) return ERR_EMPTY;
+	return ERR_NONE;
 }
 
 GSM_Error DUMMY_GetFolderListing(GSM_StateMachine *s, GSM_File *File, gboolean start)
@@ -2015,6 +2064,7 @@ GSM_Phone_Functions DUMMYPhone = {
 	DUMMY_SetSMS,
 	DUMMY_AddSMS,
 	DUMMY_DeleteSMS,
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	DUMMY_SendSMS,
 	DUMMY_SendSavedSMS,
 	DUMMY_SetFastSMSSending,
@@ -2103,7 +2153,8 @@ GSM_Phone_Functions DUMMYPhone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	DUMMY_PreAPICall
+	DUMMY_PreAPICall,
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 /*@}*/
@@ -37,6 +37,7 @@
 #define DUMMY_MAX_MEM (10000)
 #define DUMMY_MAX_TODO (10000)
 #define DUMMY_MAX_FS_DEPTH (20)
+#define DUMMY_FILE_PART (4096)
 
 typedef struct {
 	FILE *log_file;
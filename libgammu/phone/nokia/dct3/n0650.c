@@ -70,6 +70,7 @@ GSM_Phone_Functions N650Phone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	NOTSUPPORTED,			/*	AddSMS			*/
 	NOTSUPPORTED,			/* 	DeleteSMS 		*/
+	NOTSUPPORTED,			/* 	DeleteSMSBatch		*/
 	NOTSUPPORTED,			/*	SendSMSMessage		*/
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -158,7 +159,8 @@ GSM_Phone_Functions N650Phone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
@@ -2849,6 +2849,7 @@ GSM_Phone_Functions N6110Phone = {
         N6110_SetSMS,
         N6110_AddSMS,
         N6110_DeleteSMSMessage,
+        NOTIMPLEMENTED,                 /*      DeleteSMSBatch          */
         DCT3_SendSMSMessage,
         NOTSUPPORTED,                   /*      SendSavedSMS            */
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -2937,7 +2938,8 @@ GSM_Phone_Functions N6110Phone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
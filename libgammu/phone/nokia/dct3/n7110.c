@@ -1695,6 +1695,7 @@ GSM_Phone_Functions N7110Phone = {
 	N7110_SetSMS,
 	N7110_AddSMS,
 	N7110_DeleteSMS,
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	DCT3_SendSMSMessage,
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -1783,7 +1784,8 @@ GSM_Phone_Functions N7110Phone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
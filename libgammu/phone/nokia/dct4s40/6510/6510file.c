@@ -74,12 +74,27 @@ static GSM_Error N6510_AllocFileCache(GSM_StateMachine *s, int requested)
 	return ERR_NONE;
 }
 
-static int N6510_FindFileCheckSum12(GSM_StateMachine *s, unsigned char *ptr, int len)
+/**
+ * Starts computing checksum of transferred file data.
+ */
+static void N6510_StartFileCheckSum12(GSM_StateMachine *s)
+{
+	GSM_Phone_N6510Data *Priv = &s->Phone.Data.Priv.N6510;
+
+	Priv->FileCheckSumAcc  = 0xffff;
+	Priv->FileCheckSumAccx = 0;
+}
+
+/**
+ * Adds next block of transferred file data to checksum.
+ */
+static void N6510_UpdateFileCheckSum12(GSM_StateMachine *s, const unsigned char *ptr, size_t len)
 {
+	GSM_Phone_N6510Data *Priv = &s->Phone.Data.Priv.N6510;
 	int acc, i, accx;
 
-	accx = 0;
-	acc  = 0xffff;
+	accx = Priv->FileCheckSumAccx;
+	acc  = Priv->FileCheckSumAcc;
 	while (len--) {
 		accx = (accx & 0xffff00ff) | (acc & 0xff00);
 		acc  = (acc  & 0xffff00ff) | (*ptr++ << 8);
@@ -90,28 +105,30 @@ static int N6510_FindFileCheckSum12(GSM_StateMachine *s, unsigned char *ptr, int
 			accx <<= 1;
 		}
 	}
-	smprintf(s, "Checksum from Gammu is %04X\n",(acc & 0xffff));
-	return (acc & 0xffff);
+	Priv->FileCheckSumAccx = accx;
+	Priv->FileCheckSumAcc  = acc;
+}
+
+static int N6510_FindFileCheckSum12(GSM_StateMachine *s)
+{
+	GSM_Phone_N6510Data *Priv = &s->Phone.Data.Priv.N6510;
+
+	smprintf(s, "Checksum from Gammu is %04X\n",(Priv->FileCheckSumAcc & 0xffff));
+	return (Priv->FileCheckSumAcc & 0xffff);
 }
 
 GSM_Error N6510_ReplyGetFilePart12(GSM_Protocol_Message *msg, GSM_StateMachine *s)
 {
-	int old;
+	size_t length;
 
 	smprintf(s,"File part received\n");
-	old = s->Phone.Data.File->Used;
-	s->Phone.Data.File->Used += msg->Buffer[6]*256*256*256+
-				    msg->Buffer[7]*256*256+
-				    msg->Buffer[8]*256+
-				    msg->Buffer[9];
-	smprintf(s,"Length of file part: %i\n",
-			msg->Buffer[6]*256*256*256+
-			msg->Buffer[7]*256*256+
-			msg->Buffer[8]*256+
-			msg->Buffer[9]);
-	s->Phone.Data.File->Buffer = (unsigned char *)realloc(s->Phone.Data.File->Buffer,s->Phone.Data.File->Used);
-	memcpy(s->Phone.Data.File->Buffer+old,msg->Buffer+10,s->Phone.Data.File->Used-old);
-	return ERR_NONE;
+	length = msg->Buffer[6]*256*256*256+
+		 msg->Buffer[7]*256*256+
+		 msg->Buffer[8]*256+
+		 msg->Buffer[9];
+	smprintf(s,"Length of file part: %ld\n", (long)length);
+	N6510_UpdateFileCheckSum12(s, msg->Buffer+10, length);
+	return PHONE_AppendFileData(s, s->Phone.Data.File, msg->Buffer+10, length);
 }
 
 GSM_Error N6510_ReplyGetFileCRC12(GSM_Protocol_Message *msg, GSM_StateMachine *s)
@@ -399,6 +416,7 @@ static GSM_Error N6510_GetFilePart1(GSM_StateMachine *s, GSM_File *File, int *Ha
 
 		(*Size) 	= File->Used;
 		File->Used 	= 0;
+		N6510_StartFileCheckSum12(s);
 	}
 
 	old		 = File->Used;
@@ -417,8 +435,8 @@ static GSM_Error N6510_GetFilePart1(GSM_StateMachine *s, GSM_File *File, int *Ha
 		error = N6510_GetFileCRC1(s, File->ID_FullName);
 		if (error != ERR_NONE) return error;
 
-		if (N6510_FindFileCheckSum12(s, File->Buffer, File->Used) != Priv->FileCheckSum) {
-			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s, File->Buffer, File->Used),Priv->FileCheckSum);
+		if (N6510_FindFileCheckSum12(s) != Priv->FileCheckSum) {
+			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s),Priv->FileCheckSum);
 			return ERR_WRONGCRC;
 		}
 		return ERR_EMPTY;
@@ -633,6 +651,8 @@ static GSM_Error N6510_AddFilePart1(GSM_StateMachine *s, GSM_File *File, size_t
 		smprintf(s, "Adding file header\n");
 		error=GSM_WaitFor (s, Header, 246, 0x6D, 4, ID_AddFile);
 		if (error != ERR_NONE) return error;
+
+		N6510_StartFileCheckSum12(s);
 	}
 
 	j = 1000;
@@ -641,10 +661,12 @@ static GSM_Error N6510_AddFilePart1(GSM_StateMachine *s, GSM_File *File, size_t
 	Add[ 9] = atoi(DecodeUnicodeString(File->ID_FullName)) % 256;
 	Add[12] = j / 256;
 	Add[13] = j % 256;
-	memcpy(Add+14,File->Buffer+(*Pos),j);
+	error = PHONE_ReadFileData(s, File, *Pos, Add+14, j);
+	if (error != ERR_NONE) return error;
 	smprintf(s, "Adding file part %ld %i\n", (long)*Pos,j);
 	error=GSM_WaitFor (s, Add, 14+j, 0x6D, 4, ID_AddFile);
 	if (error != ERR_NONE) return error;
+	N6510_UpdateFileCheckSum12(s, Add+14, j);
 	*Pos = *Pos + j;
 
 	if (j < 1000) {
@@ -718,8 +740,8 @@ static GSM_Error N6510_AddFilePart1(GSM_StateMachine *s, GSM_File *File, size_t
 		error = N6510_GetFileCRC1(s, File->ID_FullName);
 		if (error != ERR_NONE) return error;
 
-		if (N6510_FindFileCheckSum12(s, File->Buffer, File->Used) != Priv->FileCheckSum) {
-			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s, File->Buffer, File->Used),Priv->FileCheckSum);
+		if (N6510_FindFileCheckSum12(s) != Priv->FileCheckSum) {
+			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s),Priv->FileCheckSum);
 			return ERR_WRONGCRC;
 		}
 
@@ -1218,6 +1240,7 @@ static GSM_Error N6510_GetFilePart2(GSM_StateMachine *s, GSM_File *File, int *Ha
 
 		(*Size) 	= File->Used;
 		File->Used 	= 0;
+		N6510_StartFileCheckSum12(s);
 	}
 
 	req[6]		 = (*Handle) / (256*256*256);
@@ -1243,8 +1266,8 @@ static GSM_Error N6510_GetFilePart2(GSM_StateMachine *s, GSM_File *File, int *Ha
 		error = N6510_CloseFile2(s, Handle);
 		if (error != ERR_NONE) return error;
 
-		if (N6510_FindFileCheckSum12(s, File->Buffer, File->Used) != Priv->FileCheckSum) {
-			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s, File->Buffer, File->Used),Priv->FileCheckSum);
+		if (N6510_FindFileCheckSum12(s) != Priv->FileCheckSum) {
+			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s),Priv->FileCheckSum);
 			return ERR_WRONGCRC;
 		}
 
@@ -1363,7 +1386,8 @@ static GSM_Error N6510_AddFilePart2(GSM_StateMachine *s, GSM_File *File, size_t
 	req[11]		 = j / (256*256);
 	req[12]		 = j / 256;
 	req[13]		 = j % 256;
-	memcpy(req+14,File->Buffer+(*Pos),j);
+	error = PHONE_ReadFileData(s, File, *Pos, req+14, j);
+	if (error != ERR_NONE) return error;
 
 	smprintf(s, "Adding file part %ld %i\n",(long)*Pos,j);
 	error=GSM_WaitFor (s, req, 14+j, 0x6D, 4, ID_AddFile);
@@ -1408,8 +1432,8 @@ static GSM_Error N6510_AddFilePart2(GSM_StateMachine *s, GSM_File *File, size_t
 /* 		if (error != ERR_NONE) return error; */
 /* 		error = N6510_CloseFile2(s, Handle); */
 /* 		if (error != ERR_NONE) return error; */
-/* 		if (N6510_FindFileCheckSum12(s, File->Buffer, File->Used) != Priv->FileCheckSum) { */
-/* 			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s, File->Buffer, File->Used),Priv->FileCheckSum); */
+/* 		if (N6510_FindFileCheckSum12(s) != Priv->FileCheckSum) { */
+/* 			smprintf(s,"File2 checksum is %i, File checksum is %i\n",N6510_FindFileCheckSum12(s),Priv->FileCheckSum); */
 /* 			return ERR_WRONGCRC; */
 /* 		} */
 
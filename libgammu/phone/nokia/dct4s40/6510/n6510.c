@@ -48,6 +48,7 @@ static GSM_Error N6510_Initialise (GSM_StateMachine *s)
 	s->Phone.Data.Priv.N6510.FilesLocationsAvail = 0;
 	s->Phone.Data.Priv.N6510.FilesLocationsUsed = 0;
 	s->Phone.Data.Priv.N6510.FilesCache = NULL;
+	s->Phone.Data.FileStreamSupported = TRUE;
 	s->Phone.Data.Priv.N6510.ScreenWidth = 0;
 	s->Phone.Data.Priv.N6510.ScreenHeight = 0;
 
@@ -4529,6 +4530,7 @@ GSM_Phone_Functions N6510Phone = {
 	N6510_SetSMS,
 	N6510_AddSMS,
 	N6510_DeleteSMSMessage,
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	N6510_SendSMSMessage,
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -4617,7 +4619,8 @@ GSM_Phone_Functions N6510Phone = {
 	DCT4_Screenshot,
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
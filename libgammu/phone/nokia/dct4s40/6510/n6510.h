@@ -46,6 +46,8 @@ typedef struct {
 	int				FileToken;
 	int				ParentID;
 	int				FileCheckSum;
+	int				FileCheckSumAcc;
+	int				FileCheckSumAccx;
 	gboolean				FilesEnd;
 	gboolean				UseFs1;
 	GSM_Error			filesystem2error;
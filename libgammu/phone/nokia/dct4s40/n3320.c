@@ -195,6 +195,7 @@ GSM_Phone_Functions N3320Phone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	NOTSUPPORTED,			/*	AddSMS			*/
 	NOTSUPPORTED,			/* 	DeleteSMS 		*/
+	NOTSUPPORTED,			/* 	DeleteSMSBatch		*/
 	NOTSUPPORTED,			/*	SendSMS			*/
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -283,7 +284,8 @@ GSM_Phone_Functions N3320Phone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
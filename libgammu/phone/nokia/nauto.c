@@ -89,6 +89,7 @@ GSM_Phone_Functions NAUTOPhone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	NOTSUPPORTED,			/*	AddSMS			*/
 	NOTSUPPORTED,			/* 	DeleteSMS 		*/
+	NOTSUPPORTED,			/* 	DeleteSMSBatch		*/
 	NOTSUPPORTED,			/*	SendSMSMessage		*/
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -177,7 +178,8 @@ GSM_Phone_Functions NAUTOPhone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect		*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
@@ -359,6 +359,7 @@ GSM_Phone_Functions N3650Phone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	NOTSUPPORTED,			/*	AddSMS			*/
 	NOTSUPPORTED,			/* 	DeleteSMS 		*/
+	NOTSUPPORTED,			/* 	DeleteSMSBatch		*/
 	NOTSUPPORTED,			/*	SendSMS			*/
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -447,7 +448,8 @@ GSM_Phone_Functions N3650Phone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
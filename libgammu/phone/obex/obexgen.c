@@ -31,6 +31,7 @@
 #include "../../gsmphones.h"
 #include "../../gsmstate.h"
 #include "../../service/gsmmisc.h"
+#include "../pfunc.h"
 #include "../../protocol/obex/obex.h"
 #include "obexfunc.h"
 #include "mobex.h"
@@ -46,6 +47,12 @@ GSM_Error OBEXGEN_GetModel(GSM_StateMachine *s);
  */
 #define OBEX_TIMEOUT 10
 
+/**
+ * Maximal packet size we offer to the peer, transfers use the smaller
+ * of this and size announced by the peer.
+ */
+#define OBEX_MAX_FRAME_SIZE 0xFFFF
+
 /**
  * Handles various error codes in OBEX protocol.
  */
@@ -187,7 +194,8 @@ GSM_Error OBEXGEN_Connect(GSM_StateMachine *s, OBEX_Service service)
 	unsigned char 	req[200] = {
 		0x10,			/* Version 1.0 			*/
 		0x00,			/* no flags 			*/
-		0x04,0x00};		/* max size of packet (changed below for m-obex) */
+		OBEX_MAX_FRAME_SIZE / 256,
+		OBEX_MAX_FRAME_SIZE % 256};	/* max size of packet (changed below for m-obex) */
 
 	/* Are we requsted for initial service? */
 	if (service == 0) {
@@ -235,8 +243,9 @@ GSM_Error OBEXGEN_Connect(GSM_StateMachine *s, OBEX_Service service)
 		OBEXAddBlock(req, &Current, 0x46, req2, 16);
 		break;
 	case OBEX_m_OBEX:
-		/* Bigger frame size for m-OBEX */
+		/* Phones are known to work with this frame size for m-OBEX */
 		req[2] = 0x20;
+		req[3] = 0x00;
 		/* IrMC Service UUID */
 		req2[0] = 'M'; req2[1] = 'O'; req2[2] = 'B';
 		req2[3] = 'E'; req2[4] = 'X';
@@ -272,8 +281,16 @@ GSM_Error OBEXGEN_InitialiseVars(GSM_StateMachine *s)
 {
 	GSM_Phone_OBEXGENData	*Priv = &s->Phone.Data.Priv.OBEXGEN;
 
+	/* File data are read and written by PHONE_ReadFileData and PHONE_AppendFileData */
+	s->Phone.Data.FileStreamSupported = TRUE;
+
 	Priv->Service = 0;
 	Priv->InitialService = 0;
+	/* Minimal packet size allowed by OBEX, until peer tells us more */
+	Priv->FrameSize = 255;
+	Priv->SRM = FALSE;
+	Priv->SRMWait = FALSE;
+	Priv->TransferStart = 0;
 	Priv->PbLUID = NULL;
 	Priv->PbLUIDCount = 0;
 	Priv->PbIndex = NULL;
@@ -641,6 +658,24 @@ static GSM_Error OBEXGEN_ReplyAddFilePart(GSM_Protocol_Message *msg, GSM_StateMa
 	switch (msg->Type) {
 	case 0x90:
 		smprintf(s,"Last part of file added OK\n");
+		/* Only Single Response Mode headers are interesting here */
+		Priv->SRMWait = FALSE;
+		while (Pos + 1 < msg->Length) {
+			if (msg->Buffer[Pos] == 0x97) {
+				Priv->SRM = (msg->Buffer[Pos + 1] == 0x01);
+			} else if (msg->Buffer[Pos] == 0x98) {
+				Priv->SRMWait = (msg->Buffer[Pos + 1] == 0x01);
+			} else if (msg->Buffer[Pos] == 0xCB) {
+				Pos += 5;
+				continue;
+			} else {
+				break;
+			}
+			Pos += 2;
+		}
+		if (Priv->SRM) {
+			smprintf(s, "Single response mode enabled%s\n", Priv->SRMWait ? ", waiting" : "");
+		}
 		return ERR_NONE;
 	case 0xA0:
 		smprintf(s,"Part of file added OK\n");
@@ -748,17 +783,61 @@ static GSM_Error OBEXGEN_ReplyAddFilePart(GSM_Protocol_Message *msg, GSM_StateMa
 	return ERR_UNKNOWNRESPONSE;
 }
 
+/**
+ * Checks whether Single Response Mode can be requested from peer.
+ */
+static gboolean OBEXGEN_CanUseSRM(GSM_StateMachine *s)
+{
+	return s->Phone.Data.Priv.OBEXGEN.Service != OBEX_m_OBEX &&
+		!GSM_IsPhoneFeatureAvailable(s->Phone.Data.ModelInfo, F_OBEX_NO_SRM);
+}
+
+/**
+ * Logs throughput of finished file transfer.
+ */
+static void OBEXGEN_LogThroughput(GSM_StateMachine *s, const char *operation, size_t bytes)
+{
+	long diff = (long)(time(NULL) - s->Phone.Data.Priv.OBEXGEN.TransferStart);
+
+	if (diff > 0) {
+		smprintf(s, "%s %ld bytes in %ld seconds, %ld bytes/sec\n",
+			operation, (long)bytes, diff, (long)bytes / diff);
+	} else {
+		smprintf(s, "%s %ld bytes in less than second\n", operation, (long)bytes);
+	}
+}
+
+/**
+ * Checks for response to pipelined request without waiting. In Single
+ * Response Mode peer answers only to end of transfer, unless it wants
+ * to report error or to make us wait.
+ */
+static GSM_Error OBEXGEN_PollResponse(GSM_StateMachine *s, GSM_Phone_RequestID request)
+{
+	s->Phone.Data.RequestID = request;
+	s->Phone.Data.DispatchError = ERR_NONE;
+	GSM_ReadDevice(s, FALSE);
+	s->Phone.Data.RequestID = ID_None;
+	return s->Phone.Data.DispatchError;
+}
+
 GSM_Error OBEXGEN_PrivAddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos, int *Handle UNUSED, gboolean HardDelete)
 {
 	GSM_Error		error;
 	size_t			j;
 	int		Current = 0;
-	unsigned char 		req[2000];
+	unsigned char 		*req;
 	unsigned char		hard_delete_header[2] = {'\x12', '\x0'};
 	GSM_Phone_OBEXGENData	*Priv = &s->Phone.Data.Priv.OBEXGEN;
 
 	s->Phone.Data.File = File;
 
+	/* Packet never exceeds negotiated size, but first one has to fit headers */
+	req = (unsigned char *)malloc(MAX(Priv->FrameSize, 2000));
+	if (req == NULL) {
+		return ERR_MOREMEMORY;
+	}
+
 	if (Priv->Service == OBEX_BrowsingFolders || Priv->Service == OBEX_m_OBEX) {
 		OBEXGEN_AddConnectionID(s, req, &Current);
 	}
@@ -767,11 +846,17 @@ GSM_Error OBEXGEN_PrivAddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *P
 	if (*Pos == 0) {
 		if (!strcmp(DecodeUnicodeString(File->ID_FullName),"")) {
 			error = OBEXGEN_Connect(s,OBEX_None);
-			if (error != ERR_NONE) return error;
+			if (error != ERR_NONE) {
+				free(req);
+				return error;
+			}
 		} else {
 			if (Priv->Service == OBEX_BrowsingFolders) {
 				error = OBEXGEN_ChangeToFilePath(s, File->ID_FullName, FALSE, NULL);
-				if (error != ERR_NONE) return error;
+				if (error != ERR_NONE) {
+					free(req);
+					return error;
+				}
 			}
 		}
 
@@ -788,8 +873,9 @@ GSM_Error OBEXGEN_PrivAddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *P
 		}
 
 		/* Adding empty file is special on mobex */
-		if (Priv->Service == OBEX_m_OBEX && File->Buffer == NULL) {
+		if (Priv->Service == OBEX_m_OBEX && File->Buffer == NULL && !PHONE_IsFileStream(s, File)) {
 			error = GSM_WaitFor (s, req, Current, 0x82, OBEX_TIMEOUT * 10, ID_AddFile);
+			free(req);
 			if (error == ERR_NONE) {
 				return ERR_EMPTY;
 			}
@@ -807,27 +893,79 @@ GSM_Error OBEXGEN_PrivAddFilePart(GSM_StateMachine *s, GSM_File *File, size_t *P
 		if (HardDelete) {
 			OBEXAddBlock(req, &Current, 0x4c, hard_delete_header, 2);
 		}
+
+		/* Ask peer not to answer every packet */
+		Priv->SRM = FALSE;
+		Priv->SRMWait = FALSE;
+		if (OBEXGEN_CanUseSRM(s)) {
+			req[Current++] = 0x97;
+			req[Current++] = 0x01;
+		}
+
+		Priv->TransferStart = time(NULL);
 	}
 
-	j = Priv->FrameSize - Current - 20;
-	if (j > 1000) j = 1000;
+	j = 0;
+	if (Priv->FrameSize > Current + 20) {
+		j = Priv->FrameSize - Current - 20;
+	}
+
+	/* Packet without data would be sent again and again */
+	if (j == 0) {
+		smprintf(s, "Frame size %d leaves no space for file data after %d bytes of headers!\n",
+			Priv->FrameSize, Current);
+		free(req);
+		return ERR_NOTSUPPORTED;
+	}
 
 	if (File->Used - *Pos < j) {
 		j = File->Used - *Pos;
 		/* End of file body block */
-		OBEXAddBlock(req, &Current, 0x49, File->Buffer+(*Pos), j);
+		req[Current++] = 0x49;
+		req[Current++] = (j + 3) / 256;
+		req[Current++] = (j + 3) % 256;
+		error = PHONE_ReadFileData(s, File, *Pos, req + Current, j);
+		if (error != ERR_NONE) {
+			free(req);
+			return error;
+		}
+		Current += j;
 		smprintf(s, "Adding last file part %ld %ld\n", (long)*Pos, (long)j);
 		*Pos = *Pos + j;
 		error = GSM_WaitFor (s, req, (long)Current, 0x82, OBEX_TIMEOUT * 10, ID_AddFile);
+		free(req);
 		if (error != ERR_NONE) return error;
+		OBEXGEN_LogThroughput(s, "Sent", *Pos);
 		return ERR_EMPTY;
+	}
+
+	/* File body block */
+	req[Current++] = 0x48;
+	req[Current++] = (j + 3) / 256;
+	req[Current++] = (j + 3) % 256;
+	error = PHONE_ReadFileData(s, File, *Pos, req + Current, j);
+	if (error != ERR_NONE) {
+		free(req);
+		return error;
+	}
+	Current += j;
+	smprintf(s, "Adding file part %ld %ld\n", (long)*Pos, (long)j);
+
+	if (Priv->SRM && *Pos != 0) {
+		/* Peer might have reported error or asked us to wait meanwhile */
+		error = OBEXGEN_PollResponse(s, ID_AddFile);
+		if (error != ERR_NONE) {
+			free(req);
+			return error;
+		}
+	}
+	if (Priv->SRM && !Priv->SRMWait && *Pos != 0) {
+		error = GSM_WaitFor (s, req, (long)Current, 0x02, OBEX_TIMEOUT * 10, ID_None);
 	} else {
-		/* File body block */
-		OBEXAddBlock(req, &Current, 0x48, File->Buffer+(*Pos), j);
-		smprintf(s, "Adding file part %ld %ld\n", (long)*Pos, (long)j);
-		*Pos = *Pos + j;
-		error=GSM_WaitFor (s, req, (long)Current, 0x02, OBEX_TIMEOUT * 10, ID_AddFile);
+		error = GSM_WaitFor (s, req, (long)Current, 0x02, OBEX_TIMEOUT * 10, ID_AddFile);
 	}
+	*Pos = *Pos + j;
+	free(req);
 	return error;
 }
 
@@ -876,7 +1014,9 @@ GSM_Error OBEXGEN_SendFilePart(GSM_StateMachine *s, GSM_File *File, size_t *Pos,
  */
 static GSM_Error OBEXGEN_ReplyGetFilePart(GSM_Protocol_Message *msg, GSM_StateMachine *s)
 {
-	size_t old,Pos=0,len2,pos2;
+	size_t Pos=0,len2,pos2;
+	GSM_Error error;
+	gboolean found = FALSE;
 	GSM_Phone_OBEXGENData	*Priv = &s->Phone.Data.Priv.OBEXGEN;
 
 	/* Non standard Sharp GX reply */
@@ -896,19 +1036,30 @@ static GSM_Error OBEXGEN_ReplyGetFilePart(GSM_Protocol_Message *msg, GSM_StateMa
 		if (msg->Length == 0) return ERR_NONE;
 		/* Fallthrough */
 	case 0x90:
-		while(1) {
+		while(!found) {
 			if (Pos >= msg->Length) break;
 			switch (msg->Buffer[Pos]) {
 			case 0x48:
 			case 0x49:
 				smprintf(s,"File part received\n");
-				old = s->Phone.Data.File->Used;
-				s->Phone.Data.File->Used += msg->Buffer[Pos+1]*256+msg->Buffer[Pos+2]-3;
 				smprintf(s,"Length of file part: %i\n",
 						msg->Buffer[Pos+1]*256+msg->Buffer[Pos+2]-3);
-				s->Phone.Data.File->Buffer = (unsigned char *)realloc(s->Phone.Data.File->Buffer,s->Phone.Data.File->Used);
-				memcpy(s->Phone.Data.File->Buffer+old,msg->Buffer+Pos+3,s->Phone.Data.File->Used-old);
-				return ERR_NONE;
+				error = PHONE_AppendFileData(s, s->Phone.Data.File, msg->Buffer+Pos+3,
+						msg->Buffer[Pos+1]*256+msg->Buffer[Pos+2]-3);
+				if (error != ERR_NONE) return error;
+				found = TRUE;
+				break;
+			case 0x97:
+				/* Single Response Mode */
+				Priv->SRM = (msg->Buffer[Pos+1] == 0x01);
+				smprintf(s, "Single response mode %s\n", Priv->SRM ? "enabled" : "disabled");
+				Pos += 2;
+				break;
+			case 0x98:
+				/* Single Response Mode Parameters */
+				Priv->SRMWait = (msg->Buffer[Pos+1] == 0x01);
+				Pos += 2;
+				break;
 			case 0xc3:
 				/* Length */
 				/**
@@ -947,6 +1098,13 @@ static GSM_Error OBEXGEN_ReplyGetFilePart(GSM_Protocol_Message *msg, GSM_StateMa
 				break;
 			}
 		}
+		/* In Single Response Mode peer sends following parts without request */
+		if (msg->Type == 0x90 && Priv->SRM && !Priv->SRMWait) {
+			return ERR_NEEDANOTHERANSWER;
+		}
+		if (found || (msg->Type == 0x90 && Priv->SRM)) {
+			return ERR_NONE;
+		}
 		return ERR_UNKNOWNRESPONSE;
 	}
 	return ERR_UNKNOWNRESPONSE;
@@ -1029,6 +1187,15 @@ static GSM_Error OBEXGEN_PrivGetFilePart(GSM_StateMachine *s, GSM_File *File, gb
 		OBEXAddBlock(req, &Current, 0x4C, Priv->m_obex_appdata, Priv->m_obex_appdata_len);
 	}
 
+	/* Ask peer to send whole file without waiting for our requests */
+	Priv->SRM = FALSE;
+	Priv->SRMWait = FALSE;
+	if (OBEXGEN_CanUseSRM(s)) {
+		req[Current++] = 0x97;
+		req[Current++] = 0x01;
+	}
+	Priv->TransferStart = time(NULL);
+
 	smprintf(s, "Getting first file part\n");
 	retries = 0;
 	while (retries < 5) {
@@ -1065,6 +1232,7 @@ static GSM_Error OBEXGEN_PrivGetFilePart(GSM_StateMachine *s, GSM_File *File, gb
 		}
 		if (error != ERR_NONE) return error;
 	}
+	OBEXGEN_LogThroughput(s, "Received", File->Used);
 	return ERR_EMPTY;
 }
 
@@ -3838,6 +4006,7 @@ GSM_Phone_Functions OBEXGENPhone = {
 	NOTIMPLEMENTED,			/*	SetSMS			*/
 	NOTIMPLEMENTED,			/*	AddSMS			*/
 	NOTIMPLEMENTED,			/* 	DeleteSMS 		*/
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	NOTIMPLEMENTED,			/*	SendSMSMessage		*/
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -3926,7 +4095,8 @@ GSM_Phone_Functions OBEXGENPhone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
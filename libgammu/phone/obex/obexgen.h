@@ -289,6 +289,19 @@ typedef struct {
 	 * OBEX connection ID.
 	 */
 	unsigned char			connection_id[4];
+	/**
+	 * Whether peer agreed to Single Response Mode for current transfer.
+	 */
+	gboolean			SRM;
+	/**
+	 * Whether peer asked us to wait for its response in Single
+	 * Response Mode.
+	 */
+	gboolean			SRMWait;
+	/**
+	 * Start of current file transfer, used for throughput logging.
+	 */
+	time_t				TransferStart;
 } GSM_Phone_OBEXGENData;
 
 GSM_Error OBEXGEN_GetBinaryFile(GSM_StateMachine *s, const char *FileName, unsigned char ** Buffer, size_t *len);
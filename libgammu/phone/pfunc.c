@@ -1,6 +1,7 @@
 /* (c) 2002-2003 by Marcin Wiacek */
 
 #include <string.h>
+#include <stdlib.h>
 #include <ctype.h>
 
 #include <gammu-ringtone.h>
@@ -190,6 +191,57 @@ GSM_Error PHONE_UploadFile(GSM_StateMachine *s, GSM_File * File)
 	return error;
 }
 
+gboolean PHONE_IsFileStream(GSM_StateMachine *s, GSM_File *File)
+{
+	return s->Phone.Data.FileStream == File && File->Buffer == NULL;
+}
+
+GSM_Error PHONE_AppendFileData(GSM_StateMachine *s, GSM_File *File, const unsigned char *Data, size_t Length)
+{
+	unsigned char *buffer;
+	GSM_Error error;
+
+	if (Length == 0) {
+		return ERR_NONE;
+	}
+
+	if (PHONE_IsFileStream(s, File) && s->User.FileWrite != NULL) {
+		error = s->User.FileWrite(s, File, Data, Length, s->User.FileStreamUserData);
+		if (error != ERR_NONE) {
+			return error;
+		}
+		File->Used += Length;
+		s->Phone.Data.FileStreamed = File->Used;
+		return ERR_NONE;
+	}
+
+	buffer = (unsigned char *)realloc(File->Buffer, File->Used + Length);
+	if (buffer == NULL) {
+		return ERR_MOREMEMORY;
+	}
+	File->Buffer = buffer;
+	memcpy(File->Buffer + File->Used, Data, Length);
+	File->Used += Length;
+	return ERR_NONE;
+}
+
+GSM_Error PHONE_ReadFileData(GSM_StateMachine *s, GSM_File *File, size_t Offset, unsigned char *Data, size_t Length)
+{
+	if (Length == 0) {
+		return ERR_NONE;
+	}
+
+	if (PHONE_IsFileStream(s, File) && s->User.FileRead != NULL) {
+		return s->User.FileRead(s, File, Offset, Data, Length, s->User.FileStreamUserData);
+	}
+
+	if (File->Buffer == NULL || Offset + Length > File->Used) {
+		return ERR_BUG;
+	}
+	memcpy(Data, File->Buffer + Offset, Length);
+	return ERR_NONE;
+}
+
 GSM_Error NoneReply(GSM_Protocol_Message *msg UNUSED, GSM_StateMachine *s)
 {
 	smprintf(s,"None answer\n");
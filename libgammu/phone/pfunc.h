@@ -44,6 +44,24 @@ GSM_Error NoneReply(GSM_Protocol_Message *msg, GSM_StateMachine *s);
 
 GSM_Error PHONE_FindDataFile(GSM_StateMachine *s, GSM_File * File, const char *ExtraPath, const char *filename);
 GSM_Error PHONE_UploadFile(GSM_StateMachine *s, GSM_File * File);
+
+/**
+ * Checks whether data of file are transferred through user stream
+ * callbacks instead of File->Buffer.
+ */
+gboolean PHONE_IsFileStream(GSM_StateMachine *s, GSM_File *File);
+
+/**
+ * Appends received data to file, either to File->Buffer or to user
+ * stream callback. File->Used is increased in both cases.
+ */
+GSM_Error PHONE_AppendFileData(GSM_StateMachine *s, GSM_File *File, const unsigned char *Data, size_t Length);
+
+/**
+ * Reads data of file being uploaded from given offset, either from
+ * File->Buffer or from user stream callback.
+ */
+GSM_Error PHONE_ReadFileData(GSM_StateMachine *s, GSM_File *File, size_t Offset, unsigned char *Data, size_t Length);
 #endif
 /*@}*/
 /*@}*/
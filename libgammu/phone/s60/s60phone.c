@@ -2105,6 +2105,7 @@ GSM_Phone_Functions S60Phone = {
 	NOTIMPLEMENTED,			/*	SetSMS			*/
 	NOTIMPLEMENTED,			/*	AddSMS			*/
 	S60_DeleteSMS,
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	S60_SendSMS,
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -2193,7 +2194,8 @@ GSM_Phone_Functions S60Phone = {
 	S60_GetScreenshot,
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect		*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 #endif
 
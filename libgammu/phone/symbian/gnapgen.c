@@ -1897,6 +1897,7 @@ GSM_Phone_Functions GNAPGENPhone = {
 	NOTSUPPORTED,			/*	SetSMS			*/
 	GNAPGEN_AddSMS,
 	GNAPGEN_DeleteSMSMessage,
+	NOTIMPLEMENTED,			/* 	DeleteSMSBatch		*/
 	GNAPGEN_SendSMSMessage,
 	NOTSUPPORTED,			/*	SendSavedSMS		*/
 	NOTSUPPORTED,			/*	SetFastSMSSending	*/
@@ -1985,7 +1986,8 @@ GSM_Phone_Functions GNAPGENPhone = {
 	NOTSUPPORTED,			/* 	GetScreenshot		*/
 	NOTSUPPORTED,			/* 	SetPower		*/
 	NOTSUPPORTED,			/* 	PostConnect	*/
-	NONEFUNCTION			/*	PreAPICall		*/
+	NONEFUNCTION,			/*	PreAPICall		*/
+	NOTSUPPORTED			/*	GetPhoneStatus		*/
 };
 
 #endif
@@ -249,7 +249,8 @@ GSM_Protocol_Functions ALCABUSProtocol = {
 	ALCABUS_WriteMessage,
 	ALCABUS_StateMachine,
 	ALCABUS_Initialise,
-	ALCABUS_Terminate
+	ALCABUS_Terminate,
+	NULL
 };
 
 #endif
@@ -220,6 +220,11 @@ GSM_Error AT_StateMachine(GSM_StateMachine *s, unsigned char rx_char)
 						i++;
 						continue;
 					}
+					/* Replies to queries within compound command */
+					if (s->Phone.Data.RequestID == ID_CompoundCommand &&
+							SpecialAnswers[i].requestid != ID_All) {
+						continue;
+					}
 					if ((s->Phone.Data.RequestID == ID_SetOBEX || s->Phone.Data.RequestID == ID_DialVoice)&&
 							strcmp(SpecialAnswers[i].text, "NO CARRIER") == 0) {
 						i++;
@@ -343,7 +348,8 @@ GSM_Protocol_Functions ATProtocol = {
 	AT_WriteMessage,
 	AT_StateMachine,
 	AT_Initialise,
-	AT_Terminate
+	AT_Terminate,
+	NULL
 };
 
 #endif
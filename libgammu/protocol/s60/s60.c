@@ -28,106 +28,149 @@
 #include "s60.h"
 #include "s60-ids.h"
 
+#if MAX_LENGTH + 20 > S60_WRITE_BUFFER_SIZE
+#error S60_WRITE_BUFFER_SIZE is too small
+#endif
+
 static GSM_Error S60_WriteMessage (GSM_StateMachine *s, unsigned const char *MsgBuffer,
 				    size_t MsgLength, int MsgType)
 {
-	unsigned char	*buffer=NULL;
-	int pos, sent, length, buflen, bufpos;
-	GSM_Error error;
+	GSM_Protocol_S60Data *d = &s->Protocol.Data.S60;
+	unsigned char	*buffer = d->WriteBuffer;
+	size_t pos = 0, length;
+	int type, bufpos;
+	ssize_t sent;
 
 	/* No type */
 	if (MsgType == 0) {
 		return ERR_NONE;
 	}
 
-	/* Allocate buffer for composing message */
-	buflen = MIN(MAX_LENGTH, MsgLength) + 10;
-	buffer = (unsigned char *)malloc(buflen);
-	if (buffer == NULL) {
-		return ERR_MOREMEMORY;
-	}
-
-	/* Send message parts */
-	for (pos = 0; MsgLength - pos > MAX_LENGTH; pos += MAX_LENGTH) {
-		error = S60_WriteMessage(s, MsgBuffer + pos, MAX_LENGTH, NUM_PARTIAL_MESSAGE);
-		if (error != ERR_NONE) {
-			free(buffer);
-			return ERR_DEVICEWRITEERROR;
+	/*
+	 * Each part is composed in preallocated buffer and sent by
+	 * single write, all but last one are partial messages.
+	 */
+	do {
+		length = MsgLength - pos;
+		type = MsgType;
+		if (length > MAX_LENGTH) {
+			length = MAX_LENGTH;
+			type = NUM_PARTIAL_MESSAGE;
 		}
-	}
 
-	/* Send final message */
-	buffer[0] = MsgType;
-	length = MsgLength - pos;
+		bufpos = sprintf((char *)buffer, "%d%c", type, NUM_END_HEADER);
+		memcpy(buffer + bufpos, MsgBuffer + pos, length);
+		buffer[bufpos + length] = '\n';
+		pos += length;
+		length += bufpos + 1;
 
-	bufpos = snprintf(buffer, buflen, "%d%c", MsgType, NUM_END_HEADER);
-	memcpy(buffer + bufpos, MsgBuffer + pos, length);
-	buffer[bufpos + length] = '\n';
-	length += bufpos + 1;
+		/* Debugging */
+		GSM_DumpMessageBinary(s, buffer, length, type);
+		GSM_DumpMessageText(s, buffer, length, type);
 
-	/* Debugging */
-	GSM_DumpMessageBinary(s, buffer, length, MsgType);
-	GSM_DumpMessageText(s, buffer, length, MsgType);
+		sent = s->Device.Functions->WriteDevice(s, buffer, length);
+		if (sent < 0 || (size_t)sent != length) {
+			return ERR_DEVICEWRITEERROR;
+		}
+	} while (pos < MsgLength);
 
-	sent = s->Device.Functions->WriteDevice(s, buffer, length);
-	free(buffer);
-	if (sent != length) {
-		return ERR_DEVICEWRITEERROR;
+	return ERR_NONE;
+}
+
+/**
+ * Appends received data to message, buffer grows geometrically to
+ * avoid copying data for each received block.
+ */
+static GSM_Error S60_AppendData(GSM_Protocol_S60Data *d, const unsigned char *buffer, size_t length)
+{
+	size_t size;
+
+	if (d->Msg.BufferUsed < d->Msg.Length + length + 1) {
+		size = MAX(d->Msg.BufferUsed * 2, 256);
+		size = MAX(size, d->Msg.Length + length + 1);
+		d->Msg.Buffer = (unsigned char *)realloc(d->Msg.Buffer, size);
+		if (d->Msg.Buffer == NULL) {
+			d->Msg.BufferUsed = 0;
+			d->Msg.Length = 0;
+			return ERR_MOREMEMORY;
+		}
+		d->Msg.BufferUsed = size;
 	}
 
+	memcpy(d->Msg.Buffer + d->Msg.Length, buffer, length);
+	d->Msg.Length += length;
+	d->Msg.Buffer[d->Msg.Length] = 0;
+
 	return ERR_NONE;
 }
 
-static GSM_Error S60_StateMachine(GSM_StateMachine *s, unsigned char rxchar)
+static GSM_Error S60_StateMachineBlock(GSM_StateMachine *s, const unsigned char *buffer, size_t length)
 {
 	GSM_Protocol_S60Data *d = &s->Protocol.Data.S60;
+	const unsigned char *end;
+	size_t chunk, idlength;
+	GSM_Error error;
 
-	/* Did we complete part of packet? */
-	switch (d->State) {
-		case S60_Header:
-			if (rxchar == NUM_END_HEADER) {
-				d->Msg.Type = atoi(d->idbuffer);
-				d->State = S60_Data;
-				d->idpos = 0;
-			} else {
-				d->idbuffer[d->idpos++] = rxchar;
+	while (length > 0) {
+		switch (d->State) {
+			case S60_Header:
+				end = memchr(buffer, NUM_END_HEADER, length);
+				chunk = (end == NULL) ? length : (size_t)(end - buffer);
+
+				/* Store ID, ignoring what does not fit */
+				idlength = MIN(chunk, sizeof(d->idbuffer) - 1 - (size_t)d->idpos);
+				memcpy(d->idbuffer + d->idpos, buffer, idlength);
+				d->idpos += idlength;
 				d->idbuffer[d->idpos] = 0;
-			}
-			break;
-		case S60_Data:
-			if (rxchar == NUM_END_TEXT) {
-				d->State = S60_Header;
-				/* Should we wait for other parts? */
-				if (d->Msg.Type == NUM_PARTIAL_MESSAGE) {
-					return ERR_NONE;
+
+				if (end != NULL) {
+					d->Msg.Type = atoi(d->idbuffer);
+					d->State = S60_Data;
+					d->idpos = 0;
+					chunk++;
 				}
+				break;
+			case S60_Data:
+				end = memchr(buffer, NUM_END_TEXT, length);
+				chunk = (end == NULL) ? length : (size_t)(end - buffer);
+
+				/* Store received data */
+				error = S60_AppendData(d, buffer, chunk);
+				if (error != ERR_NONE) {
+					return error;
+				}
+
+				if (end != NULL) {
+					chunk++;
+					d->State = S60_Header;
 
-				/* We've got data to process */
-				s->Phone.Data.RequestMsg = &d->Msg;
-				s->Phone.Data.DispatchError = s->Phone.Functions->DispatchMessage(s);
-
-				/* Reset message length */
-				d->Msg.Length = 0;
-			} else {
-				/* Allocate buffer */
-				if (d->Msg.BufferUsed < d->Msg.Length + 2) {
-					d->Msg.BufferUsed = d->Msg.Length + 2;
-					d->Msg.Buffer = (unsigned char *)realloc(d->Msg.Buffer, d->Msg.BufferUsed);
-					if (d->Msg.Buffer == NULL) {
-						return ERR_MOREMEMORY;
+					/* Should we wait for other parts? */
+					if (d->Msg.Type != NUM_PARTIAL_MESSAGE) {
+						/* We've got data to process */
+						s->Phone.Data.RequestMsg = &d->Msg;
+						s->Phone.Data.DispatchError = s->Phone.Functions->DispatchMessage(s);
+
+						/* Reset message length */
+						d->Msg.Length = 0;
 					}
 				}
-
-				/* Store received byte */
-				d->Msg.Buffer[d->Msg.Length++] = rxchar;
-				d->Msg.Buffer[d->Msg.Length] = 0;
-			}
-			break;
+				break;
+			default:
+				chunk = length;
+				break;
+		}
+		buffer += chunk;
+		length -= chunk;
 	}
 
 	return ERR_NONE;
 }
 
+static GSM_Error S60_StateMachine(GSM_StateMachine *s, unsigned char rxchar)
+{
+	return S60_StateMachineBlock(s, &rxchar, 1);
+}
+
 static GSM_Error S60_Initialise(GSM_StateMachine *s)
 {
 	GSM_Protocol_S60Data *d = &s->Protocol.Data.S60;
@@ -145,6 +188,7 @@ static GSM_Error S60_Terminate(GSM_StateMachine *s)
 {
 	free(s->Protocol.Data.S60.Msg.Buffer);
 	s->Protocol.Data.S60.Msg.Buffer = NULL;
+	s->Protocol.Data.S60.Msg.BufferUsed = 0;
 
 	return ERR_NONE;
 }
@@ -153,7 +197,8 @@ GSM_Protocol_Functions S60Protocol = {
 	S60_WriteMessage,
 	S60_StateMachine,
 	S60_Initialise,
-	S60_Terminate
+	S60_Terminate,
+	S60_StateMachineBlock
 };
 
 #endif
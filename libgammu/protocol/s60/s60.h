@@ -25,11 +25,18 @@ typedef enum {
 	S60_Data,
 } S60_State;
 
+/**
+ * Size of buffer for composing outgoing frames, it has to fit
+ * MAX_LENGTH bytes of data with header.
+ */
+#define S60_WRITE_BUFFER_SIZE 640
+
 typedef struct {
 	GSM_Protocol_Message Msg;
 	S60_State State;
 	char idbuffer[20];
 	int idpos;
+	unsigned char WriteBuffer[S60_WRITE_BUFFER_SIZE];
 } GSM_Protocol_S60Data;
 
 #if defined(GSM_ENABLE_S60)
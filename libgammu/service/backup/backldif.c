@@ -274,7 +274,7 @@ GSM_Error GSM_DecodeLDIFEntry(char *Buffer, size_t *Pos, GSM_MemoryEntry *Pbk)
 	Pbk->EntriesNum = 0;
 
 	while (1) {
-		error = MyGetLine(Buffer, Pos, Line, strlen(Buffer), sizeof(Line), FALSE);
+		error = MyGetLine(Buffer, Pos, Line, GSM_NUL_TERMINATED, sizeof(Line), FALSE);
 		if (error != ERR_NONE) return error;
 		if (strlen(Line) == 0) break;
 		Pbk->Entries[Pbk->EntriesNum].AddError = ERR_NONE;
@@ -496,18 +496,17 @@ GSM_Error GSM_DecodeLDIFEntry(char *Buffer, size_t *Pos, GSM_MemoryEntry *Pbk)
 
 GSM_Error LoadLDIF(const char *FileName, GSM_Backup *backup)
 {
-	GSM_File 		File;
+	GSM_MappedFile		File;
 	GSM_Error		error;
 	GSM_MemoryEntry	Pbk;
 	int			numPbk = 0;
 	size_t			Pos = 0;
 
-	File.Buffer = NULL;
-	error = GSM_ReadFile(FileName, &File);
+	error = GSM_MapFile(FileName, &File);
 	if (error != ERR_NONE) return error;
 
 	while (1) {
-		error = GSM_DecodeLDIFEntry(File.Buffer, &Pos, &Pbk);
+		error = GSM_DecodeLDIFEntry(File.File.Buffer, &Pos, &Pbk);
 		if (error == ERR_EMPTY) {
 			error = ERR_NONE;
 			break;
@@ -531,8 +530,7 @@ GSM_Error LoadLDIF(const char *FileName, GSM_Backup *backup)
 		numPbk++;
 	}
 
-	free(File.Buffer);
-	File.Buffer=NULL;
+	GSM_UnmapFile(&File);
 	return error;
 }
 
@@ -67,18 +67,17 @@ fail:
 
 GSM_Error LoadVCard(const char *FileName, GSM_Backup *backup)
 {
-	GSM_File 		File;
+	GSM_MappedFile		File;
 	GSM_Error		error;
 	GSM_MemoryEntry		Pbk;
 	int			numPbk = 0, numSIM = 0;
 	size_t Pos = 0;
 
-	File.Buffer = NULL;
-	error = GSM_ReadFile(FileName, &File);
+	error = GSM_MapFile(FileName, &File);
 	if (error != ERR_NONE) return error;
 
 	while (1) {
-		error = GSM_DecodeVCARD(NULL, File.Buffer, &Pos, &Pbk, Nokia_VCard21);
+		error = GSM_DecodeVCARD(NULL, File.File.Buffer, &Pos, &Pbk, Nokia_VCard21);
 		if (error == ERR_EMPTY) {
 			error = ERR_NONE;
 			break;
@@ -124,7 +123,7 @@ GSM_Error LoadVCard(const char *FileName, GSM_Backup *backup)
 		}
 	}
 
-	free(File.Buffer);
+	GSM_UnmapFile(&File);
 	return error;
 }
 
@@ -73,19 +73,18 @@ fail:
 
 GSM_Error LoadVCalendarPrivate(const char *FileName, GSM_Backup *backup, GSM_VCalendarVersion CalVer, GSM_VToDoVersion ToDoVer)
 {
-	GSM_File 		File;
+	GSM_MappedFile		File;
 	GSM_Error		error;
 	GSM_CalendarEntry	Calendar;
 	GSM_ToDoEntry		ToDo;
 	int			numCal = 0, numToDo = 0;
 	size_t Pos = 0;
 
-	File.Buffer = NULL;
-	error = GSM_ReadFile(FileName, &File);
+	error = GSM_MapFile(FileName, &File);
 	if (error != ERR_NONE) return error;
 
 	while (1) {
-		error = GSM_DecodeVCALENDAR_VTODO(NULL, File.Buffer, &Pos, &Calendar, &ToDo, CalVer, ToDoVer);
+		error = GSM_DecodeVCALENDAR_VTODO(NULL, File.File.Buffer, &Pos, &Calendar, &ToDo, CalVer, ToDoVer);
 		if (error == ERR_EMPTY) {
 			error = ERR_NONE;
 			break;
@@ -127,8 +126,7 @@ GSM_Error LoadVCalendarPrivate(const char *FileName, GSM_Backup *backup, GSM_VCa
 		}
 	}
 
-	free(File.Buffer);
-	File.Buffer=NULL;
+	GSM_UnmapFile(&File);
 	return error;
 }
 
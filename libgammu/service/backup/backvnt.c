@@ -58,18 +58,17 @@ fail:
 
 GSM_Error LoadVNT(const char *FileName, GSM_Backup *backup)
 {
-	GSM_File 		File;
+	GSM_MappedFile		File;
 	GSM_Error		error;
 	GSM_NoteEntry		Note;
 	int			num = 0;
 	size_t Pos = 0;
 
-	File.Buffer = NULL;
-	error = GSM_ReadFile(FileName, &File);
+	error = GSM_MapFile(FileName, &File);
 	if (error != ERR_NONE) return error;
 
 	while (1) {
-		error = GSM_DecodeVNOTE(File.Buffer, &Pos, &Note);
+		error = GSM_DecodeVNOTE(File.File.Buffer, &Pos, &Note);
 		if (error == ERR_EMPTY) {
 			error = ERR_NONE;
 			break;
@@ -92,8 +91,7 @@ GSM_Error LoadVNT(const char *FileName, GSM_Backup *backup)
 		num++;
 	}
 
-	free(File.Buffer);
-	File.Buffer=NULL;
+	GSM_UnmapFile(&File);
 	return error;
 }
 
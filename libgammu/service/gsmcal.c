@@ -1685,6 +1685,7 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 	gboolean		date_only = FALSE;
 	int		lBuffer;
  	int 		Time=-1;
+	VC_Property	property;
 	char		*rrule = NULL;
 
 	if (!Buffer) return ERR_EMPTY;
@@ -1692,18 +1693,19 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 	Calendar->EntriesNum 	= 0;
 	ToDo->EntriesNum 	= 0;
 	ToDo->Location	 	= 0;
-	lBuffer = strlen(Buffer);
 	trigger.Timezone = -999 * 3600;
 
 	if (CalVer == Mozilla_iCalendar && *Pos ==0) {
+		lBuffer = strlen(Buffer);
 		error = GSM_Make_VCAL_Lines (Buffer, &lBuffer);
 		if (error != ERR_NONE) return error;
 	}
 
 	while (1) {
-		error = MyGetLine(Buffer, Pos, Line, lBuffer, sizeof(Line), TRUE);
+		error = MyGetLine(Buffer, Pos, Line, GSM_NUL_TERMINATED, sizeof(Line), TRUE);
 		if (error != ERR_NONE) return error;
 		if (strlen(Line) == 0) break;
+		VC_ParseProperty(Line, &property);
 
 		switch (Level) {
 		case 0:
@@ -1779,7 +1781,7 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 			/* Read Mozilla calendar entries. Some of them will not be used here. Notably alarm time
 			   can defined in several ways. We will use the trigger value only since this is the value
 			   Mozilla calendar uses when importing ics-files. */
-			if (ReadVCALText(Line, "UID", Buff, CalVer == Mozilla_iCalendar, NULL)) {
+			if (VC_ReadText(&property, "UID", Buff, CalVer == Mozilla_iCalendar, NULL)) {
 				/*  Any use for UIDs? */
 				break;
 			}
@@ -1791,10 +1793,11 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 			}
 
 			if (strstr(Line,"BEGIN:VALARM")) {
-				error = MyGetLine(Buffer, Pos, Line, lBuffer, sizeof(Line), TRUE);
+				error = MyGetLine(Buffer, Pos, Line, GSM_NUL_TERMINATED, sizeof(Line), TRUE);
 				if (error != ERR_NONE) return error;
 				if (strlen(Line) == 0) break;
-				if (ReadVCALText(Line, "TRIGGER;VALUE=DURATION", Buff, CalVer == Mozilla_iCalendar, NULL)) {
+				VC_ParseProperty(Line, &property);
+				if (VC_ReadText(&property, "TRIGGER;VALUE=DURATION", Buff, CalVer == Mozilla_iCalendar, NULL)) {
 					trigger = ReadVCALTriggerTime(DecodeUnicodeString(Buff));
 					break;
 				}
@@ -1816,31 +1819,31 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				break;
 			}
 
-			if ((ReadVCALText(Line, "SUMMARY", Buff, CalVer == Mozilla_iCalendar, NULL))) {
+			if ((VC_ReadText(&property, "SUMMARY", Buff, CalVer == Mozilla_iCalendar, NULL))) {
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_TEXT;
 				CopyUnicodeString(Calendar->Entries[Calendar->EntriesNum].Text, Buff);
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "DESCRIPTION", Buff, CalVer == Mozilla_iCalendar, NULL))) {
+			if ((VC_ReadText(&property, "DESCRIPTION", Buff, CalVer == Mozilla_iCalendar, NULL))) {
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_DESCRIPTION;
 				CopyUnicodeString(Calendar->Entries[Calendar->EntriesNum].Text, Buff);
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if (ReadVCALText(Line, "LOCATION", Buff, CalVer == Mozilla_iCalendar, NULL)) {
+			if (VC_ReadText(&property, "LOCATION", Buff, CalVer == Mozilla_iCalendar, NULL)) {
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_LOCATION;
 				CopyUnicodeString(Calendar->Entries[Calendar->EntriesNum].Text, Buff);
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "X-IRMC-LUID", Buff, CalVer == Mozilla_iCalendar, NULL))) {
+			if ((VC_ReadText(&property, "X-IRMC-LUID", Buff, CalVer == Mozilla_iCalendar, NULL))) {
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_LUID;
 				CopyUnicodeString(Calendar->Entries[Calendar->EntriesNum].Text, Buff);
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "CLASS", Buff, CalVer == Mozilla_iCalendar, NULL))) {
+			if ((VC_ReadText(&property, "CLASS", Buff, CalVer == Mozilla_iCalendar, NULL))) {
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_PRIVATE;
 				if (mywstrncasecmp(Buff, "\0P\0U\0B\0L\0I\0C\0\0", 0)) {
 					Calendar->Entries[Calendar->EntriesNum].Number = 0;
@@ -1850,7 +1853,7 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "DTSTART", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "DTSTART", &Date, &is_date_only)) {
 				Calendar->Entries[Calendar->EntriesNum].Date = Date;
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_START_DATETIME;
 				Time = Calendar->EntriesNum;
@@ -1858,14 +1861,14 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				Calendar->EntriesNum++;
 				if (!is_date_only) date_only = FALSE;
 			}
-			if (ReadVCALDate(Line, "DTEND", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "DTEND", &Date, &is_date_only)) {
 				Calendar->Entries[Calendar->EntriesNum].Date = Date;
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_END_DATETIME;
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 				if (!is_date_only) date_only = FALSE;
 			}
-			if (ReadVCALDate(Line, "DALARM", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "DALARM", &Date, &is_date_only)) {
 				Calendar->Entries[Calendar->EntriesNum].Date = Date;
 				if (CalVer == Siemens_VCalendar) {
 					Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_TONE_ALARM_DATETIME;
@@ -1875,13 +1878,13 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "AALARM", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "AALARM", &Date, &is_date_only)) {
 				Calendar->Entries[Calendar->EntriesNum].Date = Date;
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_TONE_ALARM_DATETIME;
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
 				Calendar->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "LAST-MODIFIED", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "LAST-MODIFIED", &Date, &is_date_only)) {
 				Calendar->Entries[Calendar->EntriesNum].Date = Date;
 				Calendar->Entries[Calendar->EntriesNum].EntryType = CAL_LAST_MODIFIED;
 				Calendar->Entries[Calendar->EntriesNum].AddError = ERR_NONE;
@@ -1918,7 +1921,7 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				GSM_Translate_Category_From_VCal(Line+11, &ToDo->Type);
 			}
 
-			if (ReadVCALText(Line, "UID", Buff, ToDoVer == Mozilla_VToDo, NULL)){
+			if (VC_ReadText(&property, "UID", Buff, ToDoVer == Mozilla_VToDo, NULL)){
 				/*  Any use for UIDs? */
 				break;
 			}
@@ -1930,7 +1933,7 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				break;
 			}
 
-			if (ReadVCALDate(Line, "DUE", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "DUE", &Date, &is_date_only)) {
 				if (ToDo->Entries[ToDo->EntriesNum].Date.Year   != 2037	&&
 				    ToDo->Entries[ToDo->EntriesNum].Date.Month  != 12	&&
 				    ToDo->Entries[ToDo->EntriesNum].Date.Day    != 31	&&
@@ -1941,48 +1944,48 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 					ToDo->EntriesNum++;
 				}
 			}
-			if (ReadVCALDate(Line, "COMLETED", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "COMLETED", &Date, &is_date_only)) {
 				ToDo->Entries[ToDo->EntriesNum].Date = Date;
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_COMPLETED_DATETIME;
 				ToDo->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "DTSTART", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "DTSTART", &Date, &is_date_only)) {
 				ToDo->Entries[ToDo->EntriesNum].Date = Date;
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_START_DATETIME;
 				ToDo->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "DALARM", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "DALARM", &Date, &is_date_only)) {
 				ToDo->Entries[ToDo->EntriesNum].Date = Date;
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_SILENT_ALARM_DATETIME;
 				ToDo->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "LAST-MODIFIED", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "LAST-MODIFIED", &Date, &is_date_only)) {
 				ToDo->Entries[ToDo->EntriesNum].Date = Date;
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_LAST_MODIFIED;
 				ToDo->EntriesNum++;
 			}
-			if (ReadVCALDate(Line, "AALARM", &Date, &is_date_only)) {
+			if (VC_ReadDate(&property, "AALARM", &Date, &is_date_only)) {
 				ToDo->Entries[ToDo->EntriesNum].Date = Date;
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_ALARM_DATETIME;
 				ToDo->EntriesNum++;
 			}
 
-			if ((ReadVCALText(Line, "SUMMARY", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
+			if ((VC_ReadText(&property, "SUMMARY", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_TEXT;
 				CopyUnicodeString(ToDo->Entries[ToDo->EntriesNum].Text, Buff);
 				ToDo->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "DESCRIPTION", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
+			if ((VC_ReadText(&property, "DESCRIPTION", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_DESCRIPTION;
 				CopyUnicodeString(ToDo->Entries[ToDo->EntriesNum].Text, Buff);
 				ToDo->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "LOCATION", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
+			if ((VC_ReadText(&property, "LOCATION", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_LOCATION;
 				CopyUnicodeString(ToDo->Entries[ToDo->EntriesNum].Text, Buff);
 				ToDo->EntriesNum++;
 			}
-			if (ReadVCALText(Line, "PRIORITY", Buff, ToDoVer == Mozilla_VToDo, NULL)) {
+			if (VC_ReadText(&property, "PRIORITY", Buff, ToDoVer == Mozilla_VToDo, NULL)) {
 				if (ToDoVer == Mozilla_VToDo) {
 					if (atoi(DecodeUnicodeString(Buff))>=9) ToDo->Priority = GSM_Priority_High;
 					else if (atoi(DecodeUnicodeString(Buff))>=5) ToDo->Priority = GSM_Priority_Medium;
@@ -2005,12 +2008,12 @@ GSM_Error GSM_DecodeVCALENDAR_VTODO(GSM_Debug_Info *di, char *Buffer, size_t *Po
 				ToDo->Entries[ToDo->EntriesNum].Number	  = 0;
 				ToDo->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "X-IRMC-LUID", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
+			if ((VC_ReadText(&property, "X-IRMC-LUID", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_LUID;
 				CopyUnicodeString(ToDo->Entries[ToDo->EntriesNum].Text, Buff);
 				ToDo->EntriesNum++;
 			}
-			if ((ReadVCALText(Line, "CLASS", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
+			if ((VC_ReadText(&property, "CLASS", Buff, ToDoVer == Mozilla_VToDo, NULL))) {
 				ToDo->Entries[ToDo->EntriesNum].EntryType = TODO_PRIVATE;
 				if (mywstrncasecmp(Buff, "\0P\0U\0B\0L\0I\0C\0", 0)) {
 					ToDo->Entries[ToDo->EntriesNum].Number = 0;
@@ -2033,14 +2036,16 @@ GSM_Error GSM_DecodeVNOTE(char *Buffer, size_t *Pos, GSM_NoteEntry *Note)
 	int	     Level = 0;
 	GSM_Error	error;
 	gboolean	empty = TRUE;
+	VC_Property	property;
 
 	Note->Text[0] = 0;
 	Note->Text[1] = 0;
 
 	while (1) {
-		error = MyGetLine(Buffer, Pos, Line, strlen(Buffer), sizeof(Line), TRUE);
+		error = MyGetLine(Buffer, Pos, Line, GSM_NUL_TERMINATED, sizeof(Line), TRUE);
 		if (error != ERR_NONE) return error;
 		if (strlen(Line) == 0) break;
+		VC_ParseProperty(Line, &property);
 		switch (Level) {
 		case 0:
 			if (strstr(Line,"BEGIN:VNOTE")) Level = 1;
@@ -2051,7 +2056,7 @@ GSM_Error GSM_DecodeVNOTE(char *Buffer, size_t *Pos, GSM_NoteEntry *Note)
 				if (UnicodeLength(Note->Text) == 0) return ERR_EMPTY;
 				return ERR_NONE;
 			}
-			if (ReadVCALText(Line, "BODY",	      Buff, FALSE, NULL)) {
+			if (VC_ReadText(&property, "BODY",	      Buff, FALSE, NULL)) {
 				CopyUnicodeString(Note->Text, Buff);
 				empty = FALSE;
 			}
@@ -6,6 +6,12 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <gammu-keys.h>
 #include <gammu-debug.h>
 
@@ -71,47 +77,143 @@ GSM_Error MakeKeySequence(char *text, GSM_KeyCode *KeyCode, size_t *Length)
 	return ERR_NONE;
 }
 
+/**
+ * Fills file attributes after its content has been loaded.
+ */
+static void GSM_FillFileInfo(GSM_File *File, const struct stat *fileinfo)
+{
+	File->Level = 0;
+	GSM_IdentifyFileFormat(File);
+	File->Protected = FALSE;
+	File->Hidden = FALSE;
+	File->System = FALSE;
+	File->ReadOnly = FALSE; /* @todo TODO get this from permissions? */
+	File->Folder = FALSE;
+
+	File->ModifiedEmpty = TRUE;
+	if (fileinfo != NULL) {
+		File->ModifiedEmpty = FALSE;
+		dbgprintf(NULL, "File info read correctly\n");
+		/* st_mtime is time of last modification of file */
+		Fill_GSM_DateTime(&File->Modified, fileinfo->st_mtime);
+		dbgprintf(NULL, "FillTime: %s\n", OSDate(File->Modified));
+	}
+}
+
 GSM_Error GSM_ReadFile(const char *FileName, GSM_File *File)
 {
-	int 		i = 1000;
+	size_t		allocated = 1000, got;
+	unsigned char	*buffer;
 	FILE		*file;
 	struct stat	fileinfo;
+	gboolean	have_info;
 
 	if (FileName[0] == 0x00) return ERR_UNKNOWN;
+
+	have_info = (stat(FileName, &fileinfo) == 0);
+	if (have_info && fileinfo.st_size > 0) {
+		/* One byte to detect growing file and one for terminating NUL */
+		allocated = fileinfo.st_size + 2;
+	}
+
 	file = fopen(FileName,"rb");
 	if (file == NULL) return ERR_CANTOPENFILE;
 
 	free(File->Buffer);
-	File->Buffer 	= NULL;
 	File->Used 	= 0;
-	while (i == 1000) {
-		File->Buffer 	= (unsigned char *)realloc(File->Buffer,File->Used + 1000);
-		i 		= fread(File->Buffer+File->Used,1,1000,file);
-		File->Used 	= File->Used + i;
+	File->Buffer 	= (unsigned char *)malloc(allocated);
+	if (File->Buffer == NULL) {
+		fclose(file);
+		return ERR_MOREMEMORY;
+	}
+
+	while (1) {
+		got = fread(File->Buffer + File->Used, 1, allocated - File->Used - 1, file);
+		File->Used += got;
+		/* Short read means end of file */
+		if (File->Used + 1 < allocated) break;
+		allocated *= 2;
+		buffer = (unsigned char *)realloc(File->Buffer, allocated);
+		if (buffer == NULL) {
+			free(File->Buffer);
+			File->Buffer = NULL;
+			File->Used = 0;
+			fclose(file);
+			return ERR_MOREMEMORY;
+		}
+		File->Buffer = buffer;
 	}
-	File->Buffer = (unsigned char *)realloc(File->Buffer,File->Used + 1);
 	/* Make it 0 terminated, in case it is needed somewhere (we don't count this to length) */
 	File->Buffer[File->Used] = 0;
 	fclose(file);
 
-	File->Level = 0;
-	GSM_IdentifyFileFormat(File);
-	File->Protected = FALSE;
-	File->Hidden = FALSE;
-	File->System = FALSE;
-	File->ReadOnly = FALSE; /* @todo TODO get this from permissions? */
-	File->Folder = FALSE;
+	GSM_FillFileInfo(File, have_info ? &fileinfo : NULL);
 
-	File->ModifiedEmpty = TRUE;
-	if (stat(FileName,&fileinfo) == 0) {
-		File->ModifiedEmpty = FALSE;
-		dbgprintf(NULL, "File info read correctly\n");
-		/* st_mtime is time of last modification of file */
-		Fill_GSM_DateTime(&File->Modified, fileinfo.st_mtime);
-		dbgprintf(NULL, "FillTime: %s\n", OSDate(File->Modified));
+	return ERR_NONE;
+}
+
+GSM_Error GSM_MapFile(const char *FileName, GSM_MappedFile *Map)
+{
+#ifdef HAVE_MMAP
+	struct stat	fileinfo;
+	long		pagesize;
+	void		*data;
+	int		fd;
+#endif
+
+	Map->MappedLength = 0;
+	Map->File.Buffer = NULL;
+	Map->File.Used = 0;
+
+	if (FileName[0] == 0x00) return ERR_UNKNOWN;
+
+#ifdef HAVE_MMAP
+	fd = open(FileName, O_RDONLY);
+	if (fd < 0) return ERR_CANTOPENFILE;
+
+	pagesize = sysconf(_SC_PAGESIZE);
+	/*
+	 * Tail of last page is zero filled by the kernel, what gives us
+	 * terminating NUL, unless file size is multiple of page size.
+	 */
+	if (fstat(fd, &fileinfo) == 0 && S_ISREG(fileinfo.st_mode) &&
+			fileinfo.st_size > 0 && pagesize > 0 &&
+			fileinfo.st_size % pagesize != 0) {
+		/* Private writable mapping, some parsers modify the buffer */
+		data = mmap(NULL, fileinfo.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			close(fd);
+#ifdef MADV_SEQUENTIAL
+			madvise(data, fileinfo.st_size, MADV_SEQUENTIAL);
+#endif
+			Map->MappedLength = fileinfo.st_size;
+			Map->File.Buffer = (unsigned char *)data;
+			Map->File.Used = fileinfo.st_size;
+			GSM_FillFileInfo(&Map->File, &fileinfo);
+			dbgprintf(NULL, "Mapped %ld bytes of %s\n", (long)Map->MappedLength, FileName);
+			return ERR_NONE;
+		}
 	}
+	close(fd);
+#endif
 
-	return ERR_NONE;
+	return GSM_ReadFile(FileName, &Map->File);
+}
+
+void GSM_UnmapFile(GSM_MappedFile *Map)
+{
+#ifdef HAVE_MMAP
+	if (Map->MappedLength > 0) {
+		munmap(Map->File.Buffer, Map->MappedLength);
+		Map->MappedLength = 0;
+		Map->File.Buffer = NULL;
+		Map->File.Used = 0;
+		return;
+	}
+#endif
+	free(Map->File.Buffer);
+	Map->File.Buffer = NULL;
+	Map->File.Used = 0;
 }
 
 static void GSM_JADFindLine(GSM_File *File, const char *Name, char *Value)
@@ -332,22 +434,24 @@ gboolean ReadVCALInt(char *Buffer, const char *Start, int *Value)
 }
 
 
-gboolean ReadVCALDate(char *Buffer, const char *Start, GSM_DateTime *Date, gboolean *is_date_only)
+gboolean VC_ReadDate(const VC_Property *Property, const char *Start, GSM_DateTime *Date, gboolean *is_date_only)
 {
 	char fullstart[200];
 	unsigned char datestring[200];
 
-	if (!ReadVCALText(Buffer, Start, datestring, FALSE, NULL)) {
-		fullstart[0] = 0;
-		strcat(fullstart, Start);
-		strcat(fullstart, ";VALUE=DATE");
-		if (ReadVCALText(Buffer, fullstart, datestring, FALSE, NULL)) {
+	/* Avoid trying variants for different property */
+	if (Property->Name.Length != strlen(Start) ||
+			strncasecmp(Property->Name.Text, Start, Property->Name.Length) != 0) {
+		return FALSE;
+	}
+
+	if (!VC_ReadText(Property, Start, datestring, FALSE, NULL)) {
+		snprintf(fullstart, sizeof(fullstart), "%s;VALUE=DATE", Start);
+		if (VC_ReadText(Property, fullstart, datestring, FALSE, NULL)) {
 			*is_date_only = TRUE;
 		} else {
-			fullstart[0] = 0;
-			strcat(fullstart, Start);
-			strcat(fullstart, ";VALUE=DATE-TIME");
-			if (! ReadVCALText(Buffer, fullstart, datestring, FALSE, NULL)) {
+			snprintf(fullstart, sizeof(fullstart), "%s;VALUE=DATE-TIME", Start);
+			if (! VC_ReadText(Property, fullstart, datestring, FALSE, NULL)) {
 				return FALSE;
 			}
 		}
@@ -362,6 +466,16 @@ gboolean ReadVCALDate(char *Buffer, const char *Start, GSM_DateTime *Date, gbool
 	return FALSE;
 }
 
+gboolean ReadVCALDate(char *Buffer, const char *Start, GSM_DateTime *Date, gboolean *is_date_only)
+{
+	VC_Property property;
+
+	if (!VC_ParseProperty(Buffer, &property)) {
+		return FALSE;
+	}
+	return VC_ReadDate(&property, Start, Date, is_date_only);
+}
+
 
 GSM_Error VC_StoreText(char *Buffer, const size_t buff_len, size_t *Pos, const unsigned char *Text, const char *Start, const gboolean UTF8)
 {
@@ -460,9 +574,89 @@ unsigned char *VCALGetTextPart(unsigned char *Buff, int *pos)
 	return tmp;
 }
 
+gboolean VC_ParseProperty(const char *Buffer, VC_Property *Property)
+{
+	const char *pos = Buffer;
+	VC_Token *param;
+
+	Property->ParamsNum = 0;
+	Property->Value.Text = "";
+	Property->Value.Length = 0;
+
+	/* Property name */
+	Property->Name.Text = pos;
+	pos += strcspn(pos, ";:");
+	Property->Name.Length = pos - Buffer;
+
+	/* Parameters */
+	while (*pos == ';') {
+		pos++;
+		if (Property->ParamsNum >= VC_MAX_PARAMS) {
+			dbgprintf(NULL, "Too many parameters! (stopped at string: %s)\n", pos);
+			goto fail;
+		}
+		param = &Property->Params[Property->ParamsNum++];
+		param->Text = pos;
+		pos += strcspn(pos, ";:");
+		param->Length = pos - param->Text;
+	}
+
+	if (*pos != ':') {
+		goto fail;
+	}
+
+	/* Value */
+	pos++;
+	Property->Value.Text = pos;
+	Property->Value.Length = strlen(pos);
+	return TRUE;
+fail:
+	/* Make sure nothing matches invalid line */
+	Property->Name.Length = 0;
+	Property->ParamsNum = 0;
+	return FALSE;
+}
+
+/**
+ * Compares token with NUL terminated string, ignoring case.
+ */
+static gboolean VC_TokenIs(const char *Text, size_t Length, const char *Match)
+{
+	return strlen(Match) == Length && strncasecmp(Text, Match, Length) == 0;
+}
+
+/**
+ * Compares token start with NUL terminated string, ignoring case.
+ */
+static gboolean VC_TokenStarts(const char *Text, size_t Length, const char *Match)
+{
+	size_t len = strlen(Match);
+
+	return len <= Length && strncasecmp(Text, Match, len) == 0;
+}
+
+/**
+ * Marks first not yet matched token from Start which is equal to given
+ * text.
+ */
+static gboolean VC_MatchToken(VC_Token *Tokens, size_t NumTokens, gboolean *Matched, const char *Text, size_t Length)
+{
+	size_t i;
+
+	for (i = 1; i < NumTokens; i++) {
+		if (!Matched[i] && Tokens[i].Length == Length &&
+				strncasecmp(Tokens[i].Text, Text, Length) == 0) {
+			Matched[i] = TRUE;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
 /**
  * We separate matching text (Start) to tokens and then try to find all
- * tokens in Buffer. We also accept tokens like PREF, CHARSET or ENCODING.
+ * tokens in parameters of parsed property. We also accept tokens like
+ * PREF, CHARSET or ENCODING.
  *
  * Also it parses TYPE=* tokens, matching it to text types passed in Start
  * parameter. For example Start "TEL;FAX;VOICE" matches "TEL;TYPE=FAX,VOICE"
@@ -471,247 +665,135 @@ unsigned char *VCALGetTextPart(unsigned char *Buff, int *pos)
  *
  * When all tokens are matched we found matching line.
  */
-gboolean ReadVCALText(char *Buffer, const char *Start, unsigned char *Value, const gboolean UTF8, GSM_EntryLocation *location)
+gboolean VC_ReadText(const VC_Property *Property, const char *Start, unsigned char *Value, const gboolean UTF8, GSM_EntryLocation *location)
 {
-	char *line = NULL;
-	char **tokens = NULL;
-	char *charset = NULL;
-	char *begin, *pos, *end, *end2;
+	VC_Token tokens[VC_MAX_PARAMS + 1];
+	gboolean matched[VC_MAX_PARAMS + 1];
+	const VC_Token *param;
+	const char *charset = NULL, *pos, *end;
+	size_t charset_len = 0;
+	size_t numtokens, token, len;
+	size_t i, j, item;
 	gboolean quoted_printable = FALSE;
-	size_t numtokens, token;
-	size_t i, j, len;
-	gboolean found;
-	gboolean ret = FALSE;
 
 	/* Initialize output */
 	Value[0] = 0x00;
 	Value[1] = 0x00;
 
-	/* Count number of tokens */
-	len = strlen(Start);
-	numtokens = 1;
-	for (i = 0; i < len; i++) {
-		if (Start[i] == ';') {
-			numtokens++;
-		}
-	}
-
-	/* Allocate memory */
-	line = strdup(Start);
-	if (line == NULL) {
-		dbgprintf(NULL, "Could not alloc!\n");
-		goto fail;
-	}
-	tokens = (char **)malloc(sizeof(char *) * numtokens);
-	if (tokens == NULL) {
-		dbgprintf(NULL, "Could not alloc!\n");
-		goto fail;
+	/* Compare first token, it must be in place */
+	len = strcspn(Start, ";");
+	if (Property->Name.Length != len || strncasecmp(Property->Name.Text, Start, len) != 0) {
+		return FALSE;
 	}
 
 	/* Parse Start to vCard tokens (separated by ;) */
-	token = 0;
-	begin = line;
-	for (i = 0; i < len; i++) {
-		if (line[i] == ';') {
-			tokens[token++] = begin;
-			begin = line + i + 1;
-			line[i] = 0;
+	numtokens = 0;
+	pos = Start;
+	while (TRUE) {
+		if (numtokens > VC_MAX_PARAMS) {
+			dbgprintf(NULL, "Too many tokens in %s!\n", Start);
+			return FALSE;
 		}
+		len = strcspn(pos, ";");
+		tokens[numtokens].Text = pos;
+		tokens[numtokens].Length = len;
+		/* No need to check name anymore */
+		matched[numtokens] = (numtokens == 0);
+		numtokens++;
+		if (pos[len] == 0) {
+			break;
+		}
+		pos += len + 1;
 	}
-	/* Store last token */
-	tokens[token] = begin;
 
-	/* Compare first token, it must be in place */
-	pos = Buffer;
-	len = strlen(tokens[0]);
-	if (strncasecmp(pos, tokens[0], len) != 0) {
-		goto fail;
-	}
-	/* Advance position */
-	pos += len;
-	/* No need to check this token anymore */
-	tokens[0][0] = 0;
 	/* Initialize location */
 	if (location != NULL) {
 		*location = PBK_Location_Unknown;
 	}
 
-	/* Check remaining tokens */
-	while (*pos != ':') {
-		if (*pos == ';') {
-			pos++;
-		} else {
-			dbgprintf(NULL, "Could not parse! (stopped at string: %s)\n", pos);
-			goto fail;
-		}
-		found = FALSE;
-		for (token = 0; token < numtokens; token++) {
-			len = strlen(tokens[token]);
-			/* Skip already matched tokens */
-			if (len == 0) {
-				continue;
-			}
-			if (strncasecmp(pos, tokens[token], len) == 0) {
-				dbgprintf(NULL, "Found %s\n", tokens[token]);
-				/* Advance position */
-				pos += len;
-				/* We need to check one token less */
-				tokens[token][0] = 0;
-				found = TRUE;
-				break;
-			}
+	/* Check parameters */
+	for (i = 0; i < Property->ParamsNum; i++) {
+		param = &Property->Params[i];
+		if (VC_MatchToken(tokens, numtokens, matched, param->Text, param->Length)) {
+			continue;
 		}
-		if (!found) {
-			if (strncasecmp(pos, "ENCODING=QUOTED-PRINTABLE", 25) == 0) {
-				quoted_printable = TRUE;
-				/* Advance position */
-				pos += 25;
-				found = TRUE;
-			} else if (strncasecmp(pos, "CHARSET=", 8) == 0) {
-				/* Advance position */
-				pos += 8;
-				/* Grab charset */
-				end = strchr(pos, ':');
-				end2 = strchr(pos, ';');
-				if (end == NULL && end2 == NULL) {
-					dbgprintf(NULL, "Could not read charset!\n");
-					goto fail;
-				} else if (end == NULL) {
-					end = end2;
-				} else if (end2 != NULL && end2 < end) {
-					end = end2;
-				}
-				/* We basically want strndup, but it is not portable */
-				charset = strdup(pos);
-				if (charset == NULL) {
-					dbgprintf(NULL, "Could not alloc!\n");
-					goto fail;
-				}
-				charset[end - pos] = 0;
-
-				pos = end;
-				found = TRUE;
-			} else if (strncasecmp(pos, "TZID=", 5) == 0) {
-				/* @todo: We ignore time zone for now */
-				/* Advance position */
-				pos += 5;
-				/* Go behind value */
-				end = strchr(pos, ':');
-				end2 = strchr(pos, ';');
-				if (end == NULL && end2 == NULL) {
-					dbgprintf(NULL, "Could not read timezone!\n");
-					goto fail;
-				} else if (end == NULL) {
-					end = end2;
-				} else if (end2 != NULL && end2 < end) {
-					end = end2;
-				}
-				pos = end;
-				found = TRUE;
-			} else if (strncasecmp(pos, "TYPE=", 5) == 0) {
-				/* We ignore TYPE= prefix */
-				pos += 5;
-
-				/* Now process types, which should be comma separated */
-				while (*pos != ':' && *pos != ';') {
-					found = FALSE;
-
-					/* Go through tokens to match */
-					for (token = 0; token < numtokens; token++) {
-						len = strlen(tokens[token]);
-						/* Skip already matched tokens */
-						if (len == 0) {
-							continue;
-						}
-						if (strncasecmp(pos, tokens[token], len) == 0) {
-							dbgprintf(NULL, "Found %s\n", tokens[token]);
-							/* Advance position */
-							pos += len;
-							/* We need to check one token less */
-							tokens[token][0] = 0;
-							found = TRUE;
-							break;
-						}
+		if (VC_TokenIs(param->Text, param->Length, "ENCODING=QUOTED-PRINTABLE")) {
+			quoted_printable = TRUE;
+		} else if (VC_TokenStarts(param->Text, param->Length, "CHARSET=")) {
+			charset = param->Text + 8;
+			charset_len = param->Length - 8;
+		} else if (VC_TokenStarts(param->Text, param->Length, "TZID=")) {
+			/* @todo: We ignore time zone for now */
+		} else if (VC_TokenStarts(param->Text, param->Length, "TYPE=")) {
+			/* Now process types, which should be comma separated */
+			pos = param->Text + 5;
+			len = param->Length - 5;
+			for (item = 0; ; item++) {
+				end = memchr(pos, ',', len);
+				j = (end == NULL) ? len : (size_t)(end - pos);
+
+				if (j == 0) {
+					/* Tolerate trailing separator */
+					if (end == NULL && item > 0) {
+						break;
 					}
+					dbgprintf(NULL, "Could not parse TYPE=! (%s)\n", Start);
+					return FALSE;
+				}
 
-					if (!found) {
-						if (strncasecmp(pos, "PREF", 4) == 0) {
-							/* We ignore pref token */
-							pos += 4;
-							found = TRUE;
-						} else if (strncasecmp(pos, "WORK", 4) == 0) {
-							/* We ignore work token */
-							pos += 4;
-							found = TRUE;
-							if (location != NULL) {
-								*location = PBK_Location_Work;
-							}
-						} else if (strncasecmp(pos, "HOME", 4) == 0) {
-							/* We ignore home token */
-							pos += 4;
-							found = TRUE;
-							if (location != NULL) {
-								*location = PBK_Location_Home;
-							}
-						} else {
-							dbgprintf(NULL, "%s not found! (%s)\n", Start, pos);
-							goto fail;
-						}
+				if (VC_MatchToken(tokens, numtokens, matched, pos, j)) {
+					/* Matched */
+				} else if (VC_TokenIs(pos, j, "PREF")) {
+					/* We ignore pref token */
+				} else if (VC_TokenIs(pos, j, "WORK")) {
+					if (location != NULL) {
+						*location = PBK_Location_Work;
 					}
-
-					if (*pos == ';' || *pos == ':') {
-						dbgprintf(NULL, "End of TYPE= string\n");
-						break;
-					} else if (*pos == ',') {
-						/* Advance past separator */
-						pos++;
-					} else {
-						dbgprintf(NULL, "Could not parse TYPE=! (stopped at string: %s)\n", pos);
-						goto fail;
+				} else if (VC_TokenIs(pos, j, "HOME")) {
+					if (location != NULL) {
+						*location = PBK_Location_Home;
 					}
+				} else {
+					dbgprintf(NULL, "%s not found!\n", Start);
+					return FALSE;
+				}
 
+				if (end == NULL) {
+					break;
 				}
-			} else if (strncasecmp(pos, "PREF", 4) == 0) {
-				/* We ignore pref token */
-				pos += 4;
-				found = TRUE;
-			} else if (location && strncasecmp(pos, "WORK", 4) == 0) {
-				/* We ignore pref token */
-				pos += 4;
-				found = TRUE;
-				*location = PBK_Location_Work;
-			} else if (location && strncasecmp(pos, "HOME", 4) == 0) {
-				/* We ignore pref token */
-				pos += 4;
-				found = TRUE;
-				*location = PBK_Location_Home;
-			}
-			if (!found) {
-				dbgprintf(NULL, "%s not found!\n", Start);
-				goto fail;
+				/* Advance past separator */
+				pos += j + 1;
+				len -= j + 1;
 			}
+		} else if (VC_TokenIs(param->Text, param->Length, "PREF")) {
+			/* We ignore pref token */
+		} else if (location && VC_TokenIs(param->Text, param->Length, "WORK")) {
+			*location = PBK_Location_Work;
+		} else if (location && VC_TokenIs(param->Text, param->Length, "HOME")) {
+			*location = PBK_Location_Home;
+		} else {
+			dbgprintf(NULL, "%s not found!\n", Start);
+			return FALSE;
 		}
 	}
-	/* Skip : */
-	pos++;
-	/* Length of rest */
-	len = strlen(pos);
 
 	/* Did we match all our tokens? */
 	for (token = 0; token < numtokens; token++) {
-		if (strlen(tokens[token]) > 0) {
+		if (!matched[token]) {
 			dbgprintf(NULL, "All tokens did not match!\n");
-			goto fail;
+			return FALSE;
 		}
 	}
 
 	/* Decode the text */
+	pos = Property->Value.Text;
+	len = Property->Value.Length;
 	if (charset == NULL) {
 		if (quoted_printable) {
 			if (UTF8) {
 				DecodeUTF8QuotedPrintable(Value, pos, len);
 			} else {
-				DecodeISO88591QuotedPrintable(Value, pos, len);
+				DecodeISO88591QuotedPrintable(Value, (const unsigned char *)pos, len);
 			}
 		} else {
 			if (UTF8) {
@@ -721,26 +803,26 @@ gboolean ReadVCALText(char *Buffer, const char *Start, unsigned char *Value, con
 			}
 		}
 	} else {
-		if (strcasecmp(charset, "UTF-8") == 0||
-				strcasecmp(charset, "\"UTF-8\"") == 0
+		if (VC_TokenIs(charset, charset_len, "UTF-8") ||
+				VC_TokenIs(charset, charset_len, "\"UTF-8\"")
 				) {
 			if (quoted_printable) {
 				DecodeUTF8QuotedPrintable(Value, pos, len);
 			} else {
 				DecodeUTF8(Value, pos, len);
 			}
-		} else if (strcasecmp(charset, "UTF-7") == 0||
-				strcasecmp(charset, "\"UTF-7\"") == 0
+		} else if (VC_TokenIs(charset, charset_len, "UTF-7") ||
+				VC_TokenIs(charset, charset_len, "\"UTF-7\"")
 				) {
 			if (quoted_printable) {
-				dbgprintf(NULL, "Unsupported charset: %s\n", charset);
-				goto fail;
+				dbgprintf(NULL, "Unsupported charset: %.*s\n", (int)charset_len, charset);
+				return FALSE;
 			} else {
-				DecodeUTF7(Value, pos, len);
+				DecodeUTF7(Value, (const unsigned char *)pos, len);
 			}
 		} else {
-			dbgprintf(NULL, "Unsupported charset: %s\n", charset);
-			goto fail;
+			dbgprintf(NULL, "Unsupported charset: %.*s\n", (int)charset_len, charset);
+			return FALSE;
 		}
 	}
 
@@ -775,16 +857,22 @@ gboolean ReadVCALText(char *Buffer, const char *Start, unsigned char *Value, con
 		}
 	}
 
-	ret = TRUE;
 	dbgprintf(NULL, "ReadVCalText(%s) is \"%s\"\n", Start, DecodeUnicodeConsole(Value));
-fail:
-	free(line);
-	line=NULL;
-	free(tokens);
-	tokens=NULL;
-	free(charset);
-	charset=NULL;
-	return ret;
+	return TRUE;
+}
+
+gboolean ReadVCALText(char *Buffer, const char *Start, unsigned char *Value, const gboolean UTF8, GSM_EntryLocation *location)
+{
+	VC_Property property;
+
+	/* Initialize output */
+	Value[0] = 0x00;
+	Value[1] = 0x00;
+
+	if (!VC_ParseProperty(Buffer, &property)) {
+		return FALSE;
+	}
+	return VC_ReadText(&property, Start, Value, UTF8, location);
 }
 
 void GSM_ClearBatteryCharge(GSM_BatteryCharge *bat)
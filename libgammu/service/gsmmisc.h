@@ -7,6 +7,32 @@
 #include <gammu-info.h>
 #include <gammu-memory.h>
 
+/**
+ * File loaded by GSM_MapFile.
+ */
+typedef struct {
+	/**
+	 * File content and attributes, Buffer is NUL terminated.
+	 */
+	GSM_File File;
+	/**
+	 * Length of memory mapping, zero if Buffer was read to heap.
+	 */
+	size_t MappedLength;
+} GSM_MappedFile;
+
+/**
+ * Maps regular file to memory, falling back to reading it to the heap
+ * in single step. Buffer is private copy, so parsers can modify it, but
+ * it can not be reallocated or freed, use GSM_UnmapFile for that.
+ */
+GSM_Error GSM_MapFile(const char *FileName, GSM_MappedFile *Map);
+
+/**
+ * Releases file loaded by GSM_MapFile.
+ */
+void GSM_UnmapFile(GSM_MappedFile *Map);
+
 /**
  * Resets all members of GSM_BatteryCharge structure.
  */
@@ -25,6 +51,56 @@ GSM_Error VC_Store(char *Buffer, const size_t buff_len, size_t *Pos, const char
 gboolean ReadVCALDateTime(const char *Buffer, GSM_DateTime *dt);
 GSM_Error VC_StoreDateTime(char *Buffer, const size_t buff_len, size_t *Length, const GSM_DateTime *Date, const char *Start);
 
+/**
+ * Maximal number of parameters of single vCalendar/vCard property.
+ */
+#define VC_MAX_PARAMS 16
+
+/**
+ * Part of vCalendar/vCard line, it is not NUL terminated.
+ */
+typedef struct {
+	const char *Text;
+	size_t Length;
+} VC_Token;
+
+/**
+ * vCalendar/vCard line split to property name, parameters and value.
+ * Tokens point to the parsed line, so it has to be kept unchanged while
+ * property is used.
+ */
+typedef struct {
+	VC_Token Name;
+	VC_Token Params[VC_MAX_PARAMS];
+	size_t ParamsNum;
+	VC_Token Value;
+} VC_Property;
+
+/**
+ * Splits vCalendar/vCard line to property name, parameters and value.
+ * Property of line which can not be parsed does not match anything.
+ *
+ * \param Buffer Line to parse.
+ * \param Property Storage for parsed property.
+ */
+gboolean VC_ParseProperty(const char *Buffer, VC_Property *Property);
+
+/**
+ * Reads text from parsed vCalendar/vCard property.
+ *
+ * \param Property Parsed line.
+ * \param Start Start expression of line.
+ * \param Value Storage for value.
+ * \param UTF8 Whether string should be treated as utf-8.
+ * \param location Storage for location, if WORK or HOME are accepted.
+ */
+gboolean VC_ReadText(const VC_Property *Property, const char *Start, unsigned char *Value, const gboolean UTF8, GSM_EntryLocation *location);
+
+/**
+ * Reads date from parsed vCalendar/vCard property.
+ */
+gboolean VC_ReadDate(const VC_Property *Property, const char *Start, GSM_DateTime *Date, gboolean *is_date_only);
+
 gboolean ReadVCALDate(char *Buffer, const char *Start, GSM_DateTime *Date, gboolean *is_date_only);
 GSM_Error VC_StoreDate(char *Buffer, const size_t buff_len, size_t *Length, const GSM_DateTime *Date, const char *Start);
 
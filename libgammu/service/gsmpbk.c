@@ -672,6 +672,90 @@ void GSM_TweakInternationalNumber(unsigned char *Number, const GSM_NumberType nu
 	Pbk->Entries[Pbk->EntriesNum].AddError = ERR_NONE; \
 }
 
+/**
+ * How value of vCard property is stored in memory entry.
+ */
+typedef enum {
+	VCARD_NONE = 0,
+	/* Following properties do not accept location */
+	VCARD_NAME,
+	VCARD_DATE,
+	VCARD_INT,
+	VCARD_LOCATION,
+	VCARD_MEMORY,
+	/* Following properties accept location */
+	VCARD_TEXT,
+	VCARD_NUMBER,
+	VCARD_CATEGORY,
+	VCARD_ADDRESS
+} GSM_VCardPropertyKind;
+
+/**
+ * vCard properties we understand, each line is matched against these in
+ * order and first match is used.
+ */
+static const struct {
+	const char *Start;
+	GSM_VCardPropertyKind Kind;
+	GSM_EntryType Type;
+} VCardProperties[] = {
+	{"N",			VCARD_NAME,	PBK_Text_Name},
+	{"TEL",			VCARD_NUMBER,	PBK_Number_General},
+	{"TEL;VOICE",		VCARD_NUMBER,	PBK_Number_General},
+	{"TEL;MAIN",		VCARD_NUMBER,	PBK_Number_General},
+	{"TEL;VIDEO",		VCARD_NUMBER,	PBK_Number_Video},
+	{"TEL;CELL",		VCARD_NUMBER,	PBK_Number_Mobile},
+	{"TEL;CELL;VOICE",	VCARD_NUMBER,	PBK_Number_Mobile},
+	{"TEL;OTHER",		VCARD_NUMBER,	PBK_Number_Other},
+	{"TEL;OTHER;VOICE",	VCARD_NUMBER,	PBK_Number_Other},
+	{"TEL;PAGER",		VCARD_NUMBER,	PBK_Number_Other},
+	{"TEL;PAGER;VOICE",	VCARD_NUMBER,	PBK_Number_Other},
+	{"TEL;MSG",		VCARD_NUMBER,	PBK_Number_Other},
+	{"TEL;MSG;VOICE",	VCARD_NUMBER,	PBK_Number_Other},
+	/* FAX + VOICE looks like nonsense */
+	{"TEL;FAX",		VCARD_NUMBER,	PBK_Number_Fax},
+	{"TEL;FAX;VOICE",	VCARD_NUMBER,	PBK_Number_Fax},
+	{"TITLE",		VCARD_TEXT,	PBK_Text_JobTitle},
+	{"NOTE",		VCARD_TEXT,	PBK_Text_Note},
+	{"LABEL",		VCARD_ADDRESS,	PBK_Text_Postal},
+	{"ADR",			VCARD_ADDRESS,	PBK_Text_Postal},
+	{"EMAIL",		VCARD_TEXT,	PBK_Text_Email},
+	{"EMAIL;OTHER",		VCARD_TEXT,	PBK_Text_Email},
+	{"EMAIL;INTERNET",	VCARD_TEXT,	PBK_Text_Email},
+	{"X-IRMC-LUID",		VCARD_TEXT,	PBK_Text_LUID},
+	{"X-DTMF",		VCARD_TEXT,	PBK_Text_DTMF},
+	{"X-SIP",		VCARD_TEXT,	PBK_Text_SIP},
+	{"X-SIP;VOIP",		VCARD_TEXT,	PBK_Text_VOIP},
+	{"X-WV-ID",		VCARD_TEXT,	PBK_Text_WVID},
+	{"X-SIP;SWIS",		VCARD_TEXT,	PBK_Text_SWIS},
+	{"X-SIP;POC",		VCARD_TEXT,	PBK_PushToTalkID},
+	{"URL",			VCARD_TEXT,	PBK_Text_URL},
+	{"ORG",			VCARD_TEXT,	PBK_Text_Company},
+	{"NICKNAME",		VCARD_TEXT,	PBK_Text_NickName},
+	{"FN",			VCARD_TEXT,	PBK_Text_FormalName},
+	{"X-NAME-PREFIX",	VCARD_TEXT,	PBK_Text_NamePrefix},
+	{"X-NAME-SUFFIX",	VCARD_TEXT,	PBK_Text_NameSuffix},
+	{"CATEGORIES",		VCARD_CATEGORY,	PBK_Category},
+	{"BDAY",		VCARD_DATE,	PBK_Date},
+	{"LAST-MODIFIED",	VCARD_DATE,	PBK_LastModified},
+	{"X-PRIVATE",		VCARD_INT,	PBK_Private},
+	{"X-CALLER-GROUP",	VCARD_INT,	PBK_Caller_Group},
+	{"X-GAMMU-LOCATION",	VCARD_LOCATION,	0},
+	{"X-GAMMU-MEMORY",	VCARD_MEMORY,	0},
+	{NULL,			VCARD_NONE,	0}
+};
+
+/**
+ * Structured address parts following PO box and extended address.
+ */
+static const GSM_EntryType AddressParts[] = {
+	PBK_Text_StreetAddress,
+	PBK_Text_City,
+	PBK_Text_State,
+	PBK_Text_Zip,
+	PBK_Text_Country,
+};
+
 /**
  * \bug We should avoid using static buffers here.
  */
@@ -685,6 +769,9 @@ GSM_Error GSM_DecodeVCARD(GSM_Debug_Info *di, char *Buffer, size_t *Pos, GSM_Mem
 	GSM_Error	error;
 	char	*Line = NULL;
 	GSM_EntryLocation location;
+	GSM_SubMemoryEntry *Entry;
+	VC_Property	property;
+	int		i, j;
 
 	Buff[0]	 = 0;
 	Pbk->EntriesNum = 0;
@@ -696,7 +783,7 @@ GSM_Error GSM_DecodeVCARD(GSM_Debug_Info *di, char *Buffer, size_t *Pos, GSM_Mem
 	while (1) {
 		free(Line);
 		Line = NULL;
-		error = GSM_GetVCSLine(&Line, Buffer, Pos, strlen(Buffer), TRUE);
+		error = GSM_GetVCSLine(&Line, Buffer, Pos, GSM_NUL_TERMINATED, TRUE);
 		if (error != ERR_NONE) goto vcard_done;
 		if (strlen(Line) == 0) break;
 		switch (Level) {
@@ -712,34 +799,6 @@ GSM_Error GSM_DecodeVCARD(GSM_Debug_Info *di, char *Buffer, size_t *Pos, GSM_Mem
 				version = atoi(Line + 8);
 				dbgprintf(di, "vCard version %d\n", version);
 			}
-			if (ReadVCALText(Line, "N", Buff,  (version >= 3), NULL)) {
-				pos = 0;
-				s = VCALGetTextPart(Buff, &pos);
-				if (s == NULL) {
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Name;
-					Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
-					Pbk->EntriesNum++;
-					continue;
-				} else {
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					/* Skip empty name */
-					if (UnicodeLength(Pbk->Entries[Pbk->EntriesNum].Text) > 0) {
-						Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_LastName;
-						Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
-						Pbk->EntriesNum++;
-					}
-
-					s = VCALGetTextPart(Buff, &pos);
-					if (s == NULL) continue;
-					CHECK_NUM_ENTRIES;
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_FirstName;
-					Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
-					Pbk->EntriesNum++;
-					continue;
-				}
-			}
 			if (strncmp(Line, "PHOTO;JPEG;BASE64:", 18) == 0 ||
 				strncmp(Line, "PHOTO;BASE64;JPEG:", 18) == 0 ||
 				strncmp(Line, "PHOTO;TYPE=JPEG;BASE64:", 23) == 0 ||
@@ -760,8 +819,10 @@ GSM_Error GSM_DecodeVCARD(GSM_Debug_Info *di, char *Buffer, size_t *Pos, GSM_Mem
 
 				/* We allocate here more memory than is actually required */
 				Pbk->Entries[Pbk->EntriesNum].Picture.Buffer = (unsigned char *)malloc(strlen(s));
-				if (Pbk->Entries[Pbk->EntriesNum].Picture.Buffer == NULL)
-					return ERR_MOREMEMORY;
+				if (Pbk->Entries[Pbk->EntriesNum].Picture.Buffer == NULL) {
+					error = ERR_MOREMEMORY;
+					goto vcard_done;
+				}
 
 				Pbk->Entries[Pbk->EntriesNum].Picture.Length =
 					DecodeBASE64(s, Pbk->Entries[Pbk->EntriesNum].Picture.Buffer, strlen(s));
@@ -769,309 +830,112 @@ GSM_Error GSM_DecodeVCARD(GSM_Debug_Info *di, char *Buffer, size_t *Pos, GSM_Mem
 				continue;
 			}
 
-			if (ReadVCALText(Line, "TEL",		   Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;VOICE",	     Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;MAIN",	     Buff,  (version >= 3), &location)) {
-				if (Buff[1] == '+') {
-					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
+			VC_ParseProperty(Line, &property);
+			for (i = 0; VCardProperties[i].Start != NULL; i++) {
+				if (VC_ReadText(&property, VCardProperties[i].Start, Buff, (version >= 3),
+							VCardProperties[i].Kind >= VCARD_TEXT ? &location : NULL)) {
+					break;
 				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_General;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
-				Pbk->EntriesNum++;
-				continue;
 			}
-			if (ReadVCALText(Line, "TEL;VIDEO",	     Buff,  (version >= 3), &location)) {
-				if (Buff[1] == '+') {
-					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
-				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_Video;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "TEL;CELL",	      Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;CELL;VOICE",	Buff,  (version >= 3), &location)) {
-				if (Buff[1] == '+') {
-					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
-				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_Mobile;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
+			Entry = &Pbk->Entries[Pbk->EntriesNum];
+			switch (VCardProperties[i].Kind) {
+			case VCARD_NONE:
+				break;
+			case VCARD_LOCATION:
+				Pbk->Location = atoi(DecodeUnicodeString(Buff));
+				break;
+			case VCARD_MEMORY:
+				Pbk->MemoryType = GSM_StringToMemoryType(DecodeUnicodeString(Buff));
+				break;
+			case VCARD_INT:
+				Entry->Number = atoi(DecodeUnicodeString(Buff));
+				Entry->EntryType = VCardProperties[i].Type;
+				Entry->Location = PBK_Location_Unknown;
 				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "TEL;OTHER",	      Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;OTHER;VOICE",	Buff,  (version >= 3), &location)) {
-				if (Buff[1] == '+') {
-					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
+				break;
+			case VCARD_DATE:
+				if (ReadVCALDateTime(DecodeUnicodeString(Buff), &Entry->Date)) {
+					Entry->EntryType = VCardProperties[i].Type;
+					Entry->Location = PBK_Location_Unknown;
+					Pbk->EntriesNum++;
 				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_Other;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "TEL;PAGER",	      Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;PAGER;VOICE",	Buff,  (version >= 3), &location)) {
-				if (Buff[1] == '+') {
-					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
+				break;
+			case VCARD_NAME:
+				pos = 0;
+				s = VCALGetTextPart(Buff, &pos);
+				if (s == NULL) {
+					CopyUnicodeString(Entry->Text, Buff);
+					Entry->EntryType = PBK_Text_Name;
+					Entry->Location = PBK_Location_Unknown;
+					Pbk->EntriesNum++;
+					break;
 				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_Other;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "TEL;MSG",	      Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;MSG;VOICE",	Buff,  (version >= 3), &location)) {
-				if (Buff[1] == '+') {
-					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
+				CopyUnicodeString(Entry->Text, s);
+				/* Skip empty name */
+				if (UnicodeLength(Entry->Text) > 0) {
+					Entry->EntryType = PBK_Text_LastName;
+					Entry->Location = PBK_Location_Unknown;
+					Pbk->EntriesNum++;
 				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_Other;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
+
+				s = VCALGetTextPart(Buff, &pos);
+				if (s == NULL) break;
+				CHECK_NUM_ENTRIES;
+				Entry = &Pbk->Entries[Pbk->EntriesNum];
+				CopyUnicodeString(Entry->Text, s);
+				Entry->EntryType = PBK_Text_FirstName;
+				Entry->Location = PBK_Location_Unknown;
 				Pbk->EntriesNum++;
-				continue;
-			}
-			/* FAX + VOICE looks like nonsense */
-			if (ReadVCALText(Line, "TEL;FAX",	       Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "TEL;FAX;VOICE",	 Buff,  (version >= 3), &location)) {
+				break;
+			case VCARD_NUMBER:
 				if (Buff[1] == '+') {
 					GSM_TweakInternationalNumber(Buff, NUMBER_INTERNATIONAL_NUMBERING_PLAN_ISDN);
 				}
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Number_Fax;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->Entries[Pbk->EntriesNum].SMSList[0] = 0;
-				Pbk->Entries[Pbk->EntriesNum].VoiceTag = 0;
+				CopyUnicodeString(Entry->Text, Buff);
+				Entry->EntryType = VCardProperties[i].Type;
+				Entry->Location = location;
+				Entry->SMSList[0] = 0;
+				Entry->VoiceTag = 0;
 				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "TITLE", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_JobTitle;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
+				break;
+			case VCARD_TEXT:
+				CopyUnicodeString(Entry->Text, Buff);
+				Entry->EntryType = VCardProperties[i].Type;
+				Entry->Location = location;
 				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "NOTE", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Note;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
+				break;
+			case VCARD_CATEGORY:
+				CopyUnicodeString(Entry->Text, Buff);
+				Entry->Number = -1;
+				Entry->EntryType = VCardProperties[i].Type;
+				Entry->Location = location;
 				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "LABEL", Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "ADR", Buff,  (version >= 3), &location)) {
+				break;
+			case VCARD_ADDRESS:
 				pos = 0;
 				s = VCALGetTextPart(Buff, &pos); /* PO box, ignore for now */
 				if (s == NULL) {
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Postal;
-					Pbk->Entries[Pbk->EntriesNum].Location = location;
+					CopyUnicodeString(Entry->Text, Buff);
+					Entry->EntryType = PBK_Text_Postal;
+					Entry->Location = location;
 					Pbk->EntriesNum++;
-					continue;
-				} else {
-					s = VCALGetTextPart(Buff, &pos); /* Don't know ... */
-
-					s = VCALGetTextPart(Buff, &pos);
-					if (s == NULL) continue;
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_StreetAddress;
-					Pbk->Entries[Pbk->EntriesNum].Location = location;
-					Pbk->EntriesNum++;
-					CHECK_NUM_ENTRIES;
-
-					s = VCALGetTextPart(Buff, &pos);
-					if (s == NULL) continue;
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_City;
-					Pbk->Entries[Pbk->EntriesNum].Location = location;
-					Pbk->EntriesNum++;
-					CHECK_NUM_ENTRIES;
-
-					s = VCALGetTextPart(Buff, &pos);
-					if (s == NULL) continue;
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_State;
-					Pbk->Entries[Pbk->EntriesNum].Location = location;
-					Pbk->EntriesNum++;
-					CHECK_NUM_ENTRIES;
-
-					s = VCALGetTextPart(Buff, &pos);
-					if (s == NULL) continue;
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Zip;
-					Pbk->Entries[Pbk->EntriesNum].Location = location;
-					Pbk->EntriesNum++;
-					CHECK_NUM_ENTRIES;
+					break;
+				}
+				s = VCALGetTextPart(Buff, &pos); /* Don't know ... */
 
+				for (j = 0; j < (int)(sizeof(AddressParts) / sizeof(AddressParts[0])); j++) {
 					s = VCALGetTextPart(Buff, &pos);
-					if (s == NULL) continue;
-					CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text, s);
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Country;
-					Pbk->Entries[Pbk->EntriesNum].Location = location;
-					Pbk->EntriesNum++;
-					continue;
-				}
-			}
-			if (ReadVCALText(Line, "EMAIL", Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "EMAIL;OTHER", Buff,  (version >= 3), &location) ||
-			    ReadVCALText(Line, "EMAIL;INTERNET", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Email;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-IRMC-LUID", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_LUID;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-DTMF", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_DTMF;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-SIP", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_SIP;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-SIP;VOIP", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_VOIP;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-WV-ID", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_WVID;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-SIP;SWIS", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_SWIS;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-SIP;POC", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_PushToTalkID;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "URL", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_URL;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "ORG", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_Company;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "NICKNAME", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_NickName;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "FN", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_FormalName;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-NAME-PREFIX", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_NamePrefix;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-NAME-SUFFIX", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Text_NameSuffix;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "CATEGORIES", Buff,  (version >= 3), &location)) {
-				CopyUnicodeString(Pbk->Entries[Pbk->EntriesNum].Text,Buff);
-				Pbk->Entries[Pbk->EntriesNum].Number = -1;
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Category;
-				Pbk->Entries[Pbk->EntriesNum].Location = location;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "BDAY", Buff,  (version >= 3), NULL)) {
-				if (ReadVCALDateTime(DecodeUnicodeString(Buff), &Pbk->Entries[Pbk->EntriesNum].Date)) {
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Date;
-					Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
-					Pbk->EntriesNum++;
-					continue;
-				}
-			}
-			if (ReadVCALText(Line, "LAST-MODIFIED", Buff,  (version >= 3), NULL)) {
-				if (ReadVCALDateTime(DecodeUnicodeString(Buff), &Pbk->Entries[Pbk->EntriesNum].Date)) {
-					Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_LastModified;
-					Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
+					if (s == NULL) break;
+					if (j > 0) {
+						CHECK_NUM_ENTRIES;
+					}
+					Entry = &Pbk->Entries[Pbk->EntriesNum];
+					CopyUnicodeString(Entry->Text, s);
+					Entry->EntryType = AddressParts[j];
+					Entry->Location = location;
 					Pbk->EntriesNum++;
-					continue;
 				}
-			}
-			if (ReadVCALText(Line, "X-PRIVATE", Buff,  (version >= 3), NULL)) {
-				Pbk->Entries[Pbk->EntriesNum].Number = atoi(DecodeUnicodeString(Buff));
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Private;
-				Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-CALLER-GROUP", Buff,  (version >= 3), NULL)) {
-				Pbk->Entries[Pbk->EntriesNum].Number = atoi(DecodeUnicodeString(Buff));
-				Pbk->Entries[Pbk->EntriesNum].EntryType = PBK_Caller_Group;
-				Pbk->Entries[Pbk->EntriesNum].Location = PBK_Location_Unknown;
-				Pbk->EntriesNum++;
-				continue;
-			}
-			if (ReadVCALText(Line, "X-GAMMU-LOCATION", Buff,  (version >= 3), NULL)) {
-				Pbk->Location = atoi(DecodeUnicodeString(Buff));
-			}
-			if (ReadVCALText(Line, "X-GAMMU-MEMORY", Buff,  (version >= 3), NULL)) {
-				Pbk->MemoryType = GSM_StringToMemoryType(DecodeUnicodeString(Buff));
+				break;
 			}
 			break;
 		}
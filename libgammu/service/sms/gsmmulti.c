@@ -226,7 +226,7 @@ GSM_Error GSM_AddSMS_Text_UDH(GSM_Debug_Info *di,
 		      		size_t			*CopiedText,
 		      		size_t			*CopiedSMSText)
 {
-	size_t FreeText=0,FreeBytes=0,Copy,i,j;
+	size_t FreeText=0,FreeBytes=0,Copy,i,j,Offset;
 
 	smfprintf(di, "Checking used: ");
 	GSM_Find_Free_Used_SMS2(
@@ -270,22 +270,24 @@ GSM_Error GSM_AddSMS_Text_UDH(GSM_Debug_Info *di,
 			Copy = BufferLen;
 		}
 
+		Offset = UnicodeLength(SMS->SMS[SMS->Number].Text) * 2;
+
 		switch (Coding) {
 		case SMS_Coding_Default_No_Compression:
 			FindDefaultAlphabetLen(Buffer,&i,&j,FreeText);
 			smfprintf(di, "Default text, length %ld %ld\n", (long)i, (long)j);
-			SMS->SMS[SMS->Number].Text[UnicodeLength(SMS->SMS[SMS->Number].Text)*2+i*2]   = 0;
-			SMS->SMS[SMS->Number].Text[UnicodeLength(SMS->SMS[SMS->Number].Text)*2+i*2+1] = 0;
-			memcpy(SMS->SMS[SMS->Number].Text+UnicodeLength(SMS->SMS[SMS->Number].Text)*2,Buffer,i*2);
+			SMS->SMS[SMS->Number].Text[Offset+i*2]   = 0;
+			SMS->SMS[SMS->Number].Text[Offset+i*2+1] = 0;
+			memcpy(SMS->SMS[SMS->Number].Text+Offset,Buffer,i*2);
 			*CopiedText 	= i;
 			*CopiedSMSText 	= j;
 			SMS->SMS[SMS->Number].Length += i;
 			break;
 		case SMS_Coding_Unicode_No_Compression:
 			AlignSegmentForContent(di, &Copy, Buffer, BufferLen);
-			SMS->SMS[SMS->Number].Text[UnicodeLength(SMS->SMS[SMS->Number].Text)*2+Copy*2]   = 0;
-			SMS->SMS[SMS->Number].Text[UnicodeLength(SMS->SMS[SMS->Number].Text)*2+Copy*2+1] = 0;
-			memcpy(SMS->SMS[SMS->Number].Text+UnicodeLength(SMS->SMS[SMS->Number].Text)*2,Buffer,Copy*2);
+			SMS->SMS[SMS->Number].Text[Offset+Copy*2]   = 0;
+			SMS->SMS[SMS->Number].Text[Offset+Copy*2+1] = 0;
+			memcpy(SMS->SMS[SMS->Number].Text+Offset,Buffer,Copy*2);
 			*CopiedText = *CopiedSMSText = Copy;
 			SMS->SMS[SMS->Number].Length += Copy;
 			break;
@@ -295,9 +297,9 @@ GSM_Error GSM_AddSMS_Text_UDH(GSM_Debug_Info *di,
 			*CopiedText = *CopiedSMSText = Copy;
         break;
     case SMS_Coding_ASCII:
-      SMS->SMS[SMS->Number].Text[UnicodeLength(SMS->SMS[SMS->Number].Text)*2+Copy*2]   = 0;
-      SMS->SMS[SMS->Number].Text[UnicodeLength(SMS->SMS[SMS->Number].Text)*2+Copy*2+1] = 0;
-      memcpy(SMS->SMS[SMS->Number].Text+UnicodeLength(SMS->SMS[SMS->Number].Text)*2,Buffer,Copy*2);
+      SMS->SMS[SMS->Number].Text[Offset+Copy*2]   = 0;
+      SMS->SMS[SMS->Number].Text[Offset+Copy*2+1] = 0;
+      memcpy(SMS->SMS[SMS->Number].Text+Offset,Buffer,Copy*2);
       *CopiedText = *CopiedSMSText = Copy;
       SMS->SMS[SMS->Number].Length += Copy;
       break;
@@ -316,6 +318,77 @@ GSM_Error GSM_AddSMS_Text_UDH(GSM_Debug_Info *di,
 	return ERR_NONE;
 }
 
+/**
+ * Returns number of characters which fit into message part without
+ * any text, 0 if coding is not supported.
+ *
+ * Equals to FreeText computed by \ref GSM_Find_Free_Used_SMS2 for
+ * empty part.
+ */
+static size_t GSM_EmptySMSCapacity(GSM_Coding_Type Coding, GSM_UDHHeader *UDH)
+{
+	switch (Coding) {
+	case SMS_Coding_Default_No_Compression:
+		return (GSM_MAX_8BIT_SMS_LENGTH - UDH->Length) * 8 / 7;
+	case SMS_Coding_Unicode_No_Compression:
+		return (GSM_MAX_8BIT_SMS_LENGTH - UDH->Length) / 2;
+	case SMS_Coding_8bit:
+		return GSM_MAX_8BIT_SMS_LENGTH - UDH->Length;
+	case SMS_Coding_ASCII:
+		return (size_t)(GSM_MAX_8BIT_SMS_LENGTH - ceil(UDH->Length * 7.0 / 8)) * 8 / 7;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * Fills empty message part with as much text as fits into it.
+ *
+ * Produces same result as \ref GSM_AddSMS_Text_UDH on empty part, but
+ * walks only the text which is copied into the part and does not
+ * rescan the part text.
+ *
+ * \return Number of characters consumed from Buffer.
+ */
+static size_t GSM_FillEmptySMS(GSM_Debug_Info *di,
+			       GSM_SMSMessage	*SMS,
+			       GSM_Coding_Type	Coding,
+			       unsigned char	*Buffer,
+			       size_t		BufferLen,
+			       size_t		FreeText)
+{
+	size_t Copy, SMSText;
+
+	Copy = MIN(FreeText, BufferLen);
+
+	switch (Coding) {
+	case SMS_Coding_Default_No_Compression:
+		FindDefaultAlphabetLen(Buffer, &Copy, &SMSText, FreeText);
+		break;
+	case SMS_Coding_Unicode_No_Compression:
+		AlignSegmentForContent(di, &Copy, (char *)Buffer, BufferLen);
+		break;
+	default:
+		break;
+	}
+
+	if (Coding == SMS_Coding_8bit) {
+		memcpy(SMS->Text, Buffer, Copy);
+	} else {
+		memcpy(SMS->Text, Buffer, Copy * 2);
+		SMS->Text[Copy * 2] = 0;
+		SMS->Text[Copy * 2 + 1] = 0;
+	}
+	SMS->Length = Copy;
+
+	smfprintf(di, "UDH Len(%i), FreeText(%ld), Copied(%ld)\n",
+		SMS->UDH.Length,
+		(long)FreeText,
+		(long)Copy);
+
+	return Copy;
+}
+
 void GSM_MakeMultiPartSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage	*SMS,
 			  unsigned char		*MessageBuffer,
 			  size_t		MessageLength,
@@ -324,7 +397,7 @@ void GSM_MakeMultiPartSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage	*SMS,
 			  int			Class,
 			  unsigned char		ReplaceMessage)
 {
-	size_t 		Len,UsedText = 0,CopiedText = 0,CopiedSMSText = 0;
+	size_t 		Len,UsedText = 0,CopiedText = 0,CopiedSMSText = 0,FreeText;
 	int		j;
 	unsigned char 	UDHID;
 	GSM_DateTime 	Date;
@@ -341,7 +414,14 @@ void GSM_MakeMultiPartSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage	*SMS,
 		SMS->SMS[SMS->Number].UDH.Type = UDHType;
 		GSM_EncodeUDHHeader(di, &SMS->SMS[SMS->Number].UDH);
 
-		if (Coding == SMS_Coding_8bit) {
+		/* Part is empty, so we know its capacity without looking at it */
+		FreeText = GSM_EmptySMSCapacity(Coding, &SMS->SMS[SMS->Number].UDH);
+
+		if (FreeText > 0) {
+			CopiedText = GSM_FillEmptySMS(di, &SMS->SMS[SMS->Number], Coding,
+				Coding == SMS_Coding_8bit ? MessageBuffer + Len : MessageBuffer + Len * 2,
+				MessageLength - Len, FreeText);
+		} else if (Coding == SMS_Coding_8bit) {
 			GSM_AddSMS_Text_UDH(di, SMS,Coding,MessageBuffer+Len,MessageLength - Len,FALSE,&UsedText,&CopiedText,&CopiedSMSText);
 		} else {
 			GSM_AddSMS_Text_UDH(di, SMS,Coding,MessageBuffer+Len*2,MessageLength - Len,FALSE,&UsedText,&CopiedText,&CopiedSMSText);
@@ -1510,18 +1590,18 @@ gboolean GSM_DecodeMultiPartSMS(GSM_Debug_Info *di,
 	return FALSE;
 }
 
-GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, GSM_MultiSMSMessage **OutputMessages, gboolean ems)
+GSM_Error GSM_LinkSMSGroups(GSM_Debug_Info *di, GSM_SMSMessage **Input, const int *InputNumber, GSM_SMSLinkGroup *Groups, int *GroupsNum, gboolean ems)
 {
 	gboolean			*InputMessagesSorted, copyit,OtherNumbers[GSM_SMS_OTHER_NUMBERS+1],wrong=FALSE;
-	int			i,OutputMessagesNum,z,w,m,p;
+	int			i,GroupNum,z,w,m,p;
 	int			j;
 	GSM_SiemensOTASMSInfo	SiemensOTA,SiemensOTA2;
 
 	i = 0;
-	while (InputMessages[i] != NULL) i++;
+	while (Input[i] != NULL) i++;
 
-	OutputMessagesNum = 0;
-	OutputMessages[0] = NULL;
+	GroupNum = 0;
+	*GroupsNum = 0;
 
 	if (i == 0) {
 		return ERR_NONE;
@@ -1531,41 +1611,41 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 	if (InputMessagesSorted == NULL) return ERR_MOREMEMORY;
 
 	if (ems) {
-		for (i = 0; InputMessages[i] != NULL; i++) {
-			if (InputMessages[i]->SMS[0].UDH.Type == UDH_UserUDH) {
+		for (i = 0; Input[i] != NULL; i++) {
+			if (Input[i]->UDH.Type == UDH_UserUDH) {
 				w=1;
-				while (w < InputMessages[i]->SMS[0].UDH.Length) {
-					switch(InputMessages[i]->SMS[0].UDH.Text[w]) {
+				while (w < Input[i]->UDH.Length) {
+					switch(Input[i]->UDH.Text[w]) {
 					case 0x00:
 						smfprintf(di, "Adding ID to user UDH - linked SMS with 8 bit ID\n");
-						InputMessages[i]->SMS[0].UDH.ID8bit	= InputMessages[i]->SMS[0].UDH.Text[w+2];
-						InputMessages[i]->SMS[0].UDH.ID16bit	= -1;
-						InputMessages[i]->SMS[0].UDH.AllParts	= InputMessages[i]->SMS[0].UDH.Text[w+3];
-						InputMessages[i]->SMS[0].UDH.PartNumber	= InputMessages[i]->SMS[0].UDH.Text[w+4];
+						Input[i]->UDH.ID8bit	= Input[i]->UDH.Text[w+2];
+						Input[i]->UDH.ID16bit	= -1;
+						Input[i]->UDH.AllParts	= Input[i]->UDH.Text[w+3];
+						Input[i]->UDH.PartNumber	= Input[i]->UDH.Text[w+4];
 						break;
 					case 0x08:
 						smfprintf(di, "Adding ID to user UDH - linked SMS with 16 bit ID\n");
-						InputMessages[i]->SMS[0].UDH.ID8bit	= -1;
-						InputMessages[i]->SMS[0].UDH.ID16bit	= InputMessages[i]->SMS[0].UDH.Text[w+2]*256+InputMessages[i]->SMS[0].UDH.Text[w+3];
-						InputMessages[i]->SMS[0].UDH.AllParts	= InputMessages[i]->SMS[0].UDH.Text[w+4];
-						InputMessages[i]->SMS[0].UDH.PartNumber	= InputMessages[i]->SMS[0].UDH.Text[w+5];
+						Input[i]->UDH.ID8bit	= -1;
+						Input[i]->UDH.ID16bit	= Input[i]->UDH.Text[w+2]*256+Input[i]->UDH.Text[w+3];
+						Input[i]->UDH.AllParts	= Input[i]->UDH.Text[w+4];
+						Input[i]->UDH.PartNumber	= Input[i]->UDH.Text[w+5];
 						break;
 					default:
-						smfprintf(di, "Block %02x\n",InputMessages[i]->SMS[0].UDH.Text[w]);
+						smfprintf(di, "Block %02x\n",Input[i]->UDH.Text[w]);
 					}
 					smfprintf(di, "id8: %i, id16: %i, part: %i, parts count: %i\n",
-						InputMessages[i]->SMS[0].UDH.ID8bit,
-						InputMessages[i]->SMS[0].UDH.ID16bit,
-						InputMessages[i]->SMS[0].UDH.PartNumber,
-						InputMessages[i]->SMS[0].UDH.AllParts);
-					w=w+InputMessages[i]->SMS[0].UDH.Text[w+1]+2;
+						Input[i]->UDH.ID8bit,
+						Input[i]->UDH.ID16bit,
+						Input[i]->UDH.PartNumber,
+						Input[i]->UDH.AllParts);
+					w=w+Input[i]->UDH.Text[w+1]+2;
 				}
 			}
 		}
 	}
 
 	i=0;
-	while (InputMessages[i]!=NULL) {
+	while (Input[i] != NULL) {
 		/* If this one SMS was sorted earlier, do not touch */
 		if (InputMessagesSorted[i]) {
 			i++;
@@ -1574,18 +1654,11 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 		/* We have 1'st part of SIEMENS sms. It's single.
 		 * We will try to find other parts
 		 */
-		if (GSM_DecodeSiemensOTASMS(di, &SiemensOTA,&InputMessages[i]->SMS[0]) &&
+		if (GSM_DecodeSiemensOTASMS(di, &SiemensOTA,Input[i]) &&
 		    SiemensOTA.PacketNum == 1) {
-			OutputMessages[OutputMessagesNum] = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
-			if (OutputMessages[OutputMessagesNum] == NULL) {
-				free(InputMessagesSorted);
-				InputMessagesSorted=NULL;
-				return ERR_MOREMEMORY;
-			}
-			OutputMessages[OutputMessagesNum+1] = NULL;
-
-			memcpy(&OutputMessages[OutputMessagesNum]->SMS[0],&InputMessages[i]->SMS[0],sizeof(GSM_SMSMessage));
-			OutputMessages[OutputMessagesNum]->Number = 1;
+			Groups[GroupNum].Whole = FALSE;
+			Groups[GroupNum].Parts[0] = i;
+			Groups[GroupNum].Number = 1;
 			InputMessagesSorted[i]	= TRUE;
 			j		= 1;
 			/* We're searching for other parts in sequence */
@@ -1599,13 +1672,13 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
         }
 
 				z=0;
-				while(InputMessages[z]!=NULL) {
+				while(Input[z] != NULL) {
 					/* This was sorted earlier or is not single */
-					if (InputMessagesSorted[z] || InputMessages[z]->Number != 1) {
+					if (InputMessagesSorted[z] || InputNumber[z] != 1) {
 						z++;
 						continue;
 					}
-					if (!GSM_DecodeSiemensOTASMS(di, &SiemensOTA2,&InputMessages[z]->SMS[0])) {
+					if (!GSM_DecodeSiemensOTASMS(di, &SiemensOTA2,Input[z])) {
 						z++;
 						continue;
 					}
@@ -1618,40 +1691,40 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 						continue;
 					}
 					/* For SMS_Deliver compare also SMSC and Sender numbers */
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver &&
-					    strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].SMSC.Number),DecodeUnicodeString(InputMessages[i]->SMS[0].SMSC.Number))) {
+					if (Input[z]->PDU == SMS_Deliver &&
+					    strcmp(DecodeUnicodeString(Input[z]->SMSC.Number),DecodeUnicodeString(Input[i]->SMSC.Number))) {
 						z++;
 						continue;
 					}
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver &&
-					    InputMessages[z]->SMS[0].OtherNumbersNum!=InputMessages[i]->SMS[0].OtherNumbersNum) {
+					if (Input[z]->PDU == SMS_Deliver &&
+					    Input[z]->OtherNumbersNum!=Input[i]->OtherNumbersNum) {
 						z++;
 						continue;
 					}
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver) {
+					if (Input[z]->PDU == SMS_Deliver) {
 						for (m=0;m<GSM_SMS_OTHER_NUMBERS+1;m++) {
 							OtherNumbers[m]=FALSE;
 						}
-						for (m=0;m<InputMessages[z]->SMS[0].OtherNumbersNum+1;m++) {
+						for (m=0;m<Input[z]->OtherNumbersNum+1;m++) {
 							wrong=TRUE;
-							for (p=0;p<InputMessages[i]->SMS[0].OtherNumbersNum+1;p++) {
+							for (p=0;p<Input[i]->OtherNumbersNum+1;p++) {
 								if (OtherNumbers[p]) continue;
-								if (m==0 && p==0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].Number),DecodeUnicodeString(InputMessages[i]->SMS[0].Number))) {
+								if (m==0 && p==0 && !strcmp(DecodeUnicodeString(Input[z]->Number),DecodeUnicodeString(Input[i]->Number))) {
 									OtherNumbers[0]=TRUE;
 									wrong=FALSE;
 									break;
 								}
-								if (m==0 && p!=0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].Number),DecodeUnicodeString(InputMessages[i]->SMS[0].OtherNumbers[p-1]))) {
+								if (m==0 && p!=0 && !strcmp(DecodeUnicodeString(Input[z]->Number),DecodeUnicodeString(Input[i]->OtherNumbers[p-1]))) {
 									OtherNumbers[p]=TRUE;
 									wrong=FALSE;
 									break;
 								}
-								if (m!=0 && p==0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].OtherNumbers[m-1]),DecodeUnicodeString(InputMessages[i]->SMS[0].Number))) {
+								if (m!=0 && p==0 && !strcmp(DecodeUnicodeString(Input[z]->OtherNumbers[m-1]),DecodeUnicodeString(Input[i]->Number))) {
 									OtherNumbers[0]=TRUE;
 									wrong=FALSE;
 									break;
 								}
-								if (m!=0 && p!=0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].OtherNumbers[m-1]),DecodeUnicodeString(InputMessages[i]->SMS[0].OtherNumbers[p-1]))) {
+								if (m!=0 && p!=0 && !strcmp(DecodeUnicodeString(Input[z]->OtherNumbers[m-1]),DecodeUnicodeString(Input[i]->OtherNumbers[p-1]))) {
 									OtherNumbers[p]=TRUE;
 									wrong=FALSE;
 									break;
@@ -1665,41 +1738,40 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 						}
 					}
 					/* DCT4 Outbox: SMS Deliver. Empty number and SMSC. We compare dates */
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver 		&&
-					    UnicodeLength(InputMessages[z]->SMS[0].SMSC.Number)==0 	&&
-					    UnicodeLength(InputMessages[z]->SMS[0].Number)==0 		&&
-					    (InputMessages[z]->SMS[0].DateTime.Day    != InputMessages[i]->SMS[0].DateTime.Day 	  ||
-	   				     InputMessages[z]->SMS[0].DateTime.Month  != InputMessages[i]->SMS[0].DateTime.Month  ||
-					     InputMessages[z]->SMS[0].DateTime.Year   != InputMessages[i]->SMS[0].DateTime.Year   ||
-					     InputMessages[z]->SMS[0].DateTime.Hour   != InputMessages[i]->SMS[0].DateTime.Hour   ||
-					     InputMessages[z]->SMS[0].DateTime.Minute != InputMessages[i]->SMS[0].DateTime.Minute ||
-					     InputMessages[z]->SMS[0].DateTime.Second != InputMessages[i]->SMS[0].DateTime.Second)) {
+					if (Input[z]->PDU == SMS_Deliver 		&&
+					    UnicodeLength(Input[z]->SMSC.Number)==0 	&&
+					    UnicodeLength(Input[z]->Number)==0 		&&
+					    (Input[z]->DateTime.Day    != Input[i]->DateTime.Day 	  ||
+	   				     Input[z]->DateTime.Month  != Input[i]->DateTime.Month  ||
+					     Input[z]->DateTime.Year   != Input[i]->DateTime.Year   ||
+					     Input[z]->DateTime.Hour   != Input[i]->DateTime.Hour   ||
+					     Input[z]->DateTime.Minute != Input[i]->DateTime.Minute ||
+					     Input[z]->DateTime.Second != Input[i]->DateTime.Second)) {
 						z++;
 						continue;
 					}
 					smfprintf(di, "Found Siemens SMS %i\n",j);
 					/* We found correct sms. Copy it */
-					memcpy(&OutputMessages[OutputMessagesNum]->SMS[j],&InputMessages[z]->SMS[0],sizeof(GSM_SMSMessage));
-					OutputMessages[OutputMessagesNum]->Number++;
+					Groups[GroupNum].Parts[Groups[GroupNum].Number++] = z;
 					InputMessagesSorted[z]=TRUE;
 					break;
 				}
 				/* Incomplete sequence */
-				if (OutputMessages[OutputMessagesNum]->Number==j) {
+				if (Groups[GroupNum].Number==j) {
 					smfprintf(di, "Incomplete sequence\n");
 					break;
 				}
 				j++;
 			}
-			OutputMessagesNum++;
+			GroupNum++;
 			i = 0;
 			continue;
 		}
 		/* We have some next Siemens sms from sequence */
-		if (GSM_DecodeSiemensOTASMS(di, &SiemensOTA,&InputMessages[i]->SMS[0]) &&
+		if (GSM_DecodeSiemensOTASMS(di, &SiemensOTA,Input[i]) &&
 		    SiemensOTA.PacketNum > 1) {
 			j = 0;
-			while (InputMessages[j]!=NULL) {
+			while (Input[j] != NULL) {
 				if (InputMessagesSorted[j]) {
 					j++;
 					continue;
@@ -1707,24 +1779,18 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 				/* We have some not unassigned first sms from sequence.
 				 * We can't touch other sms from sequences
 				 */
-				if (GSM_DecodeSiemensOTASMS(di, &SiemensOTA,&InputMessages[j]->SMS[0]) &&
+				if (GSM_DecodeSiemensOTASMS(di, &SiemensOTA,Input[j]) &&
 				    SiemensOTA.PacketNum == 1) {
 					break;
 				}
 				j++;
 			}
-			if (InputMessages[j]==NULL) {
-				OutputMessages[OutputMessagesNum] = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
-				if (OutputMessages[OutputMessagesNum] == NULL) {
-					free(InputMessagesSorted);
-					InputMessagesSorted=NULL;
-					return ERR_MOREMEMORY;
-				}
-				OutputMessages[OutputMessagesNum+1] = NULL;
-
-				memcpy(OutputMessages[OutputMessagesNum],InputMessages[i],sizeof(GSM_MultiSMSMessage));
+			if (Input[j] == NULL) {
+				Groups[GroupNum].Whole = TRUE;
+				Groups[GroupNum].Parts[0] = i;
+				Groups[GroupNum].Number = InputNumber[i];
 				InputMessagesSorted[i]=TRUE;
-				OutputMessagesNum++;
+				GroupNum++;
 				i = 0;
 				continue;
 			} else i++;
@@ -1733,51 +1799,38 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 		/* If we have:
 		 * - linked sms returned by phone driver
 		 * - sms without linking
-		 * we copy it to OutputMessages
+		 * it goes to output alone
 		 */
-		if (InputMessages[i]->Number 			!= 1 	       	||
-		    InputMessages[i]->SMS[0].UDH.Type 		== UDH_NoUDH   	||
-                    InputMessages[i]->SMS[0].UDH.PartNumber 	== -1) {
+		if (InputNumber[i] 			!= 1 	       	||
+		    Input[i]->UDH.Type 		== UDH_NoUDH   	||
+                    Input[i]->UDH.PartNumber 	== -1) {
 			copyit = TRUE;
 		}
-		/* If we have unknown UDH, we copy it to OutputMessages */
-		if (InputMessages[i]->SMS[0].UDH.Type == UDH_UserUDH) {
+		/* If we have unknown UDH, it goes to output alone */
+		if (Input[i]->UDH.Type == UDH_UserUDH) {
 			if (!ems) copyit = TRUE;
-			if (ems && InputMessages[i]->SMS[0].UDH.PartNumber == -1) copyit = TRUE;
+			if (ems && Input[i]->UDH.PartNumber == -1) copyit = TRUE;
 		}
 		if (copyit) {
-			OutputMessages[OutputMessagesNum] = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
-			if (OutputMessages[OutputMessagesNum] == NULL) {
-				free(InputMessagesSorted);
-				InputMessagesSorted=NULL;
-				return ERR_MOREMEMORY;
-			}
-			OutputMessages[OutputMessagesNum+1] = NULL;
-
-			memcpy(OutputMessages[OutputMessagesNum],InputMessages[i],sizeof(GSM_MultiSMSMessage));
+			Groups[GroupNum].Whole = TRUE;
+			Groups[GroupNum].Parts[0] = i;
+			Groups[GroupNum].Number = InputNumber[i];
 			InputMessagesSorted[i]=TRUE;
-			OutputMessagesNum++;
+			GroupNum++;
 			i = 0;
 			continue;
 		}
 		/* We have 1'st part of linked sms. It's single.
 		 * We will try to find other parts
 		 */
-		if (InputMessages[i]->SMS[0].UDH.PartNumber == 1) {
-			OutputMessages[OutputMessagesNum] = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
-			if (OutputMessages[OutputMessagesNum] == NULL) {
-				free(InputMessagesSorted);
-				InputMessagesSorted=NULL;
-				return ERR_MOREMEMORY;
-			}
-			OutputMessages[OutputMessagesNum+1] = NULL;
-
-			memcpy(&OutputMessages[OutputMessagesNum]->SMS[0],&InputMessages[i]->SMS[0],sizeof(GSM_SMSMessage));
-			OutputMessages[OutputMessagesNum]->Number = 1;
+		if (Input[i]->UDH.PartNumber == 1) {
+			Groups[GroupNum].Whole = FALSE;
+			Groups[GroupNum].Parts[0] = i;
+			Groups[GroupNum].Number = 1;
 			InputMessagesSorted[i]	= TRUE;
 			j		= 1;
 			/* We're searching for other parts in sequence */
-			while (j != InputMessages[i]->SMS[0].UDH.AllParts) {
+			while (j != Input[i]->UDH.AllParts) {
 
 				if(j >= GSM_MAX_MULTI_SMS) {
 					smfprintf(di,
@@ -1787,80 +1840,80 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 				}
 
 				z=0;
-				while(InputMessages[z]!=NULL) {
+				while(Input[z] != NULL) {
 					/* This was sorted earlier or is not single */
-					if (InputMessagesSorted[z] || InputMessages[z]->Number != 1) {
+					if (InputMessagesSorted[z] || InputNumber[z] != 1) {
 						z++;
 						continue;
 					}
-					if (ems && InputMessages[i]->SMS[0].UDH.Type != UDH_ConcatenatedMessages &&
-					    InputMessages[i]->SMS[0].UDH.Type != UDH_ConcatenatedMessages16bit   &&
-					    InputMessages[i]->SMS[0].UDH.Type != UDH_UserUDH 			 &&
-					    InputMessages[z]->SMS[0].UDH.Type != UDH_ConcatenatedMessages 	 &&
-					    InputMessages[z]->SMS[0].UDH.Type != UDH_ConcatenatedMessages16bit   &&
-					    InputMessages[z]->SMS[0].UDH.Type != UDH_UserUDH) {
-						if (InputMessages[z]->SMS[0].UDH.Type != InputMessages[i]->SMS[0].UDH.Type) {
+					if (ems && Input[i]->UDH.Type != UDH_ConcatenatedMessages &&
+					    Input[i]->UDH.Type != UDH_ConcatenatedMessages16bit   &&
+					    Input[i]->UDH.Type != UDH_UserUDH 			 &&
+					    Input[z]->UDH.Type != UDH_ConcatenatedMessages 	 &&
+					    Input[z]->UDH.Type != UDH_ConcatenatedMessages16bit   &&
+					    Input[z]->UDH.Type != UDH_UserUDH) {
+						if (Input[z]->UDH.Type != Input[i]->UDH.Type) {
 							z++;
 							continue;
 						}
 					}
-					if (!ems && InputMessages[z]->SMS[0].UDH.Type != InputMessages[i]->SMS[0].UDH.Type) {
+					if (!ems && Input[z]->UDH.Type != Input[i]->UDH.Type) {
 						z++;
 						continue;
 					}
 					smfprintf(di, "compare %i         %i %i %i %i",
 						j+1,
-						InputMessages[i]->SMS[0].UDH.ID8bit,
-						InputMessages[i]->SMS[0].UDH.ID16bit,
-						InputMessages[i]->SMS[0].UDH.PartNumber,
-						InputMessages[i]->SMS[0].UDH.AllParts);
+						Input[i]->UDH.ID8bit,
+						Input[i]->UDH.ID16bit,
+						Input[i]->UDH.PartNumber,
+						Input[i]->UDH.AllParts);
 					smfprintf(di, "         %i %i %i %i\n",
-						InputMessages[z]->SMS[0].UDH.ID8bit,
-						InputMessages[z]->SMS[0].UDH.ID16bit,
-						InputMessages[z]->SMS[0].UDH.PartNumber,
-						InputMessages[z]->SMS[0].UDH.AllParts);
-					if (InputMessages[z]->SMS[0].UDH.ID8bit      != InputMessages[i]->SMS[0].UDH.ID8bit	||
-							InputMessages[z]->SMS[0].UDH.ID16bit     != InputMessages[i]->SMS[0].UDH.ID16bit	||
-							InputMessages[z]->SMS[0].UDH.AllParts    != InputMessages[i]->SMS[0].UDH.AllParts 	||
-							(InputMessages[z]->SMS[0].UDH.PartNumber) != j + 1) {
+						Input[z]->UDH.ID8bit,
+						Input[z]->UDH.ID16bit,
+						Input[z]->UDH.PartNumber,
+						Input[z]->UDH.AllParts);
+					if (Input[z]->UDH.ID8bit      != Input[i]->UDH.ID8bit	||
+							Input[z]->UDH.ID16bit     != Input[i]->UDH.ID16bit	||
+							Input[z]->UDH.AllParts    != Input[i]->UDH.AllParts 	||
+							(Input[z]->UDH.PartNumber) != j + 1) {
 						z++;
 						continue;
 					}
 					/* For SMS_Deliver compare also SMSC and Sender numbers */
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver &&
-					    strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].SMSC.Number),DecodeUnicodeString(InputMessages[i]->SMS[0].SMSC.Number))) {
+					if (Input[z]->PDU == SMS_Deliver &&
+					    strcmp(DecodeUnicodeString(Input[z]->SMSC.Number),DecodeUnicodeString(Input[i]->SMSC.Number))) {
 						z++;
 						continue;
 					}
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver &&
-					    InputMessages[z]->SMS[0].OtherNumbersNum!=InputMessages[i]->SMS[0].OtherNumbersNum) {
+					if (Input[z]->PDU == SMS_Deliver &&
+					    Input[z]->OtherNumbersNum!=Input[i]->OtherNumbersNum) {
 						z++;
 						continue;
 					}
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver) {
+					if (Input[z]->PDU == SMS_Deliver) {
 						for (m=0;m<GSM_SMS_OTHER_NUMBERS+1;m++) {
 							OtherNumbers[m]=FALSE;
 						}
-						for (m=0;m<InputMessages[z]->SMS[0].OtherNumbersNum+1;m++) {
+						for (m=0;m<Input[z]->OtherNumbersNum+1;m++) {
 							wrong=TRUE;
-							for (p=0;p<InputMessages[i]->SMS[0].OtherNumbersNum+1;p++) {
+							for (p=0;p<Input[i]->OtherNumbersNum+1;p++) {
 								if (OtherNumbers[p]) continue;
-								if (m==0 && p==0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].Number),DecodeUnicodeString(InputMessages[i]->SMS[0].Number))) {
+								if (m==0 && p==0 && !strcmp(DecodeUnicodeString(Input[z]->Number),DecodeUnicodeString(Input[i]->Number))) {
 									OtherNumbers[0]=TRUE;
 									wrong=FALSE;
 									break;
 								}
-								if (m==0 && p!=0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].Number),DecodeUnicodeString(InputMessages[i]->SMS[0].OtherNumbers[p-1]))) {
+								if (m==0 && p!=0 && !strcmp(DecodeUnicodeString(Input[z]->Number),DecodeUnicodeString(Input[i]->OtherNumbers[p-1]))) {
 									OtherNumbers[p]=TRUE;
 									wrong=FALSE;
 									break;
 								}
-								if (m!=0 && p==0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].OtherNumbers[m-1]),DecodeUnicodeString(InputMessages[i]->SMS[0].Number))) {
+								if (m!=0 && p==0 && !strcmp(DecodeUnicodeString(Input[z]->OtherNumbers[m-1]),DecodeUnicodeString(Input[i]->Number))) {
 									OtherNumbers[0]=TRUE;
 									wrong=FALSE;
 									break;
 								}
-								if (m!=0 && p!=0 && !strcmp(DecodeUnicodeString(InputMessages[z]->SMS[0].OtherNumbers[m-1]),DecodeUnicodeString(InputMessages[i]->SMS[0].OtherNumbers[p-1]))) {
+								if (m!=0 && p!=0 && !strcmp(DecodeUnicodeString(Input[z]->OtherNumbers[m-1]),DecodeUnicodeString(Input[i]->OtherNumbers[p-1]))) {
 									OtherNumbers[p]=TRUE;
 									wrong=FALSE;
 									break;
@@ -1874,39 +1927,38 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 						}
 					}
 					/* DCT4 Outbox: SMS Deliver. Empty number and SMSC. We compare dates */
-					if (InputMessages[z]->SMS[0].PDU == SMS_Deliver 		&&
-					    UnicodeLength(InputMessages[z]->SMS[0].SMSC.Number)==0 	&&
-					    UnicodeLength(InputMessages[z]->SMS[0].Number)==0 		&&
-					    (InputMessages[z]->SMS[0].DateTime.Day    != InputMessages[i]->SMS[0].DateTime.Day 	  ||
-	   				     InputMessages[z]->SMS[0].DateTime.Month  != InputMessages[i]->SMS[0].DateTime.Month  ||
-					     InputMessages[z]->SMS[0].DateTime.Year   != InputMessages[i]->SMS[0].DateTime.Year   ||
-					     InputMessages[z]->SMS[0].DateTime.Hour   != InputMessages[i]->SMS[0].DateTime.Hour   ||
-					     InputMessages[z]->SMS[0].DateTime.Minute != InputMessages[i]->SMS[0].DateTime.Minute ||
-					     InputMessages[z]->SMS[0].DateTime.Second != InputMessages[i]->SMS[0].DateTime.Second)) {
+					if (Input[z]->PDU == SMS_Deliver 		&&
+					    UnicodeLength(Input[z]->SMSC.Number)==0 	&&
+					    UnicodeLength(Input[z]->Number)==0 		&&
+					    (Input[z]->DateTime.Day    != Input[i]->DateTime.Day 	  ||
+	   				     Input[z]->DateTime.Month  != Input[i]->DateTime.Month  ||
+					     Input[z]->DateTime.Year   != Input[i]->DateTime.Year   ||
+					     Input[z]->DateTime.Hour   != Input[i]->DateTime.Hour   ||
+					     Input[z]->DateTime.Minute != Input[i]->DateTime.Minute ||
+					     Input[z]->DateTime.Second != Input[i]->DateTime.Second)) {
 						z++;
 						continue;
 					}
 					/* We found correct sms. Copy it */
-					memcpy(&OutputMessages[OutputMessagesNum]->SMS[j],&InputMessages[z]->SMS[0],sizeof(GSM_SMSMessage));
-					OutputMessages[OutputMessagesNum]->Number++;
+					Groups[GroupNum].Parts[Groups[GroupNum].Number++] = z;
 					InputMessagesSorted[z]=TRUE;
 					break;
 				}
 				/* Incomplete sequence */
-				if (OutputMessages[OutputMessagesNum]->Number==j) {
+				if (Groups[GroupNum].Number==j) {
 					smfprintf(di, "Incomplete sequence\n");
 					break;
 				}
 				j++;
 			}
-			OutputMessagesNum++;
+			GroupNum++;
 			i = 0;
 			continue;
 		}
 		/* We have some next linked sms from sequence */
-		if (InputMessages[i]->SMS[0].UDH.PartNumber > 1) {
+		if (Input[i]->UDH.PartNumber > 1) {
 			j = 0;
-			while (InputMessages[j]!=NULL) {
+			while (Input[j] != NULL) {
 				if (InputMessagesSorted[j]) {
 					j++;
 					continue;
@@ -1914,21 +1966,15 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 				/* We have some not unassigned first sms from sequence.
 				 * We can't touch other sms from sequences
 				 */
-				if (InputMessages[j]->SMS[0].UDH.PartNumber == 1) break;
+				if (Input[j]->UDH.PartNumber == 1) break;
 				j++;
 			}
-			if (InputMessages[j]==NULL) {
-				OutputMessages[OutputMessagesNum] = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
-				if (OutputMessages[OutputMessagesNum] == NULL) {
-					free(InputMessagesSorted);
-					InputMessagesSorted=NULL;
-					return ERR_MOREMEMORY;
-				}
-				OutputMessages[OutputMessagesNum+1] = NULL;
-
-				memcpy(OutputMessages[OutputMessagesNum],InputMessages[i],sizeof(GSM_MultiSMSMessage));
+			if (Input[j] == NULL) {
+				Groups[GroupNum].Whole = TRUE;
+				Groups[GroupNum].Parts[0] = i;
+				Groups[GroupNum].Number = InputNumber[i];
 				InputMessagesSorted[i]=TRUE;
-				OutputMessagesNum++;
+				GroupNum++;
 				i = 0;
 				continue;
 			} else i++;
@@ -1936,9 +1982,71 @@ GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, G
 	}
 	free(InputMessagesSorted);
 	InputMessagesSorted=NULL;
+	*GroupsNum = GroupNum;
 	return ERR_NONE;
 }
 
+GSM_Error GSM_LinkSMS(GSM_Debug_Info *di, GSM_MultiSMSMessage **InputMessages, GSM_MultiSMSMessage **OutputMessages, gboolean ems)
+{
+	GSM_SMSMessage		**Input;
+	GSM_SMSLinkGroup	*Groups;
+	GSM_Error		error;
+	int			*InputNumber;
+	int			i, j, count, GroupsNum = 0;
+
+	count = 0;
+	while (InputMessages[count] != NULL) count++;
+
+	OutputMessages[0] = NULL;
+
+	if (count == 0) {
+		return ERR_NONE;
+	}
+
+	Input = (GSM_SMSMessage **)malloc((count + 1) * sizeof(GSM_SMSMessage *));
+	InputNumber = (int *)malloc(count * sizeof(int));
+	Groups = (GSM_SMSLinkGroup *)malloc(count * sizeof(GSM_SMSLinkGroup));
+	if (Input == NULL || InputNumber == NULL || Groups == NULL) {
+		error = ERR_MOREMEMORY;
+		goto done;
+	}
+
+	for (i = 0; i < count; i++) {
+		Input[i] = &InputMessages[i]->SMS[0];
+		InputNumber[i] = InputMessages[i]->Number;
+	}
+	Input[count] = NULL;
+
+	error = GSM_LinkSMSGroups(di, Input, InputNumber, Groups, &GroupsNum, ems);
+	if (error != ERR_NONE) {
+		goto done;
+	}
+
+	for (i = 0; i < GroupsNum; i++) {
+		OutputMessages[i] = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+		if (OutputMessages[i] == NULL) {
+			error = ERR_MOREMEMORY;
+			goto done;
+		}
+		OutputMessages[i + 1] = NULL;
+
+		if (Groups[i].Whole) {
+			memcpy(OutputMessages[i], InputMessages[Groups[i].Parts[0]], sizeof(GSM_MultiSMSMessage));
+			continue;
+		}
+		for (j = 0; j < Groups[i].Number; j++) {
+			memcpy(&OutputMessages[i]->SMS[j], Input[Groups[i].Parts[j]], sizeof(GSM_SMSMessage));
+		}
+		OutputMessages[i]->Number = Groups[i].Number;
+	}
+
+done:
+	free(Input);
+	free(InputNumber);
+	free(Groups);
+	return error;
+}
+
 /* How should editor hadle tabs in this file? Add editor commands here.
  * vim: noexpandtab sw=8 ts=8 sts=8:
  */
@@ -47,6 +47,40 @@ void GSM_Find_Free_Used_SMS2(GSM_Debug_Info *di, GSM_Coding_Type Coding, GSM_SMS
 
 unsigned char GSM_MakeSMSIDFromTime(void);
 
+/**
+ * Group of messages linked together by \ref GSM_LinkSMSGroups.
+ */
+typedef struct {
+	/**
+	 * Number of parts in group.
+	 */
+	int Number;
+	/**
+	 * Whether whole input message (possibly linked already by phone
+	 * driver) forms this group. Parts[0] is then its index.
+	 */
+	gboolean Whole;
+	/**
+	 * Indexes of input messages forming the group, in order of parts.
+	 */
+	int Parts[GSM_MAX_MULTI_SMS];
+} GSM_SMSLinkGroup;
+
+/**
+ * Links messages together without copying them.
+ *
+ * \param di Debug information.
+ * \param Input NULL terminated list of first parts of input messages.
+ * \param InputNumber Number of parts of each input message.
+ * \param Groups Storage for groups, needs to hold as many entries as
+ * there are input messages.
+ * \param GroupsNum Number of created groups.
+ * \param ems Whether to handle EMS (user UDH) linking.
+ *
+ * \return Error code.
+ */
+GSM_Error GSM_LinkSMSGroups(GSM_Debug_Info *di, GSM_SMSMessage **Input, const int *InputNumber, GSM_SMSLinkGroup *Groups, int *GroupsNum, gboolean ems);
+
 gboolean GSM_DecodeMMSIndication(GSM_Debug_Info *di,
 			    GSM_MultiPartSMSInfo	*Info,
 			    GSM_MultiSMSMessage		*SMS);
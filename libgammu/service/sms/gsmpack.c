@@ -0,0 +1,367 @@
+/**
+ * \file gsmpack.c
+ *
+ * Compact storage of SMS messages.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <gammu-misc.h>
+
+#include "gsmpack.h"
+
+/**
+ * Fixed size part of packed message part.
+ */
+typedef struct {
+	size_t Size;
+	unsigned char ReplaceMessage;
+	gboolean RejectDuplicates;
+	GSM_UDH UDHType;
+	int UDHLength;
+	int ID8bit;
+	int ID16bit;
+	int PartNumber;
+	int AllParts;
+	int OtherNumbersNum;
+	int CallbackIndex;
+	int SMSCLocation;
+	GSM_SMSValidity SMSCValidity;
+	GSM_SMSFormat SMSCFormat;
+	GSM_MemoryType Memory;
+	int Location;
+	int Folder;
+	gboolean InboxFolder;
+	int Length;
+	GSM_SMS_State State;
+	GSM_SMSMessageType PDU;
+	GSM_Coding_Type Coding;
+	GSM_DateTime DateTime;
+	GSM_DateTime SMSCTime;
+	unsigned char DeliveryStatus;
+	gboolean ReplyViaSameSMSC;
+	signed char Class;
+	unsigned char MessageReference;
+	SMS_PRIORITY Priority;
+} GSM_PackedSMS;
+
+/**
+ * Fixed size part of packed message.
+ */
+typedef struct {
+	int Number;
+	gboolean Processed;
+} GSM_PackedMultiSMS;
+
+#define PACK_MAX_FIELDS (8 + GSM_SMS_OTHER_NUMBERS)
+
+/**
+ * Lists variable length fields of message, returns their count.
+ */
+static int GSM_PackFields(GSM_SMSMessage *sms, int othernumbers, unsigned char **fields, size_t *sizes)
+{
+	int i, num = 0;
+
+#define PACK_FIELD(field) \
+	fields[num] = (unsigned char *)(field); \
+	sizes[num++] = sizeof(field);
+
+	PACK_FIELD(sms->UDH.Text);
+	PACK_FIELD(sms->Number);
+	for (i = 0; i < othernumbers; i++) {
+		PACK_FIELD(sms->OtherNumbers[i]);
+	}
+	PACK_FIELD(sms->SMSC.Name);
+	PACK_FIELD(sms->SMSC.Number);
+	PACK_FIELD(sms->SMSC.DefaultNumber);
+	PACK_FIELD(sms->Name);
+	PACK_FIELD(sms->Text);
+
+#undef PACK_FIELD
+
+	return num;
+}
+
+/**
+ * Length of Unicode string including terminator, limited by buffer size.
+ */
+static size_t GSM_PackStringLength(const unsigned char *str, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i + 1 < size; i += 2) {
+		if (str[i] == 0 && str[i + 1] == 0) {
+			return i + 2;
+		}
+	}
+	return size;
+}
+
+/**
+ * Packs single part, returns packed size. Nothing is written when
+ * dest is NULL.
+ */
+static size_t GSM_PackSMS(unsigned char *dest, const GSM_SMSMessage *sms)
+{
+	GSM_PackedSMS header;
+	unsigned char *fields[PACK_MAX_FIELDS];
+	size_t sizes[PACK_MAX_FIELDS];
+	size_t pos, len;
+	unsigned short packedlen;
+	int i, num, othernumbers;
+
+	othernumbers = sms->OtherNumbersNum;
+	if (othernumbers < 0) othernumbers = 0;
+	if (othernumbers > GSM_SMS_OTHER_NUMBERS) othernumbers = GSM_SMS_OTHER_NUMBERS;
+
+	num = GSM_PackFields((GSM_SMSMessage *)sms, othernumbers, fields, sizes);
+
+	pos = sizeof(GSM_PackedSMS);
+	for (i = 0; i < num; i++) {
+		if (fields[i] == sms->UDH.Text) {
+			len = sms->UDH.Length > 0 ? (size_t)sms->UDH.Length : 0;
+		} else {
+			len = GSM_PackStringLength(fields[i], sizes[i]);
+		}
+		if (fields[i] == sms->Text && sms->Length > 0) {
+			/* 8-bit data can contain zeros */
+			if (sms->Coding == SMS_Coding_8bit) {
+				len = MAX(len, (size_t)sms->Length);
+			} else {
+				len = MAX(len, (size_t)sms->Length * 2);
+			}
+		}
+		len = MIN(len, sizes[i]);
+		if (dest != NULL) {
+			packedlen = len;
+			memcpy(dest + pos, &packedlen, sizeof(packedlen));
+			memcpy(dest + pos + sizeof(packedlen), fields[i], len);
+		}
+		pos += sizeof(packedlen) + len;
+	}
+
+	if (dest == NULL) {
+		return pos;
+	}
+
+	header.Size = pos;
+	header.ReplaceMessage = sms->ReplaceMessage;
+	header.RejectDuplicates = sms->RejectDuplicates;
+	header.UDHType = sms->UDH.Type;
+	header.UDHLength = sms->UDH.Length;
+	header.ID8bit = sms->UDH.ID8bit;
+	header.ID16bit = sms->UDH.ID16bit;
+	header.PartNumber = sms->UDH.PartNumber;
+	header.AllParts = sms->UDH.AllParts;
+	header.OtherNumbersNum = sms->OtherNumbersNum;
+	header.CallbackIndex = sms->CallbackIndex;
+	header.SMSCLocation = sms->SMSC.Location;
+	header.SMSCValidity = sms->SMSC.Validity;
+	header.SMSCFormat = sms->SMSC.Format;
+	header.Memory = sms->Memory;
+	header.Location = sms->Location;
+	header.Folder = sms->Folder;
+	header.InboxFolder = sms->InboxFolder;
+	header.Length = sms->Length;
+	header.State = sms->State;
+	header.PDU = sms->PDU;
+	header.Coding = sms->Coding;
+	header.DateTime = sms->DateTime;
+	header.SMSCTime = sms->SMSCTime;
+	header.DeliveryStatus = sms->DeliveryStatus;
+	header.ReplyViaSameSMSC = sms->ReplyViaSameSMSC;
+	header.Class = sms->Class;
+	header.MessageReference = sms->MessageReference;
+	header.Priority = sms->Priority;
+	memcpy(dest, &header, sizeof(header));
+
+	return pos;
+}
+
+/**
+ * Unpacks single part, returns packed size.
+ */
+static size_t GSM_UnpackSMS(const unsigned char *src, GSM_SMSMessage *sms)
+{
+	GSM_PackedSMS header;
+	unsigned char *fields[PACK_MAX_FIELDS];
+	size_t sizes[PACK_MAX_FIELDS];
+	size_t pos;
+	unsigned short packedlen;
+	int i, num, othernumbers;
+
+	memcpy(&header, src, sizeof(header));
+
+	sms->ReplaceMessage = header.ReplaceMessage;
+	sms->RejectDuplicates = header.RejectDuplicates;
+	sms->UDH.Type = header.UDHType;
+	sms->UDH.Length = header.UDHLength;
+	sms->UDH.ID8bit = header.ID8bit;
+	sms->UDH.ID16bit = header.ID16bit;
+	sms->UDH.PartNumber = header.PartNumber;
+	sms->UDH.AllParts = header.AllParts;
+	sms->OtherNumbersNum = header.OtherNumbersNum;
+	sms->CallbackIndex = header.CallbackIndex;
+	sms->SMSC.Location = header.SMSCLocation;
+	sms->SMSC.Validity = header.SMSCValidity;
+	sms->SMSC.Format = header.SMSCFormat;
+	sms->Memory = header.Memory;
+	sms->Location = header.Location;
+	sms->Folder = header.Folder;
+	sms->InboxFolder = header.InboxFolder;
+	sms->Length = header.Length;
+	sms->State = header.State;
+	sms->PDU = header.PDU;
+	sms->Coding = header.Coding;
+	sms->DateTime = header.DateTime;
+	sms->SMSCTime = header.SMSCTime;
+	sms->DeliveryStatus = header.DeliveryStatus;
+	sms->ReplyViaSameSMSC = header.ReplyViaSameSMSC;
+	sms->Class = header.Class;
+	sms->MessageReference = header.MessageReference;
+	sms->Priority = header.Priority;
+
+	othernumbers = header.OtherNumbersNum;
+	if (othernumbers < 0) othernumbers = 0;
+	if (othernumbers > GSM_SMS_OTHER_NUMBERS) othernumbers = GSM_SMS_OTHER_NUMBERS;
+
+	num = GSM_PackFields(sms, othernumbers, fields, sizes);
+
+	pos = sizeof(GSM_PackedSMS);
+	for (i = 0; i < num; i++) {
+		memcpy(&packedlen, src + pos, sizeof(packedlen));
+		pos += sizeof(packedlen);
+		memcpy(fields[i], src + pos, packedlen);
+		pos += packedlen;
+		/* Terminate strings which were stored without terminator */
+		if (packedlen < sizes[i]) {
+			fields[i][packedlen] = 0;
+		}
+		if ((size_t)packedlen + 1 < sizes[i]) {
+			fields[i][packedlen + 1] = 0;
+		}
+	}
+
+	return header.Size;
+}
+
+void GSM_SMSArena_New(GSM_SMSArena *arena)
+{
+	arena->Buffer = NULL;
+	arena->Used = 0;
+	arena->Allocated = 0;
+	arena->Offsets = NULL;
+	arena->Number = 0;
+	arena->OffsetsAllocated = 0;
+}
+
+void GSM_SMSArena_Free(GSM_SMSArena *arena)
+{
+	free(arena->Buffer);
+	free(arena->Offsets);
+	GSM_SMSArena_New(arena);
+}
+
+GSM_Error GSM_SMSArena_Add(GSM_SMSArena *arena, const GSM_MultiSMSMessage *sms)
+{
+	GSM_PackedMultiSMS header;
+	unsigned char *newbuffer;
+	size_t *newoffsets;
+	size_t size, newsize;
+	int i, number;
+
+	number = MIN(MAX(sms->Number, 0), GSM_MAX_MULTI_SMS);
+
+	size = sizeof(GSM_PackedMultiSMS);
+	for (i = 0; i < number; i++) {
+		size += GSM_PackSMS(NULL, &sms->SMS[i]);
+	}
+
+	if (arena->Number + 1 > arena->OffsetsAllocated) {
+		newoffsets = (size_t *)realloc(arena->Offsets, (arena->OffsetsAllocated + 20) * sizeof(size_t));
+		if (newoffsets == NULL) return ERR_MOREMEMORY;
+		arena->Offsets = newoffsets;
+		arena->OffsetsAllocated += 20;
+	}
+
+	if (arena->Used + size > arena->Allocated) {
+		newsize = MAX(arena->Allocated * 2, arena->Used + size);
+		newbuffer = (unsigned char *)realloc(arena->Buffer, newsize);
+		if (newbuffer == NULL) return ERR_MOREMEMORY;
+		arena->Buffer = newbuffer;
+		arena->Allocated = newsize;
+	}
+
+	arena->Offsets[arena->Number++] = arena->Used;
+
+	header.Number = number;
+	header.Processed = sms->Processed;
+	memcpy(arena->Buffer + arena->Used, &header, sizeof(header));
+	arena->Used += sizeof(header);
+
+	for (i = 0; i < number; i++) {
+		arena->Used += GSM_PackSMS(arena->Buffer + arena->Used, &sms->SMS[i]);
+	}
+
+	return ERR_NONE;
+}
+
+int GSM_SMSArena_Parts(const GSM_SMSArena *arena, int index)
+{
+	GSM_PackedMultiSMS header;
+
+	if (index < 0 || index >= arena->Number) {
+		return 0;
+	}
+	memcpy(&header, arena->Buffer + arena->Offsets[index], sizeof(header));
+	return header.Number;
+}
+
+GSM_Error GSM_SMSArena_GetPart(const GSM_SMSArena *arena, int index, int part, GSM_SMSMessage *sms)
+{
+	GSM_PackedSMS header;
+	size_t pos;
+	int i;
+
+	if (part < 0 || part >= GSM_SMSArena_Parts(arena, index)) {
+		return ERR_INVALIDLOCATION;
+	}
+
+	pos = arena->Offsets[index] + sizeof(GSM_PackedMultiSMS);
+	for (i = 0; i < part; i++) {
+		memcpy(&header, arena->Buffer + pos, sizeof(header));
+		pos += header.Size;
+	}
+
+	GSM_UnpackSMS(arena->Buffer + pos, sms);
+
+	return ERR_NONE;
+}
+
+GSM_Error GSM_SMSArena_Get(const GSM_SMSArena *arena, int index, GSM_MultiSMSMessage *sms)
+{
+	GSM_PackedMultiSMS header;
+	size_t pos;
+	int i;
+
+	if (index < 0 || index >= arena->Number) {
+		return ERR_INVALIDLOCATION;
+	}
+
+	pos = arena->Offsets[index];
+	memcpy(&header, arena->Buffer + pos, sizeof(header));
+	pos += sizeof(header);
+
+	sms->Number = header.Number;
+	sms->Processed = header.Processed;
+	for (i = 0; i < header.Number; i++) {
+		pos += GSM_UnpackSMS(arena->Buffer + pos, &sms->SMS[i]);
+	}
+
+	return ERR_NONE;
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
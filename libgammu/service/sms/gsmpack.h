@@ -0,0 +1,86 @@
+/**
+ * \file gsmpack.h
+ *
+ * Compact storage of SMS messages.
+ */
+#ifndef __gsm_pack_h
+#define __gsm_pack_h
+
+#include <gammu-message.h>
+
+/**
+ * Arena holding messages in compact form.
+ *
+ * Messages are stored one after another in single buffer, each part
+ * occupies only space needed for its actual content instead of the
+ * fixed size buffers of \ref GSM_SMSMessage. Conversion from and to
+ * \ref GSM_MultiSMSMessage is done when message is added or read.
+ */
+typedef struct {
+	/**
+	 * Packed messages.
+	 */
+	unsigned char *Buffer;
+	/**
+	 * Used bytes in Buffer.
+	 */
+	size_t Used;
+	/**
+	 * Allocated bytes in Buffer.
+	 */
+	size_t Allocated;
+	/**
+	 * Offsets of messages in Buffer.
+	 */
+	size_t *Offsets;
+	/**
+	 * Number of stored messages.
+	 */
+	int Number;
+	/**
+	 * Allocated entries in Offsets.
+	 */
+	int OffsetsAllocated;
+} GSM_SMSArena;
+
+/**
+ * Initializes empty arena.
+ */
+void GSM_SMSArena_New(GSM_SMSArena *arena);
+
+/**
+ * Frees all messages stored in arena.
+ */
+void GSM_SMSArena_Free(GSM_SMSArena *arena);
+
+/**
+ * Stores message in arena.
+ *
+ * \return Error code, ERR_MOREMEMORY if allocation fails.
+ */
+GSM_Error GSM_SMSArena_Add(GSM_SMSArena *arena, const GSM_MultiSMSMessage *sms);
+
+/**
+ * Returns number of parts of stored message.
+ */
+int GSM_SMSArena_Parts(const GSM_SMSArena *arena, int index);
+
+/**
+ * Reads single part of stored message.
+ *
+ * \return Error code, ERR_INVALIDLOCATION for invalid index or part.
+ */
+GSM_Error GSM_SMSArena_GetPart(const GSM_SMSArena *arena, int index, int part, GSM_SMSMessage *sms);
+
+/**
+ * Reads stored message, only used parts of sms are written.
+ *
+ * \return Error code, ERR_INVALIDLOCATION for invalid index.
+ */
+GSM_Error GSM_SMSArena_Get(const GSM_SMSArena *arena, int index, GSM_MultiSMSMessage *sms);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -6,6 +6,7 @@
 #include <time.h>
 #include <assert.h>
 #include <math.h>
+#include <sys/stat.h>
 #ifndef WIN32
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -28,6 +29,13 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif
+#ifndef WIN32
+#include <sys/time.h>
+#endif
+
 #ifdef HAVE_SHM
 #include <sys/types.h>
 #include <sys/ipc.h>
@@ -49,8 +57,11 @@
 #endif
 
 #include "core.h"
+#include "metrics.h"
+#include "status.h"
 #include "services/files.h"
 #include "services/null.h"
+#include "services/stream.h"
 #if defined(HAVE_MYSQL_MYSQL_H) || defined(HAVE_POSTGRESQL_LIBPQ_FE_H) || defined(LIBDBI_FOUND) || defined(ODBC_FOUND)
 #include "services/sql.h"
 #endif
@@ -62,6 +73,8 @@
 #include "../libgammu/misc/string.h"
 #include "../libgammu/protocol/protocol.h"
 #include "../libgammu/gsmstate.h"
+#include "../libgammu/service/sms/gsmmulti.h"
+#include "../libgammu/service/sms/gsmpack.h"
 
 #ifndef PATH_MAX
 #ifdef MAX_PATH
@@ -71,7 +84,7 @@
 #endif
 #endif
 
-GSM_Error SMSD_ProcessSMSInfoCache(GSM_SMSDConfig *Config);
+GSM_Error SMSD_FreeSharedMemory(GSM_SMSDConfig *Config, gboolean writable);
 
 const char smsd_name[] = "gammu-smsd";
 
@@ -396,6 +409,7 @@ GSM_SMSDConfig *SMSD_NewConfig(const char *name)
 	if (Config == NULL) return Config;
 
 	Config->running = FALSE;
+	Config->Status = NULL;
 	Config->failure = ERR_NONE;
 	Config->exit_on_failure = TRUE;
 	Config->shutdown = FALSE;
@@ -415,6 +429,25 @@ GSM_SMSDConfig *SMSD_NewConfig(const char *name)
 	Config->Service = NULL;
 	Config->IgnoredMessages = 0;
 	Config->PhoneID = NULL;
+	Config->outboxmtime = 0;
+	Config->outboxwatch = -1;
+	Config->streampath = NULL;
+	Config->streamsocket = NULL;
+	Config->streamsegmentsize = 0;
+	Config->streamfd = -1;
+	Config->streamsegment = 0;
+	Config->journalpath = NULL;
+	Config->journal_pending = FALSE;
+	Config->inbox_journaled = FALSE;
+	SMSD_Scheduler_Init(&Config->Scheduler);
+	SMSD_Locations_Init(&Config->Indicated);
+	SMSD_Locations_Init(&Config->Expected);
+	Config->IncomingNotify = FALSE;
+	Config->Indications = 0;
+	Config->UnexpectedMessages = 0;
+	Config->ScanIndicated = 0;
+	Config->NotifyHealthy = FALSE;
+	Config->ScanNeeded = FALSE;
 
 #if defined(HAVE_MYSQL_MYSQL_H)
 	Config->conn.my = NULL;
@@ -460,6 +493,9 @@ GSM_Error SMSGetService(GSM_SMSDConfig *Config)
 	} else if (strcasecmp(Config->ServiceName, "NULL") == 0) {
 		SMSD_Log(DEBUG_NOTICE, Config, "Using NULL service");
 		Config->Service = &SMSDNull;
+	} else if (strcasecmp(Config->ServiceName, "STREAM") == 0) {
+		SMSD_Log(DEBUG_NOTICE, Config, "Using STREAM service");
+		Config->Service = &SMSDStream;
 	} else if (strcasecmp(Config->ServiceName, "SQL") == 0) {
 #if defined(ODBC_FOUND) ||  defined(LIBDBI_FOUND) || defined(HAVE_MYSQL_MYSQL_H) || defined(HAVE_POSTGRESQL_LIBPQ_FE_H)
 		SMSD_Log(DEBUG_NOTICE, Config, "Using SQL service");
@@ -523,8 +559,16 @@ void SMSD_FreeConfig(GSM_SMSDConfig *Config)
 
 	free(Config->gammu_log_buffer);
 
+	SMSD_Locations_Free(&Config->Indicated);
+	SMSD_Locations_Free(&Config->Expected);
+
 	INI_Free(Config->smsdcfgfile);
 
+	/* Shared memory kept mapped by SMSD_GetStatus */
+	if (!Config->running && Config->Status != NULL) {
+		SMSD_FreeSharedMemory(Config, FALSE);
+	}
+
 	GSM_FreeStateMachine(Config->gsm);
 
 	free(Config);
@@ -695,6 +739,7 @@ GSM_Error SMSD_ReadConfig(const char *filename, GSM_SMSDConfig *Config, gboolean
 	GSM_Config 		*gammucfg;
 	unsigned char		*str;
 	GSM_Error		error;
+	struct stat		st;
 #ifdef HAVE_SHM
 	char			fullpath[PATH_MAX + 1];
 #endif
@@ -834,6 +879,7 @@ GSM_Error SMSD_ReadConfig(const char *filename, GSM_SMSDConfig *Config, gboolean
 	Config->receivefrequency = INI_GetInt(Config->smsdcfgfile, "smsd", "receivefrequency", 15);
 	Config->statusfrequency = INI_GetInt(Config->smsdcfgfile, "smsd", "statusfrequency", 60);
 	Config->loopsleep = INI_GetInt(Config->smsdcfgfile, "smsd", "loopsleep", 1);
+	Config->reconcilefrequency = INI_GetInt(Config->smsdcfgfile, "smsd", "reconcilefrequency", 300);
 	Config->checksecurity = INI_GetBool(Config->smsdcfgfile, "smsd", "checksecurity", TRUE);
 	Config->hangupcalls = INI_GetBool(Config->smsdcfgfile, "smsd", "hangupcalls", FALSE);
 	Config->checksignal = INI_GetBool(Config->smsdcfgfile, "smsd", "checksignal", TRUE);
@@ -851,9 +897,15 @@ GSM_Error SMSD_ReadConfig(const char *filename, GSM_SMSDConfig *Config, gboolean
 		SMSD_Log(DEBUG_NOTICE, Config, "BackendRetries too low, forcing to 1");
 		Config->backend_retries = 1;
 	}
+	Config->journalpath = INI_GetValue(Config->smsdcfgfile, "smsd", "journal", FALSE);
+	Config->journal_pending = FALSE;
+	if (Config->journalpath != NULL && stat(Config->journalpath, &st) == 0 && st.st_size > 0) {
+		SMSD_Log(DEBUG_NOTICE, Config, "Journal %s contains operations to replay", Config->journalpath);
+		Config->journal_pending = TRUE;
+	}
 
-	SMSD_Log(DEBUG_NOTICE, Config, "CommTimeout=%i, SendTimeout=%i, ReceiveFrequency=%i, ResetFrequency=%i, HardResetFrequency=%i",
-			Config->commtimeout, Config->sendtimeout, Config->receivefrequency, Config->resetfrequency, Config->hardresetfrequency);
+	SMSD_Log(DEBUG_NOTICE, Config, "CommTimeout=%i, SendTimeout=%i, ReceiveFrequency=%i, ReconcileFrequency=%i, ResetFrequency=%i, HardResetFrequency=%i",
+			Config->commtimeout, Config->sendtimeout, Config->receivefrequency, Config->reconcilefrequency, Config->resetfrequency, Config->hardresetfrequency);
 	SMSD_Log(DEBUG_NOTICE, Config, "checks: CheckSecurity=%d, CheckBattery=%d, CheckSignal=%d, CheckNetwork=%d",
 			Config->checksecurity, Config->checkbattery, Config->checksignal, Config->checknetwork);
 	SMSD_Log(DEBUG_NOTICE, Config, "mode: Send=%d, Receive=%d",
@@ -1130,7 +1182,7 @@ void SMSD_RunOnReceiveEnvironment(GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Conf
  *
  * This is Windows variant.
  */
-gboolean SMSD_RunOn(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, const char *locations, const char *event)
+static gboolean SMSD_RunOnExecute(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, const char *locations, const char *event)
 {
 	BOOL ret;
 	STARTUPINFO si;
@@ -1177,7 +1229,7 @@ gboolean SMSD_RunOn(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfi
  *
  * This is POSIX variant.
  */
-gboolean SMSD_RunOn(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, const char *locations, const char *event)
+static gboolean SMSD_RunOnExecute(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, const char *locations, const char *event)
 {
 	int pid;
 	int pipefd[2];
@@ -1292,6 +1344,19 @@ out:
 }
 #endif
 
+/**
+ * Executes external command and measures how long it took.
+ */
+gboolean SMSD_RunOn(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, const char *locations, const char *event)
+{
+	long long start = GSM_GetMonotonicTime();
+	gboolean result;
+
+	result = SMSD_RunOnExecute(command, sms, Config, locations, event);
+	SMSD_Metrics_Record(Config, SMSD_METRIC_HOOK, start, result ? ERR_NONE : ERR_UNKNOWN);
+	return result;
+}
+
 /**
  * Checks whether we are allowed to accept a message from number.
  */
@@ -1373,13 +1438,20 @@ GSM_Error SMSD_ProcessSMS(GSM_SMSDConfig *Config, GSM_MultiSMSMessage *sms)
 {
 	GSM_Error error = ERR_NONE;
 	char *locations = NULL;
+	long long start;
 
 	/* Increase message counter */
+	SMSD_Status_BeginUpdate(Config->Status);
 	Config->Status->Received += sms->Number;
+	Config->Status->LastReceived = time(NULL);
+	SMSD_Status_EndUpdate(Config->Status);
 	/* Send message to the backend */
+	start = GSM_GetMonotonicTime();
+	Config->inbox_journaled = FALSE;
 	error = Config->Service->SaveInboxSMS(sms, Config, &locations);
-	/* RunOnReceive handling */
-	if (Config->RunOnReceive != NULL && error == ERR_NONE) {
+	SMSD_Metrics_Record(Config, SMSD_METRIC_INBOX, start, error);
+	/* RunOnReceive handling, journaled message gets it on replay */
+	if (Config->RunOnReceive != NULL && error == ERR_NONE && !Config->inbox_journaled) {
 		SMSD_RunOn(Config->RunOnReceive, sms, Config, locations, "receive");
 	}
 	/* Free memory allocated by SaveInboxSMS */
@@ -1458,6 +1530,138 @@ success:
 	return TRUE;
 }
 
+/**
+ * Remembers locations of all parts of message read from phone, returns
+ * number of parts which were not seen before.
+ */
+static int SMSD_RememberSMS(GSM_SMSDConfig *Config, SMSD_Locations *Seen, GSM_MultiSMSMessage *sms)
+{
+	int i, unexpected = 0;
+
+	for (i = 0; i < sms->Number; i++) {
+		if (!SMSD_Locations_Contains(&Config->Expected, 0, sms->SMS[i].Location, sms->SMS[i].Memory)) {
+			unexpected++;
+		}
+		if (SMSD_Locations_Add(Seen, 0, sms->SMS[i].Location, sms->SMS[i].Memory) != ERR_NONE) {
+			SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
+		}
+	}
+	return unexpected;
+}
+
+/**
+ * Links messages read from phone, processes them and deletes processed
+ * ones from phone. Incomplete multipart messages are left in the phone,
+ * their number is stored in skipped.
+ */
+static gboolean SMSD_ProcessReadSMS(GSM_SMSDConfig *Config, GSM_SMSArena *arena, int *skipped)
+{
+	gboolean result = FALSE;
+	GSM_MultiSMSMessage *linked = NULL;
+	GSM_SMSMessage **FirstParts = NULL;
+	GSM_SMSMessage *FirstPartsData = NULL;
+	GSM_SMSLinkGroup *Groups = NULL;
+	GSM_SMSLocation *Processed = NULL;
+	int *PartsNumber = NULL;
+	int GroupsNum = 0, ProcessedNum = 0, PartsTotal = 0;
+	int GetSMSNumber = arena->Number;
+	GSM_Error error;
+	int i, j;
+
+	*skipped = 0;
+
+	/* No messages to process */
+	if (GetSMSNumber == 0) {
+		return TRUE;
+	}
+
+	/* Only first parts are needed for linking messages, they share one block */
+	FirstParts = (GSM_SMSMessage **)calloc(GetSMSNumber + 1, sizeof(GSM_SMSMessage *));
+	FirstPartsData = (GSM_SMSMessage *)malloc(GetSMSNumber * sizeof(GSM_SMSMessage));
+	PartsNumber = (int *)malloc(GetSMSNumber * sizeof(int));
+	Groups = (GSM_SMSLinkGroup *)malloc(GetSMSNumber * sizeof(GSM_SMSLinkGroup));
+	linked = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+	if (FirstParts == NULL || FirstPartsData == NULL || PartsNumber == NULL || Groups == NULL || linked == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory for linking messages");
+		goto cleanup;
+	}
+	for (i = 0; i < GetSMSNumber; i++) {
+		FirstParts[i] = &FirstPartsData[i];
+		GSM_SMSArena_GetPart(arena, i, 0, FirstParts[i]);
+		PartsNumber[i] = GSM_SMSArena_Parts(arena, i);
+		PartsTotal += PartsNumber[i];
+	}
+
+	/* Locations of processed messages, these are deleted at once */
+	Processed = (GSM_SMSLocation *)malloc(PartsTotal * sizeof(GSM_SMSLocation));
+	if (Processed == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory for linking messages");
+		goto cleanup;
+	}
+
+	/* Link messages */
+	error = GSM_LinkSMSGroups(GSM_GetDebug(Config->gsm), FirstParts, PartsNumber, Groups, &GroupsNum, TRUE);
+	if (error != ERR_NONE) goto cleanup;
+
+	/* Process messages */
+	for (i = 0; i < GroupsNum; i++) {
+		/* Expand linked message, first parts can have updated UDH information */
+		if (Groups[i].Whole) {
+			GSM_SMSArena_Get(arena, Groups[i].Parts[0], linked);
+			linked->SMS[0] = *FirstParts[Groups[i].Parts[0]];
+		} else {
+			for (j = 0; j < Groups[i].Number; j++) {
+				linked->SMS[j] = *FirstParts[Groups[i].Parts[j]];
+			}
+			linked->Number = Groups[i].Number;
+			linked->Processed = FALSE;
+		}
+
+		/* Check multipart message parts */
+		if (!SMSD_CheckMultipart(Config, linked)) {
+			(*skipped)++;
+			continue;
+		}
+
+		/* Actually process the message */
+		error = SMSD_ProcessSMS(Config, linked);
+		if (error != ERR_NONE) {
+			SMSD_LogError(DEBUG_INFO, Config, "Error processing SMS", error);
+			goto cleanup;
+		}
+
+		/* Remember processed messages for deleting */
+		for (j = 0; j < linked->Number && ProcessedNum < PartsTotal; j++) {
+			Processed[ProcessedNum].Folder = 0;
+			Processed[ProcessedNum].Location = linked->SMS[j].Location;
+			Processed[ProcessedNum].Memory = linked->SMS[j].Memory;
+			ProcessedNum++;
+		}
+	}
+	result = TRUE;
+
+cleanup:
+	/* Delete processed messages, even when processing of others failed */
+	if (ProcessedNum > 0) {
+		error = GSM_DeleteSMSBatch(Config->gsm, Processed, ProcessedNum);
+		if (error != ERR_NONE) {
+			SMSD_LogError(DEBUG_INFO, Config, "Error deleting SMS", error);
+			result = FALSE;
+		} else {
+			for (i = 0; i < ProcessedNum; i++) {
+				SMSD_Locations_Remove(&Config->Expected, 0, Processed[i].Location, Processed[i].Memory);
+			}
+		}
+	}
+	free(Processed);
+	free(FirstParts);
+	free(FirstPartsData);
+	free(PartsNumber);
+	free(Groups);
+	free(linked);
+	return result;
+}
+
 /**
  * Reads message from phone, processes it and delete it from phone afterwards.
  *
@@ -1465,130 +1669,176 @@ success:
  */
 gboolean SMSD_ReadDeleteSMS(GSM_SMSDConfig *Config)
 {
-	gboolean start;
-	GSM_MultiSMSMessage sms;
-	GSM_MultiSMSMessage **GetSMSData = NULL, **SortedSMS;
-	int allocated = 0;
+	gboolean start, result = FALSE;
+	GSM_MultiSMSMessage *sms;
+	GSM_SMSArena arena;
+	SMSD_Locations seen;
 	GSM_Error error = ERR_NONE;
-	int GetSMSNumber = 0;
-	int i, j;
+	int skipped;
+	long long read_start;
 
-	/* Read messages from phone */
+	/* Every message is decoded to the same buffer and kept in compact form */
+	sms = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+	if (sms == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
+		return FALSE;
+	}
+	GSM_SMSArena_New(&arena);
+	SMSD_Locations_Init(&seen);
 	Config->IgnoredMessages = 0;
+	Config->UnexpectedMessages = 0;
 	start=TRUE;
-	sms.Number = 0;
-	sms.SMS[0].Location = 0;
+	sms->Number = 0;
+	sms->SMS[0].Location = 0;
 	while (error == ERR_NONE && !Config->shutdown) {
-		sms.SMS[0].Folder = 0;
-		error = GSM_GetNextSMS(Config->gsm, &sms, start);
+		sms->SMS[0].Folder = 0;
+		read_start = GSM_GetMonotonicTime();
+		error = GSM_GetNextSMS(Config->gsm, sms, start);
+		if (error != ERR_EMPTY) {
+			SMSD_Metrics_Record(Config, SMSD_METRIC_READ, read_start, error);
+		}
 		switch (error) {
 			case ERR_EMPTY:
 				break;
 			case ERR_NONE:
-				if (SMSD_ValidMessage(Config, &sms)) {
-					if (allocated <= GetSMSNumber + 2) {
-						GetSMSData = (GSM_MultiSMSMessage **)realloc(GetSMSData, (allocated + 20) * sizeof(GSM_MultiSMSMessage *));
-						if (GetSMSData == NULL) {
-							SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
-							return FALSE;
-						}
-						allocated += 20;
-					}
-					GetSMSData[GetSMSNumber] = malloc(sizeof(GSM_MultiSMSMessage));
-
-					if (GetSMSData[GetSMSNumber] == NULL) {
+				Config->UnexpectedMessages += SMSD_RememberSMS(Config, &seen, sms);
+				if (SMSD_ValidMessage(Config, sms)) {
+					if (GSM_SMSArena_Add(&arena, sms) != ERR_NONE) {
 						SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
-						for (i = 0; GetSMSData[i] != NULL; i++) {
-							free(GetSMSData[i]);
-							GetSMSData[i] = NULL;
-						}
-						free(GetSMSData);
-						return FALSE;
+						goto cleanup;
 					}
-
-					*(GetSMSData[GetSMSNumber]) = sms;
-					GetSMSNumber++;
-					GetSMSData[GetSMSNumber] = NULL;
 				} else {
 					Config->IgnoredMessages++;
 				}
 				break;
 			default:
 				SMSD_LogError(DEBUG_ERROR, Config, "Error getting SMS", error);
-				if (GetSMSData != NULL) {
-					for (i = 0; GetSMSData[i] != NULL; i++) {
-						free(GetSMSData[i]);
-						GetSMSData[i] = NULL;
-					}
-					free(GetSMSData);
-				}
-				return FALSE;
+				goto cleanup;
 		}
 		start = FALSE;
-
-    /* process any incoming SMS information records to help prevent memory exhaustion, ignore any
-     * errors so as not to interfere with this function, they'll be handle in main-loop processing */
-    SMSD_ProcessSMSInfoCache(Config);
-  }
+	}
 
 	/* Log how many messages were read */
-	SMSD_Log(DEBUG_INFO, Config, "Read %d messages", GetSMSNumber);
+	SMSD_Log(DEBUG_INFO, Config, "Read %d messages", arena.Number);
 
-	/* No messages to process */
-	if (GetSMSNumber == 0) {
+	/* Listing describes all messages left in the phone */
+	SMSD_Locations_Free(&Config->Expected);
+	Config->Expected = seen;
+	SMSD_Locations_Init(&seen);
+
+	result = SMSD_ProcessReadSMS(Config, &arena, &skipped);
+
+cleanup:
+	SMSD_Locations_Free(&seen);
+	GSM_SMSArena_Free(&arena);
+	free(sms);
+	return result;
+}
+
+/**
+ * Number of indicated messages which are read one by one, listing all
+ * messages is used when more messages are indicated.
+ */
+#define SMSD_MAX_INDICATED_READS 5
+
+/**
+ * Reads messages from locations indicated by the phone, processes them
+ * and deletes them at once. This avoids full scan of phone memory for
+ * every received message. Multipart messages which are not complete
+ * are left for full scan, which links them with other stored parts.
+ */
+gboolean SMSD_ReadIndicatedSMS(GSM_SMSDConfig *Config)
+{
+	GSM_MultiSMSMessage *sms;
+	GSM_SMSArena arena;
+	GSM_SMSLocation *location;
+	GSM_Error error = ERR_NONE;
+	gboolean result = TRUE;
+	int i, skipped;
+	long long read_start;
+
+	if (Config->Indicated.Number == 0) {
 		return TRUE;
 	}
 
-	/* Allocate memory for sorted messages */
-	SortedSMS = (GSM_MultiSMSMessage **)malloc(allocated * sizeof(GSM_MultiSMSMessage *));
-	if (SortedSMS == NULL) {
-		SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory for linking messages");
-		SMSD_Log(DEBUG_ERROR, Config, "Skipping linking messages, long messages will not be connected");
-		SortedSMS = GetSMSData;
-	} else {
-		/* Link messages */
-		error = GSM_LinkSMS(GSM_GetDebug(Config->gsm), GetSMSData, SortedSMS, TRUE);
-		if (error != ERR_NONE) return FALSE;
-
-		/* Free memory */
-		for (i = 0; GetSMSData[i] != NULL; i++) {
-			free(GetSMSData[i]);
-			GetSMSData[i] = NULL;
-		}
-		free(GetSMSData);
+	/* Listing all messages is cheaper than reading many of them */
+	if (Config->Indicated.Number > SMSD_MAX_INDICATED_READS) {
+		SMSD_Log(DEBUG_INFO, Config, "%d messages indicated, reading all messages",
+				Config->Indicated.Number);
+		Config->ScanIndicated += Config->Indicated.Number;
+		SMSD_Locations_Clear(&Config->Indicated);
+		Config->ScanNeeded = TRUE;
+		return TRUE;
 	}
 
-	/* Process messages */
-	for (i = 0; SortedSMS[i] != NULL; i++) {
-		/* Check multipart message parts */
-		if (!SMSD_CheckMultipart(Config, SortedSMS[i])) {
-			goto cleanup;
+	/* Every message is decoded to the same buffer and kept in compact form */
+	sms = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+	if (sms == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
+		return FALSE;
+	}
+	GSM_SMSArena_New(&arena);
+	for (i = 0; i < Config->Indicated.Number && !Config->shutdown; i++) {
+		location = &Config->Indicated.Locations[i];
+		/* Only first part describes what to read */
+		memset(&sms->SMS[0], 0, sizeof(sms->SMS[0]));
+		sms->Number = 1;
+		sms->SMS[0].Folder = location->Folder;
+		sms->SMS[0].Location = location->Location;
+		sms->SMS[0].Memory = location->Memory;
+
+		read_start = GSM_GetMonotonicTime();
+		error = GSM_GetSMS(Config->gsm, sms);
+		if (error == ERR_EMPTY) {
+			/* Already processed by full scan */
+			SMSD_Log(DEBUG_INFO, Config, "No message at indicated location %s:%d",
+					GSM_MemoryTypeToString(location->Memory),
+					location->Location);
+			continue;
 		}
-
-		/* Actually process the message */
-		error = SMSD_ProcessSMS(Config, SortedSMS[i]);
+		SMSD_Metrics_Record(Config, SMSD_METRIC_READ, read_start, error);
 		if (error != ERR_NONE) {
-			SMSD_LogError(DEBUG_INFO, Config, "Error processing SMS", error);
-			return FALSE;
+			SMSD_LogError(DEBUG_ERROR, Config, "Error reading indicated SMS", error);
+			result = FALSE;
+			break;
 		}
 
-		/* Delete processed messages */
-		for (j = 0; j < SortedSMS[i]->Number; j++) {
-			SortedSMS[i]->SMS[j].Folder = 0;
-			error = GSM_DeleteSMS(Config->gsm, &SortedSMS[i]->SMS[j]);
-			// Empty error can happen if deleting message several times
-			if (error != ERR_NONE && error != ERR_EMPTY) {
-				SMSD_LogError(DEBUG_INFO, Config, "Error deleting SMS", error);
-				return FALSE;
-			}
+		/* Message will be seen by full scan if left in phone */
+		if (SMSD_Locations_Add(&Config->Expected, 0, sms->SMS[0].Location, sms->SMS[0].Memory) != ERR_NONE) {
+			SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
 		}
 
-cleanup:
-		free(SortedSMS[i]);
-		SortedSMS[i] = NULL;
+		if (!SMSD_ValidMessage(Config, sms)) {
+			Config->IgnoredMessages++;
+			continue;
+		}
+		if (GSM_SMSArena_Add(&arena, sms) != ERR_NONE) {
+			SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
+			result = FALSE;
+			break;
+		}
 	}
-	free(SortedSMS);
-	return TRUE;
+
+	if (result) {
+		SMSD_Locations_Clear(&Config->Indicated);
+		SMSD_Log(DEBUG_INFO, Config, "Read %d indicated messages", arena.Number);
+	} else {
+		/* Phone is in unknown state, rely on full scan */
+		Config->ScanIndicated += Config->Indicated.Number - i;
+		SMSD_Locations_Clear(&Config->Indicated);
+		Config->ScanNeeded = TRUE;
+	}
+
+	if (!SMSD_ProcessReadSMS(Config, &arena, &skipped)) {
+		result = FALSE;
+	}
+	if (skipped > 0) {
+		Config->ScanNeeded = TRUE;
+	}
+
+	GSM_SMSArena_Free(&arena);
+	free(sms);
+	return result;
 }
 
 /**
@@ -1600,7 +1850,7 @@ gboolean SMSD_CheckSMSStatus(GSM_SMSDConfig *Config)
 	GSM_SMSMemoryStatus	SMSStatus;
 	GSM_Error		error;
 	gboolean new_message = FALSE;
-	GSM_MultiSMSMessage sms;
+	GSM_MultiSMSMessage *sms;
 
 	/* Do we have any SMS in phone ? */
 
@@ -1610,11 +1860,17 @@ gboolean SMSD_CheckSMSStatus(GSM_SMSDConfig *Config)
 		new_message = (SMSStatus.SIMUsed + SMSStatus.PhoneUsed - Config->IgnoredMessages > 0);
 	} else if (error == ERR_NOTSUPPORTED || error == ERR_NOTIMPLEMENTED) {
 		/* Fallback to GetNext */
-		sms.Number = 0;
-		sms.SMS[0].Location = 0;
-		sms.SMS[0].Folder = 0;
-		error = GSM_GetNextSMS(Config->gsm, &sms, TRUE);
+		sms = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+		if (sms == NULL) {
+			SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory");
+			return FALSE;
+		}
+		sms->Number = 0;
+		sms->SMS[0].Location = 0;
+		sms->SMS[0].Folder = 0;
+		error = GSM_GetNextSMS(Config->gsm, sms, TRUE);
 		new_message = (error == ERR_NONE);
+		free(sms);
 	} else {
 		SMSD_LogError(DEBUG_INFO, Config, "Error getting SMS status", error);
 		return FALSE;
@@ -1633,68 +1889,82 @@ gboolean SMSD_CheckSMSStatus(GSM_SMSDConfig *Config)
  */
 void SMSD_PhoneStatus(GSM_SMSDConfig *Config) {
 	GSM_Error error;
+	GSM_PhoneStatus status;
+	long long start = GSM_GetMonotonicTime();
 
-	if (Config->checkbattery) {
-		error = GSM_GetBatteryCharge(Config->gsm, &Config->Status->Charge);
-	} else {
-		error = ERR_UNKNOWN;
-	}
+	/* Read into local copies, shared status is updated at once */
+	error = GSM_GetPhoneStatus(Config->gsm, &status,
+			Config->checkbattery, Config->checksignal, Config->checknetwork);
 	if (error != ERR_NONE) {
-		memset(&(Config->Status->Charge), 0, sizeof(Config->Status->Charge));
+		status.BatteryChargeError = error;
+		status.SignalQualityError = error;
+		status.NetworkInfoError = error;
 	}
-	if (Config->checksignal) {
-		error = GSM_GetSignalQuality(Config->gsm, &Config->Status->Network);
-	} else {
-		error = ERR_UNKNOWN;
+	if (status.BatteryChargeError != ERR_NONE) {
+		memset(&status.BatteryCharge, 0, sizeof(status.BatteryCharge));
 	}
-	if (error != ERR_NONE) {
-		memset(&(Config->Status->Network), 0, sizeof(Config->Status->Network));
-	}
-	if (Config->checknetwork) {
-		error = GSM_GetNetworkInfo(Config->gsm, &Config->Status->NetInfo);
-	} else {
-		error = ERR_UNKNOWN;
+	if (status.SignalQualityError != ERR_NONE) {
+		memset(&status.SignalQuality, 0, sizeof(status.SignalQuality));
 	}
-	if (error != ERR_NONE) {
-		memset(&(Config->Status->NetInfo), 0, sizeof(Config->Status->NetInfo));
-	} else if (error == ERR_NONE) {
-		if (Config->Status->NetInfo.State == GSM_NoNetwork) {
-			GSM_SetPower(Config->gsm, TRUE);
-		}
+	if (status.NetworkInfoError != ERR_NONE) {
+		memset(&status.NetworkInfo, 0, sizeof(status.NetworkInfo));
+	} else if (status.NetworkInfo.State == GSM_NoNetwork) {
+		GSM_SetPower(Config->gsm, TRUE);
 	}
+
+	SMSD_Status_BeginUpdate(Config->Status);
+	Config->Status->Charge = status.BatteryCharge;
+	Config->Status->Network = status.SignalQuality;
+	Config->Status->NetInfo = status.NetworkInfo;
+	Config->Status->LastStatus = time(NULL);
+	SMSD_Status_EndUpdate(Config->Status);
+
+	SMSD_Metrics_Record(Config, SMSD_METRIC_STATUS, start, ERR_NONE);
 }
 
 /**
- * Sends a sms message which is provided by the service backend.
+ * Sends a sms message which is provided by the service backend, sms
+ * is used as storage for it.
  */
-GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
+static GSM_Error SMSD_SendOutboxSMS(GSM_SMSDConfig *Config, GSM_MultiSMSMessage *sms)
 {
-	GSM_MultiSMSMessage  	sms;
 	GSM_DateTime         	Date;
 	GSM_Error            	error;
 	unsigned int         	j;
 	int			i, z;
+	long long		start;
 	char destinationnumber[3 * GSM_MAX_NUMBER_LENGTH + 1];
 
 	/* Clean structure before use */
 	for (i = 0; i < GSM_MAX_MULTI_SMS; i++) {
-		GSM_SetDefaultSMSData(&sms.SMS[i]);
+		GSM_SetDefaultSMSData(&sms->SMS[i]);
 	}
 
-	error = Config->Service->FindOutboxSMS(&sms, Config, Config->SMSID);
+	start = GSM_GetMonotonicTime();
+	error = Config->Service->FindOutboxSMS(sms, Config, Config->SMSID);
+	if (error != ERR_NOTSUPPORTED) {
+		SMSD_Metrics_Record(Config, SMSD_METRIC_OUTBOX, start, error == ERR_EMPTY ? ERR_NONE : error);
+	}
 
 	if (error == ERR_EMPTY || error == ERR_NOTSUPPORTED) {
 		/* No outbox sms */
 		return error;
 	}
+	if (error == ERR_DB_TIMEOUT) {
+		/* Message stays in outbox until backend is available */
+		SMSD_Log(DEBUG_INFO, Config, "Outbox not available, will try later");
+		return error;
+	}
 	if (error != ERR_NONE) {
 		/* Unknown error - escape */
 		SMSD_Log(DEBUG_INFO, Config, "Error in outbox on '%s'", Config->SMSID);
-		for (i = 0; i < sms.Number; i++) {
+		for (i = 0; i < sms->Number; i++) {
+			SMSD_Status_BeginUpdate(Config->Status);
 			Config->Status->Failed++;
-			Config->Service->AddSentSMSInfo(&sms, Config, Config->SMSID, i+1, SMSD_SEND_ERROR, -1);
+			SMSD_Status_EndUpdate(Config->Status);
+			Config->Service->AddSentSMSInfo(sms, Config, Config->SMSID, i+1, SMSD_SEND_ERROR, -1);
 		}
-		Config->Service->MoveSMS(&sms,Config, Config->SMSID, TRUE,FALSE);
+		Config->Service->MoveSMS(sms,Config, Config->SMSID, TRUE,FALSE);
 		return error;
 	}
 
@@ -1704,47 +1974,49 @@ GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
 
 	if (Config->SMSID[0] != 0 && (Config->retries > Config->maxretries)) {
 		SMSD_Log(DEBUG_NOTICE, Config, "Moved to errorbox, reached MaxRetries: %s", Config->SMSID);
-		for (i=0;i<sms.Number;i++) {
+		for (i=0;i<sms->Number;i++) {
 			if (Config->SkipMessage[i] == TRUE) {
 				SMSD_Log(DEBUG_NOTICE, Config, "Skipping %s:%d message for errorbox", Config->SMSID, i+1);
 				continue;
 			}
+			SMSD_Status_BeginUpdate(Config->Status);
 			Config->Status->Failed++;
-			Config->Service->AddSentSMSInfo(&sms, Config, Config->SMSID, i + 1, SMSD_SEND_SENDING_ERROR, Config->TPMR);
+			SMSD_Status_EndUpdate(Config->Status);
+			Config->Service->AddSentSMSInfo(sms, Config, Config->SMSID, i + 1, SMSD_SEND_SENDING_ERROR, Config->TPMR);
 		}
-		Config->Service->MoveSMS(&sms,Config, Config->SMSID, TRUE,FALSE);
+		Config->Service->MoveSMS(sms,Config, Config->SMSID, TRUE,FALSE);
 		return ERR_UNKNOWN;
 	} else {
 		SMSD_Log(DEBUG_NOTICE, Config, "New message to send: %s", Config->SMSID);
 		Config->retries++;
 	}
 
-	for (i = 0; i < sms.Number; i++) {
+	for (i = 0; i < sms->Number; i++) {
 		if (Config->SkipMessage[i] == TRUE) {
 			SMSD_Log(DEBUG_NOTICE, Config, "Skipping %s:%d message for delivery", Config->SMSID, i+1);
 			continue;
 		}
 
 		/* No SMSC set in message */
-		if (sms.SMS[i].SMSC.Location == 0 && UnicodeLength(sms.SMS[i].SMSC.Number) == 0 && Config->SMSC.Location == 0) {
+		if (sms->SMS[i].SMSC.Location == 0 && UnicodeLength(sms->SMS[i].SMSC.Number) == 0 && Config->SMSC.Location == 0) {
 			SMSD_Log(DEBUG_INFO, Config, "Message without SMSC, using configured one");
-			sms.SMS[i].SMSC = Config->SMSC;
+			sms->SMS[i].SMSC = Config->SMSC;
 			if (Config->relativevalidity != -1) {
-				sms.SMS[i].SMSC.Validity.Format	  = SMS_Validity_RelativeFormat;
-				sms.SMS[i].SMSC.Validity.Relative = Config->relativevalidity;
+				sms->SMS[i].SMSC.Validity.Format	  = SMS_Validity_RelativeFormat;
+				sms->SMS[i].SMSC.Validity.Relative = Config->relativevalidity;
 			}
 
 		}
 		/* Still nothing set after using configured one */
-		if (sms.SMS[i].SMSC.Location == 0 && UnicodeLength(sms.SMS[i].SMSC.Number) == 0) {
+		if (sms->SMS[i].SMSC.Location == 0 && UnicodeLength(sms->SMS[i].SMSC.Number) == 0) {
 			SMSD_Log(DEBUG_INFO, Config, "Message without SMSC, assuming you want to use the one from phone");
-			sms.SMS[i].SMSC.Location = 1;
+			sms->SMS[i].SMSC.Location = 1;
 		}
 		/* Should use SMSC from phone */
-		if (sms.SMS[i].SMSC.Location != 0) {
+		if (sms->SMS[i].SMSC.Location != 0) {
 			/* Do we have cached entry? */
-			if (Config->SMSCCache.Location != sms.SMS[i].SMSC.Location) {
-				Config->SMSCCache.Location = sms.SMS[i].SMSC.Location;
+			if (Config->SMSCCache.Location != sms->SMS[i].SMSC.Location) {
+				Config->SMSCCache.Location = sms->SMS[i].SMSC.Location;
 				error = GSM_GetSMSC(Config->gsm, &Config->SMSCCache);
 				if (error!=ERR_NONE) {
 					SMSD_Log(DEBUG_ERROR, Config, "Error getting SMSC from phone");
@@ -1752,19 +2024,19 @@ GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
 				}
 
 			}
-			sms.SMS[i].SMSC = Config->SMSCCache;
+			sms->SMS[i].SMSC = Config->SMSCCache;
 			/* Reset location to avoid reading from phone */
-			sms.SMS[i].SMSC.Location = 0;
+			sms->SMS[i].SMSC.Location = 0;
 			if (Config->relativevalidity != -1) {
-				sms.SMS[i].SMSC.Validity.Format	  = SMS_Validity_RelativeFormat;
-				sms.SMS[i].SMSC.Validity.Relative = Config->relativevalidity;
+				sms->SMS[i].SMSC.Validity.Format	  = SMS_Validity_RelativeFormat;
+				sms->SMS[i].SMSC.Validity.Relative = Config->relativevalidity;
 			}
 		}
 
 		if (Config->currdeliveryreport == 1) {
-			sms.SMS[i].PDU = SMS_Status_Report;
+			sms->SMS[i].PDU = SMS_Status_Report;
 		} else if (Config->currdeliveryreport == -1 && strcmp(Config->deliveryreport, "no") != 0) {
-			sms.SMS[i].PDU = SMS_Status_Report;
+			sms->SMS[i].PDU = SMS_Status_Report;
 		}
 
 		SMSD_PhoneStatus(Config);
@@ -1772,8 +2044,9 @@ GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
 		Config->SendingSMSStatus = ERR_TIMEOUT;
 		Config->StatusCode = -1;
 		Config->Part = i + 1;
-		if (sms.SMS[i].Class == GSM_SMS_USSD) {
-			EncodeUTF8(destinationnumber, sms.SMS[i].Number);
+		start = GSM_GetMonotonicTime();
+		if (sms->SMS[i].Class == GSM_SMS_USSD) {
+			EncodeUTF8(destinationnumber, sms->SMS[i].Number);
 			SMSD_Log(DEBUG_NOTICE, Config, "Sending USSD request to %s", destinationnumber);
 			error = GSM_DialService(Config->gsm, destinationnumber);
 			/* Fallback to voice call, it can work with some phones */
@@ -1784,14 +2057,16 @@ GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
 				Config->SendingSMSStatus = ERR_NONE;
 			}
 		} else {
-			error = GSM_SendSMS(Config->gsm, &sms.SMS[i]);
+			error = GSM_SendSMS(Config->gsm, &sms->SMS[i]);
 		}
+		SMSD_Metrics_Record(Config, SMSD_METRIC_SUBMIT, start, error);
 		if (error != ERR_NONE) {
 			SMSD_LogError(DEBUG_INFO, Config, "Error sending SMS", error);
 			Config->TPMR = -1;
 			goto failure_unsent;
 		}
 		j    = 0;
+		start = GSM_GetMonotonicTime();
 		while (!Config->shutdown) {
 			/* Update timestamp for SMS in backend */
 			Config->Service->RefreshSendStatus(Config, Config->SMSID);
@@ -1814,30 +2089,36 @@ GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
 				break;
 			}
 		}
+		SMSD_Metrics_Record(Config, SMSD_METRIC_CONFIRM, start, Config->SendingSMSStatus);
 		if (Config->SendingSMSStatus != ERR_NONE) {
 			SMSD_LogError(DEBUG_INFO, Config, "Error getting send status of message", Config->SendingSMSStatus);
 			goto failure_unsent;
 		}
+		SMSD_Status_BeginUpdate(Config->Status);
 		Config->Status->Sent++;
-		error = Config->Service->AddSentSMSInfo(&sms, Config, Config->SMSID, i+1, SMSD_SEND_OK, Config->TPMR);
+		Config->Status->LastSent = time(NULL);
+		SMSD_Status_EndUpdate(Config->Status);
+		start = GSM_GetMonotonicTime();
+		error = Config->Service->AddSentSMSInfo(sms, Config, Config->SMSID, i+1, SMSD_SEND_OK, Config->TPMR);
+		SMSD_Metrics_Record(Config, SMSD_METRIC_SENT, start, error);
 		if (error != ERR_NONE) {
 			SMSD_LogError(DEBUG_INFO, Config, "Error setting sent status", error);
 			goto failure_sent;
 		}
 
-		/* process any incoming SMS information records to help prevent memory exhaustion, ignore any
+		/* process any indicated messages to help prevent memory exhaustion, ignore any
 		 * errors so as not to interfere with this function, they'll be handle in main-loop processing */
-		SMSD_ProcessSMSInfoCache(Config);
+		SMSD_ReadIndicatedSMS(Config);
 	}
 	strcpy(Config->prevSMSID, "");
-	error = Config->Service->MoveSMS(&sms,Config, Config->SMSID, FALSE, TRUE);
+	error = Config->Service->MoveSMS(sms,Config, Config->SMSID, FALSE, TRUE);
 	if (error != ERR_NONE) {
 		SMSD_LogError(DEBUG_ERROR, Config, "Error moving message", error);
-		Config->Service->MoveSMS(&sms,Config, Config->SMSID, TRUE, FALSE);
+		Config->Service->MoveSMS(sms,Config, Config->SMSID, TRUE, FALSE);
 	}
 
 	if (Config->RunOnSent != NULL && error == ERR_NONE) {
-		SMSD_RunOn(Config->RunOnSent, &sms, Config, Config->SMSID, "sent");
+		SMSD_RunOn(Config->RunOnSent, sms, Config, Config->SMSID, "sent");
 	}
 
 	return ERR_NONE;
@@ -1845,7 +2126,9 @@ failure_unsent:
 	if (Config->RunOnFailure != NULL) {
 		SMSD_RunOn(Config->RunOnFailure, NULL, Config, Config->SMSID, "failure");
 	}
+	SMSD_Status_BeginUpdate(Config->Status);
 	Config->Status->Failed++;
+	SMSD_Status_EndUpdate(Config->Status);
 
 failure_sent:
 	Config->Service->UpdateRetries(Config, Config->SMSID);
@@ -1853,6 +2136,27 @@ failure_sent:
 	return ERR_UNKNOWN;
 }
 
+/**
+ * Sends a sms message which is provided by the service backend.
+ *
+ * The message is kept on heap, it is large and reading of indicated
+ * messages while sending needs another one on the stack.
+ */
+GSM_Error SMSD_SendSMS(GSM_SMSDConfig *Config)
+{
+	GSM_MultiSMSMessage *sms;
+	GSM_Error error;
+
+	sms = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+	if (sms == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to allocate memory for message");
+		return ERR_MOREMEMORY;
+	}
+	error = SMSD_SendOutboxSMS(Config, sms);
+	free(sms);
+	return error;
+}
+
 /**
  * Initializes shared memory segment, writable if asked for it.
  */
@@ -1872,11 +2176,13 @@ GSM_Error SMSD_InitSharedMemory(GSM_SMSDConfig *Config, gboolean writable)
 	}
 	Config->Status = shmat(Config->shm_handle, NULL, 0);
 	if (Config->Status == (void *) -1) {
+		Config->Status = NULL;
 		SMSD_Terminate(Config, "Failed to map shared memory segment!", ERR_NONE, TRUE, -1);
 		return ERR_UNKNOWN;
 	}
 	if (!writable && Config->Status->Version != SMSD_SHM_VERSION) {
 		shmdt(Config->Status);
+		Config->Status = NULL;
 		return ERR_WRONGCRC;
 	}
 	if (writable) {
@@ -1925,6 +2231,11 @@ GSM_Error SMSD_InitSharedMemory(GSM_SMSDConfig *Config, gboolean writable)
 #endif
 	/* Initial shared memory content */
 	if (writable) {
+		/* Segment might be left over by crashed instance in middle of update */
+		if (Config->Status->Sequence & 1) {
+			Config->Status->Sequence++;
+		}
+		SMSD_Status_BeginUpdate(Config->Status);
 		Config->Status->Version = SMSD_SHM_VERSION;
 		strncpy(Config->Status->PhoneID, Config->PhoneID, sizeof(Config->Status->PhoneID));
 		Config->Status->PhoneID[sizeof(Config->Status->PhoneID) - 1] = 0;
@@ -1940,6 +2251,11 @@ GSM_Error SMSD_InitSharedMemory(GSM_SMSDConfig *Config, gboolean writable)
 		Config->Status->Sent = 0;
 		Config->Status->IMEI[0] = 0;
 		Config->Status->IMSI[0] = 0;
+		Config->Status->LastSent = 0;
+		Config->Status->LastReceived = 0;
+		Config->Status->LastStatus = 0;
+		SMSD_Metrics_Init(Config->Status);
+		SMSD_Status_EndUpdate(Config->Status);
 	}
 	return ERR_NONE;
 }
@@ -1949,6 +2265,12 @@ GSM_Error SMSD_InitSharedMemory(GSM_SMSDConfig *Config, gboolean writable)
  */
 GSM_Error SMSD_FreeSharedMemory(GSM_SMSDConfig *Config, gboolean writable)
 {
+	if (writable) {
+		/* Tell monitors which keep segment mapped that we're gone */
+		SMSD_Status_BeginUpdate(Config->Status);
+		Config->Status->Version = 0;
+		SMSD_Status_EndUpdate(Config->Status);
+	}
 #ifdef HAVE_SHM
 	shmdt(Config->Status);
 	if (writable) {
@@ -1958,9 +2280,7 @@ GSM_Error SMSD_FreeSharedMemory(GSM_SMSDConfig *Config, gboolean writable)
 	UnmapViewOfFile(Config->Status);
 	CloseHandle(Config->map_handle);
 #else
-	if (writable) {
-		free(Config->Status);
-	}
+	free(Config->Status);
 #endif
 	Config->Status = NULL;
 	return ERR_NONE;
@@ -2028,59 +2348,33 @@ void SMSD_IncomingUSSDCallback(GSM_StateMachine *sm UNUSED, GSM_USSDMessage *uss
 	}
 }
 
-#define INIT_SMSINFO_CACHE_SIZE 10
 /**
- * Handles SMS information messages (+CDSI/+CMTI)
- *
- * SMSD uses polling to read messages from MT memory, to avoid potential
- * conflicts only information on status reports stored in SR memory are handled.
+ * Handles SMS information messages (+CMTI/+CDSI).
  *
- * The amount of SR memory on a device is generally very small so it's unlikely
- * there would be an issue creating/reallocating the cache, if such an issue
- * occurs some or all status report information records will be lost.
+ * We can not communicate with the phone from the callback, so only the
+ * location is remembered and the message is read from the main loop.
  */
-void SMSD_IncomingSMSInfoCallback(GSM_StateMachine *s,  GSM_SMSMessage *sms, void *user_data)
+static void SMSD_IncomingSMSInfoCallback(GSM_SMSDConfig *Config, GSM_SMSMessage *sms)
 {
-  GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
-  GSM_AT_SMSInfo_Cache *Cache = &Priv->SMSInfoCache;
-  GSM_SMSDConfig *Config = user_data;
-  void *reallocated = NULL;
-
-  if (sms->PDU != SMS_Status_Report || sms->Memory != MEM_SR) {
-  	SMSD_Log(DEBUG_INFO, Config, "Ignoring incoming SMS info as not a Status Report in SR memory.");
+	if (!Config->enable_receive) {
 		return;
 	}
 
-  SMSD_Log(DEBUG_INFO, Config, "caching incoming status report information.");
-
-  if (Cache->cache_size <= Cache->cache_used) {
-    if (Cache->smsInfo_records == NULL) {
-      Cache->smsInfo_records = malloc(INIT_SMSINFO_CACHE_SIZE * sizeof(*Cache->smsInfo_records));
-      if (Cache->smsInfo_records == NULL) {
-        SMSD_Log(DEBUG_ERROR, Config, "failed to allocate SMS information cache, records will not be processed.");
-        return;
-      }
-      Cache->cache_size = INIT_SMSINFO_CACHE_SIZE;
-    } else {
-      reallocated = realloc(Cache->smsInfo_records, (Cache->cache_size * 2) * sizeof(*Cache->smsInfo_records));
-      if (reallocated == NULL) {
-        SMSD_Log(DEBUG_ERROR, Config, "failed to reallocate SMS information cache, some records will be lost.");
-        return;
-      }
-      Cache->smsInfo_records = reallocated;
-      Cache->cache_size *= 2;
-    }
-  }
-
-  memcpy(Cache->smsInfo_records + Cache->cache_used, sms, sizeof(*Cache->smsInfo_records));
-  Cache->cache_used += 1;
+	Config->Indications++;
+	SMSD_Log(DEBUG_INFO, Config, "Message indicated at %s:%d",
+			GSM_MemoryTypeToString(sms->Memory), sms->Location);
+
+	if (SMSD_Locations_Add(&Config->Indicated, sms->Folder, sms->Location, sms->Memory) != ERR_NONE) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to remember indicated message, reading all messages");
+		Config->ScanNeeded = TRUE;
+	}
 }
 
 /**
  * Handles incoming SMS messages.
  *
  */
-void SMSD_IncomingSMSCallback(GSM_StateMachine *s,  GSM_SMSMessage *sms, void *user_data)
+void SMSD_IncomingSMSCallback(GSM_StateMachine *s UNUSED,  GSM_SMSMessage *sms, void *user_data)
 {
 	GSM_MultiSMSMessage msms;
 	GSM_SMSDConfig *Config = user_data;
@@ -2088,10 +2382,13 @@ void SMSD_IncomingSMSCallback(GSM_StateMachine *s,  GSM_SMSMessage *sms, void *u
 
 	if(sms->PDU == 0) {
 		// assume we only have message information, not a full message, handoff to appropriate handler
-		SMSD_IncomingSMSInfoCallback(s, sms, user_data);
+		SMSD_IncomingSMSInfoCallback(Config, sms);
 		return;
 	}
 
+	/* Make main loop poll phone as soon as possible */
+	SMSD_Timer_Advance(&Config->Scheduler, SMSD_TIMER_RECEIVE, GSM_GetMonotonicTime());
+
 	SMSD_Log(DEBUG_INFO, Config, "processing incoming SMS.");
 
 	memset(&msms, 0, sizeof(GSM_MultiSMSMessage));
@@ -2103,55 +2400,157 @@ void SMSD_IncomingSMSCallback(GSM_StateMachine *s,  GSM_SMSMessage *sms, void *u
 		SMSD_LogError(DEBUG_ERROR, Config, "Error processing SMS", error);
 }
 
-GSM_Error SMSD_ProcessSMSInfoCache(GSM_SMSDConfig *Config)
+/**
+ * Returns timer period in milliseconds for task to be run every given
+ * number of seconds, but not more often than once per LoopSleep.
+ */
+static long long SMSD_TimerPeriod(GSM_SMSDConfig *Config, unsigned int seconds)
 {
-	GSM_StateMachine *s = Config->gsm;
-	GSM_Phone_ATGENData *Priv = &s->Phone.Data.Priv.ATGEN;
-	GSM_AT_SMSInfo_Cache *Cache = &Priv->SMSInfoCache;
-	GSM_MultiSMSMessage msms;
-	GSM_SMSMessage *sms;
-	GSM_Error error = ERR_NONE;
-	unsigned int i;
+	if (seconds < Config->loopsleep) {
+		seconds = Config->loopsleep;
+	}
+	return (long long)seconds * 1000;
+}
 
-	memset(&msms, 0, sizeof(GSM_MultiSMSMessage));
-	msms.Number = 1;
+/**
+ * Chooses how often to read all messages from phone. When the phone
+ * indicates received messages and last full scan has not found any
+ * message we were not told about, it is enough to do it only rarely to
+ * catch lost indications.
+ */
+void SMSD_UpdateReceiveMode(GSM_SMSDConfig *Config, long long now)
+{
+	gboolean healthy;
+	long long period;
+	int missed;
 
-	for(i = 0; i < Cache->cache_used; ++i) {
-		sms = Cache->smsInfo_records + i;
-		if(sms->Memory == MEM_INVALID) continue;
+	/* Messages indicated meanwhile were expected by the scan */
+	missed = Config->UnexpectedMessages - Config->ScanIndicated - Config->Indicated.Number;
+	Config->ScanIndicated = 0;
 
-		msms.SMS[0] = *sms;
+	healthy = Config->IncomingNotify && Config->Indications > 0 && missed <= 0 &&
+		Config->reconcilefrequency > Config->receivefrequency;
 
-		error = GSM_GetSMS(s, &msms);
-		if(error != ERR_NONE) {
-			SMSD_Log(DEBUG_ERROR, Config, "Error reading SMS from memory %s:%d",
-					GSM_MemoryTypeToString(sms->Memory),
-					sms->Location);
-			break;
-		}
+	if (healthy && !Config->NotifyHealthy) {
+		SMSD_Log(DEBUG_INFO, Config, "Phone indicates received messages, reading all messages every %d seconds",
+				Config->reconcilefrequency);
+	} else if (!healthy && Config->NotifyHealthy) {
+		SMSD_Log(DEBUG_INFO, Config, "Found %d messages which were not indicated, reading all messages every %d seconds",
+				missed, Config->receivefrequency);
+	}
+	Config->NotifyHealthy = healthy;
 
-		error = SMSD_ProcessSMS(Config, &msms);
-		if(error != ERR_NONE) {
-			SMSD_LogError(DEBUG_ERROR, Config, "Error processing SMS", error);
-			break;
-		}
+	period = SMSD_TimerPeriod(Config, healthy ? Config->reconcilefrequency : Config->receivefrequency);
+	SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_RECEIVE, period, now + period);
+}
 
-		error = GSM_DeleteSMS(s, sms);
-		if (error != ERR_NONE) {
-			SMSD_LogError(DEBUG_ERROR, Config, "Error deleting SMS", error);
-			break;
+/**
+ * Interval in milliseconds for polling event sources which can not be
+ * waited on.
+ */
+#define SMSD_POLL_INTERVAL 1000
+
+/**
+ * Sleeps until timeout elapses or the phone or outbox notification
+ * descriptor becomes readable. Sources which can not be waited on are
+ * polled every SMSD_POLL_INTERVAL milliseconds.
+ *
+ * \return TRUE when phone descriptor is readable.
+ */
+static gboolean SMSD_Sleep(GSM_SMSDConfig *Config, long long timeout, gboolean connected, int devicefd)
+{
+#ifndef WIN32
+	struct timeval tv;
+	fd_set readfds;
+	int fd, maxfd = -1, ret;
+#endif
+	gboolean poll = FALSE;
+
+#ifndef WIN32
+	FD_ZERO(&readfds);
+	if (devicefd >= FD_SETSIZE) {
+		devicefd = -1;
+	}
+	if (devicefd >= 0) {
+		FD_SET(devicefd, &readfds);
+		maxfd = devicefd;
+	} else
+#endif
+	if (connected) {
+		poll = TRUE;
+	}
+	if (Config->enable_send) {
+#ifndef WIN32
+		if (Config->Service->NotifyDescriptor(Config, &fd) == ERR_NONE && fd >= 0 && fd < FD_SETSIZE) {
+			FD_SET(fd, &readfds);
+			maxfd = MAX(maxfd, fd);
+		} else
+#endif
+		{
+			poll = TRUE;
 		}
+	}
+	if (poll && timeout > SMSD_POLL_INTERVAL) {
+		timeout = SMSD_POLL_INTERVAL;
+	}
 
-		/* successfully processed cache entry, mark invalid to avoid reprocessing
-		 * in case of retry loop */
-		sms->Memory = MEM_INVALID;
+#ifndef WIN32
+	tv.tv_sec = timeout / 1000;
+	tv.tv_usec = (timeout % 1000) * 1000;
+	/* Signals interrupt the wait, so shutdown is noticed */
+	ret = select(maxfd + 1, &readfds, NULL, NULL, &tv);
+	if (ret < 0) {
+		if (errno != EINTR) {
+			usleep(MIN(timeout, SMSD_POLL_INTERVAL) * 1000);
+		}
+		return FALSE;
 	}
+	return devicefd >= 0 && FD_ISSET(devicefd, &readfds);
+#else
+	usleep(timeout * 1000);
+	return FALSE;
+#endif
+}
 
-	/* cache processed successfully, reset used count */
-	if(error == ERR_NONE)
-		Cache->cache_used = 0;
+/**
+ * Waits until some timer expires or the timeout elapses. Meanwhile
+ * processes unsolicited notifications from the phone and outbox
+ * changes reported by service backend.
+ */
+static void SMSD_WaitForEvents(GSM_SMSDConfig *Config, long long timeout)
+{
+	long long start, now, left;
+	gboolean connected, waitdevice = TRUE, readable = FALSE;
+	GSM_Error error;
 
-	return error;
+	start = GSM_GetMonotonicTime();
+	while (!Config->shutdown) {
+		connected = GSM_IsConnected(Config->gsm);
+		if (connected && GSM_ReadDevice(Config->gsm, FALSE) <= 0 && readable) {
+			/* Readable device without data is probably gone, poll it instead */
+			waitdevice = FALSE;
+		}
+		if (Config->enable_send) {
+			error = Config->Service->OutboxChanged(Config);
+			if (error == ERR_NONE) {
+				SMSD_Timer_Advance(&Config->Scheduler, SMSD_TIMER_SEND, GSM_GetMonotonicTime());
+			}
+		}
+		/* Phone has indicated received message */
+		if (Config->enable_receive && (Config->Indicated.Number > 0 || Config->ScanNeeded)) {
+			break;
+		}
+		now = GSM_GetMonotonicTime();
+		if (SMSD_Scheduler_Timeout(&Config->Scheduler, now) == 0) {
+			break;
+		}
+		left = timeout - (now - start);
+		if (left <= 0) {
+			break;
+		}
+		readable = SMSD_Sleep(Config, left, connected,
+				(connected && waitdevice) ? GSM_GetDeviceDescriptor(Config->gsm) : -1);
+	}
 }
 
 /**
@@ -2162,10 +2561,10 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 {
 	GSM_Error		error;
 	int                     errors = -1, initerrors=0;
-	double			lastsleep;
- 	time_t			lastreceive = 0, lastreset = time(NULL), lasthardreset = time(NULL), lastnothingsent = 0, laststatus = 0;
-	time_t			lastloop = 0;
-	gboolean first_start = TRUE, force_reset = FALSE, force_hard_reset = FALSE;
+	long long		now, timeout;
+	gboolean first_start = TRUE, force_reset = FALSE, force_hard_reset = FALSE, scan;
+	char imei[GSM_MAX_IMEI_LENGTH + 1];
+	char imsi[GSM_MAX_INFO_LENGTH + 1];
 
 	Config->failure = ERR_NONE;
 	Config->exit_on_failure = exit_on_failure;
@@ -2187,8 +2586,27 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 
 	Config->SendingSMSStatus = ERR_NONE;
 
+	/* Setup timers for periodic tasks */
+	now = GSM_GetMonotonicTime();
+	SMSD_Scheduler_Init(&Config->Scheduler);
+	if (Config->enable_receive) {
+		SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_RECEIVE, SMSD_TimerPeriod(Config, Config->receivefrequency), now);
+	}
+	if (Config->enable_send) {
+		SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_SEND, SMSD_TimerPeriod(Config, Config->commtimeout), now);
+	}
+	if (Config->statusfrequency > 0) {
+		SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_STATUS, SMSD_TimerPeriod(Config, Config->statusfrequency), now);
+	}
+	if (Config->resetfrequency > 0) {
+		SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_RESET, (long long)Config->resetfrequency * 1000, now + (long long)Config->resetfrequency * 1000);
+	}
+	if (Config->hardresetfrequency > 0) {
+		SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_HARDRESET, (long long)Config->hardresetfrequency * 1000, now + (long long)Config->hardresetfrequency * 1000);
+	}
+
 	while (!Config->shutdown) {
-		lastloop = time(NULL);
+		now = GSM_GetMonotonicTime();
 		/* There were errors in communication - try to recover */
 		if (errors > 2 || first_start || force_reset || force_hard_reset) {
 			/* Should we disconnect from phone? */
@@ -2230,19 +2648,31 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 					GSM_SetIncomingCall(Config->gsm, TRUE);
 				}
 
+				/* Messages might arrive while we were disconnected */
+				SMSD_Locations_Clear(&Config->Indicated);
+				SMSD_Locations_Clear(&Config->Expected);
+				Config->Indications = 0;
+				Config->ScanIndicated = 0;
+				Config->NotifyHealthy = FALSE;
+				Config->ScanNeeded = TRUE;
+
 				GSM_SetIncomingSMSCallback(Config->gsm, SMSD_IncomingSMSCallback, Config);
 
-				/* We use polling so store messages to SIM */
-				GSM_SetIncomingSMS(Config->gsm, TRUE);
+				/* Messages are stored in phone, which tells us their locations */
+				Config->IncomingNotify = (GSM_SetIncomingSMS(Config->gsm, TRUE) == ERR_NONE);
 				GSM_SetIncomingUSSDCallback(Config->gsm, SMSD_IncomingUSSDCallback, Config);
 				GSM_SetIncomingUSSD(Config->gsm, TRUE);
 
 				GSM_SetSendSMSStatusCallback(Config->gsm, SMSD_SendSMSStatusCallback, Config);
 				/* On first start we need to initialize some variables */
 				if (first_start) {
-					if (GSM_GetIMEI(Config->gsm, Config->Status->IMEI) != ERR_NONE || GSM_GetSIMIMSI(Config->gsm, Config->Status->IMSI) != ERR_NONE) {
+					if (GSM_GetIMEI(Config->gsm, imei) != ERR_NONE || GSM_GetSIMIMSI(Config->gsm, imsi) != ERR_NONE) {
 						errors++;
 					} else {
+						SMSD_Status_BeginUpdate(Config->Status);
+						strcpy(Config->Status->IMEI, imei);
+						strcpy(Config->Status->IMSI, imsi);
+						SMSD_Status_EndUpdate(Config->Status);
 						errors = 0;
 						error = Config->Service->InitAfterConnect(Config);
 						if (error!=ERR_NONE) {
@@ -2262,14 +2692,14 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 				if (initerrors > 3 || force_reset ) {
 					error = GSM_Reset(Config->gsm, FALSE); /* soft reset */
 					SMSD_LogError(DEBUG_INFO, Config, "Soft reset return code", error);
-					lastreset = time(NULL);
+					SMSD_Timer_Rearm(&Config->Scheduler, SMSD_TIMER_RESET, GSM_GetMonotonicTime());
 					SMSD_InterruptibleSleep(Config, 5);
 					force_reset = FALSE;
 				}
 				if (force_hard_reset) {
 					error = GSM_Reset(Config->gsm, TRUE); /* hard reset */
 					SMSD_LogError(DEBUG_INFO, Config, "Hard reset return code", error);
-					lasthardreset = time(NULL);
+					SMSD_Timer_Rearm(&Config->Scheduler, SMSD_TIMER_HARDRESET, GSM_GetMonotonicTime());
 					SMSD_InterruptibleSleep(Config, 5);
 					force_hard_reset = FALSE;
 				}
@@ -2285,12 +2715,15 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 			continue;
 		}
 
-		/* Should we receive? */
-		if (Config->enable_receive && ((difftime(lastloop, lastreceive) >= Config->receivefrequency) || (Config->SendingSMSStatus != ERR_NONE))) {
-	 		lastreceive = time(NULL);
+		/* Should we read all messages? */
+		scan = Config->enable_receive && (Config->ScanNeeded ||
+				SMSD_Timer_IsDue(&Config->Scheduler, SMSD_TIMER_RECEIVE, now) ||
+				(Config->SendingSMSStatus != ERR_NONE));
 
+		/* Should we receive? */
+		if (Config->enable_receive && (scan || Config->Indicated.Number > 0)) {
 			/* Do we need to check security? */
-			if (Config->checksecurity) {
+			if (scan && Config->checksecurity) {
 				if (!SMSD_CheckSecurity(Config)) {
 					errors++;
 					initerrors++;
@@ -2302,8 +2735,8 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 
 			initerrors = 0;
 
-			/* process SMS info cache */
-			if(!SMSD_ProcessSMSInfoCache(Config)) {
+			/* read messages indicated by phone */
+			if (!SMSD_ReadIndicatedSMS(Config)) {
 				errors++;
 				continue;
 			} else {
@@ -2311,21 +2744,25 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 			}
 
 			/* read all incoming SMS */
-			if (!SMSD_CheckSMSStatus(Config)) {
-				errors++;
-				continue;
-			} else {
-				errors = 0;
+			if (scan || Config->ScanNeeded) {
+				SMSD_Timer_Rearm(&Config->Scheduler, SMSD_TIMER_RECEIVE, now);
+				Config->ScanNeeded = FALSE;
+				if (!SMSD_CheckSMSStatus(Config)) {
+					errors++;
+					continue;
+				} else {
+					errors = 0;
+				}
+				SMSD_UpdateReceiveMode(Config, GSM_GetMonotonicTime());
 			}
-
 		}
 
 		/* time for preventive reset */
-		if (Config->resetfrequency > 0 && difftime(lastloop, lastreset) >= Config->resetfrequency) {
+		if (SMSD_Timer_IsDue(&Config->Scheduler, SMSD_TIMER_RESET, now)) {
 			force_reset = TRUE;
 			continue;
 		}
-		if (Config->hardresetfrequency > 0 && difftime(lastloop, lasthardreset) >= Config->hardresetfrequency) {
+		if (SMSD_Timer_IsDue(&Config->Scheduler, SMSD_TIMER_HARDRESET, now)) {
 			force_hard_reset = TRUE;
 			continue;
 		}
@@ -2334,10 +2771,14 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 		}
 
 		/* Send any queued messages */
-		if (Config->enable_send && (difftime(lastloop, lastnothingsent) >= Config->commtimeout)) {
+		if (SMSD_Timer_IsDue(&Config->Scheduler, SMSD_TIMER_SEND, now)) {
 			error = SMSD_SendSMS(Config);
 			if (error == ERR_EMPTY) {
-				lastnothingsent = lastloop;
+				/* Nothing to send, wait for CommTimeout or outbox change */
+				SMSD_Timer_Rearm(&Config->Scheduler, SMSD_TIMER_SEND, now);
+			} else {
+				/* Continue sending after LoopSleep */
+				SMSD_Timer_Set(&Config->Scheduler, SMSD_TIMER_SEND, SMSD_TimerPeriod(Config, Config->commtimeout), now + (long long)Config->loopsleep * 1000);
 			}
 			/* We don't care about other errors here, they are handled in SMSD_SendSMS */
 		}
@@ -2346,9 +2787,9 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 		}
 
 		/* Refresh phone status in shared memory and in service */
-		if ((Config->statusfrequency > 0) && (difftime(lastloop, laststatus) >= Config->statusfrequency)) {
+		if (SMSD_Timer_IsDue(&Config->Scheduler, SMSD_TIMER_STATUS, now)) {
 			SMSD_PhoneStatus(Config);
-			laststatus = lastloop;
+			SMSD_Timer_Rearm(&Config->Scheduler, SMSD_TIMER_STATUS, now);
 			Config->Service->RefreshPhoneStatus(Config);
 		}
 
@@ -2356,13 +2797,13 @@ GSM_Error SMSD_MainLoop(GSM_SMSDConfig *Config, gboolean exit_on_failure, int ma
 			break;
 		}
 
-		/* Sleep some time before another loop */
-		/* Duration of last loop cycle */
-		lastsleep = difftime(time(NULL), lastloop);
-		if (Config->loopsleep > 0 && lastsleep < Config->loopsleep) {
-			/* Sleep LoopSleep - time of the loop */
-			SMSD_InterruptibleSleep(Config, Config->loopsleep - lastsleep);
+		/* Sleep until next timer, events from phone or outbox wake us earlier */
+		now = GSM_GetMonotonicTime();
+		timeout = SMSD_Scheduler_Timeout(&Config->Scheduler, now);
+		if (timeout < 0) {
+			timeout = (long long)Config->loopsleep * 1000;
 		}
+		SMSD_WaitForEvents(Config, timeout);
 	}
 	GSM_SetIncomingUSSD(Config->gsm, FALSE);
 	Config->Service->Free(Config);
@@ -2405,27 +2846,36 @@ GSM_Error SMSD_InjectSMS(GSM_SMSDConfig *Config, GSM_MultiSMSMessage *sms, char
 GSM_Error SMSD_GetStatus(GSM_SMSDConfig *Config, GSM_SMSDStatus *status)
 {
 	GSM_Error error;
-	/* Check for local instance */
-	if (Config->running) {
-		memcpy(status, Config->Status, sizeof(GSM_SMSDStatus));
-		return ERR_NONE;
-	}
+	int i, remap;
 
-	/* Init shared memory */
-	error = SMSD_InitSharedMemory(Config, FALSE);
-	if (error != ERR_NONE) {
-		return error;
-	}
+	for (remap = 0; remap < 2; remap++) {
+		/* Map shared memory unless there is local instance or it is already mapped */
+		if (!Config->running && Config->Status == NULL) {
+			error = SMSD_InitSharedMemory(Config, FALSE);
+			if (error != ERR_NONE) {
+				return error;
+			}
+		}
 
-	/* Copy data from shared memory */
-	memcpy(status, Config->Status, sizeof(GSM_SMSDStatus));
+		/* Copy consistent snapshot, retrying while SMSD updates it */
+		for (i = 0; !SMSD_Status_Read(Config->Status, status); i++) {
+			if (i >= SMSD_STATUS_RETRIES) {
+				return ERR_TIMEOUT;
+			}
+			usleep(1000);
+		}
 
-	/* Free shared memory */
-	error = SMSD_FreeSharedMemory(Config, FALSE);
-	if (error != ERR_NONE) {
-		return error;
+		if (Config->running || status->Version == SMSD_SHM_VERSION) {
+			return ERR_NONE;
+		}
+
+		/* SMSD has terminated, segment might have been created again */
+		error = SMSD_FreeSharedMemory(Config, FALSE);
+		if (error != ERR_NONE) {
+			return error;
+		}
 	}
-	return ERR_NONE;
+	return ERR_NOTRUNNING;
 }
 
 GSM_Error SMSD_NoneFunction(void)
@@ -15,11 +15,18 @@
 #include "services/sql-core.h"
 #endif
 
-#define SMSD_SHM_VERSION (2)
+#define SMSD_SHM_VERSION (4)
 #define SMSD_SHM_KEY (0xfa << 16 || SMSD_SHM_VERSION)
 #define SMSD_DB_VERSION (17)
+/**
+ * How many times to retry reading status while it is being updated,
+ * there is 1 ms sleep between attempts.
+ */
+#define SMSD_STATUS_RETRIES (1000)
 
 #include "log.h"
+#include "scheduler.h"
+#include "locations.h"
 
 #include "../libgammu/misc/array.h"
 
@@ -68,6 +75,20 @@ typedef struct {
 	 * Reads configuration specific for this backend.
 	 */
 	GSM_Error	(*ReadConfiguration) (GSM_SMSDConfig *Config);
+	/**
+	 * Checks whether outbox could have changed since last call.
+	 * This is called often while SMSD is idle, so it has to be
+	 * cheap. Returns ERR_NONE when outbox should be checked and
+	 * ERR_EMPTY when nothing has changed.
+	 */
+	GSM_Error	(*OutboxChanged)      (GSM_SMSDConfig *Config);
+	/**
+	 * Returns file descriptor which becomes readable when outbox
+	 * changes, so that SMSD can sleep until then. Returns
+	 * ERR_NOTSUPPORTED when there is none and OutboxChanged has to
+	 * be polled.
+	 */
+	GSM_Error	(*NotifyDescriptor)   (GSM_SMSDConfig *Config, int *fd);
 } GSM_SMSDService;
 
 struct _GSM_SMSDConfig {
@@ -78,6 +99,7 @@ struct _GSM_SMSDConfig {
 	GSM_StringArray IncludeSMSCList, ExcludeSMSCList;
 	unsigned int    commtimeout, 	 sendtimeout,   receivefrequency, statusfrequency;
 	unsigned int loopsleep;
+	unsigned int reconcilefrequency;
 	int deliveryreportdelay;
 	unsigned int	resetfrequency;
 	unsigned int	hardresetfrequency;
@@ -98,10 +120,55 @@ struct _GSM_SMSDConfig {
 	unsigned int maxretries;
 	unsigned int retrytimeout;
 	int backend_retries;
+	/**
+	 * Path to journal of service writes done while backend is not available.
+	 */
+	const char *journalpath;
+	/**
+	 * Whether journal contains some records.
+	 */
+	gboolean journal_pending;
+	/**
+	 * Whether last received message was only stored in the journal,
+	 * RunOnReceive is then executed when it is replayed.
+	 */
+	gboolean inbox_journaled;
 
 	/* options for FILES */
 	const char   *inboxpath, 	 *outboxpath, 	*sentsmspath;
 	const char   *errorsmspath, 	 *inboxformat,  *transmitformat, *outboxformat;
+	/**
+	 * Modification time of outbox directory at last check.
+	 */
+	time_t outboxmtime;
+	/**
+	 * Descriptor watching outbox directory, -1 when not yet created
+	 * and -2 when watching is not possible.
+	 */
+	int outboxwatch;
+
+	/* options for STREAM */
+	/**
+	 * Path to append only event log.
+	 */
+	const char *streampath;
+	/**
+	 * Path to Unix domain socket receiving events, used instead of log.
+	 */
+	const char *streamsocket;
+	/**
+	 * Size of event log in bytes after which it is rotated, 0 disables
+	 * rotation.
+	 */
+	long streamsegmentsize;
+	/**
+	 * Descriptor of opened event log or socket, -1 when closed.
+	 */
+	int streamfd;
+	/**
+	 * Number of last rotated event log segment.
+	 */
+	int streamsegment;
 
 	/* private variables required for work */
 	int		relativevalidity;
@@ -161,6 +228,31 @@ struct _GSM_SMSDConfig {
 	const char *table_outbox;
 	const char *table_outbox_multipart;
 	const char *table_phones;
+	/**
+	 * Whether database notifies us about outbox changes.
+	 */
+	gboolean outbox_notify;
+	/**
+	 * Outbox change counter seen at last check.
+	 */
+	long long outbox_lastid;
+	/**
+	 * Monotonic time of last outbox change counter check.
+	 */
+	long long outbox_lastcheck;
+	/**
+	 * Number of failed reconnection attempts, zero when connected.
+	 */
+	int db_attempts;
+	/**
+	 * Monotonic time of next reconnection attempt.
+	 */
+	long long db_retry;
+	/**
+	 * ID of outbox message fetched for sending, only its move is
+	 * journaled while database is not available.
+	 */
+	char outbox_fetched[200];
 #endif
 
 	INI_Section 		*smsdcfgfile;
@@ -207,6 +299,47 @@ struct _GSM_SMSDConfig {
 	int IncompleteMessageID;
 	time_t IncompleteMessageTime;
 
+	/**
+	 * Timers driving main loop.
+	 */
+	SMSD_Scheduler Scheduler;
+
+	/**
+	 * Locations of received messages indicated by the phone, which were
+	 * not yet read.
+	 */
+	SMSD_Locations Indicated;
+	/**
+	 * Locations of messages seen by SMSD, which were left in the phone.
+	 */
+	SMSD_Locations Expected;
+	/**
+	 * Whether phone accepted request to indicate received messages.
+	 */
+	gboolean IncomingNotify;
+	/**
+	 * Number of indications received on current connection.
+	 */
+	int Indications;
+	/**
+	 * Number of messages found by last full scan, which were not seen
+	 * before.
+	 */
+	int UnexpectedMessages;
+	/**
+	 * Number of indicated messages which were left for full scan.
+	 */
+	int ScanIndicated;
+	/**
+	 * Whether phone reliably indicates received messages, so that full
+	 * scans are done only every ReconcileFrequency.
+	 */
+	gboolean NotifyHealthy;
+	/**
+	 * Whether full scan of messages should be done as soon as possible.
+	 */
+	gboolean ScanNeeded;
+
 #ifdef HAVE_SHM
 	key_t shm_key;
 	int shm_handle;
@@ -235,6 +368,12 @@ extern GSM_Error SMSD_NotSupportedFunction	(void);
  */
 GSM_Error SMSD_CheckDBVersion(GSM_SMSDConfig *Config, int version);
 
+/**
+ * Executes external command for given event and measures how long it
+ * took.
+ */
+gboolean SMSD_RunOn(const char *command, GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, const char *locations, const char *event);
+
 /**
  * Terminates SMSD with logging error messages to log. This does not
  * signal running SMSD to stop, it can be called from initialization of
@@ -0,0 +1,309 @@
+/**
+ * SMSD local journal of service writes
+ *
+ * Records are stored in binary form as they are only meant to survive
+ * restart of the same SMSD build, header of the file guards against
+ * replaying journal written by incompatible build.
+ */
+#include <gammu-config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef WIN32
+#include <io.h>
+#endif
+
+#include "core.h"
+#include "journal.h"
+
+#define SMSD_JOURNAL_MAGIC "GSMDJRN"
+#define SMSD_JOURNAL_VERSION 1
+
+/**
+ * Journal file header.
+ */
+typedef struct {
+	char Magic[8];
+	int Version;
+	int RecordSize;
+	int SMSSize;
+} SMSD_JournalHeader;
+
+static void SMSD_Journal_FillHeader(SMSD_JournalHeader *Header)
+{
+	memset(Header, 0, sizeof(SMSD_JournalHeader));
+	strcpy(Header->Magic, SMSD_JOURNAL_MAGIC);
+	Header->Version = SMSD_JOURNAL_VERSION;
+	Header->RecordSize = sizeof(SMSD_JournalRecord);
+	Header->SMSSize = sizeof(GSM_SMSMessage);
+}
+
+/**
+ * Checks whether journal was written by this build, empty journal is
+ * compatible as well.
+ */
+static gboolean SMSD_Journal_CheckHeader(FILE *f)
+{
+	SMSD_JournalHeader header, expected;
+	size_t len;
+
+	len = fread(&header, 1, sizeof(header), f);
+	if (len == 0) {
+		return TRUE;
+	}
+	SMSD_Journal_FillHeader(&expected);
+	return len == sizeof(header) && memcmp(&header, &expected, sizeof(header)) == 0;
+}
+
+/**
+ * Moves incompatible journal aside, so that it is kept for manual
+ * recovery and new records are not appended behind foreign header.
+ */
+static void SMSD_Journal_MoveAside(GSM_SMSDConfig *Config)
+{
+	char *badpath;
+
+	badpath = (char *)malloc(strlen(Config->journalpath) + 5);
+	if (badpath == NULL) {
+		return;
+	}
+	sprintf(badpath, "%s.bad", Config->journalpath);
+
+#ifdef WIN32
+	remove(badpath);
+#endif
+	if (rename(Config->journalpath, badpath) == 0) {
+		SMSD_Log(DEBUG_ERROR, Config, "Journal %s was not written by this SMSD version, moved it to %s",
+			Config->journalpath, badpath);
+	} else {
+		SMSD_LogErrno(Config, "Can not move incompatible journal aside");
+		if (remove(Config->journalpath) != 0) {
+			SMSD_LogErrno(Config, "Can not remove incompatible journal");
+		}
+	}
+	free(badpath);
+}
+
+static void SMSD_Journal_Sync(FILE *f)
+{
+	fflush(f);
+#ifdef WIN32
+	_commit(_fileno(f));
+#elif defined(HAVE_UNISTD_H)
+	fsync(fileno(f));
+#endif
+}
+
+gboolean SMSD_Journal_Pending(GSM_SMSDConfig *Config)
+{
+	return Config->journalpath != NULL && Config->journal_pending;
+}
+
+GSM_Error SMSD_Journal_Append(GSM_SMSDConfig *Config, const SMSD_JournalRecord *Record, const GSM_MultiSMSMessage *sms)
+{
+	SMSD_JournalHeader header;
+	FILE *f;
+	int i, number = 0;
+	gboolean ok = TRUE;
+
+	if (Config->journalpath == NULL) {
+		return ERR_NOTSUPPORTED;
+	}
+
+	/* Number in record has to match data we really write */
+	if (sms != NULL) {
+		number = sms->Number;
+	}
+	if (Record->Number != number) {
+		SMSD_Log(DEBUG_ERROR, Config, "Journal record does not match message (%d != %d)", Record->Number, number);
+		return ERR_BUG;
+	}
+
+	/* Never append behind header of other build */
+	f = fopen(Config->journalpath, "rb");
+	if (f != NULL) {
+		ok = SMSD_Journal_CheckHeader(f);
+		fclose(f);
+		if (!ok) {
+			SMSD_Journal_MoveAside(Config);
+		}
+		ok = TRUE;
+	}
+
+	f = fopen(Config->journalpath, "ab");
+	if (f == NULL) {
+		SMSD_LogErrno(Config, "Can not open journal");
+		return ERR_CANTOPENFILE;
+	}
+
+	fseek(f, 0, SEEK_END);
+	if (ftell(f) == 0) {
+		SMSD_Journal_FillHeader(&header);
+		ok = fwrite(&header, sizeof(header), 1, f) == 1;
+	}
+
+	if (ok) {
+		ok = fwrite(Record, sizeof(SMSD_JournalRecord), 1, f) == 1;
+	}
+	for (i = 0; ok && i < number; i++) {
+		ok = fwrite(&sms->SMS[i], sizeof(GSM_SMSMessage), 1, f) == 1;
+	}
+
+	SMSD_Journal_Sync(f);
+	fclose(f);
+
+	if (!ok) {
+		SMSD_Log(DEBUG_ERROR, Config, "Failed to write journal %s", Config->journalpath);
+		return ERR_WRITING_FILE;
+	}
+
+	Config->journal_pending = TRUE;
+	SMSD_Log(DEBUG_INFO, Config, "Stored operation %d in journal", Record->Type);
+	return ERR_NONE;
+}
+
+/**
+ * Keeps only data starting at given offset in the journal.
+ */
+static GSM_Error SMSD_Journal_Truncate(GSM_SMSDConfig *Config, FILE *f, long offset)
+{
+	SMSD_JournalHeader header;
+	char *tmppath, buffer[4096];
+	FILE *out;
+	size_t len;
+	gboolean ok;
+
+	tmppath = (char *)malloc(strlen(Config->journalpath) + 5);
+	if (tmppath == NULL) {
+		return ERR_MOREMEMORY;
+	}
+	sprintf(tmppath, "%s.tmp", Config->journalpath);
+
+	out = fopen(tmppath, "wb");
+	if (out == NULL) {
+		SMSD_LogErrno(Config, "Can not create journal");
+		free(tmppath);
+		return ERR_CANTOPENFILE;
+	}
+
+	SMSD_Journal_FillHeader(&header);
+	ok = fwrite(&header, sizeof(header), 1, out) == 1;
+
+	fseek(f, offset, SEEK_SET);
+	while (ok && (len = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+		ok = fwrite(buffer, 1, len, out) == len;
+	}
+	SMSD_Journal_Sync(out);
+	fclose(out);
+
+	if (ok) {
+#ifdef WIN32
+		remove(Config->journalpath);
+#endif
+		ok = rename(tmppath, Config->journalpath) == 0;
+	}
+	if (!ok) {
+		SMSD_LogErrno(Config, "Can not update journal");
+		remove(tmppath);
+	}
+	free(tmppath);
+	return ok ? ERR_NONE : ERR_WRITING_FILE;
+}
+
+GSM_Error SMSD_Journal_Replay(GSM_SMSDConfig *Config, SMSD_JournalReplayFunction Replay)
+{
+	SMSD_JournalRecord record;
+	GSM_MultiSMSMessage *sms;
+	GSM_Error error = ERR_NONE;
+	FILE *f;
+	long offset;
+	int i, replayed = 0;
+	gboolean ok = TRUE;
+
+	if (!SMSD_Journal_Pending(Config)) {
+		return ERR_NONE;
+	}
+
+	f = fopen(Config->journalpath, "rb");
+	if (f == NULL) {
+		/* Journal was removed meanwhile */
+		Config->journal_pending = FALSE;
+		return ERR_NONE;
+	}
+
+	if (!SMSD_Journal_CheckHeader(f)) {
+		fclose(f);
+		SMSD_Journal_MoveAside(Config);
+		Config->journal_pending = FALSE;
+		return ERR_FILENOTSUPPORTED;
+	}
+
+	sms = (GSM_MultiSMSMessage *)malloc(sizeof(GSM_MultiSMSMessage));
+	if (sms == NULL) {
+		fclose(f);
+		return ERR_MOREMEMORY;
+	}
+
+	while (TRUE) {
+		offset = ftell(f);
+		if (fread(&record, sizeof(record), 1, f) != 1) {
+			break;
+		}
+		if (record.Number < 0 || record.Number > GSM_MAX_MULTI_SMS) {
+			ok = FALSE;
+			break;
+		}
+		memset(sms, 0, sizeof(GSM_MultiSMSMessage));
+		sms->Number = record.Number;
+		for (i = 0; ok && i < record.Number; i++) {
+			ok = fread(&sms->SMS[i], sizeof(GSM_SMSMessage), 1, f) == 1;
+		}
+		if (!ok) {
+			break;
+		}
+
+		error = Replay(Config, &record, sms);
+		if (error == ERR_DB_TIMEOUT) {
+			break;
+		}
+		if (error != ERR_NONE) {
+			SMSD_Log(DEBUG_ERROR, Config, "Dropping journaled operation %d: %s", record.Type, GSM_ErrorString(error));
+		}
+		error = ERR_NONE;
+		replayed++;
+	}
+	free(sms);
+
+	if (!ok) {
+		SMSD_Log(DEBUG_ERROR, Config, "Journal %s is truncated, ignoring rest of it", Config->journalpath);
+	}
+
+	if (replayed > 0) {
+		SMSD_Log(DEBUG_INFO, Config, "Replayed %d operations from journal", replayed);
+	}
+
+	if (error == ERR_DB_TIMEOUT) {
+		if (replayed > 0) {
+			SMSD_Journal_Truncate(Config, f, offset);
+		}
+		fclose(f);
+		return error;
+	}
+
+	fclose(f);
+	if (remove(Config->journalpath) != 0) {
+		SMSD_LogErrno(Config, "Can not remove journal");
+	}
+	Config->journal_pending = FALSE;
+	return ERR_NONE;
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
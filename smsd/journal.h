@@ -0,0 +1,89 @@
+/**
+ * SMSD local journal of service writes
+ */
+#ifndef __smsd_journal_h__
+#define __smsd_journal_h__
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+
+/**
+ * Type of journaled service operation.
+ */
+typedef enum {
+	/**
+	 * Received message, see SaveInboxSMS.
+	 */
+	SMSD_JOURNAL_INBOX = 1,
+	/**
+	 * Information about sent message part, see AddSentSMSInfo.
+	 */
+	SMSD_JOURNAL_SENT,
+	/**
+	 * Removal of processed message from outbox, see MoveSMS.
+	 */
+	SMSD_JOURNAL_MOVE
+} SMSD_JournalType;
+
+/**
+ * Single journal record header, followed by Number message parts in
+ * the journal file.
+ */
+typedef struct {
+	SMSD_JournalType Type;
+	/**
+	 * Number of message parts stored after the header.
+	 */
+	int Number;
+	/**
+	 * Outbox message ID.
+	 */
+	char ID[200];
+	/**
+	 * Time when outbox message was inserted to database.
+	 */
+	char DT[200];
+	/**
+	 * Sent message part number.
+	 */
+	int Part;
+	/**
+	 * Sending status, see GSM_SMSDSendingError.
+	 */
+	int Error;
+	/**
+	 * Message reference of sent message part.
+	 */
+	int TPMR;
+} SMSD_JournalRecord;
+
+/**
+ * Callback executing journaled operation during replay.
+ */
+typedef GSM_Error (*SMSD_JournalReplayFunction)(GSM_SMSDConfig *Config, SMSD_JournalRecord *Record, GSM_MultiSMSMessage *sms);
+
+/**
+ * Checks whether journal is enabled and contains some records.
+ */
+gboolean SMSD_Journal_Pending(GSM_SMSDConfig *Config);
+
+/**
+ * Appends record to the journal and flushes it to the disk. Journal
+ * written by incompatible build is moved aside with .bad suffix.
+ */
+GSM_Error SMSD_Journal_Append(GSM_SMSDConfig *Config, const SMSD_JournalRecord *Record, const GSM_MultiSMSMessage *sms);
+
+/**
+ * Replays journal records in order. Replay stops on first record for
+ * which callback returns ERR_DB_TIMEOUT, this and following records are
+ * kept in the journal. Records failing with other errors are dropped.
+ * Journal written by incompatible build is moved aside with .bad suffix
+ * and ERR_FILENOTSUPPORTED is returned.
+ */
+GSM_Error SMSD_Journal_Replay(GSM_SMSDConfig *Config, SMSD_JournalReplayFunction Replay);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
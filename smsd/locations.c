@@ -0,0 +1,91 @@
+/**
+ * SMSD lists of message locations in phone
+ */
+#include <gammu-config.h>
+
+#include <stdlib.h>
+
+#include "locations.h"
+
+#define SMSD_LOCATIONS_INIT_SIZE 10
+
+void SMSD_Locations_Init(SMSD_Locations *List)
+{
+	List->Locations = NULL;
+	List->Number = 0;
+	List->Size = 0;
+}
+
+static int SMSD_Locations_Find(const SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory)
+{
+	int i;
+
+	for (i = 0; i < List->Number; i++) {
+		if (List->Locations[i].Folder == Folder &&
+				List->Locations[i].Location == Location &&
+				List->Locations[i].Memory == Memory) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+GSM_Error SMSD_Locations_Add(SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory)
+{
+	GSM_SMSLocation *reallocated;
+	int size;
+
+	if (SMSD_Locations_Find(List, Folder, Location, Memory) != -1) {
+		return ERR_NONE;
+	}
+
+	if (List->Number >= List->Size) {
+		size = List->Size == 0 ? SMSD_LOCATIONS_INIT_SIZE : List->Size * 2;
+		reallocated = (GSM_SMSLocation *)realloc(List->Locations, size * sizeof(GSM_SMSLocation));
+		if (reallocated == NULL) {
+			return ERR_MOREMEMORY;
+		}
+		List->Locations = reallocated;
+		List->Size = size;
+	}
+
+	List->Locations[List->Number].Folder = Folder;
+	List->Locations[List->Number].Location = Location;
+	List->Locations[List->Number].Memory = Memory;
+	List->Number++;
+	return ERR_NONE;
+}
+
+gboolean SMSD_Locations_Contains(const SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory)
+{
+	return SMSD_Locations_Find(List, Folder, Location, Memory) != -1;
+}
+
+gboolean SMSD_Locations_Remove(SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory)
+{
+	int pos;
+
+	pos = SMSD_Locations_Find(List, Folder, Location, Memory);
+	if (pos == -1) {
+		return FALSE;
+	}
+	/* Order does not matter, move last one here */
+	List->Number--;
+	List->Locations[pos] = List->Locations[List->Number];
+	return TRUE;
+}
+
+void SMSD_Locations_Clear(SMSD_Locations *List)
+{
+	List->Number = 0;
+}
+
+void SMSD_Locations_Free(SMSD_Locations *List)
+{
+	free(List->Locations);
+	SMSD_Locations_Init(List);
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -0,0 +1,61 @@
+/**
+ * SMSD lists of message locations in phone
+ */
+#ifndef __smsd_locations_h__
+#define __smsd_locations_h__
+
+#include <gammu.h>
+
+/**
+ * Growable list of message locations, without duplicates.
+ */
+typedef struct {
+	/**
+	 * Stored locations.
+	 */
+	GSM_SMSLocation *Locations;
+	/**
+	 * Number of stored locations.
+	 */
+	int Number;
+	/**
+	 * Number of allocated locations.
+	 */
+	int Size;
+} SMSD_Locations;
+
+/**
+ * Initializes empty list.
+ */
+void SMSD_Locations_Init(SMSD_Locations *List);
+
+/**
+ * Adds location to list unless it is already there.
+ */
+GSM_Error SMSD_Locations_Add(SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory);
+
+/**
+ * Checks whether list contains given location.
+ */
+gboolean SMSD_Locations_Contains(const SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory);
+
+/**
+ * Removes location from list, returns whether it was there.
+ */
+gboolean SMSD_Locations_Remove(SMSD_Locations *List, int Folder, int Location, GSM_MemoryType Memory);
+
+/**
+ * Removes all locations, keeping allocated memory.
+ */
+void SMSD_Locations_Clear(SMSD_Locations *List);
+
+/**
+ * Frees memory used by list.
+ */
+void SMSD_Locations_Free(SMSD_Locations *List);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
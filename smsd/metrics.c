@@ -0,0 +1,65 @@
+/**
+ * SMSD per stage latency metrics
+ *
+ * Metrics live in the shared memory status block and are updated
+ * under its sequence lock, see status.c.
+ */
+#include <gammu-config.h>
+
+#include <string.h>
+
+#include "core.h"
+#include "metrics.h"
+#include "status.h"
+
+/**
+ * Upper limits of histogram buckets in milliseconds.
+ */
+static const int SMSD_Metrics_Limits[SMSD_METRIC_BUCKETS] = {
+	1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, -1
+};
+
+void SMSD_Metrics_Init(GSM_SMSDStatus *Status)
+{
+	memcpy(Status->BucketLimits, SMSD_Metrics_Limits, sizeof(Status->BucketLimits));
+	memset(Status->Metrics, 0, sizeof(Status->Metrics));
+}
+
+void SMSD_Metrics_Add(GSM_SMSDStatus *Status, SMSD_MetricStage Stage, long long Duration, gboolean failed)
+{
+	GSM_SMSDMetric *Metric = &Status->Metrics[Stage];
+	int i;
+
+	if (Duration < 0) {
+		Duration = 0;
+	}
+
+	for (i = 0; i < SMSD_METRIC_BUCKETS - 1; i++) {
+		if (Duration <= SMSD_Metrics_Limits[i]) {
+			break;
+		}
+	}
+	Metric->Buckets[i]++;
+	Metric->Sum += Duration;
+	if (Duration > Metric->Max) {
+		Metric->Max = (unsigned int)Duration;
+	}
+	if (failed) {
+		Metric->Errors++;
+	}
+	Metric->Count++;
+}
+
+void SMSD_Metrics_Record(GSM_SMSDConfig *Config, SMSD_MetricStage Stage, long long Start, GSM_Error error)
+{
+	if (Config->Status == NULL) {
+		return;
+	}
+	SMSD_Status_BeginUpdate(Config->Status);
+	SMSD_Metrics_Add(Config->Status, Stage, GSM_GetMonotonicTime() - Start, error != ERR_NONE);
+	SMSD_Status_EndUpdate(Config->Status);
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -0,0 +1,30 @@
+/**
+ * SMSD per stage latency metrics
+ */
+#ifndef __smsd_metrics_h__
+#define __smsd_metrics_h__
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+
+/**
+ * Clears metrics and fills in bucket limits.
+ */
+void SMSD_Metrics_Init(GSM_SMSDStatus *Status);
+
+/**
+ * Records operation of given stage which started at Start (as returned
+ * by GSM_GetMonotonicTime) and finished now.
+ */
+void SMSD_Metrics_Record(GSM_SMSDConfig *Config, SMSD_MetricStage Stage, long long Start, GSM_Error error);
+
+/**
+ * Records operation of given stage which took Duration milliseconds.
+ */
+void SMSD_Metrics_Add(GSM_SMSDStatus *Status, SMSD_MetricStage Stage, long long Duration, gboolean failed);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -27,6 +27,21 @@ volatile gboolean terminate = FALSE;
 int delay_seconds = 20;
 int limit_loops = -1;
 gboolean compact = FALSE;
+gboolean metrics = FALSE;
+
+/**
+ * Names of stages, indexed by SMSD_MetricStage.
+ */
+const char * const stage_names[SMSD_METRIC_LAST] = {
+	"outbox",
+	"submit",
+	"confirm",
+	"sent",
+	"read",
+	"inbox",
+	"hook",
+	"status",
+};
 
 void smsd_interrupt(int signum)
 {
@@ -93,6 +108,7 @@ void help(void)
 	print_option("h", "help", "shows this help");
 	print_option("v", "version", "shows version information");
 	print_option("C", "csv", "CSV output");
+	print_option("M", "metrics", "metrics output in text exposition format");
 	print_option_param("c", "config", "CONFIG_FILE",
 			   "defines path to config file");
 	print_option_param("d", "delay", "DELAY",
@@ -120,6 +136,8 @@ void process_commandline(int argc, char **argv, SMSD_Parameters * params)
 		{"config", 1, 0, 'c'},
 		{"delay", 1, 0, 'd'},
 		{"loops", 1, 0, 'n'},
+		{"csv", 0, 0, 'C'},
+		{"metrics", 0, 0, 'M'},
 		{"use-log", 0, 0, 'l'},
 		{"no-use-log", 0, 0, 'L'},
 		{0, 0, 0, 0}
@@ -127,10 +145,10 @@ void process_commandline(int argc, char **argv, SMSD_Parameters * params)
 	int option_index;
 
 	while ((opt =
-		getopt_long(argc, argv, "+hvc:d:n:ClL", long_options,
+		getopt_long(argc, argv, "+hvc:d:n:CMlL", long_options,
 			    &option_index)) != -1) {
 #elif defined(HAVE_GETOPT)
-	while ((opt = getopt(argc, argv, "+hvc:d:n:ClL")) != -1) {
+	while ((opt = getopt(argc, argv, "+hvc:d:n:CMlL")) != -1) {
 #else
 	/* Poor mans getopt replacement */
 	int i;
@@ -153,6 +171,9 @@ void process_commandline(int argc, char **argv, SMSD_Parameters * params)
 			case 'C':
 				compact = TRUE;
 				break;
+			case 'M':
+				metrics = TRUE;
+				break;
 			case 'd':
 				delay_seconds = atoi(optarg);
 				break;
@@ -187,8 +208,47 @@ void process_commandline(int argc, char **argv, SMSD_Parameters * params)
 
 }
 
-#ifndef WIN32
-#endif
+/**
+ * Prints counters and latency histograms in text exposition format.
+ */
+void print_metrics(GSM_SMSDStatus *status)
+{
+	GSM_SMSDMetric *metric;
+	unsigned int total;
+	int i, j;
+
+	printf("smsd_sent_total{phone=\"%s\"} %d\n", status->PhoneID, status->Sent);
+	printf("smsd_received_total{phone=\"%s\"} %d\n", status->PhoneID, status->Received);
+	printf("smsd_failed_total{phone=\"%s\"} %d\n", status->PhoneID, status->Failed);
+	printf("smsd_signal_percent{phone=\"%s\"} %d\n", status->PhoneID, status->Network.SignalPercent);
+	printf("smsd_battery_percent{phone=\"%s\"} %d\n", status->PhoneID, status->Charge.BatteryPercent);
+	printf("smsd_last_sent_timestamp_seconds{phone=\"%s\"} %lld\n", status->PhoneID, (long long)status->LastSent);
+	printf("smsd_last_received_timestamp_seconds{phone=\"%s\"} %lld\n", status->PhoneID, (long long)status->LastReceived);
+	printf("smsd_last_status_timestamp_seconds{phone=\"%s\"} %lld\n", status->PhoneID, (long long)status->LastStatus);
+
+	for (i = 0; i < SMSD_METRIC_LAST; i++) {
+		metric = &status->Metrics[i];
+		total = 0;
+		for (j = 0; j < SMSD_METRIC_BUCKETS; j++) {
+			total += metric->Buckets[j];
+			if (status->BucketLimits[j] < 0) {
+				printf("smsd_stage_duration_ms_bucket{phone=\"%s\",stage=\"%s\",le=\"+Inf\"} %u\n",
+					status->PhoneID, stage_names[i], total);
+			} else {
+				printf("smsd_stage_duration_ms_bucket{phone=\"%s\",stage=\"%s\",le=\"%d\"} %u\n",
+					status->PhoneID, stage_names[i], status->BucketLimits[j], total);
+			}
+		}
+		printf("smsd_stage_duration_ms_sum{phone=\"%s\",stage=\"%s\"} %llu\n",
+			status->PhoneID, stage_names[i], metric->Sum);
+		printf("smsd_stage_duration_ms_count{phone=\"%s\",stage=\"%s\"} %u\n",
+			status->PhoneID, stage_names[i], metric->Count);
+		printf("smsd_stage_duration_ms_max{phone=\"%s\",stage=\"%s\"} %u\n",
+			status->PhoneID, stage_names[i], metric->Max);
+		printf("smsd_stage_errors_total{phone=\"%s\",stage=\"%s\"} %u\n",
+			status->PhoneID, stage_names[i], metric->Errors);
+	}
+}
 
 int main(int argc, char **argv)
 {
@@ -255,7 +315,10 @@ int main(int argc, char **argv)
 			SMSD_FreeConfig(config);
 			return 3;
 		}
-		if (compact) {
+		if (metrics) {
+			print_metrics(&status);
+			printf("\n");
+		} else if (compact) {
 			printf("%s;%s;%s;%s;%d;%d;%d;%d;%d\n",
 				 status.Client,
 				 status.PhoneID,
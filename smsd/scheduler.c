@@ -0,0 +1,68 @@
+/**
+ * SMSD periodic task scheduling
+ */
+#include "scheduler.h"
+
+void SMSD_Scheduler_Init(SMSD_Scheduler *Sched)
+{
+	int i;
+
+	for (i = 0; i < SMSD_TIMER_LAST; i++) {
+		Sched->Timers[i].Enabled = FALSE;
+		Sched->Timers[i].Period = 0;
+		Sched->Timers[i].Due = 0;
+	}
+}
+
+void SMSD_Timer_Set(SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Period, long long Due)
+{
+	Sched->Timers[ID].Enabled = TRUE;
+	Sched->Timers[ID].Period = (Period > 0) ? Period : 0;
+	Sched->Timers[ID].Due = Due;
+}
+
+void SMSD_Timer_Disable(SMSD_Scheduler *Sched, SMSD_TimerID ID)
+{
+	Sched->Timers[ID].Enabled = FALSE;
+}
+
+gboolean SMSD_Timer_IsDue(const SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Now)
+{
+	return Sched->Timers[ID].Enabled && Now >= Sched->Timers[ID].Due;
+}
+
+void SMSD_Timer_Rearm(SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Now)
+{
+	Sched->Timers[ID].Due = Now + Sched->Timers[ID].Period;
+}
+
+void SMSD_Timer_Advance(SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Due)
+{
+	if (Due < Sched->Timers[ID].Due) {
+		Sched->Timers[ID].Due = Due;
+	}
+}
+
+long long SMSD_Scheduler_Timeout(const SMSD_Scheduler *Sched, long long Now)
+{
+	long long timeout = -1, left;
+	int i;
+
+	for (i = 0; i < SMSD_TIMER_LAST; i++) {
+		if (!Sched->Timers[i].Enabled) {
+			continue;
+		}
+		left = Sched->Timers[i].Due - Now;
+		if (left <= 0) {
+			return 0;
+		}
+		if (timeout == -1 || left < timeout) {
+			timeout = left;
+		}
+	}
+	return timeout;
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
@@ -0,0 +1,103 @@
+/**
+ * SMSD periodic task scheduling
+ */
+#ifndef __smsd_scheduler_h__
+#define __smsd_scheduler_h__
+
+#include <gammu-types.h>
+
+/**
+ * Periodic tasks of SMSD main loop.
+ */
+typedef enum {
+	/**
+	 * Polling phone for received messages.
+	 */
+	SMSD_TIMER_RECEIVE = 0,
+	/**
+	 * Checking outbox for messages to send.
+	 */
+	SMSD_TIMER_SEND,
+	/**
+	 * Refreshing phone status.
+	 */
+	SMSD_TIMER_STATUS,
+	/**
+	 * Preventive soft reset of phone.
+	 */
+	SMSD_TIMER_RESET,
+	/**
+	 * Preventive hard reset of phone.
+	 */
+	SMSD_TIMER_HARDRESET,
+	SMSD_TIMER_LAST
+} SMSD_TimerID;
+
+/**
+ * Single periodic timer, all times are in milliseconds.
+ */
+typedef struct {
+	/**
+	 * Whether timer is active.
+	 */
+	gboolean Enabled;
+	/**
+	 * Period of timer.
+	 */
+	long long Period;
+	/**
+	 * Monotonic time when timer expires.
+	 */
+	long long Due;
+} SMSD_Timer;
+
+/**
+ * Set of timers driving SMSD main loop.
+ */
+typedef struct {
+	SMSD_Timer Timers[SMSD_TIMER_LAST];
+} SMSD_Scheduler;
+
+/**
+ * Disables all timers.
+ */
+void SMSD_Scheduler_Init(SMSD_Scheduler *Sched);
+
+/**
+ * Enables timer with given period, first expiring at due time.
+ * Period of zero means the timer is due on every check.
+ */
+void SMSD_Timer_Set(SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Period, long long Due);
+
+/**
+ * Disables timer.
+ */
+void SMSD_Timer_Disable(SMSD_Scheduler *Sched, SMSD_TimerID ID);
+
+/**
+ * Checks whether timer has expired.
+ */
+gboolean SMSD_Timer_IsDue(const SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Now);
+
+/**
+ * Schedules next expiry of timer one period after given time.
+ */
+void SMSD_Timer_Rearm(SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Now);
+
+/**
+ * Schedules timer to expire at given time, unless it already expires
+ * sooner.
+ */
+void SMSD_Timer_Advance(SMSD_Scheduler *Sched, SMSD_TimerID ID, long long Due);
+
+/**
+ * Returns time in milliseconds until first timer expires, 0 if some
+ * has already expired and -1 if no timer is enabled.
+ */
+long long SMSD_Scheduler_Timeout(const SMSD_Scheduler *Sched, long long Now);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
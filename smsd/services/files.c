@@ -16,6 +16,10 @@
 #ifdef WIN32
 #include <io.h>
 #endif
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 #if defined HAVE_DIRENT_H && defined HAVE_SCANDIR && defined HAVE_ALPHASORT
 #define HAVE_DIRBROWSING
 #include <dirent.h>
@@ -874,9 +878,74 @@ GSM_Error SMSDFiles_ReadConfiguration(GSM_SMSDConfig *Config)
 	return ERR_NONE;
 }
 
+/**
+ * Checks whether outbox directory was modified since last check.
+ */
+static GSM_Error SMSDFiles_OutboxChanged(GSM_SMSDConfig * Config)
+{
+	struct stat st;
+#ifdef HAVE_SYS_INOTIFY_H
+	char buffer[4096];
+	gboolean changed = FALSE;
+
+	/* Drain pending events from directory watch */
+	if (Config->outboxwatch >= 0) {
+		while (read(Config->outboxwatch, buffer, sizeof(buffer)) > 0) {
+			changed = TRUE;
+		}
+		return changed ? ERR_NONE : ERR_EMPTY;
+	}
+#endif
+
+	if (stat(Config->outboxpath, &st) != 0) {
+		return ERR_NOTSUPPORTED;
+	}
+	if (st.st_mtime == Config->outboxmtime) {
+		return ERR_EMPTY;
+	}
+	Config->outboxmtime = st.st_mtime;
+	return ERR_NONE;
+}
+
+/**
+ * Watches outbox directory, so that SMSD does not have to poll it.
+ */
+static GSM_Error SMSDFiles_NotifyDescriptor(GSM_SMSDConfig * Config, int *fd)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+	if (Config->outboxwatch == -1) {
+		Config->outboxwatch = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (Config->outboxwatch < 0) {
+			SMSD_LogErrno(Config, "Can not create outbox watch");
+			Config->outboxwatch = -2;
+		} else if (inotify_add_watch(Config->outboxwatch, Config->outboxpath, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+			SMSD_LogErrno(Config, "Can not watch outbox directory");
+			close(Config->outboxwatch);
+			Config->outboxwatch = -2;
+		}
+	}
+	if (Config->outboxwatch >= 0) {
+		*fd = Config->outboxwatch;
+		return ERR_NONE;
+	}
+#endif
+	return ERR_NOTSUPPORTED;
+}
+
+static GSM_Error SMSDFiles_Free(GSM_SMSDConfig * Config)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+	if (Config->outboxwatch >= 0) {
+		close(Config->outboxwatch);
+	}
+#endif
+	Config->outboxwatch = -1;
+	return ERR_NONE;
+}
+
 GSM_SMSDService SMSDFiles = {
 	NONEFUNCTION,		/* Init                 */
-	NONEFUNCTION,		/* Free                 */
+	SMSDFiles_Free,
 	NONEFUNCTION,		/* InitAfterConnect     */
 	SMSDFiles_SaveInboxSMS,
 	SMSDFiles_FindOutboxSMS,
@@ -886,7 +955,9 @@ GSM_SMSDService SMSDFiles = {
 	NOTIMPLEMENTED,		/* UpdateRetries        */
 	NOTIMPLEMENTED,		/* RefreshSendStatus    */
 	NOTIMPLEMENTED,		/* RefreshPhoneStatus   */
-	SMSDFiles_ReadConfiguration
+	SMSDFiles_ReadConfiguration,
+	SMSDFiles_OutboxChanged,
+	SMSDFiles_NotifyDescriptor
 };
 
 /* How should editor handle tabs in this file? Add editor commands here.
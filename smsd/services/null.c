@@ -19,7 +19,9 @@ GSM_SMSDService SMSDNull = {
 	NOTIMPLEMENTED,		/* UpdateRetries        */
 	NOTIMPLEMENTED,		/* RefreshSendStatus    */
 	NOTIMPLEMENTED,		/* RefreshPhoneStatus   */
-	NONEFUNCTION		/* ReadConfiguration    */
+	NONEFUNCTION,		/* ReadConfiguration    */
+	NOTIMPLEMENTED,		/* OutboxChanged        */
+	NOTSUPPORTED		/* NotifyDescriptor     */
 };
 
 /* How should editor handle tabs in this file? Add editor commands here.
@@ -360,6 +360,8 @@ struct GSM_SMSDdbobj SMSDODBC = {
 	SMSDODBC_GetDate,
 	SMSDODBC_GetBool,
 	SMSDODBC_QuoteString,
+	NULL,
+	NULL,
 };
 
 /* How should editor hadle tabs in this file? Add editor commands here.
@@ -70,6 +70,37 @@ void SMSDPgSQL_Free(GSM_SMSDConfig * Config)
 	}
 }
 
+/* Subscribes to outbox notifications sent by trigger on outbox table */
+static void SMSDPgSQL_Listen(GSM_SMSDConfig * Config)
+{
+	PGresult *rc;
+	int Status;
+
+	Config->outbox_notify = FALSE;
+
+	rc = PQexec(Config->conn.pg, "SELECT 1 FROM pg_trigger WHERE tgname = 'notify_outbox'");
+	if ((rc == NULL) || (PQresultStatus(rc) != PGRES_TUPLES_OK)) {
+		SMSDPgSQL_LogError(Config, rc);
+		PQclear(rc);
+		return;
+	}
+	if (PQntuples(rc) == 0) {
+		SMSD_Log(DEBUG_INFO, Config, "No notify_outbox trigger in database, polling outbox for changes");
+		PQclear(rc);
+		return;
+	}
+	PQclear(rc);
+
+	rc = PQexec(Config->conn.pg, "LISTEN gammu_outbox");
+	if ((rc == NULL) || ((Status = PQresultStatus(rc)) != PGRES_COMMAND_OK)) {
+		SMSDPgSQL_LogError(Config, rc);
+		PQclear(rc);
+		return;
+	}
+	PQclear(rc);
+	Config->outbox_notify = TRUE;
+}
+
 /* [Re]connects to database */
 static GSM_Error SMSDPgSQL_Connect(GSM_SMSDConfig * Config)
 {
@@ -93,6 +124,7 @@ static GSM_Error SMSDPgSQL_Connect(GSM_SMSDConfig * Config)
 	if (PQstatus(Config->conn.pg) != CONNECTION_OK) {
 		SMSD_Log(DEBUG_ERROR, Config, "Error connecting to database: %s", PQerrorMessage(Config->conn.pg));
 		PQfinish(Config->conn.pg);
+		Config->conn.pg = NULL;
 		return ERR_DB_CONNECT;
 	}
 
@@ -105,6 +137,8 @@ static GSM_Error SMSDPgSQL_Connect(GSM_SMSDConfig * Config)
 	SMSD_Log(DEBUG_INFO, Config, "Connected to database: %s on %s. Server version: %d Protocol: %d",
 		 PQdb(Config->conn.pg), PQhost(Config->conn.pg), PQserverVersion(Config->conn.pg), PQprotocolVersion(Config->conn.pg));
 
+	SMSDPgSQL_Listen(Config);
+
 	return ERR_NONE;
 }
 
@@ -187,6 +221,36 @@ unsigned long long SMSDPgSQL_SeqID(GSM_SMSDConfig * Config, const char *seq_id)
 	return id;
 }
 
+/* Checks for pending outbox notifications without blocking */
+static GSM_Error SMSDPgSQL_OutboxChanged(GSM_SMSDConfig * Config)
+{
+	PGnotify *notify;
+	gboolean changed = FALSE;
+
+	if (Config->conn.pg == NULL || !Config->outbox_notify) {
+		return ERR_NOTSUPPORTED;
+	}
+	if (PQconsumeInput(Config->conn.pg) == 0) {
+		SMSDPgSQL_LogError(Config, NULL);
+		return ERR_DB_TIMEOUT;
+	}
+	while ((notify = PQnotifies(Config->conn.pg)) != NULL) {
+		changed = TRUE;
+		PQfreemem(notify);
+	}
+	return changed ? ERR_NONE : ERR_EMPTY;
+}
+
+/* Socket on which outbox notifications arrive */
+static GSM_Error SMSDPgSQL_NotifyDescriptor(GSM_SMSDConfig * Config, int *fd)
+{
+	if (Config->conn.pg == NULL || !Config->outbox_notify) {
+		return ERR_NOTSUPPORTED;
+	}
+	*fd = PQsocket(Config->conn.pg);
+	return (*fd < 0) ? ERR_NOTSUPPORTED : ERR_NONE;
+}
+
 struct GSM_SMSDdbobj SMSDPgSQL = {
 	SMSDPgSQL_Connect,
 	SMSDPgSQL_Query,
@@ -200,6 +264,8 @@ struct GSM_SMSDdbobj SMSDPgSQL = {
 	SMSDPgSQL_GetDate,
 	SMSDPgSQL_GetBool,
 	SMSDPgSQL_QuoteString,
+	SMSDPgSQL_OutboxChanged,
+	SMSDPgSQL_NotifyDescriptor,
 };
 
 #endif
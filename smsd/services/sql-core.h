@@ -115,6 +115,7 @@ enum {
 	SQL_QUERY_FIND_OUTBOX_SMS_ID,
 	SQL_QUERY_FIND_OUTBOX_BODY,
 	SQL_QUERY_FIND_OUTBOX_MULTIPART,
+	SQL_QUERY_FIND_OUTBOX_SMS, /* body and all parts in one query */
 	SQL_QUERY_DELETE_OUTBOX,
 	SQL_QUERY_DELETE_OUTBOX_MULTIPART,
 	SQL_QUERY_CREATE_OUTBOX,
@@ -126,6 +127,7 @@ enum {
 	SQL_QUERY_ADD_SENT_INFO,
 	SQL_QUERY_UPDATE_SENT,
 	SQL_QUERY_REFRESH_PHONE_STATUS,
+	SQL_QUERY_OUTBOX_CHANGED, /* outbox change counter */
 	SQL_QUERY_LAST_NO
 };
 
@@ -146,6 +148,8 @@ struct GSM_SMSDdbobj {
 	time_t (* GetDate)(GSM_SMSDConfig *, SQL_result *, unsigned int);
 	gboolean (* GetBool)(GSM_SMSDConfig *, SQL_result *, unsigned int);
 	char * (* QuoteString)(GSM_SMSDConfig *, const char *);
+	GSM_Error (* OutboxChanged)(GSM_SMSDConfig *); /* optional, NULL when driver can not be notified */
+	GSM_Error (* NotifyDescriptor)(GSM_SMSDConfig *, int *); /* optional, socket receiving notifications */
 };
 
 /* database backends */
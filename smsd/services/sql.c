@@ -28,6 +28,7 @@
 #endif
 
 #include "../core.h"
+#include "../journal.h"
 #include "../../libgammu/gsmstate.h"
 #include "../../libgammu/misc/string.h"
 
@@ -236,49 +237,68 @@ static const char *SMSDSQL_Now(GSM_SMSDConfig * Config)
 	}
 }
 
+/*
+ * Makes single reconnection attempt, unless previous attempt failed
+ * recently. This never sleeps, so the phone loop keeps running while
+ * the database is not available.
+ */
 static GSM_Error SMSDSQL_Reconnect(GSM_SMSDConfig * Config)
 {
-	GSM_Error error = ERR_DB_TIMEOUT;
-	int attempts;
+	GSM_Error error;
 	struct GSM_SMSDdbobj *db = Config->db;
+	long long now;
+	int delay;
 
-	SMSD_Log(DEBUG_INFO, Config, "Reconnecting to the database!");
-	for (attempts = 1; attempts <= Config->backend_retries; attempts++) {
-		SMSD_Log(DEBUG_INFO, Config, "Reconnecting after %d seconds...", attempts * attempts);
-		sleep(attempts * attempts);
-		db->Free(Config);
-		error = db->Connect(Config);
-		if (error == ERR_NONE) {
-			return ERR_NONE;
-		}
+	now = GSM_GetMonotonicTime();
+	if (Config->db_attempts > 0 && now < Config->db_retry) {
+		return ERR_DB_TIMEOUT;
 	}
-	return error;
+
+	Config->db_attempts++;
+	SMSD_Log(DEBUG_INFO, Config, "Reconnecting to the database (attempt %d)!", Config->db_attempts);
+	db->Free(Config);
+	error = db->Connect(Config);
+	if (error == ERR_NONE) {
+		Config->db_attempts = 0;
+		/* Phone status was not stored while disconnected */
+		SMSD_Timer_Advance(&Config->Scheduler, SMSD_TIMER_STATUS, now);
+		return ERR_NONE;
+	}
+
+	/* Back off quadratically, BackendRetries limits the delay */
+	delay = Config->db_attempts;
+	if (delay > Config->backend_retries) {
+		delay = Config->backend_retries;
+	}
+	Config->db_retry = now + (long long)delay * delay * 1000;
+	SMSD_Log(DEBUG_INFO, Config, "Will try to reconnect after %d seconds...", delay * delay);
+	return ERR_DB_TIMEOUT;
 }
 
 static GSM_Error SMSDSQL_Query(GSM_SMSDConfig * Config, const char *query, SQL_result * res)
 {
-	GSM_Error error = ERR_DB_TIMEOUT;
-	int attempts;
+	GSM_Error error;
 	struct GSM_SMSDdbobj *db = Config->db;
 
-	for (attempts = 1; attempts <= Config->backend_retries; attempts++) {
-		SMSD_Log(DEBUG_SQL, Config, "Execute SQL: %s", query);
-		error = db->Query(Config, query, res);
-		if (error == ERR_NONE) {
-			return ERR_NONE;
-		}
+	/* Not connected, fail fast until next reconnection attempt */
+	if (Config->db_attempts > 0 && SMSDSQL_Reconnect(Config) != ERR_NONE) {
+		return ERR_DB_TIMEOUT;
+	}
 
-		if (error != ERR_DB_TIMEOUT){
-			SMSD_Log(DEBUG_INFO, Config, "SQL failure: %d", error);
-			return error;
-		}
+	SMSD_Log(DEBUG_SQL, Config, "Execute SQL: %s", query);
+	error = db->Query(Config, query, res);
 
+	if (error == ERR_DB_TIMEOUT) {
 		SMSD_Log(DEBUG_INFO, Config, "SQL failed (timeout): %s", query);
 		/* We will try to reconnect */
-		error = SMSDSQL_Reconnect(Config);
-		if (error != ERR_NONE) {
+		if (SMSDSQL_Reconnect(Config) != ERR_NONE) {
 			return ERR_DB_TIMEOUT;
 		}
+		error = db->Query(Config, query, res);
+	}
+
+	if (error != ERR_NONE && error != ERR_DB_TIMEOUT) {
+		SMSD_Log(DEBUG_INFO, Config, "SQL failure: %d", error);
 	}
 	return error;
 }
@@ -617,6 +637,13 @@ static GSM_Error SMSDSQL_Init(GSM_SMSDConfig * Config)
 
 	db = Config->db;
 
+	Config->outbox_notify = FALSE;
+	Config->outbox_lastid = -1;
+	Config->outbox_lastcheck = 0;
+	Config->db_attempts = 0;
+	Config->db_retry = 0;
+	Config->outbox_fetched[0] = 0;
+
 	error = db->Connect(Config);
 	if (error != ERR_NONE)
 		return error;
@@ -712,8 +739,8 @@ static GSM_Error SMSDSQL_InitAfterConnect(GSM_SMSDConfig * Config)
 	return ERR_NONE;
 }
 
-/* Save SMS from phone (called Inbox sms - it's in phone Inbox) somewhere */
-static GSM_Error SMSDSQL_SaveInboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char **Locations)
+/* Stores received message in the database */
+static GSM_Error SMSDSQL_StoreInboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char **Locations)
 {
 	SQL_result res, res2;
 	SQL_Var vars[3];
@@ -934,211 +961,199 @@ static GSM_Error SMSDSQL_UpdateRetries(GSM_SMSDConfig * Config, char *ID)
 	return ERR_NONE;
 }
 
-/* Find one multi SMS to sending and return it (or return ERR_EMPTY)
- * There is also set ID for SMS
+/*
+ * Decodes one message part from outbox or outbox_multipart row, columns
+ * start at given offset and follow find_outbox_multipart layout.
  */
-static GSM_Error SMSDSQL_FindOutboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char *ID)
+static GSM_Error SMSDSQL_DecodeOutboxPart(GSM_SMSDConfig * Config, SQL_result *res, GSM_MultiSMSMessage * sms, const char *ID, unsigned int column, unsigned int status_column)
 {
-	SQL_result res;
 	struct GSM_SMSDdbobj *db = Config->db;
-	int i;
-	gboolean last;
-	time_t timestamp;
+	GSM_SMSMessage *part = &sms->SMS[sms->Number];
 	const char *coding;
 	const char *text;
 	size_t text_len;
 	const char *text_decoded;
-	const char *destination;
 	const char *udh;
-	const char *q;
 	const char *status;
 	size_t udh_len;
-	SQL_Var vars[3];
-	GSM_Error error;
 
-	vars[0].type = SQL_TYPE_INT;
-	vars[0].v.i = 1;
-	vars[1].type = SQL_TYPE_NONE;
+	status = db->GetString(Config, res, status_column);
+	if (status != NULL && strncmp(status, "SendingOK", 9) == 0) {
+		SMSD_Log(DEBUG_NOTICE, Config, "Marking %s:%d message for skip", ID, sms->Number + 1);
+		Config->SkipMessage[sms->Number] = TRUE;
+	} else {
+		Config->SkipMessage[sms->Number] = FALSE;
+	}
 
-	while (TRUE) {
-		error = SMSDSQL_NamedQuery(Config, Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_SMS_ID], NULL, NULL, vars, &res, FALSE);
-		if (error != ERR_NONE) {
-			SMSD_Log(DEBUG_INFO, Config, "Error reading from database (%s)", __FUNCTION__);
-			return error;
-		}
+	text = db->GetString(Config, res, column + 0);
+	if (text == NULL) {
+		text_len = 0;
+	} else {
+		text_len = strlen(text);
+	}
+	udh = db->GetString(Config, res, column + 2);
+	part->Class = (int)db->GetNumber(Config, res, column + 3);
+	text_decoded = db->GetString(Config, res, column + 4);
+	if (udh == NULL) {
+		udh_len = 0;
+	} else {
+		udh_len = strlen(udh);
+	}
 
-		if (db->NextRow(Config, &res) != 1) {
-			db->FreeResult(Config, &res);
-			return ERR_EMPTY;
-		}
+	/* ID, we don't need it, but some ODBC backend need to fetch all values */
+	db->GetNumber(Config, res, column + 5);
 
-		sprintf(ID, "%ld", (long)db->GetNumber(Config, &res, 0));
-		timestamp = db->GetDate(Config, &res, 1);
+	coding = db->GetString(Config, res, column + 1);
+	if (coding && strncasecmp("network_default", coding, 15) == 0) {
+		part->Coding = GSM_NetworkDefaultCoding(Config->gsm->CurrentConfig);
+	} else {
+		part->Coding = GSM_StringToSMSCoding(coding);
+	}
 
-		db->FreeResult(Config, &res);
+	if (part->Coding == 0) {
+		if (text == NULL || text_len == 0) {
+			SMSD_Log(DEBUG_NOTICE, Config, "Assuming default coding for text message");
+			part->Coding = GSM_NetworkDefaultCoding(Config->gsm->CurrentConfig);
+		} else {
+			SMSD_Log(DEBUG_NOTICE, Config, "Assuming 8bit coding for binary message");
+			part->Coding = SMS_Coding_8bit;
+		}
+	}
 
-		if (timestamp == -1) {
-			SMSD_Log(DEBUG_INFO, Config, "Invalid date for InsertIntoDB.");
+	if (text == NULL || text_len == 0) {
+		if (text_decoded == NULL) {
+			SMSD_Log(DEBUG_ERROR, Config, "Message without text!");
 			return ERR_UNKNOWN;
+		} else {
+			SMSD_Log(DEBUG_NOTICE, Config, "Message: %s", text_decoded);
+			DecodeUTF8(part->Text, text_decoded, strlen(text_decoded));
 		}
+	} else {
+		switch (part->Coding) {
+			case SMS_Coding_Unicode_No_Compression:
+			case SMS_Coding_Default_No_Compression:
+			case SMS_Coding_ASCII:
+				if (! DecodeHexUnicode(part->Text, text, text_len)) {
+					SMSD_Log(DEBUG_ERROR, Config, "Failed to decode Text HEX string: %s", text);
+					return ERR_UNKNOWN;
+				}
+				break;
 
-		SMSDSQL_Time2String(Config, timestamp, Config->DT, sizeof(Config->DT));
-		if (SMSDSQL_RefreshSendStatus(Config, ID) == ERR_NONE) {
-			break;
+			case SMS_Coding_8bit:
+				if (! DecodeHexBin(part->Text, text, text_len)) {
+					SMSD_Log(DEBUG_ERROR, Config, "Failed to decode Text HEX string: %s", text);
+					return ERR_UNKNOWN;
+				}
+				part->Length = text_len / 2;
+				break;
+
+			default:
+				break;
 		}
 	}
 
-	sms->Number = 0;
-	for (i = 0; i < GSM_MAX_MULTI_SMS; i++) {
-		GSM_SetDefaultSMSData(&sms->SMS[i]);
-		/* Force using default SMSC */
-		sms->SMS[i].SMSC.Location = 0;
+	if (sms->Number > 0) {
+		CopyUnicodeString(part->Number, sms->SMS[0].Number);
 	}
 
-	for (i = 1; i < GSM_MAX_MULTI_SMS + 1; i++) {
-		vars[0].type = SQL_TYPE_STRING;
-		vars[0].v.s = ID;
-		vars[1].type = SQL_TYPE_INT;
-		vars[1].v.i = i;
-		vars[2].type = SQL_TYPE_NONE;
-		if (i == 1) {
-			q = Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_BODY];
-		} else {
-			q = Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_MULTIPART];
-		}
-		error = SMSDSQL_NamedQuery(Config, q, NULL, NULL, vars, &res, FALSE);
-		if (error != ERR_NONE) {
-			SMSD_Log(DEBUG_ERROR, Config, "Error reading from database (%s)", __FUNCTION__);
-			return error;
+	part->UDH.Type = UDH_NoUDH;
+	if (udh != NULL && udh_len != 0) {
+		part->UDH.Length = udh_len / 2;
+		if (! DecodeHexBin(part->UDH.Text, udh, udh_len)) {
+			SMSD_Log(DEBUG_ERROR, Config, "Failed to decode UDH HEX string: %s", udh);
+			return ERR_UNKNOWN;
 		}
+		GSM_DecodeUDHHeader(GSM_GetDI(Config->gsm), &part->UDH);
+	}
 
-		if (db->NextRow(Config, &res) != 1) {
-			db->FreeResult(Config, &res);
-			return ERR_NONE;
-		}
+	part->PDU = SMS_Submit;
+	sms->Number++;
 
-		status = db->GetString(Config, &res, i == 1 ? 12 : 7);
-		if (status != NULL && strncmp(status, "SendingOK", 9) == 0) {
-			SMSD_Log(DEBUG_NOTICE, Config, "Marking %s:%d message for skip", ID, i);
-			Config->SkipMessage[sms->Number] = TRUE;
-		} else {
-			Config->SkipMessage[sms->Number] = FALSE;
-		}
+	return ERR_NONE;
+}
 
-		text = db->GetString(Config, &res, 0);
-		if (text == NULL) {
-			text_len = 0;
-		} else {
-			text_len = strlen(text);
-		}
-		udh = db->GetString(Config, &res, 2);
-		sms->SMS[sms->Number].Class = (int)db->GetNumber(Config, &res, 3);
-		text_decoded = db->GetString(Config, &res, 4);
-		if (udh == NULL) {
-			udh_len = 0;
-		} else {
-			udh_len = strlen(udh);
-		}
+/*
+ * Decodes first message part and message properties from outbox row in
+ * find_outbox_body layout. Sets last when message has only one part.
+ */
+static GSM_Error SMSDSQL_DecodeOutboxBody(GSM_SMSDConfig * Config, SQL_result *res, GSM_MultiSMSMessage * sms, const char *ID, gboolean *last)
+{
+	struct GSM_SMSDdbobj *db = Config->db;
+	const char *destination;
+	GSM_Error error;
 
-		/* ID, we don't need it, but some ODBC backend need to fetch all values */
-		db->GetNumber(Config, &res, 5);
-
-    coding = db->GetString(Config, &res, 1);
-		if(coding && strncasecmp("network_default", coding, 15) == 0) {
-      sms->SMS[sms->Number].Coding = GSM_NetworkDefaultCoding(Config->gsm->CurrentConfig);
-    }
-		else {
-      sms->SMS[sms->Number].Coding = GSM_StringToSMSCoding(coding);
-    }
-
-		if (sms->SMS[sms->Number].Coding == 0) {
-			if (text == NULL || text_len == 0) {
-				SMSD_Log(DEBUG_NOTICE, Config, "Assuming default coding for text message");
-				sms->SMS[sms->Number].Coding = GSM_NetworkDefaultCoding(Config->gsm->CurrentConfig);
-			} else {
-				SMSD_Log(DEBUG_NOTICE, Config, "Assuming 8bit coding for binary message");
-				sms->SMS[sms->Number].Coding = SMS_Coding_8bit;
-			}
-		}
+	destination = db->GetString(Config, res, 6);
+	if (destination == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "Message without recipient!");
+		return ERR_UNKNOWN;
+	}
+	DecodeUTF8(sms->SMS[0].Number, destination, strlen(destination));
 
-		if (text == NULL || text_len == 0) {
-			if (text_decoded == NULL) {
-				SMSD_Log(DEBUG_ERROR, Config, "Message without text!");
-				return ERR_UNKNOWN;
-			} else {
-				SMSD_Log(DEBUG_NOTICE, Config, "Message: %s", text_decoded);
-				DecodeUTF8(sms->SMS[sms->Number].Text, text_decoded, strlen(text_decoded));
-			}
-		} else {
-			switch (sms->SMS[sms->Number].Coding) {
-				case SMS_Coding_Unicode_No_Compression:
-				case SMS_Coding_Default_No_Compression:
-        case SMS_Coding_ASCII:
-					if (! DecodeHexUnicode(sms->SMS[sms->Number].Text, text, text_len)) {
-						SMSD_Log(DEBUG_ERROR, Config, "Failed to decode Text HEX string: %s", text);
-						return ERR_UNKNOWN;
-					}
-					break;
+	error = SMSDSQL_DecodeOutboxPart(Config, res, sms, ID, 0, 12);
+	if (error != ERR_NONE) {
+		return error;
+	}
 
-				case SMS_Coding_8bit:
-					if (! DecodeHexBin(sms->SMS[sms->Number].Text, text, text_len)) {
-						SMSD_Log(DEBUG_ERROR, Config, "Failed to decode Text HEX string: %s", text);
-						return ERR_UNKNOWN;
-					}
-					sms->SMS[sms->Number].Length = text_len / 2;
-					break;
+	/* Is this a multipart message? */
+	*last = !db->GetBool(Config, res, 7);
+	Config->relativevalidity = (int)db->GetNumber(Config, res, 8);
 
-				default:
-					break;
-			}
-		}
+	Config->currdeliveryreport = db->GetBool(Config, res, 9);
+	strncpy(Config->CreatorID, db->GetString(Config, res, 10), sizeof(Config->CreatorID));
+	Config->CreatorID[sizeof(Config->CreatorID) - 1] = 0;
+	Config->retries = (int)db->GetNumber(Config, res, 11);
 
-		if (i == 1) {
-			destination = db->GetString(Config, &res, 6);
-			if (destination == NULL) {
-				SMSD_Log(DEBUG_ERROR, Config, "Message without recipient!");
-				return ERR_UNKNOWN;
-			}
-			DecodeUTF8(sms->SMS[sms->Number].Number, destination, strlen(destination));
-		} else {
-			CopyUnicodeString(sms->SMS[sms->Number].Number, sms->SMS[0].Number);
-		}
+	return ERR_NONE;
+}
 
-		sms->SMS[sms->Number].UDH.Type = UDH_NoUDH;
-		if (udh != NULL && udh_len != 0) {
-			sms->SMS[sms->Number].UDH.Length = udh_len / 2;
-			if (! DecodeHexBin(sms->SMS[sms->Number].UDH.Text, udh, udh_len)) {
-				SMSD_Log(DEBUG_ERROR, Config, "Failed to decode UDH HEX string: %s", udh);
-				return ERR_UNKNOWN;
-			}
-			GSM_DecodeUDHHeader(GSM_GetDI(Config->gsm), &sms->SMS[sms->Number].UDH);
-		}
+/*
+ * Loads message with all its parts using single find_outbox_sms query,
+ * which returns outbox row joined with ordered outbox_multipart rows.
+ */
+static GSM_Error SMSDSQL_FetchOutboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, const char *ID)
+{
+	SQL_result res;
+	struct GSM_SMSDdbobj *db = Config->db;
+	SQL_Var vars[2];
+	GSM_Error error;
+	gboolean last;
+	const char *position;
 
-		sms->SMS[sms->Number].PDU = SMS_Submit;
-		sms->Number++;
+	vars[0].type = SQL_TYPE_STRING;
+	vars[0].v.s = ID;
+	vars[1].type = SQL_TYPE_NONE;
 
-		if (i == 1) {
-			/* Is this a multipart message? */
-			last = !db->GetBool(Config, &res, 7);
-			Config->relativevalidity = (int)db->GetNumber(Config, &res, 8);
-
-			Config->currdeliveryreport = db->GetBool(Config, &res, 9);
-			strncpy(Config->CreatorID, db->GetString(Config, &res, 10), sizeof(Config->CreatorID));
-			Config->CreatorID[sizeof(Config->CreatorID) - 1] = 0;
-			Config->retries = (int)db->GetNumber(Config, &res, 11);
-		}
+	error = SMSDSQL_NamedQuery(Config, Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_SMS], NULL, NULL, vars, &res, FALSE);
+	if (error != ERR_NONE) {
+		SMSD_Log(DEBUG_ERROR, Config, "Error reading from database (%s)", __FUNCTION__);
+		return error;
+	}
+
+	if (db->NextRow(Config, &res) != 1) {
 		db->FreeResult(Config, &res);
-		if (last) {
-			last = FALSE;
+		return ERR_NONE;
+	}
+
+	error = SMSDSQL_DecodeOutboxBody(Config, &res, sms, ID, &last);
+
+	while (error == ERR_NONE && !last && sms->Number < GSM_MAX_MULTI_SMS) {
+		/* Parts have to follow each other, same as with separate queries */
+		position = db->GetString(Config, &res, 20);
+		if (position == NULL || atoi(position) != sms->Number + 1) {
+			break;
+		}
+		error = SMSDSQL_DecodeOutboxPart(Config, &res, sms, ID, 14, 21);
+		if (error != ERR_NONE || db->NextRow(Config, &res) != 1) {
 			break;
 		}
 	}
 
-	return ERR_NONE;
+	db->FreeResult(Config, &res);
+	return error;
 }
 
-/* After sending SMS is moved to Sent Items or Error Items. */
-static GSM_Error SMSDSQL_MoveSMS(GSM_MultiSMSMessage * sms UNUSED, GSM_SMSDConfig * Config, char *ID, gboolean alwaysDelete UNUSED, gboolean sent UNUSED)
+/* Removes processed message from outbox */
+static GSM_Error SMSDSQL_DeleteOutboxSMS(GSM_SMSDConfig * Config, const char *ID)
 {
 	SQL_result res;
 	SQL_Var vars[2];
@@ -1221,7 +1236,8 @@ GSM_Error SMSDSQL_CreateOutboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Co
 	return ERR_NONE;
 }
 
-static GSM_Error SMSDSQL_AddSentSMSInfo(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char *ID, int Part, GSM_SMSDSendingError err, int TPMR)
+/* Stores information about sent message part in the database */
+static GSM_Error SMSDSQL_StoreSentSMSInfo(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, const char *ID, int Part, GSM_SMSDSendingError err, int TPMR)
 {
 	SQL_result res;
 	struct GSM_SMSDdbobj *db = Config->db;
@@ -1310,6 +1326,255 @@ static GSM_Error SMSDSQL_AddSentSMSInfo(GSM_MultiSMSMessage * sms, GSM_SMSDConfi
 	return ERR_NONE;
 }
 
+/* Executes operation stored in the journal */
+static GSM_Error SMSDSQL_ReplayJournal(GSM_SMSDConfig * Config, SMSD_JournalRecord *Record, GSM_MultiSMSMessage * sms)
+{
+	char *locations = NULL;
+	char DT[sizeof(Config->DT)];
+	GSM_Error error;
+
+	switch (Record->Type) {
+		case SMSD_JOURNAL_INBOX:
+			error = SMSDSQL_StoreInboxSMS(sms, Config, &locations);
+			/* RunOnReceive was postponed until message is in database */
+			if (error == ERR_NONE && Config->RunOnReceive != NULL) {
+				SMSD_RunOn(Config->RunOnReceive, sms, Config, locations, "receive");
+			}
+			free(locations);
+			return error;
+		case SMSD_JOURNAL_SENT:
+			/* Insertion time of outbox message is passed in Config */
+			strcpy(DT, Config->DT);
+			strcpy(Config->DT, Record->DT);
+			error = SMSDSQL_StoreSentSMSInfo(sms, Config, Record->ID, Record->Part, Record->Error, Record->TPMR);
+			strcpy(Config->DT, DT);
+			return error;
+		case SMSD_JOURNAL_MOVE:
+			return SMSDSQL_DeleteOutboxSMS(Config, Record->ID);
+	}
+	return ERR_UNKNOWN;
+}
+
+/*
+ * Reconnects to the database if needed and replays the journal. Has to
+ * be done before any journaled operation to keep them in order.
+ */
+static GSM_Error SMSDSQL_Recover(GSM_SMSDConfig * Config)
+{
+	GSM_Error error;
+
+	if (Config->db_attempts > 0) {
+		error = SMSDSQL_Reconnect(Config);
+		if (error != ERR_NONE) {
+			return error;
+		}
+	}
+	if (SMSD_Journal_Pending(Config)) {
+		error = SMSD_Journal_Replay(Config, SMSDSQL_ReplayJournal);
+		if (error == ERR_DB_TIMEOUT) {
+			return error;
+		}
+	}
+	return ERR_NONE;
+}
+
+/* Find one multi SMS to sending and return it (or return ERR_EMPTY)
+ * There is also set ID for SMS
+ */
+static GSM_Error SMSDSQL_FindOutboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char *ID)
+{
+	SQL_result res;
+	struct GSM_SMSDdbobj *db = Config->db;
+	int i;
+	gboolean last = FALSE;
+	time_t timestamp;
+	const char *q;
+	SQL_Var vars[3];
+	GSM_Error error;
+
+	Config->outbox_fetched[0] = 0;
+
+	/* Journaled deletes have to be done before outbox is read again */
+	error = SMSDSQL_Recover(Config);
+	if (error == ERR_NONE && SMSD_Journal_Pending(Config)) {
+		error = ERR_DB_TIMEOUT;
+	}
+	if (error != ERR_NONE) {
+		return error;
+	}
+
+	vars[0].type = SQL_TYPE_INT;
+	vars[0].v.i = 1;
+	vars[1].type = SQL_TYPE_NONE;
+
+	while (TRUE) {
+		error = SMSDSQL_NamedQuery(Config, Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_SMS_ID], NULL, NULL, vars, &res, FALSE);
+		if (error != ERR_NONE) {
+			SMSD_Log(DEBUG_INFO, Config, "Error reading from database (%s)", __FUNCTION__);
+			return error;
+		}
+
+		if (db->NextRow(Config, &res) != 1) {
+			db->FreeResult(Config, &res);
+			return ERR_EMPTY;
+		}
+
+		sprintf(ID, "%ld", (long)db->GetNumber(Config, &res, 0));
+		timestamp = db->GetDate(Config, &res, 1);
+
+		db->FreeResult(Config, &res);
+
+		if (timestamp == -1) {
+			SMSD_Log(DEBUG_INFO, Config, "Invalid date for InsertIntoDB.");
+			return ERR_UNKNOWN;
+		}
+
+		SMSDSQL_Time2String(Config, timestamp, Config->DT, sizeof(Config->DT));
+		if (SMSDSQL_RefreshSendStatus(Config, ID) == ERR_NONE) {
+			break;
+		}
+	}
+
+	sms->Number = 0;
+	for (i = 0; i < GSM_MAX_MULTI_SMS; i++) {
+		GSM_SetDefaultSMSData(&sms->SMS[i]);
+		/* Force using default SMSC */
+		sms->SMS[i].SMSC.Location = 0;
+	}
+
+	if (Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_SMS][0] != 0) {
+		error = SMSDSQL_FetchOutboxSMS(sms, Config, ID);
+		if (error == ERR_NONE) {
+			strcpy(Config->outbox_fetched, ID);
+		}
+		return error;
+	}
+
+	for (i = 1; i < GSM_MAX_MULTI_SMS + 1; i++) {
+		vars[0].type = SQL_TYPE_STRING;
+		vars[0].v.s = ID;
+		vars[1].type = SQL_TYPE_INT;
+		vars[1].v.i = i;
+		vars[2].type = SQL_TYPE_NONE;
+		if (i == 1) {
+			q = Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_BODY];
+		} else {
+			q = Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_MULTIPART];
+		}
+		error = SMSDSQL_NamedQuery(Config, q, NULL, NULL, vars, &res, FALSE);
+		if (error != ERR_NONE) {
+			SMSD_Log(DEBUG_ERROR, Config, "Error reading from database (%s)", __FUNCTION__);
+			return error;
+		}
+
+		if (db->NextRow(Config, &res) != 1) {
+			db->FreeResult(Config, &res);
+			return ERR_NONE;
+		}
+
+		if (i == 1) {
+			error = SMSDSQL_DecodeOutboxBody(Config, &res, sms, ID, &last);
+		} else {
+			error = SMSDSQL_DecodeOutboxPart(Config, &res, sms, ID, 0, 7);
+		}
+		db->FreeResult(Config, &res);
+		if (error != ERR_NONE) {
+			return error;
+		}
+		if (last) {
+			break;
+		}
+	}
+
+	strcpy(Config->outbox_fetched, ID);
+	return ERR_NONE;
+}
+
+/*
+ * Stores operation in the journal if database is not available and
+ * journal is configured, otherwise returns original error.
+ */
+static GSM_Error SMSDSQL_Journal(GSM_SMSDConfig * Config, GSM_Error error, SMSD_JournalRecord *Record, GSM_MultiSMSMessage * sms)
+{
+	if (error != ERR_DB_TIMEOUT || Config->journalpath == NULL) {
+		return error;
+	}
+	Record->Number = (sms == NULL) ? 0 : sms->Number;
+	if (SMSD_Journal_Append(Config, Record, sms) != ERR_NONE) {
+		return error;
+	}
+	return ERR_NONE;
+}
+
+/* Save SMS from phone (called Inbox sms - it's in phone Inbox) somewhere */
+static GSM_Error SMSDSQL_SaveInboxSMS(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char **Locations)
+{
+	SMSD_JournalRecord record;
+	GSM_Error error;
+
+	*Locations = NULL;
+	error = SMSDSQL_Recover(Config);
+	if (error == ERR_NONE) {
+		error = SMSDSQL_StoreInboxSMS(sms, Config, Locations);
+	}
+	if (error == ERR_DB_TIMEOUT) {
+		free(*Locations);
+		*Locations = NULL;
+	}
+
+	if (error != ERR_DB_TIMEOUT) {
+		return error;
+	}
+
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_INBOX;
+	error = SMSDSQL_Journal(Config, error, &record, sms);
+	Config->inbox_journaled = (error == ERR_NONE);
+	return error;
+}
+
+static GSM_Error SMSDSQL_AddSentSMSInfo(GSM_MultiSMSMessage * sms, GSM_SMSDConfig * Config, char *ID, int Part, GSM_SMSDSendingError err, int TPMR)
+{
+	SMSD_JournalRecord record;
+	GSM_Error error;
+
+	error = SMSDSQL_Recover(Config);
+	if (error == ERR_NONE) {
+		error = SMSDSQL_StoreSentSMSInfo(sms, Config, ID, Part, err, TPMR);
+	}
+
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_SENT;
+	strcpy(record.ID, ID);
+	strcpy(record.DT, Config->DT);
+	record.Part = Part;
+	record.Error = err;
+	record.TPMR = TPMR;
+	return SMSDSQL_Journal(Config, error, &record, sms);
+}
+
+/* After sending SMS is moved to Sent Items or Error Items. */
+static GSM_Error SMSDSQL_MoveSMS(GSM_MultiSMSMessage * sms UNUSED, GSM_SMSDConfig * Config, char *ID, gboolean alwaysDelete UNUSED, gboolean sent UNUSED)
+{
+	SMSD_JournalRecord record;
+	GSM_Error error;
+
+	error = SMSDSQL_Recover(Config);
+	if (error == ERR_NONE) {
+		error = SMSDSQL_DeleteOutboxSMS(Config, ID);
+	}
+
+	/* Message which was not read completely stays in outbox */
+	if (strcmp(ID, Config->outbox_fetched) != 0) {
+		return error;
+	}
+
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_MOVE;
+	strcpy(record.ID, ID);
+	return SMSDSQL_Journal(Config, error, &record, NULL);
+}
+
 static GSM_Error SMSDSQL_RefreshPhoneStatus(GSM_SMSDConfig * Config)
 {
 	SQL_result res;
@@ -1333,10 +1598,83 @@ static GSM_Error SMSDSQL_RefreshPhoneStatus(GSM_SMSDConfig * Config)
 	return ERR_NONE;
 }
 
+/*
+ * Checks whether outbox could have changed. Uses driver notifications
+ * when available, otherwise polls cheap change counter at most once per
+ * LoopSleep.
+ */
+static GSM_Error SMSDSQL_OutboxChanged(GSM_SMSDConfig * Config)
+{
+	SQL_result res;
+	SQL_Var vars[1] = {{SQL_TYPE_NONE, {NULL}}};
+	struct GSM_SMSDdbobj *db = Config->db;
+	long long now, id = 0;
+	GSM_Error error;
+
+	/* Reconnect and replay journal in background */
+	if (Config->db_attempts > 0 || SMSD_Journal_Pending(Config)) {
+		if (SMSDSQL_Recover(Config) != ERR_NONE) {
+			return ERR_EMPTY;
+		}
+		/* Outbox could not be checked while disconnected */
+		return ERR_NONE;
+	}
+
+	if (db->OutboxChanged != NULL) {
+		error = db->OutboxChanged(Config);
+		if (error == ERR_DB_TIMEOUT) {
+			SMSDSQL_Reconnect(Config);
+			return ERR_EMPTY;
+		}
+		if (error != ERR_NOTSUPPORTED) {
+			return error;
+		}
+	}
+
+	if (Config->SMSDSQL_queries[SQL_QUERY_OUTBOX_CHANGED][0] == 0) {
+		return ERR_NOTSUPPORTED;
+	}
+
+	now = GSM_GetMonotonicTime();
+	if (now - Config->outbox_lastcheck < 1000 * (long long)(Config->loopsleep > 0 ? Config->loopsleep : 1)) {
+		return ERR_EMPTY;
+	}
+	Config->outbox_lastcheck = now;
+
+	error = SMSDSQL_NamedQuery(Config, Config->SMSDSQL_queries[SQL_QUERY_OUTBOX_CHANGED], NULL, NULL, vars, &res, FALSE);
+	if (error != ERR_NONE) {
+		SMSD_Log(DEBUG_INFO, Config, "Error reading from database (%s)", __FUNCTION__);
+		return error;
+	}
+	if (db->NextRow(Config, &res)) {
+		id = db->GetNumber(Config, &res, 0);
+	}
+	db->FreeResult(Config, &res);
+
+	if (id == Config->outbox_lastid) {
+		return ERR_EMPTY;
+	}
+	Config->outbox_lastid = id;
+	return ERR_NONE;
+}
+
+/*
+ * Returns descriptor on which database notifies about outbox changes.
+ * While reconnecting or replaying the journal, outbox has to be polled.
+ */
+static GSM_Error SMSDSQL_NotifyDescriptor(GSM_SMSDConfig * Config, int *fd)
+{
+	if (Config->db == NULL || Config->db->NotifyDescriptor == NULL ||
+			Config->db_attempts > 0 || SMSD_Journal_Pending(Config)) {
+		return ERR_NOTSUPPORTED;
+	}
+	return Config->db->NotifyDescriptor(Config, fd);
+}
+
 /*
  * better strcat... shows where is the bug
  */
-#define STRCAT_MAX 80
+#define STRCAT_MAX 128
 GSM_Error SMSDSQL_option(GSM_SMSDConfig *Config, int optint, const char *option, ...)
 {
 	size_t len[STRCAT_MAX], to_alloc = 0;
@@ -1654,6 +1992,47 @@ GSM_Error SMSDSQL_ReadConfiguration(GSM_SMSDConfig *Config)
 		return ERR_UNKNOWN;
 	}
 
+	/*
+	 * Customized per part queries would be bypassed by the joined one,
+	 * so use it only when they are not changed or it is set explicitly.
+	 */
+	if (INI_GetValue(Config->smsdcfgfile, "sql", "find_outbox_sms", FALSE) == NULL &&
+			(INI_GetValue(Config->smsdcfgfile, "sql", "find_outbox_body", FALSE) != NULL ||
+			 INI_GetValue(Config->smsdcfgfile, "sql", "find_outbox_multipart", FALSE) != NULL)) {
+		SMSD_Log(DEBUG_NOTICE, Config, "Using customized queries to fetch outbox message parts");
+		Config->SMSDSQL_queries[SQL_QUERY_FIND_OUTBOX_SMS] = strdup("");
+	} else if (SMSDSQL_option(Config, SQL_QUERY_FIND_OUTBOX_SMS, "find_outbox_sms",
+		"SELECT ",
+			"o.", ESCAPE_FIELD("Text"),
+			", o.", ESCAPE_FIELD("Coding"),
+			", o.", ESCAPE_FIELD("UDH"),
+			", o.", ESCAPE_FIELD("Class"),
+			", o.", ESCAPE_FIELD("TextDecoded"),
+			", o.", ESCAPE_FIELD("ID"),
+			", o.", ESCAPE_FIELD("DestinationNumber"),
+			", o.", ESCAPE_FIELD("MultiPart"),
+			", o.", ESCAPE_FIELD("RelativeValidity"),
+			", o.", ESCAPE_FIELD("DeliveryReport"),
+			", o.", ESCAPE_FIELD("CreatorID"),
+			", o.", ESCAPE_FIELD("Retries"),
+			", o.", ESCAPE_FIELD("Status"),
+			", o.", ESCAPE_FIELD("StatusCode"),
+			", m.", ESCAPE_FIELD("Text"),
+			", m.", ESCAPE_FIELD("Coding"),
+			", m.", ESCAPE_FIELD("UDH"),
+			", m.", ESCAPE_FIELD("Class"),
+			", m.", ESCAPE_FIELD("TextDecoded"),
+			", m.", ESCAPE_FIELD("ID"),
+			", m.", ESCAPE_FIELD("SequencePosition"),
+			", m.", ESCAPE_FIELD("Status"),
+			", m.", ESCAPE_FIELD("StatusCode"),
+			" FROM ", Config->table_outbox, " o LEFT JOIN ", Config->table_outbox_multipart, " m ON m.",
+			ESCAPE_FIELD("ID"), " = o.", ESCAPE_FIELD("ID"),
+			" WHERE o.", ESCAPE_FIELD("ID"), "=%1",
+			" ORDER BY m.", ESCAPE_FIELD("SequencePosition"), NULL) != ERR_NONE) {
+		return ERR_UNKNOWN;
+	}
+
 	if (SMSDSQL_option(Config, SQL_QUERY_DELETE_OUTBOX, "delete_outbox",
 		"DELETE FROM ", Config->table_outbox, " WHERE ", ESCAPE_FIELD("ID"), "=%1", NULL) != ERR_NONE) {
 		return ERR_UNKNOWN;
@@ -1768,6 +2147,11 @@ GSM_Error SMSDSQL_ReadConfiguration(GSM_SMSDConfig *Config)
 			" WHERE ", ESCAPE_FIELD("IMEI"), " = %I", NULL) != ERR_NONE) {
 		return ERR_UNKNOWN;
 	}
+
+	if (SMSDSQL_option(Config, SQL_QUERY_OUTBOX_CHANGED, "outbox_changed",
+		"SELECT COALESCE(MAX(", ESCAPE_FIELD("ID"), "), 0) FROM ", Config->table_outbox, NULL) != ERR_NONE) {
+		return ERR_UNKNOWN;
+	}
 #undef ESCAPE_FIELD
 
 	return ERR_NONE;
@@ -1816,7 +2200,9 @@ GSM_SMSDService SMSDSQL = {
 	SMSDSQL_RefreshSendStatus,
 	SMSDSQL_UpdateRetries,
 	SMSDSQL_RefreshPhoneStatus,
-	SMSDSQL_ReadConfiguration
+	SMSDSQL_ReadConfiguration,
+	SMSDSQL_OutboxChanged,
+	SMSDSQL_NotifyDescriptor
 };
 
 /* How should editor hadle tabs in this file? Add editor commands here.
@@ -0,0 +1,566 @@
+/**
+ * Stream SMSD service.
+ *
+ * Received messages and sending results are appended as JSON lines to
+ * a log file or written to a Unix domain socket, all events produced by
+ * one call are written at once. Outgoing messages are queued in the
+ * same way as with FILES service.
+ */
+
+#include <gammu-config.h>
+#include <gammu.h>
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef WIN32
+#include <io.h>
+#define ftruncate _chsize
+#endif
+#ifdef HAVE_SYS_UN_H
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#endif
+
+#include "../core.h"
+#include "files.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/**
+ * How long to wait for socket consumer to accept data (in seconds).
+ */
+#define SMSD_STREAM_TIMEOUT 30
+
+/**
+ * Buffer for events written by one call.
+ */
+typedef struct {
+	char *data;
+	size_t used;
+	size_t size;
+} SMSDStream_Buffer;
+
+static gboolean SMSDStream_Add(SMSDStream_Buffer *buffer, const char *data, size_t len)
+{
+	char *tmp;
+
+	if (buffer->used + len > buffer->size) {
+		tmp = (char *)realloc(buffer->data, buffer->used + len + 1024);
+		if (tmp == NULL) {
+			return FALSE;
+		}
+		buffer->data = tmp;
+		buffer->size = buffer->used + len + 1024;
+	}
+	memcpy(buffer->data + buffer->used, data, len);
+	buffer->used += len;
+	return TRUE;
+}
+
+/**
+ * Adds "key": prefix, separated from previous item unless first is set.
+ */
+static gboolean SMSDStream_AddKey(SMSDStream_Buffer *buffer, const char *key, gboolean first)
+{
+	if (!first && !SMSDStream_Add(buffer, ",", 1)) {
+		return FALSE;
+	}
+	return SMSDStream_Add(buffer, "\"", 1) &&
+		SMSDStream_Add(buffer, key, strlen(key)) &&
+		SMSDStream_Add(buffer, "\":", 2);
+}
+
+/**
+ * Adds JSON string with escaped UTF-8 value.
+ */
+static gboolean SMSDStream_AddString(SMSDStream_Buffer *buffer, const char *key, const char *value)
+{
+	const char *pos;
+	char escaped[7];
+
+	if (!SMSDStream_AddKey(buffer, key, FALSE) || !SMSDStream_Add(buffer, "\"", 1)) {
+		return FALSE;
+	}
+	for (pos = value; *pos != 0; pos++) {
+		if (*pos == '"' || *pos == '\\') {
+			escaped[0] = '\\';
+			escaped[1] = *pos;
+			if (!SMSDStream_Add(buffer, escaped, 2)) {
+				return FALSE;
+			}
+		} else if ((unsigned char)*pos < 0x20) {
+			sprintf(escaped, "\\u%04x", (unsigned char)*pos);
+			if (!SMSDStream_Add(buffer, escaped, 6)) {
+				return FALSE;
+			}
+		} else if (!SMSDStream_Add(buffer, pos, 1)) {
+			return FALSE;
+		}
+	}
+	return SMSDStream_Add(buffer, "\"", 1);
+}
+
+static gboolean SMSDStream_AddUnicode(SMSDStream_Buffer *buffer, const char *key, const unsigned char *value)
+{
+	char text[(GSM_MAX_SMS_LENGTH + 1) * 4];
+
+	EncodeUTF8(text, value);
+	return SMSDStream_AddString(buffer, key, text);
+}
+
+static gboolean SMSDStream_AddInt(SMSDStream_Buffer *buffer, const char *key, int value)
+{
+	char number[20];
+
+	sprintf(number, "%d", value);
+	return SMSDStream_AddKey(buffer, key, FALSE) && SMSDStream_Add(buffer, number, strlen(number));
+}
+
+static gboolean SMSDStream_AddDate(SMSDStream_Buffer *buffer, const char *key, const GSM_DateTime *dt)
+{
+	char date[30];
+	int tz = dt->Timezone;
+	char sign = '+';
+
+	if (tz < 0) {
+		sign = '-';
+		tz = -tz;
+	}
+	sprintf(date, "%04d-%02d-%02dT%02d:%02d:%02d%c%02d:%02d",
+		dt->Year, dt->Month, dt->Day, dt->Hour, dt->Minute, dt->Second,
+		sign, tz / 3600, (tz % 3600) / 60);
+	return SMSDStream_AddString(buffer, key, date);
+}
+
+/**
+ * Starts new event line with common fields.
+ */
+static gboolean SMSDStream_StartEvent(SMSDStream_Buffer *buffer, GSM_SMSDConfig *Config, const char *event)
+{
+	if (!SMSDStream_Add(buffer, "{", 1) || !SMSDStream_AddKey(buffer, "event", TRUE)) {
+		return FALSE;
+	}
+	if (!SMSDStream_Add(buffer, "\"", 1) || !SMSDStream_Add(buffer, event, strlen(event)) || !SMSDStream_Add(buffer, "\"", 1)) {
+		return FALSE;
+	}
+	return Config->PhoneID == NULL || Config->PhoneID[0] == 0 ||
+		SMSDStream_AddString(buffer, "phone", Config->PhoneID);
+}
+
+static gboolean SMSDStream_EndEvent(SMSDStream_Buffer *buffer)
+{
+	return SMSDStream_Add(buffer, "}\n", 2);
+}
+
+static void SMSDStream_Close(GSM_SMSDConfig *Config)
+{
+	if (Config->streamfd != -1) {
+		close(Config->streamfd);
+		Config->streamfd = -1;
+	}
+}
+
+static GSM_Error SMSDStream_Connect(GSM_SMSDConfig *Config)
+{
+#ifdef HAVE_SYS_UN_H
+	struct sockaddr_un addr;
+	struct timeval timeout;
+
+	if (strlen(Config->streamsocket) >= sizeof(addr.sun_path)) {
+		SMSD_Log(DEBUG_ERROR, Config, "Socket path %s is too long", Config->streamsocket);
+		return ERR_INVALIDDATA;
+	}
+
+	Config->streamfd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Config->streamfd == -1) {
+		SMSD_LogErrno(Config, "Can not create socket");
+		return ERR_DEVICEOPENERROR;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, Config->streamsocket);
+	if (connect(Config->streamfd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+		SMSD_LogErrno(Config, "Can not connect to stream socket");
+		SMSDStream_Close(Config);
+		return ERR_DEVICEOPENERROR;
+	}
+
+	/* Slow consumer makes us keep messages in the phone for a while */
+	timeout.tv_sec = SMSD_STREAM_TIMEOUT;
+	timeout.tv_usec = 0;
+	setsockopt(Config->streamfd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+	SMSD_Log(DEBUG_INFO, Config, "Connected to stream socket %s", Config->streamsocket);
+	return ERR_NONE;
+#else
+	SMSD_Log(DEBUG_ERROR, Config, "Streaming to socket is not supported on this platform!");
+	return ERR_NOTSUPPORTED;
+#endif
+}
+
+/**
+ * Removes incomplete line left at end of log when SMSD was terminated
+ * while writing it.
+ */
+static void SMSDStream_Repair(GSM_SMSDConfig *Config)
+{
+	char block[1024];
+	off_t end, pos;
+	long ret;
+	int i;
+
+	end = lseek(Config->streamfd, 0, SEEK_END);
+	pos = end;
+	while (pos > 0) {
+		ret = MIN(pos, (off_t)sizeof(block));
+		pos -= ret;
+		if (lseek(Config->streamfd, pos, SEEK_SET) != pos ||
+				read(Config->streamfd, block, ret) != ret) {
+			SMSD_LogErrno(Config, "Can not read stream log");
+			return;
+		}
+		for (i = ret - 1; i >= 0; i--) {
+			if (block[i] == '\n') {
+				break;
+			}
+		}
+		if (i >= 0) {
+			pos += i + 1;
+			break;
+		}
+	}
+	if (pos == end) {
+		return;
+	}
+	SMSD_Log(DEBUG_ERROR, Config, "Removing incomplete event from end of stream log");
+	if (ftruncate(Config->streamfd, pos) != 0) {
+		SMSD_LogErrno(Config, "Can not remove incomplete events from stream log");
+	}
+}
+
+static GSM_Error SMSDStream_Open(GSM_SMSDConfig *Config)
+{
+	Config->streamfd = open(Config->streampath, O_RDWR | O_APPEND | O_CREAT | O_BINARY, 0644);
+	if (Config->streamfd == -1) {
+		SMSD_LogErrno(Config, "Can not open stream log");
+		return ERR_CANTOPENFILE;
+	}
+	SMSDStream_Repair(Config);
+	return ERR_NONE;
+}
+
+/**
+ * Moves current log to new segment if it would grow over configured
+ * size by writing len bytes.
+ */
+static GSM_Error SMSDStream_Rotate(GSM_SMSDConfig *Config, size_t len)
+{
+	struct stat st;
+	char *segment;
+
+	if (Config->streamsegmentsize <= 0 || fstat(Config->streamfd, &st) != 0) {
+		return ERR_NONE;
+	}
+	if (st.st_size == 0 || st.st_size + (long)len <= Config->streamsegmentsize) {
+		return ERR_NONE;
+	}
+
+	segment = (char *)malloc(strlen(Config->streampath) + 20);
+	if (segment == NULL) {
+		return ERR_MOREMEMORY;
+	}
+
+	/* Find first free segment number */
+	do {
+		Config->streamsegment++;
+		sprintf(segment, "%s.%d", Config->streampath, Config->streamsegment);
+	} while (stat(segment, &st) == 0);
+
+	SMSDStream_Close(Config);
+	if (rename(Config->streampath, segment) != 0) {
+		SMSD_LogErrno(Config, "Can not rotate stream log");
+	} else {
+		SMSD_Log(DEBUG_INFO, Config, "Stream log rotated to %s", segment);
+	}
+	free(segment);
+
+	return SMSDStream_Open(Config);
+}
+
+/**
+ * Writes whole buffer to opened stream.
+ */
+static GSM_Error SMSDStream_Send(GSM_SMSDConfig *Config, SMSDStream_Buffer *buffer)
+{
+	size_t pos = 0;
+	long ret;
+
+	while (pos < buffer->used) {
+#ifdef HAVE_SYS_UN_H
+		if (Config->streamsocket != NULL) {
+			ret = send(Config->streamfd, buffer->data + pos, buffer->used - pos, MSG_NOSIGNAL);
+		} else
+#endif
+		{
+			ret = write(Config->streamfd, buffer->data + pos, buffer->used - pos);
+		}
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ret <= 0) {
+			SMSD_LogErrno(Config, "Can not write events to stream");
+			return ERR_WRITING_FILE;
+		}
+		pos += ret;
+	}
+	return ERR_NONE;
+}
+
+/**
+ * Appends buffered events to log. Events which were written only
+ * partially are removed, so that log contains only complete lines.
+ */
+static GSM_Error SMSDStream_WriteFile(GSM_SMSDConfig *Config, SMSDStream_Buffer *buffer)
+{
+	GSM_Error error;
+	off_t start;
+
+	if (Config->streamfd == -1) {
+		error = SMSDStream_Open(Config);
+		if (error != ERR_NONE) {
+			return error;
+		}
+	}
+
+	error = SMSDStream_Rotate(Config, buffer->used);
+	if (error != ERR_NONE) {
+		return error;
+	}
+
+	start = lseek(Config->streamfd, 0, SEEK_END);
+	error = SMSDStream_Send(Config, buffer);
+	if (error != ERR_NONE) {
+		if (start == -1 || ftruncate(Config->streamfd, start) != 0) {
+			SMSD_LogErrno(Config, "Can not remove incomplete events from stream log");
+		}
+		SMSDStream_Close(Config);
+	}
+	return error;
+}
+
+/**
+ * Writes buffered events to socket. On failure the events are written
+ * once more to new connection, consumer has to discard incomplete line
+ * received on the failed one.
+ */
+static GSM_Error SMSDStream_WriteSocket(GSM_SMSDConfig *Config, SMSDStream_Buffer *buffer)
+{
+	GSM_Error error = ERR_NONE;
+	int attempt;
+
+	for (attempt = 0; attempt < 2; attempt++) {
+		if (Config->streamfd == -1) {
+			error = SMSDStream_Connect(Config);
+			if (error != ERR_NONE) {
+				return error;
+			}
+		}
+		error = SMSDStream_Send(Config, buffer);
+		if (error == ERR_NONE) {
+			return ERR_NONE;
+		}
+		SMSDStream_Close(Config);
+	}
+	return error;
+}
+
+/**
+ * Writes buffered events. On failure stream is closed and reopened with
+ * next write.
+ */
+static GSM_Error SMSDStream_Write(GSM_SMSDConfig *Config, SMSDStream_Buffer *buffer)
+{
+	if (Config->streamsocket != NULL) {
+		return SMSDStream_WriteSocket(Config, buffer);
+	}
+	return SMSDStream_WriteFile(Config, buffer);
+}
+
+static GSM_Error SMSDStream_SaveInboxSMS(GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, char **Locations UNUSED)
+{
+	SMSDStream_Buffer buffer = {NULL, 0, 0};
+	GSM_SMSMessage *msg;
+	GSM_Error error;
+	char data[(GSM_MAX_SMS_LENGTH + 1) * 4];
+	gboolean ok = TRUE;
+	int i;
+
+	for (i = 0; ok && i < sms->Number; i++) {
+		msg = &sms->SMS[i];
+		ok = SMSDStream_StartEvent(&buffer, Config, msg->PDU == SMS_Status_Report ? "report" : "received") &&
+			SMSDStream_AddUnicode(&buffer, "number", msg->Number) &&
+			SMSDStream_AddUnicode(&buffer, "smsc", msg->SMSC.Number) &&
+			SMSDStream_AddDate(&buffer, "date", &msg->DateTime) &&
+			SMSDStream_AddInt(&buffer, "part", i + 1) &&
+			SMSDStream_AddInt(&buffer, "parts", sms->Number) &&
+			SMSDStream_AddString(&buffer, "coding", GSM_SMSCodingToString(msg->Coding)) &&
+			SMSDStream_AddInt(&buffer, "class", msg->Class);
+		if (ok && msg->UDH.Type != UDH_NoUDH) {
+			EncodeHexBin(data, msg->UDH.Text, msg->UDH.Length);
+			ok = SMSDStream_AddString(&buffer, "udh", data);
+		}
+		if (ok && msg->PDU == SMS_Status_Report) {
+			ok = SMSDStream_AddInt(&buffer, "reference", msg->MessageReference) &&
+				SMSDStream_AddInt(&buffer, "status", msg->DeliveryStatus);
+		}
+		if (ok && msg->Coding == SMS_Coding_8bit) {
+			EncodeHexBin(data, msg->Text, msg->Length);
+			ok = SMSDStream_AddString(&buffer, "data", data);
+		} else if (ok) {
+			ok = SMSDStream_AddUnicode(&buffer, "text", msg->Text);
+		}
+		ok = ok && SMSDStream_EndEvent(&buffer);
+	}
+
+	if (!ok) {
+		free(buffer.data);
+		return ERR_MOREMEMORY;
+	}
+
+	error = SMSDStream_Write(Config, &buffer);
+	free(buffer.data);
+	if (error == ERR_NONE) {
+		SMSD_Log(DEBUG_INFO, Config, "Streamed %d message parts from %s", sms->Number, DecodeUnicodeString(sms->SMS[0].Number));
+	}
+	return error;
+}
+
+static GSM_Error SMSDStream_AddSentSMSInfo(GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, char *ID, int Part, GSM_SMSDSendingError err, int TPMR)
+{
+	SMSDStream_Buffer buffer = {NULL, 0, 0};
+	GSM_Error error;
+	const char *status;
+	gboolean ok;
+
+	error = SMSDFiles.AddSentSMSInfo(sms, Config, ID, Part, err, TPMR);
+	if (error != ERR_NONE) {
+		return error;
+	}
+
+	switch (err) {
+		case SMSD_SEND_OK:
+			status = "SendingOK";
+			break;
+		case SMSD_SEND_SENDING_ERROR:
+			status = "SendingError";
+			break;
+		default:
+			status = "Error";
+			break;
+	}
+
+	ok = SMSDStream_StartEvent(&buffer, Config, "sent") &&
+		SMSDStream_AddString(&buffer, "id", ID) &&
+		SMSDStream_AddUnicode(&buffer, "number", sms->SMS[Part - 1].Number) &&
+		SMSDStream_AddInt(&buffer, "part", Part) &&
+		SMSDStream_AddInt(&buffer, "parts", sms->Number) &&
+		SMSDStream_AddString(&buffer, "status", status) &&
+		SMSDStream_AddInt(&buffer, "reference", TPMR) &&
+		SMSDStream_EndEvent(&buffer);
+	if (!ok) {
+		free(buffer.data);
+		return ERR_MOREMEMORY;
+	}
+
+	error = SMSDStream_Write(Config, &buffer);
+	free(buffer.data);
+	return error;
+}
+
+static GSM_Error SMSDStream_Free(GSM_SMSDConfig *Config)
+{
+	SMSDStream_Close(Config);
+	return SMSDFiles.Free(Config);
+}
+
+static GSM_Error SMSDStream_FindOutboxSMS(GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, char *ID)
+{
+	return SMSDFiles.FindOutboxSMS(sms, Config, ID);
+}
+
+static GSM_Error SMSDStream_MoveSMS(GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, char *ID, gboolean alwaysDelete, gboolean sent)
+{
+	return SMSDFiles.MoveSMS(sms, Config, ID, alwaysDelete, sent);
+}
+
+static GSM_Error SMSDStream_CreateOutboxSMS(GSM_MultiSMSMessage *sms, GSM_SMSDConfig *Config, char *NewID)
+{
+	return SMSDFiles.CreateOutboxSMS(sms, Config, NewID);
+}
+
+static GSM_Error SMSDStream_OutboxChanged(GSM_SMSDConfig *Config)
+{
+	return SMSDFiles.OutboxChanged(Config);
+}
+
+static GSM_Error SMSDStream_NotifyDescriptor(GSM_SMSDConfig *Config, int *fd)
+{
+	return SMSDFiles.NotifyDescriptor(Config, fd);
+}
+
+static GSM_Error SMSDStream_ReadConfiguration(GSM_SMSDConfig *Config)
+{
+	Config->streampath = INI_GetValue(Config->smsdcfgfile, "smsd", "streampath", FALSE);
+	Config->streamsocket = INI_GetValue(Config->smsdcfgfile, "smsd", "streamsocket", FALSE);
+	if (Config->streampath == NULL && Config->streamsocket == NULL) {
+		SMSD_Log(DEBUG_ERROR, Config, "No StreamPath or StreamSocket configured!");
+		return ERR_UNCONFIGURED;
+	}
+	if (Config->streamsocket != NULL) {
+		SMSD_Log(DEBUG_NOTICE, Config, "Streaming events to socket \"%s\"", Config->streamsocket);
+	} else {
+		Config->streamsegmentsize = INI_GetInt(Config->smsdcfgfile, "smsd", "streamsegmentsize", 0);
+		SMSD_Log(DEBUG_NOTICE, Config, "Streaming events to \"%s\"", Config->streampath);
+	}
+
+	/* Outgoing messages are handled by FILES service */
+	return SMSDFiles.ReadConfiguration(Config);
+}
+
+GSM_SMSDService SMSDStream = {
+	NONEFUNCTION,		/* Init                 */
+	SMSDStream_Free,
+	NONEFUNCTION,		/* InitAfterConnect     */
+	SMSDStream_SaveInboxSMS,
+	SMSDStream_FindOutboxSMS,
+	SMSDStream_MoveSMS,
+	SMSDStream_CreateOutboxSMS,
+	SMSDStream_AddSentSMSInfo,
+	NOTIMPLEMENTED,		/* UpdateRetries        */
+	NOTIMPLEMENTED,		/* RefreshSendStatus    */
+	NOTIMPLEMENTED,		/* RefreshPhoneStatus   */
+	SMSDStream_ReadConfiguration,
+	SMSDStream_OutboxChanged,
+	SMSDStream_NotifyDescriptor
+};
+
+/* How should editor handle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
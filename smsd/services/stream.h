@@ -0,0 +1,11 @@
+/**
+ * Stream SMSD service.
+ *
+ * This service appends events to a log file or a socket.
+ */
+
+extern GSM_SMSDService SMSDStream;
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
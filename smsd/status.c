@@ -0,0 +1,65 @@
+/**
+ * SMSD status shared with monitoring programs
+ *
+ * The status block is protected by sequence lock. The daemon is the
+ * only writer and makes the sequence odd while updating, readers copy
+ * the whole block and retry when the sequence was odd or has changed
+ * meanwhile. Readers therefore never block the daemon.
+ */
+#include <gammu-config.h>
+
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "status.h"
+
+/**
+ * Prevents reordering of memory accesses by compiler and CPU.
+ */
+static void SMSD_Status_Barrier(void)
+{
+#if defined(__GNUC__)
+	__sync_synchronize();
+#elif defined(WIN32)
+	MemoryBarrier();
+#endif
+}
+
+void SMSD_Status_BeginUpdate(GSM_SMSDStatus *Status)
+{
+	if (Status == NULL) {
+		return;
+	}
+	((volatile GSM_SMSDStatus *)Status)->Sequence++;
+	SMSD_Status_Barrier();
+}
+
+void SMSD_Status_EndUpdate(GSM_SMSDStatus *Status)
+{
+	if (Status == NULL) {
+		return;
+	}
+	SMSD_Status_Barrier();
+	((volatile GSM_SMSDStatus *)Status)->Sequence++;
+}
+
+gboolean SMSD_Status_Read(const GSM_SMSDStatus *Status, GSM_SMSDStatus *Copy)
+{
+	unsigned int start;
+
+	start = ((const volatile GSM_SMSDStatus *)Status)->Sequence;
+	if (start & 1) {
+		return FALSE;
+	}
+	SMSD_Status_Barrier();
+	memcpy(Copy, Status, sizeof(GSM_SMSDStatus));
+	SMSD_Status_Barrier();
+	return ((const volatile GSM_SMSDStatus *)Status)->Sequence == start;
+}
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
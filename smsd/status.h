@@ -0,0 +1,31 @@
+/**
+ * SMSD status shared with monitoring programs
+ */
+#ifndef __smsd_status_h__
+#define __smsd_status_h__
+
+#include <gammu-smsd.h>
+
+/**
+ * Marks start of status update. Readers retry until the update is
+ * finished by SMSD_Status_EndUpdate. Does nothing without status.
+ */
+void SMSD_Status_BeginUpdate(GSM_SMSDStatus *Status);
+
+/**
+ * Marks end of status update started by SMSD_Status_BeginUpdate.
+ */
+void SMSD_Status_EndUpdate(GSM_SMSDStatus *Status);
+
+/**
+ * Copies status if it is not being updated meanwhile.
+ *
+ * \return TRUE if copy is consistent, FALSE if it should be retried.
+ */
+gboolean SMSD_Status_Read(const GSM_SMSDStatus *Status, GSM_SMSDStatus *Copy);
+
+#endif
+
+/* How should editor hadle tabs in this file? Add editor commands here.
+ * vim: noexpandtab sw=8 ts=8 sts=8:
+ */
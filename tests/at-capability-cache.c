@@ -0,0 +1,150 @@
+/* Test for caching of AT phone capabilities */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "fake-modem.h"
+
+/* Replies of fake modem, anything else is answered by ERROR */
+static const char *replies[][2] = {
+	{"AT", ""},
+	{"ATE1", ""},
+	{"AT+CMEE=1", ""},
+	{"AT+CSCS?", "+CSCS: \"GSM\"\r\n"},
+	{"AT+CSCS=?", "+CSCS: (\"GSM\",\"UCS2\",\"IRA\")\r\n"},
+	{"AT+CSCS=\"GSM\"", ""},
+	{"AT+CSCS=\"IRA\"", ""},
+	{"AT+CGMM", "E1750\r\n"},
+	{"AT+CGMI", "huawei\r\n"},
+	{"AT+CGSN", "123456789012345\r\n"},
+	{"AT+CGMR", NULL},
+	{"AT+CHUP=?", ""},
+	{NULL, NULL},
+};
+
+static char firmware[50];
+static int commands, probes;
+
+static void fake_reply(const char *cmd)
+{
+	const char *body = NULL;
+	gboolean ok = FALSE;
+	int i;
+
+	commands++;
+	if (strcmp(cmd, "AT+CPROT=?") == 0 ||
+			strcmp(cmd, "AT+SYNCML=?") == 0 ||
+			strcmp(cmd, "AT$TSSPCSW=?") == 0 ||
+			strcmp(cmd, "AT+CHUP=?") == 0 ||
+			strcmp(cmd, "AT+CSCS=?") == 0) {
+		probes++;
+	}
+
+	for (i = 0; replies[i][0] != NULL; i++) {
+		if (strcmp(cmd, replies[i][0]) == 0) {
+			body = replies[i][1] == NULL ? firmware : replies[i][1];
+			ok = TRUE;
+			break;
+		}
+	}
+
+	fake_modem_printf("%s\r\n%s%s\r\n", cmd, ok ? body : "", ok ? "OK" : "ERROR");
+}
+
+static void connect_phone(GSM_StateMachine *s)
+{
+	commands = probes = 0;
+	fake_modem_connect(s);
+}
+
+int main(int argc, char **argv)
+{
+	GSM_Debug_Info *debug_info;
+	GSM_StateMachine *s;
+	GSM_Config *cfg;
+	int full_commands;
+
+	/* Check parameters */
+	if (argc != 2) {
+		printf("Not enough parameters!\nUsage: at-capability-cache cache.ini\n");
+		return 1;
+	}
+	remove(argv[1]);
+
+	debug_info = GSM_GetGlobalDebug();
+	GSM_SetDebugFileDescriptor(stderr, FALSE, debug_info);
+	GSM_SetDebugLevel("textall", debug_info);
+
+	/* Allocates state machine */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+	debug_info = GSM_GetDebug(s);
+	GSM_SetDebugGlobal(TRUE, debug_info);
+
+	cfg = GSM_GetConfig(s, 0);
+	cfg->CapabilityCache = strdup(argv[1]);
+	cfg->CNMIParams[0] = cfg->CNMIParams[1] = cfg->CNMIParams[2] = -1;
+	cfg->CNMIParams[3] = cfg->CNMIParams[4] = -1;
+	GSM_SetConfigNum(s, 1);
+
+	fake_modem_init_at(s, fake_reply);
+	s->Protocol.Functions = &ATProtocol;
+	s->Phone.Functions = &ATGENPhone;
+	s->ConnectionType = GCT_BLUEAT;
+	s->ReplyNum = 1;
+	s->opened = TRUE;
+
+	strcpy(firmware, "11.608\r\n");
+
+	/* Full probing stores cache */
+	connect_phone(s);
+	test_result(probes == 5);
+	test_result(strcmp(s->Phone.Data.Model, "E1750") == 0);
+	test_result(s->Phone.Data.Priv.ATGEN.HasCHUP);
+	fake_modem_disconnect(s);
+	full_commands = commands;
+
+	/* Same phone uses cache */
+	connect_phone(s);
+	test_result(probes == 0);
+	test_result(commands < full_commands);
+	test_result(strcmp(s->Phone.Data.Model, "E1750") == 0);
+	test_result(strcmp(s->Phone.Data.Manufacturer, "Huawei") == 0);
+	test_result(strcmp(s->Phone.Data.IMEI, "123456789012345") == 0);
+	test_result(s->Phone.Data.Priv.ATGEN.HasCHUP);
+	test_result(s->Phone.Data.Priv.ATGEN.CMEEMode == 1);
+	test_result(s->Phone.Data.Priv.ATGEN.NormalCharset != 0);
+	fake_modem_disconnect(s);
+
+	/* Firmware upgrade invalidates cache */
+	strcpy(firmware, "11.609\r\n");
+	connect_phone(s);
+	test_result(probes == 5);
+	fake_modem_disconnect(s);
+
+	/* Changed configuration invalidates cache */
+	cfg->PhoneFeatures[0] = F_SMS_SM;
+	cfg->PhoneFeatures[1] = 0;
+	connect_phone(s);
+	test_result(probes == 5);
+	fake_modem_disconnect(s);
+
+	/* And cache was updated */
+	connect_phone(s);
+	test_result(probes == 0);
+	fake_modem_disconnect(s);
+
+	remove(argv[1]);
+
+	/* Free state machine */
+	s->opened = FALSE;
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,98 @@
+/* Test for parsing AT+CMGD=? reply on AT driver */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "../libgammu/phone/at/atgen.h"
+#include "../libgammu/protocol/protocol.h"	/* Needed for GSM_Protocol_Message */
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+#include "../libgammu/gsmphones.h"	/* Phone data */
+
+#define BUFFER_SIZE 1024
+
+extern GSM_Error ATGEN_ReplyCheckCMGD(GSM_Protocol_Message *msg, GSM_StateMachine * s);
+
+typedef struct {
+	const char *reply;
+	GSM_AT_Feature expected;
+} CMGDTest;
+
+static const CMGDTest tests[] = {
+	{"AT+CMGD=?\r\n+CMGD: (1-20),(0-4)\r\nOK\r\n", AT_AVAILABLE},
+	{"AT+CMGD=?\r\n+CMGD: (0,1,3,5),(0,1,2,3,4)\r\nOK\r\n", AT_AVAILABLE},
+	{"AT+CMGD=?\r\n+CMGD: (),(1-4)\r\nOK\r\n", AT_AVAILABLE},
+	{"AT+CMGD=?\r\n+CMGD: (1-20),(0)\r\nOK\r\n", AT_NOTAVAILABLE},
+	{"AT+CMGD=?\r\n+CMGD: (2-4,6),(2-4)\r\nOK\r\n", AT_NOTAVAILABLE},
+	{"AT+CMGD=?\r\n+CMGD: (1-20)\r\nOK\r\n", AT_NOTAVAILABLE},
+	{"AT+CMGD=?\r\nOK\r\n", AT_NOTAVAILABLE},
+	{NULL, 0}
+};
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Debug_Info *debug_info;
+	GSM_Phone_ATGENData *Priv;
+	GSM_Phone_Data *Data;
+	unsigned char buffer[BUFFER_SIZE];
+	GSM_StateMachine *s;
+	GSM_Protocol_Message msg;
+	GSM_Error error;
+	int i;
+
+	/* Configure state machine */
+	debug_info = GSM_GetGlobalDebug();
+	GSM_SetDebugFileDescriptor(stderr, FALSE, debug_info);
+	GSM_SetDebugLevel("textall", debug_info);
+
+	/* Allocates state machine */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+	debug_info = GSM_GetDebug(s);
+	GSM_SetDebugGlobal(TRUE, debug_info);
+
+	/* Initialize AT engine */
+	Data = &s->Phone.Data;
+	Data->ModelInfo = GetModelData(NULL, NULL, "unknown", NULL);
+	Priv = &s->Phone.Data.Priv.ATGEN;
+	Priv->SMSMode = SMS_AT_PDU;
+	Priv->Charset = AT_CHARSET_GSM;
+
+	for (i = 0; tests[i].reply != NULL; i++) {
+		strcpy(buffer, tests[i].reply);
+
+		/* Init message */
+		msg.Type = 0;
+		msg.Length = strlen(buffer);
+		msg.Buffer = buffer;
+		SplitLines(msg.Buffer, msg.Length, &Priv->Lines, "\x0D\x0A", 2, "\"", 1, TRUE);
+
+		/* Parse it */
+		Priv->ReplyState = AT_Reply_OK;
+		Priv->CMGDFlag = 0;
+		error = ATGEN_ReplyCheckCMGD(&msg, s);
+		gammu_test_result(error, "ATGEN_ReplyCheckCMGD");
+		test_result(Priv->CMGDFlag == tests[i].expected);
+	}
+
+	/* Error means flags are not known to work */
+	Priv->ReplyState = AT_Reply_Error;
+	Priv->CMGDFlag = 0;
+	error = ATGEN_ReplyCheckCMGD(&msg, s);
+	test_result(error == ERR_NOTSUPPORTED);
+	test_result(Priv->CMGDFlag == AT_NOTAVAILABLE);
+
+	/* This is normally done by ATGEN_Terminate */
+	FreeLines(&Priv->Lines);
+	GetLineString(NULL, NULL, 0);
+
+	/* Free state machine */
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,209 @@
+/* Test for compound AT queries */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "fake-modem.h"
+
+/* Replies of fake modem, anything else is answered by ERROR */
+static const char *replies[][2] = {
+	{"AT", ""},
+	{"ATE1", ""},
+	{"AT+CMEE=1", ""},
+	{"AT+CSCS?", "+CSCS: \"GSM\"\r\n"},
+	{"AT+CSCS=?", "+CSCS: (\"GSM\",\"UCS2\",\"IRA\")\r\n"},
+	{"AT+CSCS=\"GSM\"", ""},
+	{"AT+CSCS=\"IRA\"", ""},
+	{"AT+CGMM", "E1750\r\n"},
+	{"AT+CGMI", "huawei\r\n"},
+	{"AT+CGSN", "123456789012345\r\n"},
+	{"AT+CGMR", "11.608\r\n"},
+	{"AT+CBC", "+CBC: 0,80\r\n"},
+	{"AT+CSQ", "+CSQ: 20,99\r\n"},
+	{"AT+CREG=2", ""},
+	{"AT+CGREG=2", ""},
+	{"AT+CGATT?", "+CGATT: 1\r\n"},
+	{"AT+CREG?", "+CREG: 2,1,\"00C3\",\"A1B2\"\r\n"},
+	{"AT+CGREG?", "+CGREG: 2,1,\"00C3\",\"A1B2\"\r\n"},
+	{"AT+COPS=3,2", ""},
+	{"AT+COPS=3,0", ""},
+	{"AT+COPS?", "+COPS: 0,2,\"23002\"\r\n"},
+	{NULL, NULL},
+};
+
+static gboolean accept_compound;
+static const char *fail_query;
+static int commands, compounds;
+
+static const char *find_reply(const char *cmd)
+{
+	int i;
+
+	if (fail_query != NULL && strcmp(cmd, fail_query) == 0) {
+		return NULL;
+	}
+	for (i = 0; replies[i][0] != NULL; i++) {
+		if (strcmp(cmd, replies[i][0]) == 0) {
+			return replies[i][1];
+		}
+	}
+	return NULL;
+}
+
+static void fake_reply(const char *cmd)
+{
+	char query[200];
+	const char *body, *pos, *end;
+	gboolean ok = TRUE;
+
+	commands++;
+	fake_modem_printf("%s\r\n", cmd);
+
+	if (strchr(cmd, ';') == NULL) {
+		body = find_reply(cmd);
+		ok = (body != NULL);
+		if (ok) {
+			fake_modem_printf("%s", body);
+		}
+	} else {
+		compounds++;
+		ok = accept_compound;
+		/* Execute queries until first failure */
+		for (pos = cmd + 2; ok && *pos != 0; pos = (*end == ';') ? end + 1 : end) {
+			end = strchr(pos, ';');
+			if (end == NULL) {
+				end = pos + strlen(pos);
+			}
+			sprintf(query, "AT%.*s", (int)(end - pos), pos);
+			body = find_reply(query);
+			ok = (body != NULL);
+			if (ok) {
+				fake_modem_printf("%s", body);
+			}
+		}
+	}
+
+	fake_modem_printf("%s\r\n", ok ? "OK" : "ERROR");
+}
+
+static void check_status(GSM_StateMachine *s, int expected_commands, int expected_compounds)
+{
+	GSM_PhoneStatus status;
+	GSM_Error error;
+
+	commands = compounds = 0;
+	error = GSM_GetPhoneStatus(s, &status, TRUE, TRUE, TRUE);
+	gammu_test_result(error, "GSM_GetPhoneStatus");
+	test_result(commands == expected_commands);
+	test_result(compounds == expected_compounds);
+
+	gammu_test_result(status.BatteryChargeError, "Battery charge");
+	test_result(status.BatteryCharge.BatteryPercent == 80);
+	gammu_test_result(status.SignalQualityError, "Signal quality");
+	test_result(status.SignalQuality.SignalStrength == 2 * 20 - 113);
+	gammu_test_result(status.NetworkInfoError, "Network info");
+	test_result(status.NetworkInfo.State == GSM_HomeNetwork);
+	test_result(status.NetworkInfo.PacketState == GSM_HomeNetwork);
+	test_result(status.NetworkInfo.GPRS == GSM_GPRS_Attached);
+	test_result(strcmp(status.NetworkInfo.LAC, "00C3") == 0);
+	test_result(strcmp(status.NetworkInfo.CID, "A1B2") == 0);
+	test_result(strcmp(status.NetworkInfo.NetworkCode, "230 02") == 0);
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Debug_Info *debug_info;
+	GSM_StateMachine *s;
+	GSM_Config *cfg;
+	GSM_SignalQuality signal;
+	GSM_PhoneStatus status;
+	GSM_Error error;
+
+	debug_info = GSM_GetGlobalDebug();
+	GSM_SetDebugFileDescriptor(stderr, FALSE, debug_info);
+	GSM_SetDebugLevel("textall", debug_info);
+
+	/* Allocates state machine */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+	debug_info = GSM_GetDebug(s);
+	GSM_SetDebugGlobal(TRUE, debug_info);
+
+	cfg = GSM_GetConfig(s, 0);
+	cfg->CNMIParams[0] = cfg->CNMIParams[1] = cfg->CNMIParams[2] = -1;
+	cfg->CNMIParams[3] = cfg->CNMIParams[4] = -1;
+	GSM_SetConfigNum(s, 1);
+
+	fake_modem_init_at(s, fake_reply);
+	s->Protocol.Functions = &ATProtocol;
+	s->Phone.Functions = &ATGENPhone;
+	s->ConnectionType = GCT_BLUEAT;
+	s->ReplyNum = 1;
+	s->opened = TRUE;
+
+	/* Queries are sent on single line: CREG=2, CGREG=2, compound, 4 times COPS */
+	accept_compound = TRUE;
+	fake_modem_connect(s);
+	check_status(s, 7, 1);
+	check_status(s, 7, 1);
+
+	/* Single query is sent as is */
+	commands = compounds = 0;
+	error = GSM_GetSignalQuality(s, &signal);
+	gammu_test_result(error, "GSM_GetSignalQuality");
+	test_result(commands == 1 && compounds == 0);
+	fake_modem_disconnect(s);
+
+	/* Failed compound command falls back to separate queries */
+	accept_compound = FALSE;
+	fake_modem_connect(s);
+	check_status(s, 2 + 1 + 5 + 4, 1);
+	/* And compound command is not tried again */
+	check_status(s, 2 + 5 + 4, 0);
+	fake_modem_disconnect(s);
+
+	/* Failed query does not disable compound commands */
+	accept_compound = TRUE;
+	fake_modem_connect(s);
+	fail_query = "AT+CSQ";
+	commands = compounds = 0;
+	error = GSM_GetPhoneStatus(s, &status, TRUE, TRUE, FALSE);
+	gammu_test_result(error, "GSM_GetPhoneStatus");
+	test_result(compounds == 1);
+	gammu_test_result(status.BatteryChargeError, "Battery charge");
+	test_result(status.SignalQualityError != ERR_NONE);
+	test_result(!s->Phone.Data.Priv.ATGEN.NoCompound);
+
+	/* Neither does failure of first query */
+	fail_query = "AT+CBC";
+	commands = compounds = 0;
+	error = GSM_GetPhoneStatus(s, &status, TRUE, TRUE, FALSE);
+	gammu_test_result(error, "GSM_GetPhoneStatus");
+	test_result(compounds == 1);
+	test_result(status.BatteryChargeError != ERR_NONE);
+	gammu_test_result(status.SignalQualityError, "Signal quality");
+	test_result(!s->Phone.Data.Priv.ATGEN.NoCompound);
+
+	fail_query = NULL;
+	check_status(s, 7, 1);
+	fake_modem_disconnect(s);
+
+	/* Compound commands can be disabled for model */
+	accept_compound = TRUE;
+	fake_modem_connect(s);
+	GSM_AddPhoneFeature(s->Phone.Data.ModelInfo, F_NO_ATCOMPOUND);
+	check_status(s, 2 + 5 + 4, 0);
+	fake_modem_disconnect(s);
+
+	/* Free state machine */
+	s->opened = FALSE;
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
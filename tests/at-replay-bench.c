@@ -0,0 +1,535 @@
+/* Benchmark replaying recorded AT transcripts through AT driver */
+
+#include <gammu.h>
+#include <gammu-config.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifdef WIN32
+#include <windows.h>
+#endif
+#include "common.h"
+#include "../libgammu/protocol/at/at.h"
+#include "../libgammu/protocol/protocol.h"	/* Needed for GSM_Protocol_Message */
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+#include "../libgammu/gsmphones.h"	/* Phone data */
+
+/* PDU used for synthetic +CMGL listings */
+#define BENCH_PDU "07911326040000F0040B911346610089F60000208062917314080CC8F71D14969741F977FD07"
+
+/**
+ * One transcript to replay.
+ */
+typedef struct {
+	char *Name;
+	unsigned char *Data;
+	size_t Length;
+	GSM_Phone_RequestID RequestID;
+	GSM_AT_SMS_Modes SMSMode;
+	/* Expected number of entries for synthetic listings, 0 otherwise */
+	int Entries;
+} Bench_Transcript;
+
+/**
+ * Results of replaying one transcript.
+ */
+typedef struct {
+	size_t Frames;
+	size_t Bytes;
+	size_t Allocations;
+	size_t Completed;
+	size_t Errors;
+	double Elapsed;
+	double *Latency;
+	size_t LatencyUsed;
+	size_t LatencyAllocated;
+	double FrameStart;
+} Bench_Result;
+
+static Bench_Transcript *Transcript;
+static size_t ReplayPos;
+static size_t ChunkSize = 64;
+static Bench_Result *Current;
+static GSM_Phone_Functions BenchPhone;
+static GSM_Device_Functions BenchDevice;
+
+/*
+ * Allocation counting, libGammu and libc calls are routed here by
+ * symbol interposition, which is available only with glibc.
+ */
+#ifdef __GLIBC__
+#define BENCH_COUNT_ALLOCATIONS
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+static size_t Allocations;
+static gboolean CountAllocations = FALSE;
+
+void *malloc(size_t size)
+{
+	if (CountAllocations) Allocations++;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+	if (CountAllocations) Allocations++;
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	if (CountAllocations) Allocations++;
+	return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr)
+{
+	__libc_free(ptr);
+}
+#endif
+
+/**
+ * Returns monotonic time in seconds.
+ */
+static double Bench_Now(void)
+{
+#ifdef WIN32
+	LARGE_INTEGER freq, count;
+
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double)count.QuadPart / freq.QuadPart;
+#elif defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * Fake device returning transcript in chunks as serial port would.
+ */
+static ssize_t Bench_ReadDevice(GSM_StateMachine *s UNUSED, void *buf, size_t nbytes)
+{
+	size_t len = Transcript->Length - ReplayPos;
+
+	if (len > ChunkSize) len = ChunkSize;
+	if (len > nbytes) len = nbytes;
+
+	memcpy(buf, Transcript->Data + ReplayPos, len);
+	ReplayPos += len;
+	return len;
+}
+
+/**
+ * Wraps AT dispatching to measure time spent on each frame.
+ */
+static GSM_Error Bench_DispatchMessage(GSM_StateMachine *s)
+{
+	GSM_Error error;
+	double now;
+#ifdef BENCH_COUNT_ALLOCATIONS
+	gboolean counting;
+#endif
+
+	error = ATGEN_DispatchMessage(s);
+
+	now = Bench_Now();
+	Current->Frames++;
+	if (error != ERR_NONE) {
+		Current->Errors++;
+	}
+
+	/* Storage of results is not counted */
+#ifdef BENCH_COUNT_ALLOCATIONS
+	counting = CountAllocations;
+	CountAllocations = FALSE;
+#endif
+	if (Current->LatencyUsed == Current->LatencyAllocated) {
+		Current->LatencyAllocated += 1024;
+		Current->Latency = (double *)realloc(Current->Latency, Current->LatencyAllocated * sizeof(double));
+		test_result(Current->Latency != NULL);
+	}
+#ifdef BENCH_COUNT_ALLOCATIONS
+	CountAllocations = counting;
+#endif
+	Current->Latency[Current->LatencyUsed++] = now - Current->FrameStart;
+	Current->FrameStart = now;
+
+	return error;
+}
+
+/**
+ * Converts line endings to CR LF as sent by the phone.
+ */
+static void Bench_AddTranscript(Bench_Transcript *t, const char *name, const char *data, size_t len)
+{
+	size_t i, pos = 0;
+
+	/* Keep just directory and file name */
+	for (i = strlen(name); i > 0; i--) {
+		if ((name[i - 1] == '/' || name[i - 1] == '\\') && ++pos == 2) {
+			break;
+		}
+	}
+	t->Name = strdup(name + i);
+	pos = 0;
+	t->Data = (unsigned char *)malloc(2 * len + 1);
+	test_result(t->Name != NULL && t->Data != NULL);
+
+	for (i = 0; i < len; i++) {
+		if (data[i] == '\n' && (i == 0 || data[i - 1] != '\r')) {
+			t->Data[pos++] = '\r';
+		}
+		t->Data[pos++] = data[i];
+	}
+	t->Data[pos] = 0;
+	t->Length = pos;
+	t->Entries = 0;
+	t->SMSMode = SMS_AT_PDU;
+
+	/* Find out request based on echoed command */
+	if (strncmp(data, "AT+CMGR", 7) == 0 || strncmp(data, "AT+CMGL", 7) == 0) {
+		t->RequestID = ID_GetSMSMessage;
+		/* Text mode replies contain quoted status */
+		if (strstr(data, ": \"") != NULL) {
+			t->SMSMode = SMS_AT_TXT;
+		}
+	} else if (strncmp(data, "AT+CPBR=?", 9) == 0) {
+		t->RequestID = ID_None;
+	} else if (strncmp(data, "AT+CPBR=", 8) == 0) {
+		if (strchr(data, ',') != NULL && strchr(data, ',') < strchr(data, '\n')) {
+			t->RequestID = ID_GetMemoryStatus;
+		} else {
+			t->RequestID = ID_GetMemory;
+		}
+	} else if (strncmp(data, "AT+CPMS=?", 9) == 0) {
+		t->RequestID = ID_GetSMSMemories;
+	} else if (strncmp(data, "AT+CNMI=?", 9) == 0) {
+		t->RequestID = ID_GetCNMIMode;
+	} else if (strncmp(data, "AT+CREG?", 8) == 0) {
+		t->RequestID = ID_GetNetworkInfo;
+	} else if (strncmp(data, "AT+CGMM", 7) == 0) {
+		t->RequestID = ID_GetModel;
+	} else if (strncmp(data, "AT+CCFC=", 8) == 0) {
+		t->RequestID = ID_Divert;
+	} else {
+		t->RequestID = ID_None;
+	}
+}
+
+static void Bench_LoadTranscript(Bench_Transcript *t, const char *filename)
+{
+	char *buffer;
+	FILE *f;
+	long len;
+
+	f = fopen(filename, "rb");
+	if (f == NULL) {
+		printf("Could not open %s\n", filename);
+		exit(1);
+	}
+	fseek(f, 0, SEEK_END);
+	len = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	buffer = (char *)malloc(len + 1);
+	test_result(buffer != NULL);
+	if (fread(buffer, 1, len, f) != (size_t)len) {
+		printf("Could not read whole file %s\n", filename);
+		exit(1);
+	}
+	buffer[len] = 0;
+	fclose(f);
+
+	Bench_AddTranscript(t, filename, buffer, len);
+	free(buffer);
+}
+
+/**
+ * Generates listing of many messages or phonebook entries.
+ */
+static void Bench_SyntheticTranscript(Bench_Transcript *t, gboolean phonebook, int entries)
+{
+	char *buffer, *pos;
+	int i;
+
+	buffer = (char *)malloc(entries * (sizeof(BENCH_PDU) + 60) + 100);
+	test_result(buffer != NULL);
+
+	pos = buffer;
+	if (phonebook) {
+		pos += sprintf(pos, "AT+CPBR=1,%d\n", entries);
+	} else {
+		pos += sprintf(pos, "AT+CMGL=4\n");
+	}
+	for (i = 1; i <= entries; i++) {
+		if (phonebook) {
+			pos += sprintf(pos, "+CPBR: %d,\"+420%09d\",145,\"Contact %d\"\n", i, i, i);
+		} else {
+			pos += sprintf(pos, "+CMGL: %d,1,,%d\n%s\n", i, (int)(sizeof(BENCH_PDU) / 2 - 9), BENCH_PDU);
+		}
+	}
+	pos += sprintf(pos, "OK\n");
+
+	Bench_AddTranscript(t, phonebook ? "synthetic +CPBR" : "synthetic +CMGL", buffer, pos - buffer);
+	t->Entries = entries;
+	free(buffer);
+}
+
+static int Bench_CompareDouble(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+static double Bench_Percentile(Bench_Result *r, int percent)
+{
+	size_t pos;
+
+	if (r->LatencyUsed == 0) {
+		return 0;
+	}
+	pos = (r->LatencyUsed * percent) / 100;
+	if (pos >= r->LatencyUsed) {
+		pos = r->LatencyUsed - 1;
+	}
+	return r->Latency[pos];
+}
+
+/**
+ * Replays transcript once, returns error of last dispatched frame.
+ */
+static GSM_Error Bench_Replay(GSM_StateMachine *s, Bench_Transcript *t, Bench_Result *r)
+{
+	GSM_Phone_Data *Data = &s->Phone.Data;
+	GSM_Phone_ATGENData *Priv = &Data->Priv.ATGEN;
+	GSM_MultiSMSMessage sms;
+	GSM_MemoryEntry memory;
+	GSM_NetworkInfo network;
+	GSM_MultiCallDivert divert;
+	double start;
+
+	memset(&sms, 0, sizeof(sms));
+	memset(&memory, 0, sizeof(memory));
+	memset(&divert, 0, sizeof(divert));
+
+	Data->RequestID = t->RequestID;
+	Data->DispatchError = ERR_TIMEOUT;
+	Data->GetSMSMessage = &sms;
+	Data->Memory = &memory;
+	Data->NetworkInfo = &network;
+	Data->Divert = &divert;
+	Priv->SMSMode = t->SMSMode;
+	Priv->MemoryUsed = 0;
+	Priv->NextMemoryEntry = 0;
+	Priv->FirstMemoryEntry = 1;
+
+	Transcript = t;
+	ReplayPos = 0;
+	Current = r;
+
+	start = Bench_Now();
+	r->FrameStart = start;
+#ifdef BENCH_COUNT_ALLOCATIONS
+	Allocations = 0;
+	CountAllocations = TRUE;
+#endif
+	while (ReplayPos < t->Length) {
+		GSM_ReadDevice(s, FALSE);
+	}
+#ifdef BENCH_COUNT_ALLOCATIONS
+	CountAllocations = FALSE;
+	r->Allocations += Allocations;
+#endif
+	r->Elapsed += Bench_Now() - start;
+	r->Bytes += t->Length;
+
+	if (Data->RequestID == ID_None) {
+		r->Completed++;
+	}
+
+	/* Verify synthetic listings were completely parsed */
+	if (t->Entries > 0) {
+		gammu_test_result(Data->DispatchError, t->Name);
+		if (t->RequestID == ID_GetSMSMessage) {
+			test_result(Priv->SMSCount == t->Entries);
+		} else {
+			test_result(Priv->MemoryUsed == t->Entries);
+		}
+	}
+
+	/* Listing is normally freed when reading messages */
+	free(Priv->SMSCache);
+	Priv->SMSCache = NULL;
+	Priv->SMSCount = 0;
+
+	Data->RequestID = ID_None;
+	Data->GetSMSMessage = NULL;
+	Data->Memory = NULL;
+	Data->NetworkInfo = NULL;
+	Data->Divert = NULL;
+
+	return Data->DispatchError;
+}
+
+static void Bench_PrintResult(const char *name, Bench_Result *r, int iterations, int replays)
+{
+	double elapsed = r->Elapsed > 0 ? r->Elapsed : 1e-9;
+
+	qsort(r->Latency, r->LatencyUsed, sizeof(double), Bench_CompareDouble);
+
+	printf("%-40s %8lu %10.2f %10.0f ",
+		name,
+		(unsigned long)(r->Frames / iterations),
+		r->Bytes / elapsed / 1e6,
+		r->Frames / elapsed);
+#ifdef BENCH_COUNT_ALLOCATIONS
+	printf("%8.1f ", r->Frames > 0 ? (double)r->Allocations / r->Frames : 0.0);
+#else
+	printf("%8s ", "n/a");
+#endif
+	printf("%9.2f %9.2f %5lu/%-5lu\n",
+		Bench_Percentile(r, 50) * 1e6,
+		Bench_Percentile(r, 99) * 1e6,
+		(unsigned long)r->Completed,
+		(unsigned long)replays);
+}
+
+int main(int argc, char **argv)
+{
+	GSM_Phone_ATGENData *Priv;
+	GSM_Phone_Data *Data;
+	GSM_StateMachine *s;
+	GSM_Protocol_ATData *d;
+	Bench_Transcript *transcripts;
+	Bench_Result result, total;
+	int i, j, count = 0, iterations = 100, synthetic = 0, first = 1;
+
+	/* Parse parameters */
+	while (first + 1 < argc && argv[first][0] == '-') {
+		if (strcmp(argv[first], "-n") == 0) {
+			iterations = atoi(argv[first + 1]);
+		} else if (strcmp(argv[first], "-s") == 0) {
+			synthetic = atoi(argv[first + 1]);
+		} else if (strcmp(argv[first], "-c") == 0) {
+			ChunkSize = atoi(argv[first + 1]);
+		} else {
+			break;
+		}
+		first += 2;
+	}
+	if (iterations <= 0 || ChunkSize == 0 || (first >= argc && synthetic <= 0)) {
+		printf("Usage: at-replay-bench [-n iterations] [-s synthetic-entries] [-c chunk-size] [comm.dump...]\n");
+		return 1;
+	}
+
+	/* Load transcripts */
+	transcripts = (Bench_Transcript *)malloc((argc - first + 2) * sizeof(Bench_Transcript));
+	test_result(transcripts != NULL);
+	for (i = first; i < argc; i++) {
+		Bench_LoadTranscript(&transcripts[count], argv[i]);
+		if (transcripts[count].RequestID == ID_None) {
+			printf("Skipping %s, unknown request\n", argv[i]);
+			free(transcripts[count].Name);
+			free(transcripts[count].Data);
+			continue;
+		}
+		count++;
+	}
+	if (synthetic > 0) {
+		Bench_SyntheticTranscript(&transcripts[count++], FALSE, synthetic);
+		Bench_SyntheticTranscript(&transcripts[count++], TRUE, synthetic);
+	}
+
+	/* Init locales to get proper encoding */
+	GSM_InitLocales(NULL);
+
+	/* Allocates state machine, debug output is left disabled */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+
+	/* Initialize AT engine with fake device */
+	BenchPhone = ATGENPhone;
+	BenchPhone.DispatchMessage = Bench_DispatchMessage;
+	BenchDevice.ReadDevice = Bench_ReadDevice;
+
+	Data = &s->Phone.Data;
+	Data->ModelInfo = GetModelData(NULL, NULL, "unknown", NULL);
+	Priv = &s->Phone.Data.Priv.ATGEN;
+	Priv->ReplyState = AT_Reply_OK;
+	Priv->Charset = AT_CHARSET_GSM;
+	s->Phone.Functions = &BenchPhone;
+	s->Protocol.Functions = &ATProtocol;
+	s->Device.Functions = &BenchDevice;
+	s->opened = TRUE;
+	InitLines(&Priv->Lines);
+
+	d = &s->Protocol.Data.AT;
+	d->Msg.Buffer 		= NULL;
+	d->Msg.BufferUsed	= 0;
+	d->Msg.Length		= 0;
+	d->Msg.Type		= 0;
+	d->SpecialAnswerLines	= 0;
+	d->LineStart		= -1;
+	d->LineEnd		= -1;
+	d->wascrlf 		= FALSE;
+	d->EditMode		= FALSE;
+	d->FastWrite		= FALSE;
+	d->CPINNoOK		= FALSE;
+
+	printf("%-40s %8s %10s %10s %8s %9s %9s %11s\n",
+		"Transcript", "Frames", "MB/s", "Frames/s", "Allocs", "p50 [us]", "p99 [us]", "Completed");
+
+	memset(&total, 0, sizeof(total));
+	for (i = 0; i < count; i++) {
+		memset(&result, 0, sizeof(result));
+		for (j = 0; j < iterations; j++) {
+			Bench_Replay(s, &transcripts[i], &result);
+		}
+		Bench_PrintResult(transcripts[i].Name, &result, iterations, iterations);
+
+		total.Frames += result.Frames;
+		total.Bytes += result.Bytes;
+		total.Allocations += result.Allocations;
+		total.Completed += result.Completed;
+		total.Errors += result.Errors;
+		total.Elapsed += result.Elapsed;
+		total.Latency = (double *)realloc(total.Latency, (total.LatencyUsed + result.LatencyUsed + 1) * sizeof(double));
+		test_result(total.Latency != NULL);
+		memcpy(total.Latency + total.LatencyUsed, result.Latency, result.LatencyUsed * sizeof(double));
+		total.LatencyUsed += result.LatencyUsed;
+		free(result.Latency);
+
+		free(transcripts[i].Name);
+		free(transcripts[i].Data);
+	}
+	Bench_PrintResult("Total", &total, iterations, iterations * count);
+	printf("Dispatch errors: %lu\n", (unsigned long)total.Errors);
+	free(total.Latency);
+	free(transcripts);
+
+	/* This is normally done by ATGEN_Terminate */
+	FreeLines(&Priv->Lines);
+	GetLineString(NULL, NULL, 0);
+	free(d->Msg.Buffer);
+	d->Msg.Buffer = NULL;
+
+	/* Free state machine */
+	s->opened = FALSE;
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
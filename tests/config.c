@@ -11,7 +11,7 @@
 int main(int argc, char **argv)
 {
 	GSM_Error error;
-	GSM_Config cfg = { "", "", NULL, NULL, FALSE, FALSE, NULL, FALSE, FALSE, "", "", "", "", "", {0}, {0}, 0, "" };
+	GSM_Config cfg = { "", "", NULL, NULL, FALSE, FALSE, NULL, FALSE, FALSE, "", "", "", "", "", {0}, {0}, 0, "", NULL, FALSE, 0, 0 };
 	INI_Section *ini = NULL;
 
 	/* Check parameters */
@@ -34,6 +34,7 @@ int main(int argc, char **argv)
 	free(cfg.Device);
 	free(cfg.Connection);
 	free(cfg.DebugFile);
+	free(cfg.CapabilityCache);
 
 	return 0;
 }
@@ -0,0 +1,166 @@
+/* Fake device shared by tests */
+
+#include <gammu.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "fake-modem.h"
+#include "../libgammu/gsmphones.h"	/* Phone data */
+
+static GSM_Device_Functions device;
+static fake_modem_handler handler;
+static fake_modem_command at_command;
+
+static unsigned char input[70000];
+static size_t input_length;
+static unsigned char output[70000];
+static size_t output_length, output_pos;
+
+/* Splits written data to AT commands */
+static size_t fake_at_handler(const unsigned char *data, size_t length)
+{
+	char command[200];
+	const unsigned char *end;
+
+	end = memchr(data, '\r', length);
+	if (end == NULL) {
+		test_result(length < sizeof(command) - 1);
+		return 0;
+	}
+	length = end - data;
+	test_result(length < sizeof(command) - 1);
+	memcpy(command, data, length);
+	command[length] = 0;
+	if (length > 0 && command[0] != 0x1b) {
+		at_command(command);
+	}
+	return length + 1;
+}
+
+static ssize_t fake_write(GSM_StateMachine *s UNUSED, const void *buf, size_t nbytes)
+{
+	size_t length;
+
+	test_result(handler != NULL);
+	test_result(input_length + nbytes <= sizeof(input));
+	memcpy(input + input_length, buf, nbytes);
+	input_length += nbytes;
+
+	while (input_length > 0) {
+		length = handler(input, input_length);
+		if (length == 0) {
+			break;
+		}
+		memmove(input, input + length, input_length - length);
+		input_length -= length;
+	}
+	return nbytes;
+}
+
+static ssize_t fake_read(GSM_StateMachine *s UNUSED, void *buf, size_t nbytes)
+{
+	size_t len = MIN(nbytes, output_length - output_pos);
+
+	memcpy(buf, output + output_pos, len);
+	output_pos += len;
+	if (output_pos == output_length) {
+		output_pos = output_length = 0;
+	}
+	return len;
+}
+
+static GSM_Error fake_parity(GSM_StateMachine *s UNUSED, gboolean parity UNUSED)
+{
+	return ERR_NONE;
+}
+
+static GSM_Error fake_dtrrts(GSM_StateMachine *s UNUSED, gboolean dtr UNUSED, gboolean rts UNUSED)
+{
+	return ERR_NONE;
+}
+
+static GSM_Error fake_speed(GSM_StateMachine *s UNUSED, int speed UNUSED)
+{
+	return ERR_NONE;
+}
+
+GSM_Error fake_modem_none(GSM_StateMachine *s UNUSED)
+{
+	return ERR_NONE;
+}
+
+void fake_modem_init(GSM_StateMachine *s, fake_modem_handler data_handler)
+{
+	memset(&device, 0, sizeof(device));
+	device.WriteDevice = fake_write;
+	device.ReadDevice = fake_read;
+	device.CloseDevice = fake_modem_none;
+	device.DeviceSetParity = fake_parity;
+	device.DeviceSetDtrRts = fake_dtrrts;
+	device.DeviceSetSpeed = fake_speed;
+	s->Device.Functions = &device;
+	handler = data_handler;
+	fake_modem_reset();
+}
+
+void fake_modem_init_at(GSM_StateMachine *s, fake_modem_command command)
+{
+	at_command = command;
+	fake_modem_init(s, fake_at_handler);
+}
+
+void fake_modem_reset(void)
+{
+	input_length = 0;
+	output_length = output_pos = 0;
+}
+
+void fake_modem_reply(const void *data, size_t length)
+{
+	test_result(output_length + length <= sizeof(output));
+	memcpy(output + output_length, data, length);
+	output_length += length;
+}
+
+void fake_modem_printf(const char *format, ...)
+{
+	va_list ap;
+	int length;
+
+	va_start(ap, format);
+	length = vsnprintf((char *)output + output_length, sizeof(output) - output_length, format, ap);
+	va_end(ap);
+	test_result(length >= 0 && output_length + length < sizeof(output));
+	output_length += length;
+}
+
+void fake_modem_connect(GSM_StateMachine *s)
+{
+	GSM_Error error;
+
+	s->Phone.Data.Model[0] = 0;
+	s->Phone.Data.Manufacturer[0] = 0;
+	s->Phone.Data.Version[0] = 0;
+	s->Phone.Data.ModelInfo = GetModelData(s, "unknown", NULL, NULL);
+
+	error = s->Protocol.Functions->Initialise(s);
+	gammu_test_result(error, "Protocol initialise");
+	error = s->Phone.Functions->Initialise(s);
+	gammu_test_result(error, "Phone initialise");
+}
+
+void fake_modem_disconnect(GSM_StateMachine *s)
+{
+	GSM_Error error;
+
+	error = s->Phone.Functions->Terminate(s);
+	gammu_test_result(error, "Phone terminate");
+	error = s->Protocol.Functions->Terminate(s);
+	gammu_test_result(error, "Protocol terminate");
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,73 @@
+/**
+ * Fake device for tests driving phone drivers without a phone.
+ *
+ * Data written to the device are passed to the test, which queues
+ * replies to be read by the driver.
+ */
+
+#ifndef _test_fake_modem_h_
+#define _test_fake_modem_h_
+
+#include <gammu.h>
+#include "../libgammu/protocol/protocol.h"	/* Needed for GSM_Protocol_Message */
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+
+/**
+ * Processes data written to the device. Returns number of processed
+ * bytes or 0 when complete request was not written yet.
+ */
+typedef size_t (*fake_modem_handler)(const unsigned char *data, size_t length);
+
+/**
+ * Processes single AT command written to the device.
+ */
+typedef void (*fake_modem_command)(const char *command);
+
+/**
+ * Makes state machine use the fake device, written data are passed to
+ * handler. Handler can be NULL when nothing is written to the device.
+ */
+void fake_modem_init(GSM_StateMachine *s, fake_modem_handler handler);
+
+/**
+ * Makes state machine use the fake device, every written line is passed
+ * to command callback.
+ */
+void fake_modem_init_at(GSM_StateMachine *s, fake_modem_command command);
+
+/**
+ * Drops written data and queued replies.
+ */
+void fake_modem_reset(void);
+
+/**
+ * Queues reply to be read from the device.
+ */
+void fake_modem_reply(const void *data, size_t length);
+
+/**
+ * Queues formatted reply to be read from the device.
+ */
+void fake_modem_printf(const char *format, ...) PRINTF_STYLE(1, 2);
+
+/**
+ * Does nothing, to be used for not needed driver functions.
+ */
+GSM_Error fake_modem_none(GSM_StateMachine *s);
+
+/**
+ * Initialises protocol and phone driver, same as GSM_InitConnection
+ * does after opening the device.
+ */
+void fake_modem_connect(GSM_StateMachine *s);
+
+/**
+ * Terminates phone driver and protocol.
+ */
+void fake_modem_disconnect(GSM_StateMachine *s);
+
+#endif
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
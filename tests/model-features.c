@@ -0,0 +1,68 @@
+/* Test for per state machine phone features */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+#include "../libgammu/gsmphones.h"	/* Phone data */
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Debug_Info *debug_info;
+	GSM_StateMachine *s, *s2;
+	GSM_PhoneModel *model, *shared;
+	GSM_Config *cfg;
+
+	debug_info = GSM_GetGlobalDebug();
+	GSM_SetDebugFileDescriptor(stderr, FALSE, debug_info);
+	GSM_SetDebugLevel("textall", debug_info);
+
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+	s2 = GSM_AllocStateMachine();
+	test_result(s2 != NULL);
+
+	/* Configure features for first state machine only */
+	cfg = GSM_GetConfig(s, 0);
+	test_result(GSM_SetFeatureString(cfg->PhoneFeatures, "CAL33,SQWE") == ERR_NONE);
+	s->CurrentConfig = cfg;
+	s2->CurrentConfig = GSM_GetConfig(s2, 0);
+
+	model = GetModelData(s, NULL, "unknown", NULL);
+	test_result(model == &s->Phone.Data.ModelData);
+	test_result(GSM_IsPhoneFeatureAvailable(model, F_CAL33));
+	test_result(GSM_IsPhoneFeatureAvailable(model, F_SQWE));
+	test_result(!GSM_IsPhoneFeatureAvailable(model, F_CAL52));
+	test_result(!GSM_IsPhoneFeatureAvailable(model, F_LAST_VALUE));
+
+	/* All known features fit into bitmap */
+	test_result(F_LAST_VALUE <= GSM_MAX_PHONE_FEATURE_BITS);
+
+	/* Adding feature updates bitmap as well */
+	test_result(GSM_AddPhoneFeature(model, F_CAL52));
+	test_result(GSM_IsPhoneFeatureAvailable(model, F_CAL52));
+
+	/* Other state machine and shared database are not affected */
+	model = GetModelData(s2, NULL, "unknown", NULL);
+	test_result(!GSM_IsPhoneFeatureAvailable(model, F_CAL33));
+	shared = GetModelData(NULL, NULL, "unknown", NULL);
+	test_result(shared != model);
+	test_result(!GSM_IsPhoneFeatureAvailable(shared, F_CAL33));
+	test_result(!GSM_IsPhoneFeatureAvailable(shared, F_CAL52));
+
+	/* Model defaults are kept without configured features */
+	model = GetModelData(s2, "6310i", NULL, NULL);
+	test_result(GSM_IsPhoneFeatureAvailable(model, F_VOICETAGS));
+	test_result(!GSM_IsPhoneFeatureAvailable(model, F_SQWE));
+
+	GSM_FreeStateMachine(s);
+	GSM_FreeStateMachine(s2);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,282 @@
+/* Test for OBEX file transfers in Single Response Mode */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "fake-modem.h"
+#include "../libgammu/gsmphones.h"	/* Phone data */
+#include "../libgammu/phone/obex/obexfunc.h"	/* OBEXGEN_InitialiseVars */
+
+#define FILE_SIZE 5000
+#define GET_CHUNK 1000
+
+/* Fake peer configuration */
+static int peer_frame;
+static gboolean peer_srm;
+
+/* Fake peer state */
+static gboolean srm_active;
+static unsigned char received[FILE_SIZE * 2];
+static size_t received_length;
+static unsigned char file_data[FILE_SIZE];
+static size_t get_pos;
+
+/* Statistics */
+static int packets, responses;
+static size_t max_packet;
+
+static void respond(unsigned char type, const unsigned char *data, size_t length)
+{
+	unsigned char header[3];
+
+	header[0] = type;
+	header[1] = (length + 3) / 256;
+	header[2] = (length + 3) % 256;
+	fake_modem_reply(header, sizeof(header));
+	if (length > 0) {
+		fake_modem_reply(data, length);
+	}
+	responses++;
+}
+
+/* Answers with next part of file, all of them in Single Response Mode */
+static void respond_get(gboolean srm_requested)
+{
+	unsigned char data[GET_CHUNK + 10];
+	size_t length, pos;
+	gboolean last;
+
+	do {
+		pos = 0;
+		if (srm_requested && peer_srm && get_pos == 0) {
+			srm_active = TRUE;
+			data[pos++] = 0x97;
+			data[pos++] = 0x01;
+		}
+		length = MIN(GET_CHUNK, FILE_SIZE - get_pos);
+		last = (get_pos + length == FILE_SIZE);
+		data[pos++] = last ? 0x49 : 0x48;
+		data[pos++] = (length + 3) / 256;
+		data[pos++] = (length + 3) % 256;
+		memcpy(data + pos, file_data + get_pos, length);
+		get_pos += length;
+		respond(last ? 0xA0 : 0x90, data, pos + length);
+	} while (srm_active && !last);
+
+	if (last) {
+		srm_active = FALSE;
+	}
+}
+
+static void process_packet(const unsigned char *packet, size_t length)
+{
+	unsigned char connect[] = {0x10, 0x00, 0x00, 0x00};
+	unsigned char srm[] = {0x97, 0x01};
+	gboolean srm_requested = FALSE;
+	size_t pos, header;
+
+	packets++;
+	max_packet = MAX(max_packet, length);
+
+	/* Parse headers */
+	for (pos = (packet[0] == 0x80) ? 7 : 3; pos < length; pos += header) {
+		switch (packet[pos] & 0xc0) {
+			case 0x80:
+				header = 2;
+				break;
+			case 0xc0:
+				header = 5;
+				break;
+			default:
+				header = packet[pos + 1] * 256 + packet[pos + 2];
+				break;
+		}
+		test_result(header > 0);
+		if (packet[pos] == 0x97 && packet[pos + 1] == 0x01) {
+			srm_requested = TRUE;
+		}
+		if (packet[pos] == 0x48 || packet[pos] == 0x49) {
+			test_result(received_length + header - 3 <= sizeof(received));
+			memcpy(received + received_length, packet + pos + 3, header - 3);
+			received_length += header - 3;
+		}
+	}
+
+	switch (packet[0]) {
+		case 0x80:
+			connect[2] = peer_frame / 256;
+			connect[3] = peer_frame % 256;
+			respond(0xA0, connect, sizeof(connect));
+			break;
+		case 0x02:
+			if (srm_active) {
+				break;
+			}
+			if (srm_requested && peer_srm) {
+				srm_active = TRUE;
+				respond(0x90, srm, sizeof(srm));
+			} else {
+				respond(0x90, NULL, 0);
+			}
+			break;
+		case 0x82:
+			srm_active = FALSE;
+			respond(0xA0, NULL, 0);
+			break;
+		case 0x83:
+			respond_get(srm_requested);
+			break;
+		default:
+			respond(0xC0, NULL, 0);
+			break;
+	}
+}
+
+/* Passes every complete packet to the peer */
+static size_t fake_packet(const unsigned char *data, size_t length)
+{
+	size_t packet;
+
+	if (length < 3) {
+		return 0;
+	}
+	packet = data[1] * 256 + data[2];
+	if (length < packet) {
+		return 0;
+	}
+	process_packet(data, packet);
+	return packet;
+}
+
+static void reset_peer(GSM_StateMachine *s, int frame, gboolean srm)
+{
+	peer_frame = frame;
+	peer_srm = srm;
+	srm_active = FALSE;
+	fake_modem_reset();
+	received_length = 0;
+	get_pos = 0;
+	packets = responses = 0;
+	max_packet = 0;
+	/* Connect again to learn new frame size */
+	s->Phone.Data.Priv.OBEXGEN.Service = 0;
+}
+
+static GSM_Error send_file(GSM_StateMachine *s, const char *name, size_t size)
+{
+	GSM_File file;
+	GSM_Error error;
+	size_t pos = 0;
+	int handle, i;
+
+	memset(&file, 0, sizeof(file));
+	EncodeUnicode(file.Name, name, strlen(name));
+	file.Buffer = file_data;
+	file.Used = size;
+
+	/* Bounded, broken chunking would loop forever */
+	for (i = 0; i < 1000; i++) {
+		error = GSM_SendFilePart(s, &file, &pos, &handle);
+		if (error != ERR_NONE) {
+			break;
+		}
+	}
+	test_result(i < 1000);
+	return error;
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_StateMachine *s;
+	GSM_Error error;
+	GSM_File file;
+	char name[200];
+	size_t i, size;
+	int handle;
+
+	for (i = 0; i < FILE_SIZE; i++) {
+		file_data[i] = i % 251;
+	}
+
+	/* Allocates state machine */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+
+	fake_modem_init(s, fake_packet);
+
+	s->Protocol.Functions = &OBEXProtocol;
+	error = s->Protocol.Functions->Initialise(s);
+	gammu_test_result(error, "Initialise");
+
+	s->Phone.Functions = &OBEXGENPhone;
+	s->Phone.Data.ModelInfo = GetModelData(s, "unknown", NULL, NULL);
+	s->CurrentConfig = GSM_GetConfig(s, 0);
+	s->ReplyNum = 1;
+	s->opened = TRUE;
+	error = OBEXGEN_InitialiseVars(s);
+	gammu_test_result(error, "OBEXGEN_InitialiseVars");
+
+	/* Upload in Single Response Mode is answered only at start and end */
+	reset_peer(s, 1024, TRUE);
+	error = send_file(s, "srm.bin", FILE_SIZE);
+	test_result(error == ERR_EMPTY);
+	test_result(received_length == FILE_SIZE);
+	test_result(memcmp(received, file_data, FILE_SIZE) == 0);
+	test_result(max_packet <= 1024);
+	test_result(packets > 5);
+	/* Connect, first part and last part */
+	test_result(responses == 3);
+
+	/* Peer without Single Response Mode answers every packet */
+	reset_peer(s, 1024, FALSE);
+	error = send_file(s, "plain.bin", FILE_SIZE);
+	test_result(error == ERR_EMPTY);
+	test_result(received_length == FILE_SIZE);
+	test_result(memcmp(received, file_data, FILE_SIZE) == 0);
+	test_result(responses == packets);
+
+	/* Download in Single Response Mode needs single request */
+	reset_peer(s, 1024, TRUE);
+	memset(&file, 0, sizeof(file));
+	EncodeUnicode(file.ID_FullName, "srm.bin", 7);
+	for (i = 0; i < 10; i++) {
+		error = GSM_GetFilePart(s, &file, &handle, &size);
+		if (error != ERR_NONE) {
+			break;
+		}
+	}
+	test_result(error == ERR_EMPTY);
+	test_result(file.Used == FILE_SIZE);
+	test_result(memcmp(file.Buffer, file_data, FILE_SIZE) == 0);
+	test_result(packets == 1);
+	test_result(responses == FILE_SIZE / GET_CHUNK);
+	free(file.Buffer);
+
+	/* Smallest frame still transfers data */
+	reset_peer(s, 255, TRUE);
+	error = send_file(s, "small.bin", FILE_SIZE);
+	test_result(error == ERR_EMPTY);
+	test_result(received_length == FILE_SIZE);
+	test_result(max_packet <= 255);
+
+	/* Headers filling whole frame are rejected instead of looping */
+	reset_peer(s, 255, TRUE);
+	memset(name, 'x', 120);
+	strcpy(name + 120, ".bin");
+	error = send_file(s, name, FILE_SIZE);
+	test_result(error == ERR_NOTSUPPORTED);
+	test_result(received_length == 0);
+
+	/* Free state machine */
+	s->opened = FALSE;
+	s->Protocol.Functions->Terminate(s);
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,192 @@
+/* Test for response time statistics and adaptive timeouts */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "fake-modem.h"
+#include "../libgammu/gsmphones.h"	/* Phone data */
+
+static int writes;
+static gboolean answer;
+
+static GSM_Error fake_write_message(GSM_StateMachine *s UNUSED, unsigned const char *buffer UNUSED,
+		size_t length UNUSED, int type UNUSED)
+{
+	writes++;
+	if (answer) {
+		fake_modem_reply("OK\n", 3);
+	}
+	return ERR_NONE;
+}
+
+/* Whole line completes request */
+static GSM_Error fake_state_machine(GSM_StateMachine *s, unsigned char rx_char)
+{
+	if (rx_char == '\n') {
+		s->Phone.Data.RequestID = ID_None;
+		s->Phone.Data.DispatchError = ERR_NONE;
+	}
+	return ERR_NONE;
+}
+
+static void check_statistics(GSM_Config *cfg)
+{
+	GSM_ResponseTiming timing;
+	int i;
+
+	/* Driver limit is used until there is enough data */
+	GSM_Timing_Reset(&timing);
+	cfg->AdaptiveTimeout = TRUE;
+	cfg->MinTimeout = 0;
+	cfg->MaxTimeout = 0;
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 5000);
+	for (i = 0; i < GSM_TIMING_MIN_SAMPLES - 1; i++) {
+		GSM_Timing_Record(&timing, 100);
+	}
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 5000);
+
+	/* Percentile is upper bound of bucket */
+	for (i = 0; i < 20; i++) {
+		GSM_Timing_Record(&timing, 100);
+	}
+	test_result(timing.Count == GSM_TIMING_MIN_SAMPLES + 19);
+	test_result(timing.Maximum == 100);
+	test_result((int)timing.Average == 100);
+	test_result(GSM_Timing_Percentile(&timing, 50) == 127);
+	test_result(GSM_Timing_Percentile(&timing, 99) == 127);
+
+	/* Derived timeout respects all bounds */
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 254);
+	test_result(GSM_Timing_Timeout(&timing, cfg, 200) == 200);
+	cfg->MinTimeout = 1000;
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 1000);
+	cfg->MaxTimeout = 500;
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 500);
+	cfg->AdaptiveTimeout = FALSE;
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 500);
+	cfg->MaxTimeout = 0;
+	test_result(GSM_Timing_Timeout(&timing, cfg, 5000) == 5000);
+
+	/* Outliers move tail percentile */
+	for (i = 0; i < 5; i++) {
+		GSM_Timing_Record(&timing, 3000);
+	}
+	test_result(timing.Maximum == 3000);
+	test_result(GSM_Timing_Percentile(&timing, 50) == 127);
+	test_result(GSM_Timing_Percentile(&timing, 99) == 4095);
+
+	/* Histogram is aged */
+	for (i = 0; i < 3 * GSM_TIMING_WINDOW; i++) {
+		GSM_Timing_Record(&timing, 10);
+	}
+	test_result(timing.HistogramCount <= GSM_TIMING_WINDOW);
+	test_result(GSM_Timing_Percentile(&timing, 99) == 15);
+	test_result(timing.Maximum == 3000);
+
+	test_result(strcmp(GSM_RequestIDToString(ID_GetSMSMessage), "GetSMSMessage") == 0);
+	test_result(strcmp(GSM_RequestIDToString(ID_EachFrame), "EachFrame") == 0);
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Protocol_Functions protocol;
+	GSM_Phone_Functions phone;
+	GSM_ResponseStats stats;
+	GSM_StateMachine *s;
+	GSM_Config *cfg;
+	GSM_Error error;
+	long long start, elapsed;
+	int i;
+
+	/* Allocates state machine */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+
+	cfg = GSM_GetConfig(s, 0);
+	check_statistics(cfg);
+
+	memset(&protocol, 0, sizeof(protocol));
+	protocol.WriteMessage = fake_write_message;
+	protocol.StateMachine = fake_state_machine;
+	protocol.Initialise = fake_modem_none;
+	protocol.Terminate = fake_modem_none;
+	s->Protocol.Functions = &protocol;
+
+	fake_modem_init(s, NULL);
+
+	memset(&phone, 0, sizeof(phone));
+	s->Phone.Functions = &phone;
+	s->Phone.Data.ModelInfo = GetModelData(s, "unknown", NULL, NULL);
+	s->CurrentConfig = cfg;
+	s->ReplyNum = 3;
+	s->opened = TRUE;
+
+	cfg->AdaptiveTimeout = TRUE;
+	cfg->MinTimeout = 0;
+	cfg->MaxTimeout = 400;
+
+	/* Known response times shorten all but last attempt */
+	for (i = 0; i < GSM_TIMING_MIN_SAMPLES; i++) {
+		GSM_Timing_Record(&s->Timing[ID_GetFirmware], 10);
+	}
+
+	/* Silent phone gets all attempts, last one with full timeout */
+	answer = FALSE;
+	writes = 0;
+	start = GSM_GetMonotonicTime();
+	error = GSM_WaitFor(s, (const unsigned char *)"AT\r", 3, 0x00, 4, ID_GetFirmware);
+	elapsed = GSM_GetMonotonicTime() - start;
+	test_result(error == ERR_TIMEOUT);
+	test_result(writes == 3);
+	test_result(elapsed >= 30 + 60 + 400);
+	test_result(elapsed < 3 * 400);
+	test_result(s->SilentTimeouts == 1);
+
+	/* Next request gets single attempt, but with full timeout */
+	writes = 0;
+	start = GSM_GetMonotonicTime();
+	error = GSM_WaitFor(s, (const unsigned char *)"AT\r", 3, 0x00, 4, ID_GetFirmware);
+	elapsed = GSM_GetMonotonicTime() - start;
+	test_result(error == ERR_TIMEOUT);
+	test_result(writes == 1);
+	test_result(elapsed >= 400);
+	test_result(elapsed < 2 * 400);
+	test_result(s->SilentTimeouts == 2);
+
+	/* Reply recovers normal operation and is measured */
+	answer = TRUE;
+	writes = 0;
+	error = GSM_WaitFor(s, (const unsigned char *)"AT\r", 3, 0x00, 4, ID_GetModel);
+	gammu_test_result(error, "GSM_WaitFor");
+	test_result(writes == 1);
+	test_result(s->SilentTimeouts == 0);
+
+	error = GSM_GetResponseStats(s, 0, &stats);
+	gammu_test_result(error, "GSM_GetResponseStats");
+	test_result(strcmp(stats.Request, "GetModel") == 0);
+	test_result(stats.Count == 1);
+	test_result(stats.Timeouts == 0);
+	test_result(stats.Maximum < 400);
+	test_result(stats.Timeout == 0);
+
+	error = GSM_GetResponseStats(s, 1, &stats);
+	gammu_test_result(error, "GSM_GetResponseStats");
+	test_result(strcmp(stats.Request, "GetFirmware") == 0);
+	test_result(stats.Count == GSM_TIMING_MIN_SAMPLES);
+	test_result(stats.Timeouts == 4);
+	test_result(stats.Percentile99 == 15);
+	test_result(stats.Timeout == 30);
+	test_result(GSM_GetResponseStats(s, 2, &stats) == ERR_EMPTY);
+
+	/* Free state machine */
+	s->opened = FALSE;
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,125 @@
+/* Test for framing on S60 protocol */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "../libgammu/protocol/protocol.h"	/* Needed for GSM_Protocol_Message */
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+
+/* Two partial frames followed by final one, then short frame */
+static const char test_data[] =
+	"130\x02" "first part \x03"
+	"130\x02" "second part \x03"
+	"201\x02" "last part\x03"
+	"111\x02" "1.5\x03";
+
+static const char *expected_data[] = {
+	"first part second part last part",
+	"1.5",
+};
+
+static const int expected_type[] = {
+	201,
+	111,
+};
+
+static int dispatched;
+static unsigned char written[2000];
+static size_t written_length;
+
+static GSM_Error test_dispatch(GSM_StateMachine *s)
+{
+	GSM_Protocol_Message *msg = s->Phone.Data.RequestMsg;
+
+	test_result(dispatched < 2);
+	test_result(msg->Type == expected_type[dispatched]);
+	test_result(msg->Length == strlen(expected_data[dispatched]));
+	test_result(strcmp((char *)msg->Buffer, expected_data[dispatched]) == 0);
+	dispatched++;
+
+	return ERR_NONE;
+}
+
+static ssize_t test_write(GSM_StateMachine *s UNUSED, const void *buf, size_t nbytes)
+{
+	test_result(written_length + nbytes <= sizeof(written));
+	memcpy(written + written_length, buf, nbytes);
+	written_length += nbytes;
+	return nbytes;
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Phone_Functions phone;
+	GSM_Device_Functions device;
+	GSM_StateMachine *s;
+	unsigned char message[700];
+	size_t i, pos, chunk;
+	GSM_Error error;
+
+	/* Allocates state machine */
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+
+	memset(&phone, 0, sizeof(phone));
+	phone.DispatchMessage = test_dispatch;
+	s->Phone.Functions = &phone;
+
+	memset(&device, 0, sizeof(device));
+	device.WriteDevice = test_write;
+	s->Device.Functions = &device;
+
+	s->Protocol.Functions = &S60Protocol;
+	error = s->Protocol.Functions->Initialise(s);
+	gammu_test_result(error, "Initialise");
+
+	/* Feed data by characters */
+	dispatched = 0;
+	for (i = 0; i < sizeof(test_data) - 1; i++) {
+		error = s->Protocol.Functions->StateMachine(s, test_data[i]);
+		gammu_test_result(error, "StateMachine");
+	}
+	test_result(dispatched == 2);
+
+	/* Feed data in blocks of various sizes */
+	for (chunk = 2; chunk < sizeof(test_data); chunk += 7) {
+		dispatched = 0;
+		for (pos = 0; pos < sizeof(test_data) - 1; pos += chunk) {
+			error = s->Protocol.Functions->StateMachineBlock(s,
+				(const unsigned char *)test_data + pos,
+				MIN(chunk, sizeof(test_data) - 1 - pos));
+			gammu_test_result(error, "StateMachineBlock");
+		}
+		test_result(dispatched == 2);
+	}
+
+	/* Long message is split to partial ones */
+	memset(message, 'x', sizeof(message));
+	written_length = 0;
+	error = s->Protocol.Functions->WriteMessage(s, message, sizeof(message), 201);
+	gammu_test_result(error, "WriteMessage");
+	test_result(written_length == 4 + 600 + 1 + 4 + 100 + 1);
+	test_result(memcmp(written, "130\x02", 4) == 0);
+	test_result(written[604] == '\n');
+	test_result(memcmp(written + 605, "201\x02", 4) == 0);
+	test_result(written[written_length - 1] == '\n');
+
+	/* Empty message is still sent */
+	written_length = 0;
+	error = s->Protocol.Functions->WriteMessage(s, message, 0, 111);
+	gammu_test_result(error, "WriteMessage");
+	test_result(written_length == 5);
+	test_result(memcmp(written, "111\x02\n", 5) == 0);
+
+	/* Free state machine */
+	s->Protocol.Functions->Terminate(s);
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,121 @@
+/* Test for compact SMS storage */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "../libgammu/service/sms/gsmpack.h"
+#include "../libgammu/service/sms/gsmmulti.h"
+
+static void compare_sms(GSM_SMSMessage *a, GSM_SMSMessage *b)
+{
+	int i;
+
+	test_result(a->Length == b->Length);
+	test_result(a->Coding == b->Coding);
+	test_result(a->PDU == b->PDU);
+	test_result(a->Class == b->Class);
+	test_result(a->UDH.Type == b->UDH.Type);
+	test_result(a->UDH.Length == b->UDH.Length);
+	test_result(a->UDH.PartNumber == b->UDH.PartNumber);
+	test_result(a->UDH.AllParts == b->UDH.AllParts);
+	test_result(a->UDH.ID8bit == b->UDH.ID8bit);
+	test_result(memcmp(a->UDH.Text, b->UDH.Text, a->UDH.Length) == 0);
+	test_result(memcmp(&a->DateTime, &b->DateTime, sizeof(GSM_DateTime)) == 0);
+	test_result(mywstrncmp(a->Number, b->Number, 0));
+	test_result(mywstrncmp(a->SMSC.Number, b->SMSC.Number, 0));
+	test_result(a->OtherNumbersNum == b->OtherNumbersNum);
+	for (i = 0; i < a->OtherNumbersNum; i++) {
+		test_result(mywstrncmp(a->OtherNumbers[i], b->OtherNumbers[i], 0));
+	}
+	test_result(memcmp(a->Text, b->Text, a->Length * 2 + 2) == 0);
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_MultiSMSMessage sms, *out;
+	GSM_MultiPartSMSInfo SMSInfo;
+	GSM_SMSArena arena;
+	GSM_SMSMessage part, *first[GSM_MAX_MULTI_SMS + 1];
+	GSM_SMSLinkGroup groups[GSM_MAX_MULTI_SMS];
+	GSM_Error error;
+	unsigned char Buffer[2000];
+	int numbers[GSM_MAX_MULTI_SMS];
+	int i, groupsnum;
+
+	GSM_ClearMultiPartSMSInfo(&SMSInfo);
+	SMSInfo.EntriesNum = 1;
+	EncodeUnicode(Buffer,
+		      ".........1.........2.........3.........4.........5.........6.........7.........8.........9........0"
+		      ".........1.........2.........3.........4.........5.........6.........7.........8.........9........0"
+		      ".........1.........2.........3.........4.........5.........6.........7.........8.........9........0"
+		      ".........1.........2.........3.........4.........5.........6.........7.........8.........9........0", 400);
+	SMSInfo.Entries[0].Buffer = Buffer;
+	SMSInfo.Entries[0].ID = SMS_ConcatenatedTextLong;
+	SMSInfo.UnicodeCoding = TRUE;
+	error = GSM_EncodeMultiPartSMS(NULL, &SMSInfo, &sms);
+	gammu_test_result(error, "GSM_EncodeMultiPartSMS");
+	test_result(sms.Number > 2);
+
+	for (i = 0; i < sms.Number; i++) {
+		EncodeUnicode(sms.SMS[i].Number, "321", 3);
+		EncodeUnicode(sms.SMS[i].OtherNumbers[0], "+420123", 7);
+		sms.SMS[i].OtherNumbersNum = 1;
+	}
+
+	GSM_SMSArena_New(&arena);
+	gammu_test_result(GSM_SMSArena_Add(&arena, &sms), "GSM_SMSArena_Add");
+	test_result(arena.Used < sizeof(GSM_SMSMessage));
+
+	out = malloc(sizeof(GSM_MultiSMSMessage));
+	test_result(out != NULL);
+
+	/* Whole message */
+	gammu_test_result(GSM_SMSArena_Get(&arena, 0, out), "GSM_SMSArena_Get");
+	test_result(out->Number == sms.Number);
+	for (i = 0; i < sms.Number; i++) {
+		compare_sms(&sms.SMS[i], &out->SMS[i]);
+	}
+	test_result(GSM_SMSArena_Get(&arena, 1, out) == ERR_INVALIDLOCATION);
+
+	/* Store parts separately in reverse order */
+	for (i = sms.Number - 1; i >= 0; i--) {
+		out->Number = 1;
+		out->SMS[0] = sms.SMS[i];
+		gammu_test_result(GSM_SMSArena_Add(&arena, out), "GSM_SMSArena_Add");
+	}
+	test_result(arena.Number == sms.Number + 1);
+	gammu_test_result(GSM_SMSArena_GetPart(&arena, 1, 0, &part), "GSM_SMSArena_GetPart");
+	compare_sms(&sms.SMS[sms.Number - 1], &part);
+	test_result(GSM_SMSArena_GetPart(&arena, 1, 1, &part) == ERR_INVALIDLOCATION);
+
+	/* Link single parts back together */
+	for (i = 0; i < sms.Number; i++) {
+		first[i] = malloc(sizeof(GSM_SMSMessage));
+		test_result(first[i] != NULL);
+		gammu_test_result(GSM_SMSArena_GetPart(&arena, i + 1, 0, first[i]), "GSM_SMSArena_GetPart");
+		numbers[i] = GSM_SMSArena_Parts(&arena, i + 1);
+	}
+	first[sms.Number] = NULL;
+	error = GSM_LinkSMSGroups(NULL, first, numbers, groups, &groupsnum, TRUE);
+	gammu_test_result(error, "GSM_LinkSMSGroups");
+	test_result(groupsnum == 1);
+	test_result(groups[0].Number == sms.Number);
+	test_result(!groups[0].Whole);
+	for (i = 0; i < sms.Number; i++) {
+		compare_sms(&sms.SMS[i], first[groups[0].Parts[i]]);
+	}
+	for (i = 0; i < sms.Number; i++) {
+		free(first[i]);
+	}
+
+	free(out);
+	GSM_SMSArena_Free(&arena);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,263 @@
+/**
+ * Test for reading messages indicated by the phone and for choosing
+ * how often all messages are read.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include <string.h>
+#include "common.h"
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+#include "../smsd/core.h"
+#include "../smsd/services/null.h"
+
+void SMSD_IncomingSMSCallback(GSM_StateMachine *s, GSM_SMSMessage *sms, void *user_data);
+gboolean SMSD_ReadIndicatedSMS(GSM_SMSDConfig *Config);
+gboolean SMSD_ReadDeleteSMS(GSM_SMSDConfig *Config);
+void SMSD_UpdateReceiveMode(GSM_SMSDConfig *Config, long long now);
+
+#define LOCATIONS 10
+
+/* Fake phone storage */
+static gboolean present[LOCATIONS + 1];
+static int fail_location;
+
+/* Statistics */
+static int reads, listings, deletes;
+
+static void fill_sms(GSM_MultiSMSMessage *sms, int location)
+{
+	GSM_SetDefaultSMSData(&sms->SMS[0]);
+	sms->Number = 1;
+	sms->SMS[0].PDU = SMS_Deliver;
+	sms->SMS[0].InboxFolder = TRUE;
+	sms->SMS[0].Folder = 1;
+	sms->SMS[0].Location = location;
+	sms->SMS[0].Memory = MEM_SM;
+	sms->SMS[0].State = SMS_UnRead;
+	sms->SMS[0].Coding = SMS_Coding_Default_No_Compression;
+	EncodeUnicode(sms->SMS[0].Number, "+420123456789", 13);
+	EncodeUnicode(sms->SMS[0].Text, "Test", 4);
+}
+
+static GSM_Error fake_pre_api_call(GSM_StateMachine *s UNUSED)
+{
+	return ERR_NONE;
+}
+
+static GSM_Error fake_get_sms(GSM_StateMachine *s UNUSED, GSM_MultiSMSMessage *sms)
+{
+	int location = sms->SMS[0].Location;
+
+	reads++;
+	if (location == fail_location) {
+		return ERR_TIMEOUT;
+	}
+	if (location < 1 || location > LOCATIONS || !present[location]) {
+		return ERR_EMPTY;
+	}
+	fill_sms(sms, location);
+	return ERR_NONE;
+}
+
+static GSM_Error fake_get_next_sms(GSM_StateMachine *s UNUSED, GSM_MultiSMSMessage *sms, gboolean start)
+{
+	int location;
+
+	if (start) {
+		listings++;
+		location = 1;
+	} else {
+		location = sms->SMS[0].Location + 1;
+	}
+	for (; location <= LOCATIONS; location++) {
+		if (present[location]) {
+			fill_sms(sms, location);
+			return ERR_NONE;
+		}
+	}
+	return ERR_EMPTY;
+}
+
+static GSM_Error fake_delete_sms(GSM_StateMachine *s UNUSED, GSM_SMSMessage *sms)
+{
+	deletes++;
+	if (!present[sms->Location]) {
+		return ERR_EMPTY;
+	}
+	present[sms->Location] = FALSE;
+	return ERR_NONE;
+}
+
+static GSM_Error fake_delete_sms_batch(GSM_StateMachine *s UNUSED, GSM_SMSLocation *locations UNUSED, int count UNUSED)
+{
+	return ERR_NOTIMPLEMENTED;
+}
+
+/* Phone tells about message stored at location */
+static void indicate(GSM_SMSDConfig *Config, int location)
+{
+	GSM_SMSMessage info;
+
+	memset(&info, 0, sizeof(info));
+	info.Folder = 1;
+	info.Location = location;
+	info.Memory = MEM_SM;
+	SMSD_IncomingSMSCallback(Config->gsm, &info, Config);
+}
+
+/* Full scan as done by main loop */
+static void scan(GSM_SMSDConfig *Config)
+{
+	Config->ScanNeeded = FALSE;
+	test_result(SMSD_ReadDeleteSMS(Config));
+	SMSD_UpdateReceiveMode(Config, 0);
+}
+
+static long long receive_period(GSM_SMSDConfig *Config)
+{
+	return Config->Scheduler.Timers[SMSD_TIMER_RECEIVE].Period;
+}
+
+static void reset_stats(void)
+{
+	reads = listings = deletes = 0;
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Phone_Functions phone;
+	GSM_SMSDConfig *Config;
+	GSM_SMSDStatus status;
+	GSM_StateMachine *s;
+	int i;
+
+	Config = SMSD_NewConfig("test");
+	test_result(Config != NULL);
+
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+	memset(&phone, 0, sizeof(phone));
+	phone.PreAPICall = fake_pre_api_call;
+	phone.GetSMS = fake_get_sms;
+	phone.GetNextSMS = fake_get_next_sms;
+	phone.DeleteSMS = fake_delete_sms;
+	phone.DeleteSMSBatch = fake_delete_sms_batch;
+	s->Phone.Functions = &phone;
+	s->opened = TRUE;
+
+	memset(&status, 0, sizeof(status));
+	Config->gsm = s;
+	Config->Status = &status;
+	Config->Service = &SMSDNull;
+	Config->enable_receive = TRUE;
+	Config->IncomingNotify = TRUE;
+	Config->loopsleep = 1;
+	Config->receivefrequency = 15;
+	Config->reconcilefrequency = 300;
+	Config->multiparttimeout = 600;
+	Config->IncompleteMessageID = -1;
+	Config->IncompleteMessageTime = 0;
+
+	/* Without indications all messages are read regularly */
+	scan(Config);
+	test_result(!Config->NotifyHealthy);
+	test_result(receive_period(Config) == 15000);
+
+	/* Indicated message is read directly */
+	present[1] = TRUE;
+	indicate(Config, 1);
+	test_result(Config->Indicated.Number == 1);
+	test_result(Config->Indications == 1);
+	reset_stats();
+	test_result(SMSD_ReadIndicatedSMS(Config));
+	test_result(reads == 1);
+	test_result(listings == 0);
+	test_result(deletes == 1);
+	test_result(!present[1]);
+	test_result(status.Received == 1);
+	test_result(Config->Indicated.Number == 0);
+	test_result(!Config->ScanNeeded);
+	test_result(Config->Expected.Number == 0);
+
+	/* Failed read falls back to full scan */
+	present[2] = TRUE;
+	fail_location = 2;
+	indicate(Config, 2);
+	reset_stats();
+	test_result(!SMSD_ReadIndicatedSMS(Config));
+	test_result(reads == 1);
+	test_result(deletes == 0);
+	test_result(present[2]);
+	test_result(Config->Indicated.Number == 0);
+	test_result(Config->ScanNeeded);
+	fail_location = 0;
+	scan(Config);
+	test_result(listings == 1);
+	test_result(!present[2]);
+	test_result(status.Received == 2);
+	test_result(!Config->ScanNeeded);
+
+	/* Message found by scan was indicated, so scanning is rare */
+	test_result(Config->UnexpectedMessages == 1);
+	test_result(Config->NotifyHealthy);
+	test_result(receive_period(Config) == 300000);
+
+	/* Message which was not indicated brings back frequent scans */
+	present[3] = TRUE;
+	scan(Config);
+	test_result(!present[3]);
+	test_result(Config->UnexpectedMessages == 1);
+	test_result(!Config->NotifyHealthy);
+	test_result(receive_period(Config) == 15000);
+
+	/* Indicated messages recover reconcile mode */
+	present[4] = TRUE;
+	indicate(Config, 4);
+	test_result(SMSD_ReadIndicatedSMS(Config));
+	scan(Config);
+	test_result(Config->UnexpectedMessages == 0);
+	test_result(Config->NotifyHealthy);
+	test_result(receive_period(Config) == 300000);
+
+	/* Many indicated messages are read by single scan */
+	for (i = 5; i <= LOCATIONS; i++) {
+		present[i] = TRUE;
+		indicate(Config, i);
+	}
+	reset_stats();
+	test_result(SMSD_ReadIndicatedSMS(Config));
+	test_result(reads == 0);
+	test_result(Config->ScanNeeded);
+	scan(Config);
+	test_result(listings == 1);
+	test_result(Config->UnexpectedMessages == LOCATIONS - 4);
+	test_result(Config->NotifyHealthy);
+	for (i = 1; i <= LOCATIONS; i++) {
+		test_result(!present[i]);
+	}
+
+	/* Phone not sending indications is always scanned regularly */
+	Config->IncomingNotify = FALSE;
+	scan(Config);
+	test_result(!Config->NotifyHealthy);
+	test_result(receive_period(Config) == 15000);
+
+	/* Reconciling can not be less frequent than receiving */
+	Config->IncomingNotify = TRUE;
+	Config->reconcilefrequency = 10;
+	scan(Config);
+	test_result(!Config->NotifyHealthy);
+	test_result(receive_period(Config) == 15000);
+
+	Config->Status = NULL;
+	Config->Service = NULL;
+	s->opened = FALSE;
+	SMSD_FreeConfig(Config);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,175 @@
+/**
+ * Test for SMSD journal of service writes.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#include "../smsd/core.h"
+#include "../smsd/journal.h"
+
+#define JOURNAL_FILE "smsd-journal.bin"
+
+static int replayed[10];
+static int replayed_count = 0;
+static int fail_at = -1;
+
+static GSM_Error replay(GSM_SMSDConfig *Config UNUSED, SMSD_JournalRecord *Record, GSM_MultiSMSMessage *sms)
+{
+	if (replayed_count == fail_at) {
+		fail_at = -1;
+		return ERR_DB_TIMEOUT;
+	}
+	test_result(replayed_count < 10);
+	replayed[replayed_count++] = Record->Type;
+
+	switch (Record->Type) {
+		case SMSD_JOURNAL_INBOX:
+			test_result(sms->Number == 2);
+			test_result(sms->SMS[1].Location == 42);
+			break;
+		case SMSD_JOURNAL_SENT:
+			test_result(sms->Number == 1);
+			test_result(strcmp(Record->ID, "123") == 0);
+			test_result(strcmp(Record->DT, "2019-01-01 00:00:00") == 0);
+			test_result(Record->Part == 1);
+			test_result(Record->TPMR == 7);
+			break;
+		case SMSD_JOURNAL_MOVE:
+			test_result(sms->Number == 0);
+			test_result(strcmp(Record->ID, "123") == 0);
+			break;
+	}
+	return ERR_NONE;
+}
+
+static gboolean file_exists(const char *path)
+{
+	FILE *f;
+
+	f = fopen(path, "rb");
+	if (f == NULL) {
+		return FALSE;
+	}
+	fclose(f);
+	return TRUE;
+}
+
+/* Journal with header of different version */
+static void write_foreign_journal(void)
+{
+	FILE *f;
+	char header[8 + 3 * sizeof(int)];
+	int version = 999;
+
+	memset(header, 0, sizeof(header));
+	strcpy(header, "GSMDJRN");
+	memcpy(header + 8, &version, sizeof(version));
+
+	f = fopen(JOURNAL_FILE, "wb");
+	test_result(f != NULL);
+	fwrite(header, sizeof(header), 1, f);
+	fputs("garbage, garbage, garbage", f);
+	fclose(f);
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_SMSDConfig *Config;
+	GSM_MultiSMSMessage sms;
+	SMSD_JournalRecord record;
+	FILE *f;
+
+	Config = SMSD_NewConfig("test");
+	test_result(Config != NULL);
+
+	remove(JOURNAL_FILE);
+
+	/* Disabled journal */
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_MOVE;
+	test_result(SMSD_Journal_Append(Config, &record, NULL) == ERR_NOTSUPPORTED);
+	test_result(!SMSD_Journal_Pending(Config));
+
+	Config->journalpath = JOURNAL_FILE;
+
+	memset(&sms, 0, sizeof(sms));
+	sms.Number = 2;
+	sms.SMS[1].Location = 42;
+	record.Type = SMSD_JOURNAL_INBOX;
+	record.Number = 2;
+	test_result(SMSD_Journal_Append(Config, &record, &sms) == ERR_NONE);
+	test_result(SMSD_Journal_Pending(Config));
+
+	sms.Number = 1;
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_SENT;
+	record.Number = 1;
+	strcpy(record.ID, "123");
+	strcpy(record.DT, "2019-01-01 00:00:00");
+	record.Part = 1;
+	record.TPMR = 7;
+	test_result(SMSD_Journal_Append(Config, &record, &sms) == ERR_NONE);
+
+	/* Number has to match stored message */
+	record.Number = 0;
+	test_result(SMSD_Journal_Append(Config, &record, &sms) != ERR_NONE);
+
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_MOVE;
+	strcpy(record.ID, "123");
+	test_result(SMSD_Journal_Append(Config, &record, NULL) == ERR_NONE);
+
+	/* Database disappears during replay */
+	fail_at = 1;
+	test_result(SMSD_Journal_Replay(Config, replay) == ERR_DB_TIMEOUT);
+	test_result(replayed_count == 1);
+	test_result(replayed[0] == SMSD_JOURNAL_INBOX);
+	test_result(SMSD_Journal_Pending(Config));
+
+	/* Remaining records are replayed in order */
+	test_result(SMSD_Journal_Replay(Config, replay) == ERR_NONE);
+	test_result(replayed_count == 3);
+	test_result(replayed[1] == SMSD_JOURNAL_SENT);
+	test_result(replayed[2] == SMSD_JOURNAL_MOVE);
+	test_result(!SMSD_Journal_Pending(Config));
+
+	/* Journal is removed after replay */
+	f = fopen(JOURNAL_FILE, "rb");
+	test_result(f == NULL);
+
+	/* Journal from different build is moved aside */
+	remove(JOURNAL_FILE ".bad");
+	write_foreign_journal();
+	Config->journal_pending = TRUE;
+	test_result(SMSD_Journal_Replay(Config, replay) == ERR_FILENOTSUPPORTED);
+	test_result(!SMSD_Journal_Pending(Config));
+	test_result(replayed_count == 3);
+	test_result(file_exists(JOURNAL_FILE ".bad"));
+	test_result(!file_exists(JOURNAL_FILE));
+	remove(JOURNAL_FILE ".bad");
+
+	/* New records are not appended behind foreign header */
+	write_foreign_journal();
+	memset(&record, 0, sizeof(record));
+	record.Type = SMSD_JOURNAL_MOVE;
+	strcpy(record.ID, "123");
+	test_result(SMSD_Journal_Append(Config, &record, NULL) == ERR_NONE);
+	test_result(file_exists(JOURNAL_FILE ".bad"));
+	test_result(SMSD_Journal_Replay(Config, replay) == ERR_NONE);
+	test_result(replayed_count == 4);
+	test_result(replayed[3] == SMSD_JOURNAL_MOVE);
+	test_result(!file_exists(JOURNAL_FILE));
+	remove(JOURNAL_FILE ".bad");
+
+	Config->journalpath = NULL;
+	SMSD_FreeConfig(Config);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
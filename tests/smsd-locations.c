@@ -0,0 +1,67 @@
+/**
+ * Test for SMSD lists of message locations.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include "common.h"
+#include "../smsd/locations.h"
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	SMSD_Locations list;
+	GSM_Error error;
+	int i;
+
+	SMSD_Locations_Init(&list);
+	test_result(list.Number == 0);
+	test_result(!SMSD_Locations_Contains(&list, 1, 1, MEM_SM));
+
+	/* Duplicates are stored only once */
+	error = SMSD_Locations_Add(&list, 1, 1, MEM_SM);
+	gammu_test_result(error, "SMSD_Locations_Add");
+	error = SMSD_Locations_Add(&list, 1, 1, MEM_SM);
+	gammu_test_result(error, "SMSD_Locations_Add");
+	test_result(list.Number == 1);
+
+	/* Memory is part of location */
+	error = SMSD_Locations_Add(&list, 1, 1, MEM_SR);
+	gammu_test_result(error, "SMSD_Locations_Add");
+	test_result(list.Number == 2);
+	test_result(SMSD_Locations_Contains(&list, 1, 1, MEM_SR));
+	test_result(!SMSD_Locations_Contains(&list, 0, 1, MEM_SR));
+
+	/* List grows */
+	for (i = 2; i < 100; i++) {
+		error = SMSD_Locations_Add(&list, 0, i, MEM_ME);
+		gammu_test_result(error, "SMSD_Locations_Add");
+	}
+	test_result(list.Number == 100);
+	test_result(list.Size >= 100);
+
+	/* Removing keeps other locations */
+	test_result(SMSD_Locations_Remove(&list, 1, 1, MEM_SM));
+	test_result(!SMSD_Locations_Remove(&list, 1, 1, MEM_SM));
+	test_result(list.Number == 99);
+	test_result(!SMSD_Locations_Contains(&list, 1, 1, MEM_SM));
+	test_result(SMSD_Locations_Contains(&list, 1, 1, MEM_SR));
+	for (i = 2; i < 100; i++) {
+		test_result(SMSD_Locations_Contains(&list, 0, i, MEM_ME));
+	}
+
+	/* Clearing keeps memory for reuse */
+	SMSD_Locations_Clear(&list);
+	test_result(list.Number == 0);
+	test_result(list.Size >= 100);
+	test_result(!SMSD_Locations_Contains(&list, 0, 2, MEM_ME));
+
+	SMSD_Locations_Free(&list);
+	test_result(list.Locations == NULL);
+	test_result(list.Size == 0);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
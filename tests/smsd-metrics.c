@@ -0,0 +1,69 @@
+/**
+ * Test for SMSD latency metrics.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include <string.h>
+#include "common.h"
+#include "../smsd/core.h"
+#include "../smsd/metrics.h"
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_SMSDConfig *Config;
+	GSM_SMSDStatus status;
+	GSM_SMSDMetric *metric;
+	int i;
+	unsigned int total = 0;
+
+	memset(&status, 0xff, sizeof(status));
+	SMSD_Metrics_Init(&status);
+	test_result(status.BucketLimits[0] == 1);
+	test_result(status.BucketLimits[SMSD_METRIC_BUCKETS - 1] == -1);
+	test_result(status.Metrics[SMSD_METRIC_SUBMIT].Count == 0);
+
+	/* Bucket limits are inclusive */
+	SMSD_Metrics_Add(&status, SMSD_METRIC_SUBMIT, 0, FALSE);
+	SMSD_Metrics_Add(&status, SMSD_METRIC_SUBMIT, 1, FALSE);
+	SMSD_Metrics_Add(&status, SMSD_METRIC_SUBMIT, 2, TRUE);
+	SMSD_Metrics_Add(&status, SMSD_METRIC_SUBMIT, 300, FALSE);
+	SMSD_Metrics_Add(&status, SMSD_METRIC_SUBMIT, 60000, FALSE);
+	/* Clock going backwards */
+	SMSD_Metrics_Add(&status, SMSD_METRIC_SUBMIT, -5, FALSE);
+
+	metric = &status.Metrics[SMSD_METRIC_SUBMIT];
+	test_result(metric->Count == 6);
+	test_result(metric->Errors == 1);
+	test_result(metric->Sum == 60303);
+	test_result(metric->Max == 60000);
+	test_result(metric->Buckets[0] == 3);
+	test_result(metric->Buckets[1] == 1);
+	test_result(metric->Buckets[8] == 1);
+	test_result(metric->Buckets[SMSD_METRIC_BUCKETS - 1] == 1);
+	for (i = 0; i < SMSD_METRIC_BUCKETS; i++) {
+		total += metric->Buckets[i];
+	}
+	test_result(total == metric->Count);
+
+	/* Other stages are not touched */
+	test_result(status.Metrics[SMSD_METRIC_INBOX].Count == 0);
+
+	/* Recording without status is ignored */
+	Config = SMSD_NewConfig("test");
+	test_result(Config != NULL);
+	Config->Status = NULL;
+	SMSD_Metrics_Record(Config, SMSD_METRIC_INBOX, 0, ERR_NONE);
+	Config->Status = &status;
+	SMSD_Metrics_Record(Config, SMSD_METRIC_INBOX, GSM_GetMonotonicTime(), ERR_TIMEOUT);
+	test_result(status.Metrics[SMSD_METRIC_INBOX].Count == 1);
+	test_result(status.Metrics[SMSD_METRIC_INBOX].Errors == 1);
+	Config->Status = NULL;
+	SMSD_FreeConfig(Config);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
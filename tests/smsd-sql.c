@@ -0,0 +1,289 @@
+/**
+ * Test for SQL service reading outbox messages with all their parts
+ * and journaling their removal while database is not available.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "../smsd/core.h"
+#include "../smsd/journal.h"
+#include "../smsd/services/sql.h"
+#include "../smsd/services/sql-core.h"
+
+#define JOURNAL_FILE "smsd-sql-journal.bin"
+
+#if defined(HAVE_POSTGRESQL_LIBPQ_FE_H)
+#define TEST_DRIVER "native_pgsql"
+#elif defined(HAVE_MYSQL_MYSQL_H)
+#define TEST_DRIVER "native_mysql"
+#else
+#define TEST_DRIVER "sqlite3"
+#endif
+
+/* Columns of outbox row joined with outbox_multipart row */
+#define COLUMNS 23
+
+typedef const char *Row[COLUMNS];
+
+/* Single part message */
+static Row single_rows[] = {
+	{NULL, "Default_No_Compression", NULL, "-1", "Hello", "42", "+420123456789", "0", "255", "0", "test", "0", "Reserved", "-1",
+		NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL},
+};
+
+/* Outbox row joined with its parts */
+#define OUTBOX_ROW(position, text) \
+	{NULL, "Default_No_Compression", NULL, "-1", "Part 1", "42", "+420123456789", "1", "255", "0", "test", "0", "Reserved", "-1", \
+		NULL, "Default_No_Compression", NULL, "-1", text, "42", position, "Reserved", "-1"}
+
+static Row multipart_rows[] = {
+	OUTBOX_ROW("2", "Part 2"),
+	OUTBOX_ROW("3", "Part 3"),
+};
+
+/* Part 3 is missing */
+static Row missing_rows[] = {
+	OUTBOX_ROW("2", "Part 2"),
+	OUTBOX_ROW("4", "Part 4"),
+};
+
+/* Parts are not ordered */
+static Row unordered_rows[] = {
+	OUTBOX_ROW("3", "Part 3"),
+	OUTBOX_ROW("2", "Part 2"),
+};
+
+/* Row with message ID, only first two columns are used */
+static Row id_rows[] = {
+	{"42", "2019-01-01 00:00:00"},
+};
+
+/* Fake database state */
+static gboolean db_down;
+static Row *outbox_rows = single_rows;
+static int outbox_count = 1;
+static Row *rows;
+static int row_count, row_pos;
+static int queries, deletes, fetches;
+
+static GSM_Error fake_connect(GSM_SMSDConfig *Config UNUSED)
+{
+	if (db_down) {
+		return ERR_DB_TIMEOUT;
+	}
+	return ERR_NONE;
+}
+
+static GSM_Error fake_query(GSM_SMSDConfig *Config UNUSED, const char *query, SQL_result *res UNUSED)
+{
+	if (db_down) {
+		return ERR_DB_TIMEOUT;
+	}
+	queries++;
+	rows = NULL;
+	row_count = 0;
+	row_pos = -1;
+	if (strncmp(query, "DELETE", 6) == 0) {
+		deletes++;
+	} else if (strstr(query, "LEFT JOIN") != NULL) {
+		fetches++;
+		rows = outbox_rows;
+		row_count = outbox_count;
+	} else if (strncmp(query, "SELECT", 6) == 0) {
+		rows = id_rows;
+		row_count = sizeof(id_rows) / sizeof(id_rows[0]);
+	}
+	return ERR_NONE;
+}
+
+static void fake_free(GSM_SMSDConfig *Config UNUSED)
+{
+}
+
+static void fake_free_result(GSM_SMSDConfig *Config UNUSED, SQL_result *res UNUSED)
+{
+}
+
+static int fake_next_row(GSM_SMSDConfig *Config UNUSED, SQL_result *res UNUSED)
+{
+	row_pos++;
+	return row_pos < row_count ? 1 : 0;
+}
+
+static unsigned long long fake_seq_id(GSM_SMSDConfig *Config UNUSED, const char *id UNUSED)
+{
+	return 0;
+}
+
+static unsigned long fake_affected_rows(GSM_SMSDConfig *Config UNUSED, SQL_result *res UNUSED)
+{
+	return 1;
+}
+
+static const char *fake_get_string(GSM_SMSDConfig *Config UNUSED, SQL_result *res UNUSED, unsigned int column)
+{
+	test_result(row_pos >= 0 && row_pos < row_count);
+	test_result(column < COLUMNS);
+	return rows[row_pos][column];
+}
+
+static long long fake_get_number(GSM_SMSDConfig *Config, SQL_result *res, unsigned int column)
+{
+	const char *value = fake_get_string(Config, res, column);
+
+	return value == NULL ? 0 : atoll(value);
+}
+
+static time_t fake_get_date(GSM_SMSDConfig *Config UNUSED, SQL_result *res UNUSED, unsigned int column UNUSED)
+{
+	return 1546300800;
+}
+
+static gboolean fake_get_bool(GSM_SMSDConfig *Config, SQL_result *res, unsigned int column)
+{
+	return fake_get_number(Config, res, column) != 0;
+}
+
+static char *fake_quote_string(GSM_SMSDConfig *Config UNUSED, const char *string)
+{
+	char *result;
+
+	result = malloc(strlen(string) + 3);
+	sprintf(result, "'%s'", string);
+	return result;
+}
+
+static struct GSM_SMSDdbobj fake_db = {
+	fake_connect,
+	fake_query,
+	fake_free,
+	fake_free_result,
+	fake_next_row,
+	fake_seq_id,
+	fake_affected_rows,
+	fake_get_string,
+	fake_get_number,
+	fake_get_date,
+	fake_get_bool,
+	fake_quote_string,
+	NULL,
+	NULL,
+};
+
+static GSM_Error find_outbox(GSM_SMSDConfig *Config, GSM_MultiSMSMessage *sms, char *ID)
+{
+	/* Do not wait for reconnection backoff */
+	Config->db_retry = 0;
+	return SMSDSQL.FindOutboxSMS(sms, Config, ID);
+}
+
+static void set_outbox(Row *outbox, int count)
+{
+	outbox_rows = outbox;
+	outbox_count = count;
+}
+
+static gboolean part_text(GSM_MultiSMSMessage *sms, int part, const char *text)
+{
+	return strcmp(DecodeUnicodeString(sms->SMS[part].Text), text) == 0;
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_MultiSMSMessage *sms;
+	GSM_SMSDConfig *Config;
+	GSM_SMSDStatus status;
+	char ID[200];
+
+	sms = malloc(sizeof(GSM_MultiSMSMessage));
+	test_result(sms != NULL);
+
+	Config = SMSD_NewConfig("test");
+	test_result(Config != NULL);
+
+	memset(&status, 0, sizeof(status));
+	Config->Status = &status;
+	Config->driver = TEST_DRIVER;
+	Config->backend_retries = 1;
+	test_result(SMSDSQL.ReadConfiguration(Config) == ERR_NONE);
+	Config->db = &fake_db;
+	Config->db_attempts = 0;
+	Config->db_retry = 0;
+	Config->outbox_fetched[0] = 0;
+
+	remove(JOURNAL_FILE);
+	Config->journalpath = JOURNAL_FILE;
+
+	/* Message is read from outbox */
+	test_result(find_outbox(Config, sms, ID) == ERR_NONE);
+	test_result(strcmp(ID, "42") == 0);
+	test_result(sms->Number == 1);
+	test_result(fetches == 1);
+
+	/* Message which was not read is not removed later */
+	db_down = TRUE;
+	test_result(find_outbox(Config, sms, ID) == ERR_DB_TIMEOUT);
+	strcpy(ID, "42");
+	test_result(SMSDSQL.MoveSMS(sms, Config, ID, FALSE, TRUE) == ERR_DB_TIMEOUT);
+	test_result(!SMSD_Journal_Pending(Config));
+
+	/* Removal of read message is journaled */
+	db_down = FALSE;
+	test_result(find_outbox(Config, sms, ID) == ERR_NONE);
+	db_down = TRUE;
+	test_result(SMSDSQL.MoveSMS(sms, Config, ID, FALSE, TRUE) == ERR_NONE);
+	test_result(SMSD_Journal_Pending(Config));
+
+	/* Outbox is not read while the removal is only in journal */
+	queries = 0;
+	test_result(find_outbox(Config, sms, ID) == ERR_DB_TIMEOUT);
+	test_result(queries == 0);
+
+	/* Journal is replayed before outbox is read again */
+	db_down = FALSE;
+	deletes = 0;
+	fetches = 0;
+	test_result(find_outbox(Config, sms, ID) == ERR_NONE);
+	test_result(!SMSD_Journal_Pending(Config));
+	test_result(deletes == 2);
+	test_result(fetches == 1);
+
+	/* Parts are read in order from single query */
+	set_outbox(multipart_rows, 2);
+	fetches = 0;
+	test_result(find_outbox(Config, sms, ID) == ERR_NONE);
+	test_result(fetches == 1);
+	test_result(sms->Number == 3);
+	test_result(part_text(sms, 0, "Part 1"));
+	test_result(part_text(sms, 1, "Part 2"));
+	test_result(part_text(sms, 2, "Part 3"));
+	test_result(strcmp(DecodeUnicodeString(sms->SMS[2].Number), "+420123456789") == 0);
+
+	/* Reading stops at missing part */
+	set_outbox(missing_rows, 2);
+	test_result(find_outbox(Config, sms, ID) == ERR_NONE);
+	test_result(sms->Number == 2);
+	test_result(part_text(sms, 1, "Part 2"));
+
+	/* Part which does not follow previous one is not read */
+	set_outbox(unordered_rows, 2);
+	test_result(find_outbox(Config, sms, ID) == ERR_NONE);
+	test_result(sms->Number == 1);
+
+	SMSDSQL.Free(Config);
+	remove(JOURNAL_FILE);
+	Config->journalpath = NULL;
+	Config->Status = NULL;
+	SMSD_FreeConfig(Config);
+	free(sms);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,64 @@
+/**
+ * Test for consistent reading of SMSD shared status.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include <string.h>
+#include "common.h"
+#include "../smsd/core.h"
+#include "../smsd/status.h"
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_SMSDConfig *Config;
+	GSM_SMSDStatus status, copy;
+	GSM_Error error;
+
+	memset(&status, 0, sizeof(status));
+	status.Version = SMSD_SHM_VERSION;
+	status.Sent = 5;
+
+	/* Consistent read */
+	test_result(SMSD_Status_Read(&status, &copy));
+	test_result(copy.Sent == 5);
+
+	/* Reading during update fails */
+	SMSD_Status_BeginUpdate(&status);
+	test_result(status.Sequence == 1);
+	status.Sent++;
+	test_result(!SMSD_Status_Read(&status, &copy));
+	SMSD_Status_EndUpdate(&status);
+	test_result(status.Sequence == 2);
+	test_result(SMSD_Status_Read(&status, &copy));
+	test_result(copy.Sent == 6);
+
+	/* Updates without status are ignored */
+	SMSD_Status_BeginUpdate(NULL);
+	SMSD_Status_EndUpdate(NULL);
+
+	/* Local instance is read through the lock as well */
+	Config = SMSD_NewConfig("test");
+	test_result(Config != NULL);
+	Config->Status = &status;
+	Config->running = TRUE;
+	error = SMSD_GetStatus(Config, &copy);
+	gammu_test_result(error, "SMSD_GetStatus");
+	test_result(copy.Sent == 6);
+
+	/* Update never finished */
+	SMSD_Status_BeginUpdate(&status);
+	error = SMSD_GetStatus(Config, &copy);
+	test_result(error == ERR_TIMEOUT);
+	SMSD_Status_EndUpdate(&status);
+
+	Config->running = FALSE;
+	Config->Status = NULL;
+	SMSD_FreeConfig(Config);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,171 @@
+/**
+ * Test for STREAM service writing only complete events after write
+ * failures.
+ */
+
+#include <gammu.h>
+#include <gammu-smsd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "common.h"
+#include "../smsd/core.h"
+#include "../smsd/services/stream.h"
+
+#define LOG_FILE "smsd-stream.log"
+#define SOCKET_FILE "smsd-stream.sock"
+
+static void fill_sms(GSM_MultiSMSMessage *sms)
+{
+	memset(sms, 0, sizeof(GSM_MultiSMSMessage));
+	GSM_SetDefaultSMSData(&sms->SMS[0]);
+	sms->Number = 1;
+	sms->SMS[0].PDU = SMS_Deliver;
+	sms->SMS[0].Coding = SMS_Coding_Default_No_Compression;
+	EncodeUnicode(sms->SMS[0].Number, "+420123456789", 13);
+	EncodeUnicode(sms->SMS[0].Text, "Test", 4);
+}
+
+static off_t file_size(const char *name)
+{
+	struct stat st;
+
+	test_result(stat(name, &st) == 0);
+	return st.st_size;
+}
+
+/* Reads single event line from socket */
+static size_t read_line(int fd, char *line, size_t size)
+{
+	size_t pos = 0;
+	ssize_t ret;
+
+	while (pos == 0 || line[pos - 1] != '\n') {
+		test_result(pos < size);
+		ret = recv(fd, line + pos, size - pos, 0);
+		test_result(ret > 0);
+		pos += ret;
+	}
+	return pos;
+}
+
+static void test_file(GSM_SMSDConfig *Config, GSM_MultiSMSMessage *sms)
+{
+	struct rlimit limit, small;
+	off_t size;
+	FILE *log;
+
+	remove(LOG_FILE);
+	Config->streampath = LOG_FILE;
+	Config->streamsocket = NULL;
+
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) == ERR_NONE);
+	size = file_size(LOG_FILE);
+	test_result(size > 0);
+
+	/* Only part of the event fits into the file */
+	signal(SIGXFSZ, SIG_IGN);
+	test_result(getrlimit(RLIMIT_FSIZE, &limit) == 0);
+	small = limit;
+	small.rlim_cur = size + 10;
+	test_result(setrlimit(RLIMIT_FSIZE, &small) == 0);
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) != ERR_NONE);
+	test_result(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+	/* Incomplete event was removed */
+	test_result(file_size(LOG_FILE) == size);
+
+	/* Log is reopened with next write */
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) == ERR_NONE);
+	test_result(file_size(LOG_FILE) == 2 * size);
+	SMSDStream.Free(Config);
+
+	/* Event left incomplete by terminated SMSD is removed */
+	log = fopen(LOG_FILE, "a");
+	test_result(log != NULL);
+	fputs("{\"event\":\"rec", log);
+	fclose(log);
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) == ERR_NONE);
+	test_result(file_size(LOG_FILE) == 3 * size);
+
+	SMSDStream.Free(Config);
+	remove(LOG_FILE);
+}
+
+static void test_socket(GSM_SMSDConfig *Config, GSM_MultiSMSMessage *sms)
+{
+	struct sockaddr_un addr;
+	char first[1000], second[1000];
+	size_t first_len, second_len;
+	int listener, fd;
+
+	remove(SOCKET_FILE);
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	test_result(listener != -1);
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, SOCKET_FILE);
+	test_result(bind(listener, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+	test_result(listen(listener, 2) == 0);
+
+	Config->streampath = NULL;
+	Config->streamsocket = SOCKET_FILE;
+
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) == ERR_NONE);
+	fd = accept(listener, NULL, NULL);
+	test_result(fd != -1);
+	first_len = read_line(fd, first, sizeof(first));
+
+	/* Consumer was restarted, event is written to new connection */
+	close(fd);
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) == ERR_NONE);
+	fd = accept(listener, NULL, NULL);
+	test_result(fd != -1);
+	second_len = read_line(fd, second, sizeof(second));
+	test_result(first_len == second_len);
+	test_result(memcmp(first, second, first_len) == 0);
+	close(fd);
+
+	/* Without consumer writing fails */
+	close(listener);
+	remove(SOCKET_FILE);
+	test_result(SMSDStream.SaveInboxSMS(sms, Config, NULL) != ERR_NONE);
+
+	SMSDStream.Free(Config);
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_MultiSMSMessage *sms;
+	GSM_SMSDConfig *Config;
+
+	sms = malloc(sizeof(GSM_MultiSMSMessage));
+	test_result(sms != NULL);
+	fill_sms(sms);
+
+	Config = SMSD_NewConfig("test");
+	test_result(Config != NULL);
+
+	/* Sending to closed socket must not terminate us */
+	signal(SIGPIPE, SIG_IGN);
+
+	test_file(Config, sms);
+	test_socket(Config, sms);
+
+	Config->streampath = NULL;
+	Config->streamsocket = NULL;
+	SMSD_FreeConfig(Config);
+	free(sms);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */
@@ -0,0 +1,197 @@
+/* Test for usb transfer handling using fake transport */
+
+#include <gammu.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <libusb.h>
+#include "common.h"
+#include "../libgammu/gsmstate.h"	/* Needed for state machine internals */
+
+GSM_Error GSM_USB_StartTransfers(GSM_StateMachine *s);
+void GSM_USB_StopTransfers(GSM_StateMachine *s);
+ssize_t GSM_USB_Read(GSM_StateMachine *s, void *buf, size_t nbytes);
+ssize_t GSM_USB_Write(GSM_StateMachine *s, const void *buf, size_t nbytes);
+
+#define EP_READ 0x81
+#define EP_WRITE 0x02
+
+/* Transfers currently owned by fake transport */
+static struct libusb_transfer *queue[32];
+static int queued;
+static int submits;
+
+/* How many reads to finish in next event handling and how */
+static int read_count;
+static enum libusb_transfer_status read_status;
+static enum libusb_transfer_status write_status;
+static const char read_data[] = "ABC";
+
+static int fake_submit(struct libusb_transfer *transfer)
+{
+	submits++;
+	queue[queued++] = transfer;
+	return 0;
+}
+
+static int fake_cancel(struct libusb_transfer *transfer)
+{
+	transfer->status = LIBUSB_TRANSFER_CANCELLED;
+	/* Mark as pending completion */
+	transfer->actual_length = -1;
+	return 0;
+}
+
+static void finish(int i, enum libusb_transfer_status status)
+{
+	struct libusb_transfer *transfer = queue[i];
+
+	memmove(queue + i, queue + i + 1, (queued - i - 1) * sizeof(queue[0]));
+	queued--;
+
+	transfer->status = status;
+	if (status == LIBUSB_TRANSFER_COMPLETED) {
+		if (transfer->endpoint == EP_READ) {
+			memcpy(transfer->buffer, read_data, strlen(read_data));
+			transfer->actual_length = strlen(read_data);
+		} else {
+			transfer->actual_length = transfer->length;
+		}
+	} else {
+		transfer->actual_length = 0;
+	}
+	transfer->callback(transfer);
+	if (transfer->flags & LIBUSB_TRANSFER_FREE_TRANSFER) {
+		libusb_free_transfer(transfer);
+	}
+}
+
+static int fake_handle_events(libusb_context *context UNUSED, struct timeval *tv UNUSED, int *completed UNUSED)
+{
+	int i = 0;
+
+	while (i < queued) {
+		if (queue[i]->actual_length == -1) {
+			finish(i, LIBUSB_TRANSFER_CANCELLED);
+		} else if (queue[i]->endpoint == EP_WRITE) {
+			finish(i, write_status);
+		} else if (read_count > 0) {
+			read_count--;
+			finish(i, read_status);
+		} else {
+			i++;
+		}
+	}
+	return 0;
+}
+
+static const GSM_USB_Transport fake_transport = {
+	fake_submit,
+	fake_cancel,
+	fake_handle_events
+};
+
+static void start(GSM_StateMachine *s)
+{
+	GSM_Error error;
+
+	submits = 0;
+	error = GSM_USB_StartTransfers(s);
+	gammu_test_result(error, "GSM_USB_StartTransfers");
+	test_result(submits == GSM_USB_READ_TRANSFERS);
+	test_result(s->Device.Data.USB.read_active == GSM_USB_READ_TRANSFERS);
+}
+
+static void stop(GSM_StateMachine *s)
+{
+	GSM_USB_StopTransfers(s);
+	test_result(queued == 0);
+	test_result(s->Device.Data.USB.read_active == 0);
+}
+
+int main(int argc UNUSED, char **argv UNUSED)
+{
+	GSM_Debug_Info *debug_info;
+	GSM_Device_USBData *d;
+	GSM_StateMachine *s;
+	char buffer[10];
+	ssize_t len;
+
+	debug_info = GSM_GetGlobalDebug();
+	GSM_SetDebugFileDescriptor(stderr, FALSE, debug_info);
+	GSM_SetDebugLevel("textall", debug_info);
+
+	s = GSM_AllocStateMachine();
+	test_result(s != NULL);
+	debug_info = GSM_GetDebug(s);
+	GSM_SetDebugGlobal(TRUE, debug_info);
+
+	d = &s->Device.Data.USB;
+	memset(d, 0, sizeof(*d));
+	d->transport = &fake_transport;
+	d->ep_read = EP_READ;
+	d->ep_write = EP_WRITE;
+
+	/* Received data are queued and transfer is resubmitted */
+	start(s);
+	read_count = 1;
+	read_status = LIBUSB_TRANSFER_COMPLETED;
+	len = GSM_USB_Read(s, buffer, sizeof(buffer));
+	test_result(len == 3);
+	test_result(memcmp(buffer, read_data, 3) == 0);
+	test_result(submits == GSM_USB_READ_TRANSFERS + 1);
+
+	/* Failed transfer is not resubmitted, others keep reading */
+	read_count = 1;
+	read_status = LIBUSB_TRANSFER_ERROR;
+	submits = 0;
+	test_result(GSM_USB_Read(s, buffer, sizeof(buffer)) == 0);
+	test_result(submits == 0);
+	test_result(d->read_active == GSM_USB_READ_TRANSFERS - 1);
+	test_result(d->transfer_error == LIBUSB_ERROR_IO);
+	read_count = 1;
+	read_status = LIBUSB_TRANSFER_COMPLETED;
+	test_result(GSM_USB_Read(s, buffer, sizeof(buffer)) == 3);
+	test_result(submits == 1);
+
+	/* Reading fails once no transfer is left */
+	read_count = GSM_USB_READ_TRANSFERS;
+	read_status = LIBUSB_TRANSFER_ERROR;
+	submits = 0;
+	test_result(GSM_USB_Read(s, buffer, sizeof(buffer)) == -1);
+	test_result(submits == 0);
+	test_result(d->read_active == 0);
+	stop(s);
+
+	/* Unplugged device is not resubmitted */
+	start(s);
+	read_count = GSM_USB_READ_TRANSFERS;
+	read_status = LIBUSB_TRANSFER_NO_DEVICE;
+	submits = 0;
+	test_result(GSM_USB_Read(s, buffer, sizeof(buffer)) == -1);
+	test_result(GSM_USB_Read(s, buffer, sizeof(buffer)) == -1);
+	test_result(submits == 0);
+	test_result(queued == 0);
+	test_result(d->transfer_error == LIBUSB_ERROR_NO_DEVICE);
+	stop(s);
+
+	/* Failed write is reported by the call itself */
+	start(s);
+	write_status = LIBUSB_TRANSFER_COMPLETED;
+	test_result(GSM_USB_Write(s, "AT\r", 3) == 3);
+	write_status = LIBUSB_TRANSFER_STALL;
+	test_result(GSM_USB_Write(s, "AT\r", 3) == -1);
+	write_status = LIBUSB_TRANSFER_COMPLETED;
+	test_result(GSM_USB_Write(s, "AT\r", 3) == 3);
+	test_result(d->write_active == 0);
+	stop(s);
+
+	/* Free state machine */
+	GSM_FreeStateMachine(s);
+
+	return 0;
+}
+
+/* Editor configuration
+ * vim: noexpandtab sw=8 ts=8 sts=8 tw=72:
+ */